@@ -41,8 +41,12 @@
 #include <locale>
 #include <codecvt>
 
+#include <algorithm>
 #include <vector>
 #include <tuple>
+#include <fstream>
+#include <iterator>
+#include <unistd.h>
 
 #include "Configuration.h"
 #include "MetaTypesList.h"
@@ -52,6 +56,9 @@
 #define CONFIGURATION_FILES_VERSION "1.0"
 #define CONFIGURATION_FILES_ENCODING "UTF-8"
 
+#define CONFIGURATION_BINARY_MAGIC "OSCB"
+#define CONFIGURATION_BINARY_VERSION 2
+
 #define CONFIGURATION_FLOAT_PRECISION 10
 #define CONFIGURATION_DOUBLE_PRECISION 20
 #define CONFIGURATION_LONG_DOUBLE_PRECISION 30
@@ -78,6 +85,39 @@ xmlNodePtr rootToXML(std::shared_ptr<OpenSANDConf::DataComponent> element);
 // fromXML functions
 bool loadRootFromXML(std::shared_ptr<OpenSANDConf::DataModel> datamodel, xmlNodePtr node);
 
+// binary encoding functions
+void hashString(uint64_t &hash, const std::string &value);
+void appendString(std::string &buffer, const std::string &value);
+bool readBytes(const std::string &buffer, std::size_t &pos, std::size_t length, std::string &value);
+bool readString(const std::string &buffer, std::size_t &pos, std::string &value);
+
+template<typename T>
+void appendInteger(std::string &buffer, T value)
+{
+	buffer.append(reinterpret_cast<const char *>(&value), sizeof(value));
+}
+
+template<typename T>
+bool readInteger(const std::string &buffer, std::size_t &pos, T &value)
+{
+	if (buffer.size() - pos < sizeof(value))
+	{
+		return false;
+	}
+	std::copy(buffer.begin() + pos, buffer.begin() + pos + sizeof(value), reinterpret_cast<char *>(&value));
+	pos += sizeof(value);
+	return true;
+}
+
+// modelHash functions
+void hashElement(uint64_t &hash, std::shared_ptr<OpenSANDConf::MetaElement> element);
+
+// toBinary functions
+void componentToBinary(std::string &buffer, std::shared_ptr<OpenSANDConf::DataComponent> element);
+
+// fromBinary functions
+bool loadComponentFromBinary(std::shared_ptr<OpenSANDConf::DataComponent> current, const std::string &buffer, std::size_t &pos);
+
 bool OpenSANDConf::toXSD(std::shared_ptr<OpenSANDConf::MetaModel> model, const std::string &filepath)
 {
 	int code;
@@ -360,6 +400,87 @@ error:
 	return datamodel;
 }
 
+uint64_t OpenSANDConf::modelHash(std::shared_ptr<OpenSANDConf::MetaModel> model)
+{
+	// FNV-1a
+	uint64_t hash = 0xcbf29ce484222325ULL;
+	hashString(hash, model->getVersion());
+	for (auto element : model->getTypesDefinition()->getEnumTypes())
+	{
+		hashString(hash, element->getId());
+		for (auto &v : element->getValues())
+		{
+			hashString(hash, v);
+		}
+	}
+	hashElement(hash, model->getRoot());
+	return hash;
+}
+
+bool OpenSANDConf::toBinary(std::shared_ptr<OpenSANDConf::MetaModel> model,
+                            std::shared_ptr<OpenSANDConf::DataModel> datamodel,
+                            const std::string &filepath,
+                            const std::string &source)
+{
+	std::string buffer(CONFIGURATION_BINARY_MAGIC);
+	appendInteger<uint32_t>(buffer, CONFIGURATION_BINARY_VERSION);
+	appendInteger<uint64_t>(buffer, modelHash(model));
+	appendString(buffer, source);
+	appendString(buffer, datamodel->getVersion());
+	componentToBinary(buffer, datamodel->getRoot());
+
+	// Write in a temporary file renamed afterwards so that concurrent
+	// readers never see a partial file
+	std::string tmppath = filepath + "." + std::to_string(getpid()) + ".tmp";
+	std::ofstream file(tmppath, std::ios::binary | std::ios::trunc);
+	file.write(buffer.data(), buffer.size());
+	file.close();
+	if (!file || rename(tmppath.c_str(), filepath.c_str()) != 0)
+	{
+		remove(tmppath.c_str());
+		return false;
+	}
+	return true;
+}
+
+std::shared_ptr<OpenSANDConf::DataModel> OpenSANDConf::fromBinary(std::shared_ptr<OpenSANDConf::MetaModel> model,
+                                                                  const std::string &filepath,
+                                                                  const std::string &source)
+{
+	std::ifstream file(filepath, std::ios::binary);
+	if (!file)
+	{
+		return nullptr;
+	}
+	std::string buffer((std::istreambuf_iterator<char>(file)), (std::istreambuf_iterator<char>()));
+
+	// Check header
+	std::size_t pos = 0;
+	std::string magic;
+	uint32_t format;
+	uint64_t hash;
+	std::string stored_source;
+	std::string version;
+	if (!readBytes(buffer, pos, 4, magic) || magic != CONFIGURATION_BINARY_MAGIC ||
+	    !readInteger(buffer, pos, format) || format != CONFIGURATION_BINARY_VERSION ||
+	    !readInteger(buffer, pos, hash) || hash != modelHash(model) ||
+	    !readString(buffer, pos, stored_source) || stored_source != source ||
+	    !readString(buffer, pos, version) || version != model->getVersion())
+	{
+		return nullptr;
+	}
+
+	// Initiate datamodel
+	auto datamodel = model->createData();
+	if (datamodel == nullptr ||
+	    !loadComponentFromBinary(datamodel->getRoot(), buffer, pos) ||
+	    pos != buffer.size())
+	{
+		return nullptr;
+	}
+	return datamodel;
+}
+
 //================================================================
 // libxml2 extended functions
 //================================================================
@@ -1291,3 +1412,201 @@ bool loadRootFromXML(std::shared_ptr<OpenSANDConf::DataModel> datamodel, xmlNode
 	auto rootnode = getUniqueChildNode(node, "", "root");
 	return rootnode != nullptr && loadComponentFromXML(datamodel->getRoot(), rootnode);
 }
+
+//================================================================
+// binary encoding functions
+//================================================================
+void hashString(uint64_t &hash, const std::string &value)
+{
+	// the terminating null separates consecutive strings
+	for (const char *c = value.c_str(); ; ++c)
+	{
+		hash ^= static_cast<unsigned char>(*c);
+		hash *= 0x100000001b3ULL;
+		if (*c == '\0')
+		{
+			break;
+		}
+	}
+}
+
+void appendString(std::string &buffer, const std::string &value)
+{
+	appendInteger<uint32_t>(buffer, value.size());
+	buffer.append(value);
+}
+
+bool readBytes(const std::string &buffer, std::size_t &pos, std::size_t length, std::string &value)
+{
+	if (buffer.size() - pos < length)
+	{
+		return false;
+	}
+	value.assign(buffer, pos, length);
+	pos += length;
+	return true;
+}
+
+bool readString(const std::string &buffer, std::size_t &pos, std::string &value)
+{
+	uint32_t length;
+	return readInteger(buffer, pos, length) && readBytes(buffer, pos, length, value);
+}
+
+//================================================================
+// modelHash functions
+//================================================================
+void hashElement(uint64_t &hash, std::shared_ptr<OpenSANDConf::MetaElement> element)
+{
+	hashString(hash, element->getId());
+
+	auto ref = element->getReferenceTarget();
+	hashString(hash, ref != nullptr ? ref->getPath() : "");
+	auto data = element->getReferenceData();
+	hashString(hash, data != nullptr && data->isSet() ? data->toString() : "");
+
+	if (std::dynamic_pointer_cast<OpenSANDConf::MetaParameter>(element) != nullptr)
+	{
+		auto param = std::dynamic_pointer_cast<OpenSANDConf::MetaParameter>(element);
+		hashString(hash, "p");
+		hashString(hash, param->getType()->getId());
+		hashString(hash, param->getUnit());
+	}
+	else if (std::dynamic_pointer_cast<OpenSANDConf::MetaComponent>(element) != nullptr)
+	{
+		auto comp = std::dynamic_pointer_cast<OpenSANDConf::MetaComponent>(element);
+		hashString(hash, "c");
+		for (auto elt : comp->getItems())
+		{
+			hashElement(hash, elt);
+		}
+		hashString(hash, "/c");
+	}
+	else if (std::dynamic_pointer_cast<OpenSANDConf::MetaList>(element) != nullptr)
+	{
+		auto lst = std::dynamic_pointer_cast<OpenSANDConf::MetaList>(element);
+		hashString(hash, "l");
+		hashElement(hash, lst->getPattern());
+	}
+}
+
+//================================================================
+// toBinary functions
+//================================================================
+// Each component is written as its number of stored children followed by
+// the children: identifier, kind ('p', 'c' or 'l') and content.
+// Unset parameters are skipped, as in XML files.
+void componentToBinary(std::string &buffer, std::shared_ptr<OpenSANDConf::DataComponent> element)
+{
+	std::size_t count_pos = buffer.size();
+	uint32_t count = 0;
+	appendInteger<uint32_t>(buffer, count);
+
+	for (auto elt : element->getItems())
+	{
+		if (std::dynamic_pointer_cast<OpenSANDConf::DataParameter>(elt) != nullptr)
+		{
+			auto data = std::dynamic_pointer_cast<OpenSANDConf::DataParameter>(elt)->getData();
+			if (!data->isSet())
+			{
+				continue;
+			}
+			appendString(buffer, elt->getId());
+			buffer.push_back('p');
+			appendString(buffer, data->toString());
+		}
+		else if (std::dynamic_pointer_cast<OpenSANDConf::DataComponent>(elt) != nullptr)
+		{
+			appendString(buffer, elt->getId());
+			buffer.push_back('c');
+			componentToBinary(buffer, std::dynamic_pointer_cast<OpenSANDConf::DataComponent>(elt));
+		}
+		else if (std::dynamic_pointer_cast<OpenSANDConf::DataList>(elt) != nullptr)
+		{
+			auto lst = std::dynamic_pointer_cast<OpenSANDConf::DataList>(elt);
+			appendString(buffer, elt->getId());
+			buffer.push_back('l');
+			appendInteger<uint32_t>(buffer, lst->getItems().size());
+			for (auto item : lst->getItems())
+			{
+				componentToBinary(buffer, std::dynamic_pointer_cast<OpenSANDConf::DataComponent>(item));
+			}
+		}
+		else
+		{
+			continue;
+		}
+		++count;
+	}
+
+	std::copy(reinterpret_cast<const char *>(&count),
+	          reinterpret_cast<const char *>(&count) + sizeof(count),
+	          buffer.begin() + count_pos);
+}
+
+//================================================================
+// fromBinary functions
+//================================================================
+bool loadComponentFromBinary(std::shared_ptr<OpenSANDConf::DataComponent> current, const std::string &buffer, std::size_t &pos)
+{
+	uint32_t count;
+	if (!readInteger(buffer, pos, count))
+	{
+		return false;
+	}
+
+	for (uint32_t i = 0; i < count; ++i)
+	{
+		std::string id;
+		std::string kind;
+		if (!readString(buffer, pos, id) || !readBytes(buffer, pos, 1, kind))
+		{
+			return false;
+		}
+
+		auto element = current->getItem(id);
+		if (element == nullptr)
+		{
+			return false;
+		}
+		else if (kind == "p" && std::dynamic_pointer_cast<OpenSANDConf::DataParameter>(element) != nullptr)
+		{
+			auto param = std::dynamic_pointer_cast<OpenSANDConf::DataParameter>(element);
+			std::string content;
+			if (!readString(buffer, pos, content) || !param->getData()->fromString(content))
+			{
+				return false;
+			}
+		}
+		else if (kind == "c" && std::dynamic_pointer_cast<OpenSANDConf::DataComponent>(element) != nullptr)
+		{
+			auto comp = std::dynamic_pointer_cast<OpenSANDConf::DataComponent>(element);
+			if (!loadComponentFromBinary(comp, buffer, pos))
+			{
+				return false;
+			}
+		}
+		else if (kind == "l" && std::dynamic_pointer_cast<OpenSANDConf::DataList>(element) != nullptr)
+		{
+			auto lst = std::dynamic_pointer_cast<OpenSANDConf::DataList>(element);
+			uint32_t items;
+			if (!readInteger(buffer, pos, items))
+			{
+				return false;
+			}
+			for (uint32_t j = 0; j < items; ++j)
+			{
+				auto item = lst->addItem();
+				if (item == nullptr || !loadComponentFromBinary(item, buffer, pos))
+				{
+					return false;
+				}
+			}
+		}
+		else
+		{
+			return false;
+		}
+	}
+	return true;
+}
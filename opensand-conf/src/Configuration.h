@@ -35,6 +35,7 @@
 #ifndef OPENSAND_CONF_CONFIGURATION_HPP
 #define OPENSAND_CONF_CONFIGURATION_HPP
 
+#include <cstdint>
 #include <memory>
 #include <string>
 
@@ -82,6 +83,48 @@ namespace OpenSANDConf
 	 * @return The new generated datamodel from XML on success, nullptr otherwise
 	 */
   std::shared_ptr<DataModel> fromXML(std::shared_ptr<MetaModel> model, const std::string &filepath);
+
+	/**
+	 * @brief Compute a hash of the structure of a model
+	 *        (version, enumerations, elements identifiers, parameters types
+	 *        and units, references).
+	 *
+	 * @param  model  The model to hash
+	 *
+	 * @return The hash of the model
+	 */
+	uint64_t modelHash(std::shared_ptr<MetaModel> model);
+
+	/**
+	 * @brief Write a binary snapshot of a datamodel, that can be read
+	 *        back without XML parsing nor XSD validation.
+	 *        The file is replaced atomically.
+	 *
+	 * @param  model      The model the datamodel matches to
+	 * @param  datamodel  The datamodel to write
+	 * @param  filepath   The filepath to write
+	 * @param  source     The state of the file the datamodel was read
+	 *                    from, stored to be checked when reading back
+	 *
+	 * @return True on success, false otherwise
+	 */
+	bool toBinary(std::shared_ptr<MetaModel> model, std::shared_ptr<DataModel> datamodel,
+	              const std::string &filepath, const std::string &source);
+
+	/**
+	 * @brief Read a binary snapshot to generate a new datamodel matching a model.
+	 *
+	 * @param  model     The model which the new datamodel will match to
+	 * @param  filepath  The filepath to read
+	 * @param  source    The current state of the file the snapshot was
+	 *                   written from, it must match the stored one exactly
+	 *
+	 * @return The new generated datamodel on success, nullptr if the file
+	 *         is missing, malformed or was written for another model or
+	 *         another source
+	 */
+	std::shared_ptr<DataModel> fromBinary(std::shared_ptr<MetaModel> model, const std::string &filepath,
+	                                      const std::string &source);
 }
 
 #endif // OPENSAND_CONF_CONFIGURATION_HPP
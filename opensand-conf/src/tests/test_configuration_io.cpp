@@ -29,6 +29,8 @@ using OpenSANDConf::toXSD;
 using OpenSANDConf::fromXSD;
 using OpenSANDConf::toXML;
 using OpenSANDConf::fromXML;
+using OpenSANDConf::toBinary;
+using OpenSANDConf::fromBinary;
 
 std::string readFile(const std::string &filepath);
 
@@ -238,6 +240,47 @@ TEST_CASE("Model read/write from/to file", "[Model][Read/Write]")
 		auto content2 = readFile(path2);
 		REQUIRE(content == content2);
 	}
+
+	SECTION("Read/Write binary data model")
+	{
+		std::string path = "my_datamodel.bin";
+		std::string path2 = "my_datamodel.xml";
+		std::string path3 = "my_datamodel2.xml";
+		remove(path.c_str());
+		remove(path2.c_str());
+		remove(path3.c_str());
+
+		// Test reading a missing snapshot
+		REQUIRE(fromBinary(model, path, "source") == nullptr);
+
+		// Test writing datamodel to binary
+		REQUIRE(toBinary(model, datamodel, path, "source") == true);
+
+		// Test reading datamodel from binary
+		auto datamodel2 = fromBinary(model, path, "source");
+		REQUIRE(datamodel2 != nullptr);
+		REQUIRE(toXML(datamodel, path2) == true);
+		REQUIRE(toXML(datamodel2, path3) == true);
+		auto content = readFile(path2);
+		auto content2 = readFile(path3);
+		REQUIRE(content == content2);
+
+		// Test the snapshot is rejected once the source changed
+		REQUIRE(fromBinary(model, path, "other source") == nullptr);
+		REQUIRE(fromBinary(model, path, "") == nullptr);
+
+		// Test the snapshot is rejected once a parameter unit changed
+		auto unit_parameter = model->getRoot()->getParameter("s");
+		REQUIRE(unit_parameter != nullptr);
+		unit_parameter->setUnit("ms");
+		REQUIRE(fromBinary(model, path, "source") == nullptr);
+		unit_parameter->setUnit("");
+		REQUIRE(fromBinary(model, path, "source") != nullptr);
+
+		// Test the snapshot is rejected once the model changed
+		REQUIRE(model->getRoot()->addParameter("s7", "String parameter (level 1)", model->getTypesDefinition()->getType("string")) != nullptr);
+		REQUIRE(fromBinary(model, path, "source") == nullptr);
+	}
 }
 
 std::string readFile(const std::string &filepath)
@@ -0,0 +1,137 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file CounterRng.h
+ * @brief A counter-based pseudo-random number generator
+ * @author Viveris Technologies
+ */
+
+#ifndef COUNTER_RNG_H
+#define COUNTER_RNG_H
+
+
+#include <cstdint>
+
+
+/**
+ * @class CounterRng
+ * @brief Counter-based pseudo-random number generator
+ *
+ * The n-th draw is a bijective hash (SplitMix64 finalizer) of the key
+ * and of n: there is no internal state to update besides the counter,
+ * draws are reproducible for a given key and any of them can be
+ * computed directly with at().
+ * Several generators with different keys give independent streams.
+ */
+class CounterRng
+{
+ public:
+	/**
+	 * @brief Create a generator
+	 *
+	 * @param key      The key (seed) of the stream
+	 * @param counter  The index of the first draw
+	 */
+	CounterRng(uint64_t key = 0, uint64_t counter = 0):
+		key{mix(key ^ 0x243F6A8885A308D3ULL)},
+		counter{counter}
+	{
+	}
+
+	/**
+	 * @brief Get the draw of the stream at the given index
+	 *
+	 * @param index  The index of the draw
+	 * @return the 64 random bits of the draw
+	 */
+	uint64_t at(uint64_t index) const
+	{
+		return mix(this->key + index * 0x9E3779B97F4A7C15ULL);
+	}
+
+	/**
+	 * @brief Get the next 64 random bits
+	 */
+	uint64_t operator()()
+	{
+		return this->at(this->counter++);
+	}
+
+	/**
+	 * @brief Get the next random number uniformly distributed in [0, 1)
+	 */
+	double uniform()
+	{
+		return ((*this)() >> 11) * 0x1.0p-53;
+	}
+
+	/**
+	 * @brief Get the next random number uniformly distributed in [0, bound)
+	 *        (multiply-shift reduction, without division)
+	 *
+	 * @param bound  The exclusive upper bound
+	 */
+	uint32_t below(uint32_t bound)
+	{
+		return static_cast<uint32_t>(((*this)() >> 32) * bound >> 32);
+	}
+
+	/**
+	 * @brief Get the index of the next draw
+	 */
+	uint64_t getCounter() const
+	{
+		return this->counter;
+	}
+
+	/**
+	 * @brief Jump to the given draw index
+	 */
+	void seek(uint64_t counter)
+	{
+		this->counter = counter;
+	}
+
+ private:
+	static uint64_t mix(uint64_t value)
+	{
+		value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		value = (value ^ (value >> 27)) * 0x94D049BB133111EBULL;
+		return value ^ (value >> 31);
+	}
+
+	/// The key of the stream
+	uint64_t key;
+
+	/// The index of the next draw
+	uint64_t counter;
+};
+
+
+#endif
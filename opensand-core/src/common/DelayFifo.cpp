@@ -44,7 +44,9 @@
 DelayFifo::DelayFifo(vol_pkt_t max_size_pkt):
 	queue(),
 	max_size_pkt(max_size_pkt),
-	fifo_mutex()
+	fifo_mutex(),
+	single_owner(false),
+	cur_size_pkt(0)
 {
 }
 
@@ -60,14 +62,36 @@ DelayFifo::~DelayFifo()
 
 vol_pkt_t DelayFifo::getCurrentSize() const
 {
-	Rt::Lock lock(this->fifo_mutex);
-	return this->queue.size();
+	return this->cur_size_pkt.load(std::memory_order_relaxed);
+}
+
+
+void DelayFifo::setSingleOwner(bool single_owner)
+{
+	auto lock = this->acquire();
+	this->single_owner = single_owner;
+}
+
+
+std::unique_lock<Rt::Mutex> DelayFifo::acquire() const
+{
+	if(this->single_owner)
+	{
+		return std::unique_lock<Rt::Mutex>{this->fifo_mutex, std::defer_lock};
+	}
+	return std::unique_lock<Rt::Mutex>{this->fifo_mutex};
+}
+
+
+void DelayFifo::updateSize()
+{
+	this->cur_size_pkt.store(this->queue.size(), std::memory_order_relaxed);
 }
 
 
 bool DelayFifo::setMaxSize(vol_pkt_t max_size_pkt)
 {
-	Rt::Lock lock(this->fifo_mutex);
+	auto lock = this->acquire();
 	// check if current size is bigger than the new max value
 	if(this->queue.size() > max_size_pkt)
 		return false;
@@ -78,34 +102,52 @@ bool DelayFifo::setMaxSize(vol_pkt_t max_size_pkt)
 
 vol_pkt_t DelayFifo::getMaxSize() const
 {
-	Rt::Lock lock(this->fifo_mutex);
+	auto lock = this->acquire();
 	return this->max_size_pkt;
 }
 
 
 bool DelayFifo::push(Rt::Ptr<NetContainer> elem, time_ms_t duration)
 {
-	Rt::Lock lock(this->fifo_mutex);
-	if(this->queue.size() < this->max_size_pkt)
+	auto lock = this->acquire();
+	return this->insert(std::move(elem), duration) != this->queue.end();
+}
+
+
+decltype(DelayFifo::queue)::iterator DelayFifo::insert(Rt::Ptr<NetContainer> elem,
+                                                       time_ms_t duration)
+{
+	if(this->queue.size() >= this->max_size_pkt)
 	{
-		auto end_date = std::chrono::high_resolution_clock::now() + duration;
-		this->queue.emplace(end_date, std::make_unique<FifoElement>(std::move(elem)));
-		return true;
+		return this->queue.end();
 	}
 
-	return false;
+	auto end_date = std::chrono::high_resolution_clock::now() + duration;
+	auto fifo_elem = std::make_unique<FifoElement>(std::move(elem));
+	// elements pushed within the clock resolution would share the same
+	// date, shift them so that none is lost and the order is kept
+	auto result = this->queue.emplace(end_date, nullptr);
+	while(!result.second)
+	{
+		end_date += std::chrono::high_resolution_clock::duration{1};
+		result = this->queue.emplace(end_date, nullptr);
+	}
+	result.first->second = std::move(fifo_elem);
+	this->updateSize();
+	return result.first;
 }
 
 
 std::unique_ptr<FifoElement> DelayFifo::pop()
 {
-	Rt::Lock lock(this->fifo_mutex);
+	auto lock = this->acquire();
 
 	auto elem = this->queue.begin();
 	if (elem != this->queue.end())
 	{
 		std::unique_ptr<FifoElement> result = std::move(elem->second);
 		this->queue.erase(elem);
+		this->updateSize();
 		return result;
 	}
 
@@ -115,8 +157,9 @@ std::unique_ptr<FifoElement> DelayFifo::pop()
 
 void DelayFifo::flush()
 {
-	Rt::Lock lock(this->fifo_mutex);
+	auto lock = this->acquire();
 	this->queue.clear();
+	this->updateSize();
 }
 
 
@@ -146,7 +189,9 @@ DelayFifo::iterator_wrapper DelayFifo::wend()
 
 DelayFifo::iterator_wrapper DelayFifo::erase(DelayFifo::iterator_wrapper pos)
 {
-	return iterator_wrapper(this->queue.erase(pos.it));
+	auto next = this->queue.erase(pos.it);
+	this->updateSize();
+	return iterator_wrapper(next);
 }
 
 
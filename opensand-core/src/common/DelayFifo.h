@@ -35,8 +35,10 @@
 #define DELAY_FIFO_H
 
 
+#include <atomic>
 #include <map>
 #include <memory>
+#include <mutex>
 
 #include <opensand_rt/Ptr.h>
 #include <opensand_rt/RtMutex.h>
@@ -73,6 +75,16 @@ public:
 	 */
 	vol_pkt_t getCurrentSize() const;
 
+	/**
+	 * @brief Set whether the fifo is only accessed by the thread owning it
+	 *
+	 * A single owner fifo takes no lock, its size and the counters of
+	 * derived fifos can still be read from other threads.
+	 *
+	 * @param single_owner  whether the fifo has a single owner
+	 */
+	void setSingleOwner(bool single_owner);
+
 	/**
 	 * @brief Set the fifo maximum size
 	 *
@@ -113,6 +125,33 @@ public:
 
 	mutable Rt::Mutex fifo_mutex;                    ///< The mutex to protect FIFO from concurrent access
 
+	bool single_owner;                               ///< whether the FIFO is accessed by its owner only
+
+	std::atomic<vol_pkt_t> cur_size_pkt;             ///< the queue size, for lock-free readers
+
+	/**
+	 * @brief Lock the fifo if it may be accessed by several threads
+	 *
+	 * @return the lock, that does not own the mutex for a single owner fifo
+	 */
+	std::unique_lock<Rt::Mutex> acquire() const;
+
+	/**
+	 * @brief Publish the queue size to the lock-free readers,
+	 *        to be called after each modification of the queue
+	 */
+	void updateSize();
+
+	/**
+	 * @brief Store an element in the queue if the FIFO is not full
+	 *
+	 * @param elem      the element to store
+	 * @param duration  the amount of time the element should stay in the fifo
+	 * @return the position of the element in the queue,
+	 *         queue.end() if the FIFO is full
+	 */
+	decltype(queue)::iterator insert(Rt::Ptr<NetContainer> elem, time_ms_t duration);
+
 	/**
 	 * @brief Remove an element at the head of the list
 	 *
@@ -185,7 +224,7 @@ public:
 
 	iterator_wrapper wbegin();
 	iterator_wrapper wend();
-	iterator_wrapper erase(iterator_wrapper pos);
+	virtual iterator_wrapper erase(iterator_wrapper pos);
 };
 
 
@@ -32,6 +32,8 @@
  * @author Aurelien DELRIEU <adelrieu@toulouse.viveris.com>
  */
 
+#include <algorithm>
+
 #include <opensand_output/Output.h>
 
 #include "EncapPlugin.h"
@@ -56,3 +58,37 @@ void EncapPlugin::setFilterTalId(uint8_t tal_id)
 {
 	this->dst_tal_id = tal_id;
 }
+
+
+bool EncapPlugin::encapInto(Rt::Ptr<NetPacket> packet,
+                            uint8_t *dst,
+                            std::size_t dst_length,
+                            bool new_burst,
+                            std::size_t &written,
+                            Rt::Ptr<NetPacket> &remaining_data)
+{
+	Rt::Ptr<NetPacket> encap_packet = Rt::make_ptr<NetPacket>(nullptr);
+
+	written = 0;
+	if(!this->encapNextPacket(std::move(packet), dst_length, new_burst,
+	                          encap_packet, remaining_data))
+	{
+		return false;
+	}
+	if(!encap_packet)
+	{
+		return true;
+	}
+
+	std::size_t length = encap_packet->getTotalLength();
+	if(length > dst_length)
+	{
+		LOG(this->log, LEVEL_ERROR,
+		    "encapsulated packet (%zu bytes) does not fit in "
+		    "the %zu remaining bytes\n", length, dst_length);
+		return false;
+	}
+	std::copy_n(encap_packet->getRawData(), length, dst);
+	written = length;
+	return true;
+}
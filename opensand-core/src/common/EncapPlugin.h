@@ -109,6 +109,31 @@ public:
 								 Rt::Ptr<NetPacket> &encap_packet,
 								 Rt::Ptr<NetPacket> &remaining_data) = 0;
 
+	/**
+	 * @brief Encapsulate the packet directly into a destination buffer
+	 *        and store unencapsulable part
+	 *
+	 * The default implementation relies on encapNextPacket and copies
+	 * the encapsulated packet in the buffer, plugins able to write their
+	 * headers and payload in place should override it.
+	 *
+	 * @param[in]  packet          The packet to encapsulate
+	 * @param[out] dst             The buffer receiving the encapsulated packet
+	 * @param[in]  dst_length      The length available in the buffer
+	 * @param[in]  new_burst       The new burst status
+	 * @param[out] written         The length written in the buffer
+	 *                             (0 if nothing was encapsulated)
+	 * @param[out] remaining_data  The data remaining after encapsulation
+	 *
+	 * @return  true if success, false otherwise
+	 */
+	bool virtual encapInto(Rt::Ptr<NetPacket> packet,
+						   uint8_t *dst,
+						   std::size_t dst_length,
+						   bool new_burst,
+						   std::size_t &written,
+						   Rt::Ptr<NetPacket> &remaining_data);
+
 	/**
 	 * @brief Decapsulate packets from NetContainer.
 	 * @details  Decapsulate @ref decap_packets_count from the @ref packet.
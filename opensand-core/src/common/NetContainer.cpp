@@ -88,7 +88,7 @@ std::string NetContainer::getName() const
 }
 
 
-Rt::Data NetContainer::getData() const
+const Rt::Data &NetContainer::getData() const
 {
 	return this->data;
 }
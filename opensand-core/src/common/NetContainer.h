@@ -118,9 +118,9 @@ class NetContainer
 	/**
 	 * Get data string
 	 *
-	 * @return the data string
+	 * @return the data string, valid as long as the container is
 	 */
-	Rt::Data getData() const;
+	const Rt::Data &getData() const;
 
 	/**
 	 * Returns a const pointer to the raw data. 
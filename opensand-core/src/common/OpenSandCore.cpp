@@ -33,8 +33,11 @@
 
 
 #include <arpa/inet.h>
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <sstream>
+#include <vector>
 
 #include "OpenSandCore.h"
 
@@ -127,6 +130,61 @@ double ncntoh(uint32_t cn)
 }
 
 
+double ncntolin(uint32_t cn)
+{
+	// cn is in hundredths of dB: 10^(cn / 1000) = 10^(db / 10) * 10^(hundredths / 1000)
+	static constexpr int min_db = std::numeric_limits<int16_t>::min() / 100 - 1;
+	static constexpr int max_db = std::numeric_limits<int16_t>::max() / 100;
+	static const auto tables = []()
+	{
+		std::pair<std::vector<double>, std::vector<double>> tables;
+		for(int db = min_db; db <= max_db; ++db)
+		{
+			tables.first.push_back(std::pow(10.0, db / 10.0));
+		}
+		for(int hundredths = 0; hundredths < 100; ++hundredths)
+		{
+			tables.second.push_back(std::pow(10.0, hundredths / 1000.0));
+		}
+		return tables;
+	}();
+
+	int tmp_cn = static_cast<int16_t>(ntohl(cn));
+	// floor division so that the remainder is positive
+	int db = tmp_cn >= 0 ? tmp_cn / 100 : -((-tmp_cn + 99) / 100);
+	int hundredths = tmp_cn - db * 100;
+	return tables.first[db - min_db] * tables.second[hundredths];
+}
+
+
+double lintodb(double cn)
+{
+	// cn = m * 2^e with m in [0.5, 1[: 10 log10(cn) = 10 e log10(2) + 10 log10(m)
+	static constexpr std::size_t steps = 1024;
+	static const std::vector<double> mantissa_db = []()
+	{
+		std::vector<double> table;
+		for(std::size_t step = 0; step <= steps; ++step)
+		{
+			table.push_back(10 * std::log10(0.5 + 0.5 * step / steps));
+		}
+		return table;
+	}();
+	static const double exponent_db = 10 * std::log10(2.0);
+
+	if(cn <= 0)
+	{
+		return -std::numeric_limits<double>::infinity();
+	}
+	int exponent;
+	double position = (std::frexp(cn, &exponent) - 0.5) * 2 * steps;
+	std::size_t step = std::min(static_cast<std::size_t>(position), steps - 1);
+	double interpolated = mantissa_db[step] +
+	                      (position - step) * (mantissa_db[step + 1] - mantissa_db[step]);
+	return exponent * exponent_db + interpolated;
+}
+
+
 std::string generateProbePrefix(spot_id_t spot_id, Component entity_type, bool is_sat)
 {
 	std::ostringstream ss{};
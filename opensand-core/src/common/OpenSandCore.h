@@ -130,6 +130,14 @@ enum struct IslType
 };
 
 
+enum struct TapSharing
+{
+	PerTerminal,  ///< one TAP interface per terminal
+	Vlan,         ///< one TAP interface, terminals selected by VLAN ID
+	Mac,          ///< one TAP interface, terminals selected by source MAC address
+};
+
+
 enum struct RegenLevel {
 	Unknown,
 	Transparent, 
@@ -189,6 +197,27 @@ uint32_t hcnton(double cn);
  */
 double ncntoh(uint32_t cn);
 
+/**
+ * @brief  Convert a C/N value from network to host, in linear scale
+ *
+ * The network value has a 0.01 dB step, so the conversion uses
+ * tables instead of an exponentiation.
+ *
+ * @param cn  The CN value
+ * return the linear CN value
+ */
+double ncntolin(uint32_t cn);
+
+/**
+ * @brief  Convert a linear C/N value into dB, with a precision well
+ *         below the 0.01 dB step carried on network, using a table
+ *         instead of a logarithm
+ *
+ * @param cn  The linear CN value
+ * return the CN value in dB
+ */
+double lintodb(double cn);
+
 
 // The types used in OpenSAND
 
@@ -88,6 +88,15 @@ ErrorInsertionPlugin::~ErrorInsertionPlugin()
 {
 }
 
+void ErrorInsertionPlugin::isToBeModifiedPackets(std::vector<ErrorInsertionSample> &samples)
+{
+	for(auto &&sample: samples)
+	{
+		sample.corrupted = this->isToBeModifiedPacket(sample.cn_total,
+		                                              sample.threshold_qef);
+	}
+}
+
 
 SatDelayPlugin::SatDelayPlugin():
 		OpenSandPlugin(),
@@ -40,6 +40,7 @@
 
 #include <memory>
 #include <mutex>
+#include <vector>
 
 #include <opensand_rt/Data.h>
 
@@ -159,6 +160,25 @@ public:
 	virtual bool updateThreshold(uint8_t modcod_id, EmulatedMessageType message_type) = 0;
 };
 
+/**
+ * @brief The reception conditions of a frame submitted to the
+ *        error insertion
+ */
+struct ErrorInsertionSample
+{
+	/// The frame type, S2 and RCS2 MODCOD ids overlap
+	EmulatedMessageType message_type;
+	/// The MODCOD id carried by the frame
+	fmt_id_t modcod_id;
+	/// The total C/N of the link (dB)
+	double cn_total;
+	/// The minimal C/N of the link (dB)
+	double threshold_qef;
+	/// OUT: whether the frame must be corrupted
+	bool corrupted;
+};
+
+
 /**
 * @class ErrorInsertion
 * @brief ErrorInsertion
@@ -179,9 +199,10 @@ public:
 	/**
 	 * @brief initialize the error insertion
 	 *
+	 * @param entity_id  the terminal or gateway the errors are inserted for
 	 * @return true on success, false otherwise
 	 */
-	virtual bool init() = 0;
+	virtual bool init(tal_id_t entity_id) = 0;
 
 	/**
 	 * @brief Determine if a Packet shall be corrupted or not depending on
@@ -195,6 +216,17 @@ public:
 	virtual bool isToBeModifiedPacket(double cn_total,
 	                                  double threshold_qef) = 0;
 
+	/**
+	 * @brief Determine which packets of a burst shall be corrupted,
+	 *        this sets the corrupted field of each sample
+	 *
+	 * The default implementation calls isToBeModifiedPacket on each
+	 * sample, plugins may override it to evaluate the whole burst at once
+	 *
+	 * @param samples  The reception conditions of the burst frames
+	 */
+	virtual void isToBeModifiedPackets(std::vector<ErrorInsertionSample> &samples);
+
 	/**
 	 * @brief Corrupt a packet with error bits 
 	 *
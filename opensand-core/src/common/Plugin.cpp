@@ -48,6 +48,16 @@ bool Plugin::loadPlugins(bool enable_phy_layer)
 	return utils.loadPlugins(enable_phy_layer);
 }
 
+bool Plugin::loadReferencedPlugins(const std::vector<std::string> &filenames)
+{
+	return utils.loadReferencedPlugins(filenames);
+}
+
+bool Plugin::loadAllPlugins()
+{
+	return utils.loadAllPlugins();
+}
+
 
 void Plugin::releasePlugins()
 {
@@ -63,6 +63,21 @@ public:
 	 */
 	static bool loadPlugins(bool enable_phy_layer);
 
+	/**
+	 * @brief open the plugins referenced by the configuration files
+	 *
+	 * @param filenames  The configuration files
+	 * @return true on success, false otherwise
+	 */
+	static bool loadReferencedPlugins(const std::vector<std::string> &filenames);
+
+	/**
+	 * @brief open all the plugins, used to generate the configuration models
+	 *
+	 * @return true on success, false otherwise
+	 */
+	static bool loadAllPlugins();
+
 	/**
 	 * @brief release the class elements for plugins
 	 */
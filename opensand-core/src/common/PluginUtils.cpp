@@ -46,35 +46,119 @@
 #include <errno.h>
 #include <dlfcn.h>
 
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <set>
+#include <sstream>
+
 #include <opensand_output/Output.h>
 
 
 extern const std::string PLUGIN_LIBDIR;
 const std::string PLUGIN_DIRECTORY{"/opensand/plugins/"};
 const std::string PLUGIN_FILE_END = ".so.0";
+const std::string PLUGIN_MANIFEST_END = ".manifest";
 
-PluginUtils::PluginUtils()
+PluginUtils::PluginUtils():
+	enable_phy_layer{false}
 {
 }
 
 template<class T, typename = std::enable_if<std::is_base_of<OpenSandPlugin, T>::value>>
-inline bool storePlugin(PluginConfigurationContainer<T> &container, OpenSandPluginFactory *plugin)
+inline bool storePlugin(PluginConfigurationContainer<T> &container,
+                        OpenSandPluginFactory *plugin,
+                        const std::string &library)
 {
+	auto registered = container.find(plugin->name);
+	if (registered != container.end())
+	{
+		// the plugin was declared in a manifest, fill its entry
+		// if this is the library the manifest refers to
+		PluginConfigurationElement<T> &element = registered->second;
+		if (element.create != nullptr || element.library != library)
+		{
+			return false;
+		}
+		element.init = plugin->configure;
+		element.create = plugin->create;
+		return true;
+	}
+
 	// if we load twice the same plugin, keep the first one
 	// this is why LD_LIBRARY_PATH should be first in the paths
 	const auto [_, inserted] = container.insert({
 			plugin->name, {
 			plugin->configure,
 			plugin->create,
-			nullptr}});
+			{},
+			library}});
 
 	return inserted;
 }
 
+template<class T, typename = std::enable_if<std::is_base_of<OpenSandPlugin, T>::value>>
+inline bool declarePlugin(PluginConfigurationContainer<T> &container,
+                          const std::string &name,
+                          const std::string &library)
+{
+	const auto [_, inserted] = container.insert({
+			name, {
+			nullptr,
+			nullptr,
+			{},
+			library}});
+
+	return inserted;
+}
+
+/**
+ * @brief get the plugin type from its name in a manifest
+ *
+ * @param type  The type name
+ * @return the plugin type, Unknown if the name is not recognized
+ */
+static PluginType pluginTypeFromName(const std::string &type)
+{
+	if (type == "Encapsulation")
+	{
+		return PluginType::Encapsulation;
+	}
+	if (type == "Attenuation")
+	{
+		return PluginType::Attenuation;
+	}
+	if (type == "Minimal")
+	{
+		return PluginType::Minimal;
+	}
+	if (type == "Error")
+	{
+		return PluginType::Error;
+	}
+	if (type == "SatDelay")
+	{
+		return PluginType::SatDelay;
+	}
+	if (type == "IslDelay")
+	{
+		return PluginType::IslDelay;
+	}
+	return PluginType::Unknown;
+}
+
+static bool endsWith(const std::string &filename, const std::string &end)
+{
+	return filename.length() > end.length() &&
+	       !filename.compare(filename.length() - end.length(), end.length(), end);
+}
+
 bool PluginUtils::loadPlugins(bool enable_phy_layer)
 {
 	std::vector<std::string> path;
 	this->log_init = Output::Get()->registerLog(LEVEL_WARNING, "init");
+	this->enable_phy_layer = enable_phy_layer;
 
 	char *lib_path = getenv("LD_LIBRARY_PATH");
 	if (lib_path)
@@ -99,109 +183,360 @@ bool PluginUtils::loadPlugins(bool enable_phy_layer)
 		LOG(this->log_init, LEVEL_NOTICE,
 			"search for plugins in %s folder\n", dir.c_str());
 
+		std::vector<std::string> manifests;
+		std::vector<std::string> libraries;
 		struct dirent *ent;
 		while ((ent = readdir(plugin_dir)) != NULL)
 		{
 			std::string filename = ent->d_name;
-			if (filename.length() <= PLUGIN_FILE_END.length())
+			if (endsWith(filename, PLUGIN_MANIFEST_END))
+			{
+				manifests.push_back(filename);
+			}
+			else if (endsWith(filename, PLUGIN_FILE_END))
+			{
+				libraries.push_back(filename);
+			}
+		}
+		closedir(plugin_dir);
+
+		// the plugins declared in a manifest are only opened when needed
+		std::vector<std::string> declared;
+		for (auto &&filename : manifests)
+		{
+			this->readManifest(dir, filename, declared);
+		}
+
+		for (auto &&filename : libraries)
+		{
+			if (std::find(declared.begin(), declared.end(), filename) != declared.end())
 			{
 				continue;
 			}
-			if (!filename.compare(filename.length() - PLUGIN_FILE_END.length(),
-								  PLUGIN_FILE_END.length(),
-								  PLUGIN_FILE_END))
+
+			LOG(this->log_init, LEVEL_INFO,
+				"find plugin library %s\n", filename.c_str());
+			if (!this->loadLibrary(dir + filename))
 			{
-				std::string plugin_name = dir + filename;
+				return false;
+			}
+		}
+	}
 
-				LOG(this->log_init, LEVEL_INFO,
-						"find plugin library %s\n", filename.c_str());
-				void *handle = dlopen(plugin_name.c_str(), RTLD_LAZY);
-				if (!handle)
-				{
-					LOG(this->log_init, LEVEL_ERROR,
-							"cannot load plugin %s (%s)\n",
-							filename.c_str(), dlerror());
-					continue;
-				}
+	return true;
+}
 
-				void *sym = dlsym(handle, "init");
-				if (!sym)
-				{
-					LOG(this->log_init, LEVEL_ERROR,
-							"cannot find 'init' method in plugin %s "
-							"(%s)\n",
-							filename.c_str(), dlerror());
-					dlclose(handle);
-					closedir(plugin_dir);
-					return false;
-				}
+void PluginUtils::readManifest(const std::string &directory,
+                               const std::string &filename,
+                               std::vector<std::string> &libraries)
+{
+	std::ifstream manifest_file{directory + filename};
+	if (!manifest_file.is_open())
+	{
+		LOG(this->log_init, LEVEL_WARNING,
+			"cannot open plugins manifest %s\n",
+			filename.c_str());
+		return;
+	}
 
-				OpenSandPluginFactory *plugin = reinterpret_cast<fn_init *>(sym)();
-				if (!plugin)
-				{
-					LOG(this->log_init, LEVEL_ERROR,
-							"cannot create plugin\n");
-					dlclose(handle);
-					continue;
-				}
+	std::string line;
+	while (std::getline(manifest_file, line))
+	{
+		std::istringstream fields{line};
+		std::string type_name;
+		ManifestEntry entry;
+		if (!(fields >> type_name) || type_name[0] == '#')
+		{
+			continue;
+		}
+		if (!(fields >> entry.name >> entry.library))
+		{
+			LOG(this->log_init, LEVEL_WARNING,
+				"malformed line '%s' in plugins manifest %s\n",
+				line.c_str(), filename.c_str());
+			continue;
+		}
+		entry.type = pluginTypeFromName(type_name);
+		libraries.push_back(entry.library);
+		entry.library = directory + entry.library;
+
+		bool inserted = false;
+		switch (entry.type)
+		{
+			case PluginType::Encapsulation:
+				inserted = declarePlugin(this->encapsulation, entry.name, entry.library);
+				break;
+
+			case PluginType::IslDelay:
+				inserted = declarePlugin(this->isl_delay, entry.name, entry.library);
+				break;
+
+			case PluginType::SatDelay:
+				inserted = declarePlugin(this->sat_delay, entry.name, entry.library);
+				break;
 
-				bool inserted = false;
-				switch (plugin->type)
+			case PluginType::Attenuation:
+				if (this->enable_phy_layer)
 				{
-					case PluginType::Encapsulation:
-						inserted = storePlugin(this->encapsulation, plugin);
-						break;
-
-					case PluginType::IslDelay:
-						inserted = storePlugin(this->isl_delay, plugin);
-						break;
-
-					case PluginType::SatDelay:
-						inserted = storePlugin(this->sat_delay, plugin);
-						break;
-
-					case PluginType::Attenuation:
-						if (enable_phy_layer)
-						{
-							inserted = storePlugin(this->attenuation, plugin);
-						}
-						break;
-
-					case PluginType::Minimal:
-						if (enable_phy_layer)
-						{
-							inserted = storePlugin(this->minimal, plugin);
-						}
-						break;
-
-					case PluginType::Error:
-						if (enable_phy_layer)
-						{
-							inserted = storePlugin(this->error, plugin);
-						}
-						break;
-
-					default:
-						LOG(this->log_init, LEVEL_ERROR,
-								"Wrong plugin type %d for %s",
-								plugin->type, filename.c_str());
+					inserted = declarePlugin(this->attenuation, entry.name, entry.library);
 				}
-				delete plugin;
+				break;
 
-				if (inserted)
+			case PluginType::Minimal:
+				if (this->enable_phy_layer)
 				{
-					LOG(this->log_init, LEVEL_NOTICE,
-							"load plugin %s\n",
-							plugin->name.c_str());
-					this->handlers.push_back(handle);
+					inserted = declarePlugin(this->minimal, entry.name, entry.library);
 				}
-				else
+				break;
+
+			case PluginType::Error:
+				if (this->enable_phy_layer)
 				{
-					dlclose(handle);
+					inserted = declarePlugin(this->error, entry.name, entry.library);
 				}
+				break;
+
+			default:
+				LOG(this->log_init, LEVEL_ERROR,
+					"Wrong plugin type %s for %s in manifest %s",
+					type_name.c_str(), entry.name.c_str(), filename.c_str());
+		}
+
+		if (inserted)
+		{
+			LOG(this->log_init, LEVEL_INFO,
+				"register plugin %s from manifest %s\n",
+				entry.name.c_str(), filename.c_str());
+			this->manifest.push_back(entry);
+		}
+	}
+}
+
+bool PluginUtils::loadLibrary(const std::string &library)
+{
+	void *handle = dlopen(library.c_str(), RTLD_LAZY);
+	if (!handle)
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+			"cannot load plugin %s (%s)\n",
+			library.c_str(), dlerror());
+		return false;
+	}
+
+	void *sym = dlsym(handle, "init");
+	if (!sym)
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+			"cannot find 'init' method in plugin %s "
+			"(%s)\n",
+			library.c_str(), dlerror());
+		dlclose(handle);
+		return false;
+	}
+
+	OpenSandPluginFactory *plugin = reinterpret_cast<fn_init *>(sym)();
+	if (!plugin)
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+			"cannot create plugin\n");
+		dlclose(handle);
+		return false;
+	}
+
+	bool inserted = false;
+	switch (plugin->type)
+	{
+		case PluginType::Encapsulation:
+			inserted = storePlugin(this->encapsulation, plugin, library);
+			break;
+
+		case PluginType::IslDelay:
+			inserted = storePlugin(this->isl_delay, plugin, library);
+			break;
+
+		case PluginType::SatDelay:
+			inserted = storePlugin(this->sat_delay, plugin, library);
+			break;
+
+		case PluginType::Attenuation:
+			if (this->enable_phy_layer)
+			{
+				inserted = storePlugin(this->attenuation, plugin, library);
+			}
+			break;
+
+		case PluginType::Minimal:
+			if (this->enable_phy_layer)
+			{
+				inserted = storePlugin(this->minimal, plugin, library);
+			}
+			break;
+
+		case PluginType::Error:
+			if (this->enable_phy_layer)
+			{
+				inserted = storePlugin(this->error, plugin, library);
+			}
+			break;
+
+		default:
+			LOG(this->log_init, LEVEL_ERROR,
+				"Wrong plugin type %d for %s",
+				plugin->type, library.c_str());
+	}
+
+	if (inserted)
+	{
+		LOG(this->log_init, LEVEL_NOTICE,
+			"load plugin %s\n",
+			plugin->name.c_str());
+		this->handlers.push_back(handle);
+	}
+	else
+	{
+		dlclose(handle);
+	}
+	delete plugin;
+
+	return true;
+}
+
+/**
+ * @brief get the parameter selecting the plugins of a type in the
+ *        configuration, as generated by generatePluginsConfiguration
+ *
+ * @param type  The plugin type
+ * @return the parameter identifier, empty if no parameter selects
+ *         the plugins of this type
+ */
+static std::string pluginSelectionParameter(PluginType type)
+{
+	switch (type)
+	{
+		case PluginType::Attenuation:
+			return "attenuation_type";
+		case PluginType::Minimal:
+			return "minimal_condition_type";
+		case PluginType::Error:
+			return "error_insertion_type";
+		case PluginType::SatDelay:
+			return "delay_type";
+		case PluginType::IslDelay:
+			return "isl_delay";
+		default:
+			return "";
+	}
+}
+
+/**
+ * @brief collect the values of some parameters in a XML file
+ *
+ * This is a plain text scan of the <parameter>value</parameter>
+ * elements, good enough to know which plugins a configuration
+ * selects before the models are built.
+ *
+ * @param filename    The XML file
+ * @param parameters  The parameters identifiers
+ * @param values      OUT: the values of the parameters, per identifier
+ * @return true on success, false otherwise
+ */
+static bool scanParametersValues(const std::string &filename,
+                                 const std::set<std::string> &parameters,
+                                 std::map<std::string, std::set<std::string>> &values)
+{
+	std::ifstream xml_file{filename};
+	if (!xml_file.is_open())
+	{
+		return false;
+	}
+	std::string content{std::istreambuf_iterator<char>{xml_file},
+	                    std::istreambuf_iterator<char>{}};
+
+	const char *blanks = " \t\r\n";
+	std::size_t position = 0;
+	while ((position = content.find('<', position)) != std::string::npos)
+	{
+		std::size_t close = content.find('>', position);
+		if (close == std::string::npos)
+		{
+			break;
+		}
+
+		std::size_t name_start = position + 1;
+		std::size_t name_end = content.find_first_of(" \t\r\n/>", name_start);
+		std::string name = content.substr(name_start, name_end - name_start);
+
+		// text value up to the next element
+		position = content.find('<', close);
+		if (parameters.find(name) == parameters.end() || content[close - 1] == '/')
+		{
+			continue;
+		}
+		std::size_t value_start = content.find_first_not_of(blanks, close + 1);
+		if (value_start != std::string::npos && value_start < position)
+		{
+			std::size_t value_end = content.find_last_not_of(blanks, position - 1);
+			values[name].insert(content.substr(value_start, value_end - value_start + 1));
+		}
+	}
+
+	return true;
+}
+
+bool PluginUtils::loadReferencedPlugins(const std::vector<std::string> &filenames)
+{
+	std::set<std::string> parameters;
+	for (auto &&entry : this->manifest)
+	{
+		std::string parameter = pluginSelectionParameter(entry.type);
+		if (!parameter.empty())
+		{
+			parameters.insert(parameter);
+		}
+	}
+
+	std::map<std::string, std::set<std::string>> values;
+	for (auto &&filename : filenames)
+	{
+		if (!scanParametersValues(filename, parameters, values))
+		{
+			LOG(this->log_init, LEVEL_WARNING,
+				"cannot read configuration file %s, load all plugins\n",
+				filename.c_str());
+			return this->loadAllPlugins();
+		}
+	}
+
+	std::set<std::string> libraries;
+	for (auto &&entry : this->manifest)
+	{
+		std::string parameter = pluginSelectionParameter(entry.type);
+		bool selected = parameter.empty() ||
+		                values[parameter].find(entry.name) != values[parameter].end();
+		if (selected && libraries.insert(entry.library).second)
+		{
+			if (!this->loadLibrary(entry.library))
+			{
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+bool PluginUtils::loadAllPlugins()
+{
+	std::set<std::string> libraries;
+	for (auto &&entry : this->manifest)
+	{
+		if (libraries.insert(entry.library).second)
+		{
+			if (!this->loadLibrary(entry.library))
+			{
+				return false;
 			}
 		}
-		closedir(plugin_dir);
 	}
 
 	return true;
@@ -229,14 +564,17 @@ void PluginUtils::releasePlugins()
  *
  * @param plugin_name  The name of the plugin to retrieve
  * @param container    The container where to look for the plugin
- * @param plugin       The plugin
- * @return true on success, false otherwise
+ * @param load         The function opening the library of a plugin
+ *                     only declared in a manifest
+ * @return the plugin instance of the current output probe scope
+ *         on success, nullptr otherwise
  */
 template <class PluginType>
 std::shared_ptr<PluginType> getPlugin(
 		std::shared_ptr<OutputLog> log,
 		const std::string &plugin_name,
-		PluginConfigurationContainer<PluginType> &container)
+		PluginConfigurationContainer<PluginType> &container,
+		std::function<bool(const std::string &)> load)
 {
 	auto plugin_configuration = container.find(plugin_name);
 	if (plugin_configuration == container.end())
@@ -245,10 +583,22 @@ std::shared_ptr<PluginType> getPlugin(
 		return nullptr;
 	}
 
+	// the plugins keep a state (fragmentation contexts, filters, random
+	// draws...) so each entity emulated by the process gets its instance
 	PluginConfigurationElement<PluginType> &configuration = plugin_configuration->second;
-	if (configuration.plugin != nullptr)
+	const std::string &scope = Output::Get()->getProbeScope();
+	auto instance = configuration.plugins.find(scope);
+	if (instance != configuration.plugins.end())
 	{
-		return configuration.plugin;
+		return instance->second;
+	}
+
+	if (!configuration.create && !configuration.library.empty())
+	{
+		if (!load(configuration.library))
+		{
+			return nullptr;
+		}
 	}
 
 	if (!configuration.create)
@@ -272,38 +622,45 @@ std::shared_ptr<PluginType> getPlugin(
 		return nullptr;
 	}
 
-	configuration.plugin = std::shared_ptr<PluginType>(plugin_cast);
-	return configuration.plugin;
+	std::shared_ptr<PluginType> result{plugin_cast};
+	configuration.plugins.emplace(scope, result);
+	return result;
 }
 
 std::shared_ptr<EncapPlugin> PluginUtils::getEncapsulationPlugin(std::string name)
 {
-	return getPlugin(this->log_init, name, this->encapsulation);
+	return getPlugin(this->log_init, name, this->encapsulation,
+	                 [this](const std::string &library) { return this->loadLibrary(library); });
 };
 
 std::shared_ptr<IslDelayPlugin> PluginUtils::getIslDelayPlugin(std::string name)
 {
-	return getPlugin(this->log_init, name, this->isl_delay);
+	return getPlugin(this->log_init, name, this->isl_delay,
+	                 [this](const std::string &library) { return this->loadLibrary(library); });
 };
 
 std::shared_ptr<SatDelayPlugin> PluginUtils::getSatDelayPlugin(std::string name)
 {
-	return getPlugin(this->log_init, name, this->sat_delay);
+	return getPlugin(this->log_init, name, this->sat_delay,
+	                 [this](const std::string &library) { return this->loadLibrary(library); });
 };
 
 std::shared_ptr<AttenuationModelPlugin> PluginUtils::getAttenuationPlugin(std::string name)
 {
-	return getPlugin(this->log_init, name, this->attenuation);
+	return getPlugin(this->log_init, name, this->attenuation,
+	                 [this](const std::string &library) { return this->loadLibrary(library); });
 };
 
 std::shared_ptr<MinimalConditionPlugin> PluginUtils::getMinimalConditionPlugin(std::string name)
 {
-	return getPlugin(this->log_init, name, this->minimal);
+	return getPlugin(this->log_init, name, this->minimal,
+	                 [this](const std::string &library) { return this->loadLibrary(library); });
 };
 
 std::shared_ptr<ErrorInsertionPlugin> PluginUtils::getErrorInsertionPlugin(std::string name)
 {
-	return getPlugin(this->log_init, name, this->error);
+	return getPlugin(this->log_init, name, this->error,
+	                 [this](const std::string &library) { return this->loadLibrary(library); });
 };
 
 template<class T>
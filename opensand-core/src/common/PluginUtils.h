@@ -66,7 +66,12 @@ template<class T>
 struct PluginConfigurationElement {
 	fn_configure init;
 	fn_create create;
-	std::shared_ptr<T> plugin;
+	/// the plugin instances, by output probe scope: the entities emulated
+	/// by a single process (see Output::setProbeScope) each get their own
+	std::map<std::string, std::shared_ptr<T>> plugins;
+	/// the library providing the plugin, opened on demand when
+	/// the plugin is only known from a manifest (init and create unset)
+	std::string library;
 };
 template<class T>
 using PluginConfigurationContainer = std::map<std::string, PluginConfigurationElement<T>>;
@@ -90,16 +95,75 @@ protected:
 	PluginConfigurationContainer<IslDelayPlugin> isl_delay;
 	std::vector<void *> handlers;
 
+	/**
+	 * @brief A plugin declared in a manifest
+	 */
+	struct ManifestEntry
+	{
+		PluginType type;
+		std::string name;
+		std::string library;
+	};
+	/// the plugins declared in manifests, whose library may not be opened yet
+	std::vector<ManifestEntry> manifest;
+
+	/// whether the physical layer plugins are enabled
+	bool enable_phy_layer;
+
 	PluginUtils();
 
 	/**
 	 * @brief load the plugins
 	 *
+	 * The plugins declared in a manifest (*.manifest file in the plugins
+	 * folder, with lines "<type> <name> <library>")
+	 * are only registered, their library is opened by loadReferencedPlugins,
+	 * loadAllPlugins or when the plugin is first requested.
+	 * The other libraries of the plugins folder are opened right away.
+	 *
 	 * @param enable_phy_layer Whether the physical layer is enabled or not
 	 * @return true on success, false otherwise
 	 */
 	bool loadPlugins(bool enable_phy_layer);
 
+	/**
+	 * @brief open the libraries of the registered plugins that are
+	 *        selected by the configuration files, that is the plugins
+	 *        named by a plugin type parameter (attenuation_type,
+	 *        delay_type, ...). The encapsulation plugins are not selected
+	 *        by a parameter, they are all opened.
+	 *
+	 * @param filenames  The configuration files
+	 * @return true on success, false otherwise
+	 */
+	bool loadReferencedPlugins(const std::vector<std::string> &filenames);
+
+	/**
+	 * @brief open the libraries of all the registered plugins
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool loadAllPlugins();
+
+	/**
+	 * @brief open a plugin library and store the plugin it provides
+	 *
+	 * @param library  The path of the library
+	 * @return true on success, false otherwise
+	 */
+	bool loadLibrary(const std::string &library);
+
+	/**
+	 * @brief read a plugins manifest and register the plugins it declares
+	 *
+	 * @param directory  The plugins folder
+	 * @param filename   The manifest file name
+	 * @param libraries  OUT: the libraries declared in the manifest
+	 */
+	void readManifest(const std::string &directory,
+	                  const std::string &filename,
+	                  std::vector<std::string> &libraries);
+
 	/**
 	 * @brief release the class elements for plugins
 	 */
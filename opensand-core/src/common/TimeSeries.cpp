@@ -0,0 +1,424 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file TimeSeries.cpp
+ * @brief Time series read from a file, used by the file driven plugins
+ * @author Viveris Technologies
+ */
+
+
+#include "TimeSeries.h"
+
+#include <opensand_output/Output.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <numeric>
+#include <sstream>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+static constexpr char TIME_SERIES_MAGIC[4] = {'O', 'S', 'T', 'S'};
+static constexpr uint32_t TIME_SERIES_VERSION = 1;
+
+/// The number of rows an entry may be resampled into, beyond that the
+/// entries are kept as they are
+static constexpr uint64_t MAX_ROWS_PER_ENTRY = 16;
+
+
+TimeSeries::TimeSeries():
+	header{},
+	times{nullptr},
+	values{nullptr},
+	parsed_times{},
+	parsed_values{},
+	mapping{nullptr},
+	mapping_length{0}
+{
+}
+
+
+TimeSeries::~TimeSeries()
+{
+	this->release();
+}
+
+
+void TimeSeries::release()
+{
+	if(this->mapping != nullptr)
+	{
+		munmap(this->mapping, this->mapping_length);
+		this->mapping = nullptr;
+		this->mapping_length = 0;
+	}
+	this->parsed_times.clear();
+	this->parsed_values.clear();
+	this->times = nullptr;
+	this->values = nullptr;
+	this->header = BinaryHeader{};
+}
+
+
+bool TimeSeries::load(const std::string &filename, std::shared_ptr<OutputLog> log)
+{
+	this->release();
+
+	int fd = open(filename.c_str(), O_RDONLY);
+	if(fd < 0)
+	{
+		LOG(log, LEVEL_ERROR,
+		    "Cannot open file %s: %s\n",
+		    filename.c_str(), strerror(errno));
+		return false;
+	}
+
+	struct stat status;
+	BinaryHeader file_header;
+	if(fstat(fd, &status) != 0 ||
+	   static_cast<std::size_t>(status.st_size) < sizeof(BinaryHeader) ||
+	   pread(fd, &file_header, sizeof(file_header), 0) != sizeof(file_header) ||
+	   memcmp(file_header.magic, TIME_SERIES_MAGIC, sizeof(TIME_SERIES_MAGIC)) != 0)
+	{
+		// not a binary file, parse the text format
+		close(fd);
+		if(!parseText(filename, log, this->header, this->parsed_times, this->parsed_values))
+		{
+			return false;
+		}
+		this->times = this->parsed_times.empty() ? nullptr : this->parsed_times.data();
+		this->values = this->parsed_values.data();
+		LOG(log, LEVEL_NOTICE,
+		    "Time series %s parsed: %u columns, %llu rows; convert it to "
+		    "the binary format to map it instead\n",
+		    filename.c_str(), this->header.columns,
+		    static_cast<unsigned long long>(this->header.rows));
+		return true;
+	}
+
+	// check the size from the file length, the header fields may be
+	// large enough to overflow a multiplication
+	uint64_t payload = status.st_size - sizeof(BinaryHeader);
+	uint64_t row_size = uint64_t(file_header.columns) * sizeof(double) +
+	                    (file_header.stride == 0 ? sizeof(uint64_t) : 0);
+	if(file_header.version != TIME_SERIES_VERSION ||
+	   file_header.columns == 0 || file_header.rows == 0 ||
+	   payload % row_size != 0 || payload / row_size != file_header.rows)
+	{
+		LOG(log, LEVEL_ERROR,
+		    "Malformed binary time series file '%s'\n",
+		    filename.c_str());
+		close(fd);
+		return false;
+	}
+
+	std::size_t expected = status.st_size;
+	void *mapped = mmap(nullptr, expected, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if(mapped == MAP_FAILED)
+	{
+		LOG(log, LEVEL_ERROR,
+		    "Cannot map file %s: %s\n",
+		    filename.c_str(), strerror(errno));
+		return false;
+	}
+
+	this->mapping = mapped;
+	this->mapping_length = expected;
+	this->header = file_header;
+	const char *payload_start = static_cast<const char *>(mapped) + sizeof(BinaryHeader);
+	if(file_header.stride == 0)
+	{
+		// the lookup is a binary search on the rows times
+		this->times = reinterpret_cast<const uint64_t *>(payload_start);
+		payload_start += file_header.rows * sizeof(uint64_t);
+		if(!std::is_sorted(this->times, this->times + file_header.rows,
+		                   std::less_equal<uint64_t>()))
+		{
+			LOG(log, LEVEL_ERROR,
+			    "Malformed binary time series file '%s': "
+			    "the rows times are not increasing\n",
+			    filename.c_str());
+			this->release();
+			return false;
+		}
+	}
+	this->values = reinterpret_cast<const double *>(payload_start);
+	LOG(log, LEVEL_NOTICE,
+	    "Time series %s mapped: %u columns, %llu rows\n",
+	    filename.c_str(), this->header.columns,
+	    static_cast<unsigned long long>(this->header.rows));
+	return true;
+}
+
+
+bool TimeSeries::convert(const std::string &text_filename,
+                         const std::string &binary_filename,
+                         std::shared_ptr<OutputLog> log)
+{
+	BinaryHeader header;
+	std::vector<uint64_t> times;
+	std::vector<double> values;
+	if(!parseText(text_filename, log, header, times, values))
+	{
+		return false;
+	}
+
+	std::ofstream file(binary_filename, std::ios::binary | std::ios::trunc);
+	file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+	file.write(reinterpret_cast<const char *>(times.data()), times.size() * sizeof(uint64_t));
+	file.write(reinterpret_cast<const char *>(values.data()), values.size() * sizeof(double));
+	file.close();
+	if(!file)
+	{
+		LOG(log, LEVEL_ERROR,
+		    "Cannot write file %s\n", binary_filename.c_str());
+		return false;
+	}
+	return true;
+}
+
+
+bool TimeSeries::parseText(const std::string &filename,
+                           std::shared_ptr<OutputLog> log,
+                           BinaryHeader &header,
+                           std::vector<uint64_t> &times,
+                           std::vector<double> &values)
+{
+	std::ifstream file(filename);
+	if(!file)
+	{
+		LOG(log, LEVEL_ERROR,
+		    "Cannot open file %s\n", filename.c_str());
+		return false;
+	}
+
+	// read the entries, a later entry replaces an earlier one at the same time
+	std::vector<std::pair<uint64_t, std::vector<double>>> entries;
+	std::size_t columns = 0;
+	std::string line;
+	unsigned int line_number = 0;
+	while(std::getline(file, line))
+	{
+		line_number++;
+
+		// skip line if empty
+		if(line == "" || line[0] == '#')
+		{
+			continue;
+		}
+
+		std::istringstream line_stream{line};
+		uint64_t time;
+		if(!(line_stream >> time))
+		{
+			LOG(log, LEVEL_ERROR,
+			    "Bad syntax in file '%s', line %u: "
+			    "there should be a timestamp (integer) "
+			    "instead of '%s'\n",
+			    filename.c_str(), line_number,
+			    line.c_str());
+			return false;
+		}
+
+		std::vector<double> row;
+		double value;
+		while(line_stream >> value)
+		{
+			row.push_back(value);
+		}
+		if(!line_stream.eof() || row.empty() ||
+		   (columns != 0 && row.size() != columns))
+		{
+			LOG(log, LEVEL_ERROR,
+			    "Bad syntax in file '%s', line %u: "
+			    "there should be %s values\n",
+			    filename.c_str(), line_number,
+			    columns != 0 ? std::to_string(columns).c_str() : "one or more");
+			return false;
+		}
+		columns = row.size();
+		entries.emplace_back(time, std::move(row));
+	}
+
+	if(entries.empty())
+	{
+		LOG(log, LEVEL_ERROR,
+		    "No entry in time series file '%s'\n",
+		    filename.c_str());
+		return false;
+	}
+
+	std::stable_sort(entries.begin(), entries.end(),
+	                 [](const auto &a, const auto &b) { return a.first < b.first; });
+	std::vector<std::pair<uint64_t, std::vector<double>>> unique_entries;
+	for(auto &&entry: entries)
+	{
+		if(!unique_entries.empty() && unique_entries.back().first == entry.first)
+		{
+			unique_entries.back() = std::move(entry);
+		}
+		else
+		{
+			unique_entries.push_back(std::move(entry));
+		}
+	}
+
+	// sample the entries at the greatest common step, interpolating
+	// between the entries of irregular files
+	uint64_t stride = 0;
+	for(std::size_t index = 1; index < unique_entries.size(); ++index)
+	{
+		stride = std::gcd(stride, unique_entries[index].first - unique_entries[index - 1].first);
+	}
+	stride = std::max<uint64_t>(stride, 1);
+
+	uint64_t first_time = unique_entries.front().first;
+	uint64_t rows = (unique_entries.back().first - first_time) / stride + 1;
+	memcpy(header.magic, TIME_SERIES_MAGIC, sizeof(TIME_SERIES_MAGIC));
+	header.version = TIME_SERIES_VERSION;
+	header.columns = columns;
+	header.first_time = first_time;
+	times.clear();
+
+	if(stride > UINT32_MAX || rows / MAX_ROWS_PER_ENTRY >= unique_entries.size())
+	{
+		// too many rows, keep the entries and look them up by time
+		LOG(log, LEVEL_INFO,
+		    "Time series file '%s' is too irregular to be resampled, "
+		    "its %zu entries are kept\n",
+		    filename.c_str(), unique_entries.size());
+		rows = unique_entries.size();
+		header.stride = 0;
+		header.rows = rows;
+		times.reserve(rows);
+		values.assign(columns * rows, 0);
+		for(uint64_t row = 0; row < rows; ++row)
+		{
+			times.push_back(unique_entries[row].first);
+			for(std::size_t column = 0; column < columns; ++column)
+			{
+				values[column * rows + row] = unique_entries[row].second[column];
+			}
+		}
+		return true;
+	}
+
+	header.stride = stride;
+	header.rows = rows;
+	values.assign(columns * rows, 0);
+	std::size_t next = 0;
+	for(uint64_t row = 0; row < rows; ++row)
+	{
+		uint64_t time = first_time + row * stride;
+		while(unique_entries[next].first < time)
+		{
+			next++;
+		}
+		const auto &[new_time, new_values] = unique_entries[next];
+		for(std::size_t column = 0; column < columns; ++column)
+		{
+			double value = new_values[column];
+			if(new_time != time)
+			{
+				// Linear interpolation
+				const auto &[old_time, old_values] = unique_entries[next - 1];
+				double coef = (new_values[column] - old_values[column]) / (new_time - old_time);
+				value = old_values[column] + coef * (time - old_time);
+			}
+			values[column * rows + row] = value;
+		}
+	}
+	return true;
+}
+
+
+std::size_t TimeSeries::getColumnsCount() const
+{
+	return this->header.columns;
+}
+
+
+uint64_t TimeSeries::getLastTime() const
+{
+	if(this->times != nullptr)
+	{
+		return this->times[this->header.rows - 1];
+	}
+	return this->header.first_time + (this->header.rows - 1) * this->header.stride;
+}
+
+
+double TimeSeries::getValue(std::size_t column, uint64_t time) const
+{
+	const double *column_values = this->values + column * this->header.rows;
+	if(time <= this->header.first_time)
+	{
+		return column_values[0];
+	}
+
+	if(this->times != nullptr)
+	{
+		const uint64_t *next = std::upper_bound(this->times, this->times + this->header.rows, time);
+		if(next == this->times + this->header.rows)
+		{
+			return column_values[this->header.rows - 1];
+		}
+
+		// Linear interpolation
+		std::size_t row = next - this->times;
+		uint64_t old_time = this->times[row - 1];
+		double coef = (column_values[row] - column_values[row - 1]) / (*next - old_time);
+		return column_values[row - 1] + coef * (time - old_time);
+	}
+
+	uint64_t offset = time - this->header.first_time;
+	uint64_t row = offset / this->header.stride;
+	if(row >= this->header.rows - 1)
+	{
+		return column_values[this->header.rows - 1];
+	}
+
+	// Linear interpolation
+	double coef = (column_values[row + 1] - column_values[row]) / this->header.stride;
+	return column_values[row] + coef * (offset % this->header.stride);
+}
+
+
+double TimeSeries::getMaxValue(std::size_t column) const
+{
+	const double *column_values = this->values + column * this->header.rows;
+	return *std::max_element(column_values, column_values + this->header.rows);
+}
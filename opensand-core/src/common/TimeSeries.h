@@ -0,0 +1,188 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file TimeSeries.h
+ * @brief Time series read from a file, used by the file driven plugins
+ * @author Viveris Technologies
+ */
+
+#ifndef TIME_SERIES_H
+#define TIME_SERIES_H
+
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+
+class OutputLog;
+
+
+/**
+ * @class TimeSeries
+ * @brief Time series sampled every refresh period, with one or
+ *        several value columns (e.g. the delay and attenuation of
+ *        many links in a single file)
+ *
+ * Two file formats are supported:
+ *  - the text format: one "<time> <value> [<value> ...]" line per
+ *    entry, the time being a number of refresh periods, empty lines
+ *    and lines starting with '#' are skipped;
+ *  - the binary format, produced from the text one by convert() and
+ *    mapped in memory instead of parsed, so that long traces load
+ *    instantly and share their pages between the entities of a host.
+ *    It starts with a BinaryHeader followed, for each column, by the
+ *    values of the rows (native byte order, row n being at time
+ *    first_time + n * stride).
+ *
+ * Entries are resampled at their greatest common time step so that a
+ * lookup is a direct index in the column. When this would create too
+ * many rows (irregular entries far apart), the entries are kept as is:
+ * the stride is then 0 and the time of each row (uint64_t) is stored
+ * between the header and the values, a lookup is a binary search.
+ * Values between rows are linearly interpolated.
+ */
+class TimeSeries
+{
+public:
+	/// Header of the binary format
+	struct BinaryHeader
+	{
+		char magic[4];        ///< "OSTS"
+		uint32_t version;     ///< the format version
+		uint32_t columns;     ///< the number of value columns
+		uint32_t stride;      ///< the time between two rows, 0 if the
+		                      ///< rows times are stored
+		uint64_t first_time;  ///< the time of the first row
+		uint64_t rows;        ///< the number of rows
+	};
+
+	TimeSeries();
+	~TimeSeries();
+
+	TimeSeries(const TimeSeries &) = delete;
+	TimeSeries &operator=(const TimeSeries &) = delete;
+
+	/**
+	 * @brief Load a time series file, binary or text
+	 *
+	 * @param filename  The file name
+	 * @param log       The log to report errors on
+	 * @return true on success, false otherwise
+	 */
+	bool load(const std::string &filename, std::shared_ptr<OutputLog> log);
+
+	/**
+	 * @brief Convert a text time series file into the binary format
+	 *
+	 * @param text_filename    The text file to read
+	 * @param binary_filename  The binary file to write
+	 * @param log              The log to report errors on
+	 * @return true on success, false otherwise
+	 */
+	static bool convert(const std::string &text_filename,
+	                    const std::string &binary_filename,
+	                    std::shared_ptr<OutputLog> log);
+
+	/**
+	 * @brief Get the number of value columns
+	 */
+	std::size_t getColumnsCount() const;
+
+	/**
+	 * @brief Get the time of the last entry
+	 */
+	uint64_t getLastTime() const;
+
+	/**
+	 * @brief Get the value of a column at a given time, interpolated
+	 *        between the surrounding entries; the first (resp. last)
+	 *        entry is used before (resp. after) the series
+	 *
+	 * @param column  The column, lower than getColumnsCount()
+	 * @param time    The time
+	 * @return the value
+	 */
+	double getValue(std::size_t column, uint64_t time) const;
+
+	/**
+	 * @brief Get the maximum value of a column
+	 *
+	 * @param column  The column, lower than getColumnsCount()
+	 * @return the maximum value
+	 */
+	double getMaxValue(std::size_t column) const;
+
+private:
+	/**
+	 * @brief Parse a text time series file into rows sampled at a
+	 *        constant stride, or into the entries rows if resampling
+	 *        them would create too many rows
+	 *
+	 * @param filename  The file name
+	 * @param log       The log to report errors on
+	 * @param header    OUT: the header describing the rows
+	 * @param times     OUT: the rows times, empty if sampled at a stride
+	 * @param values    OUT: the values, column after column
+	 * @return true on success, false otherwise
+	 */
+	static bool parseText(const std::string &filename,
+	                      std::shared_ptr<OutputLog> log,
+	                      BinaryHeader &header,
+	                      std::vector<uint64_t> &times,
+	                      std::vector<double> &values);
+
+	/**
+	 * @brief Release the current series
+	 */
+	void release();
+
+	/// The header describing the rows
+	BinaryHeader header;
+
+	/// The rows times, mapped or parsed, nullptr if sampled at a stride
+	const uint64_t *times;
+
+	/// The values, column after column, mapped or parsed
+	const double *values;
+
+	/// The rows times parsed from a text file
+	std::vector<uint64_t> parsed_times;
+
+	/// The values parsed from a text file
+	std::vector<double> parsed_values;
+
+	/// The memory mapping of a binary file
+	void *mapping;
+	std::size_t mapping_length;
+};
+
+
+#endif
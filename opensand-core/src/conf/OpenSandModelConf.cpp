@@ -35,7 +35,9 @@
  */
 
 #include <sstream>
+#include <thread>
 #include <utility>
+#include <sys/stat.h>
 
 #include <opensand_conf/Configuration.h>
 
@@ -62,7 +64,8 @@ OpenSandModelConf::OpenSandModelConf():
 	profile_model{nullptr},
 	topology{nullptr},
 	infrastructure{nullptr},
-	profile{nullptr}
+	profile{nullptr},
+	use_snapshots{true}
 {
 	this->log = Output::Get()->registerLog(LEVEL_WARNING, "Configuration");
 }
@@ -86,8 +89,11 @@ void OpenSandModelConf::createModels()
 	infrastructure_model->getRoot()->setDescription("infrastructure");
 	auto types = infrastructure_model->getTypesDefinition();
 	types->addEnumType("log_level", "Log Level", {"debug", "info", "notice", "warning", "error", "critical"});
-	types->addEnumType("entity_type", "Entity Type", {"Gateway", "Gateway Net Access", "Gateway Phy", "Satellite", "Terminal"});
+	types->addEnumType("entity_type", "Entity Type", {"Gateway", "Gateway Net Access", "Gateway Phy", "Satellite", "Terminal", "Terminals"});
 	types->addEnumType("isl_type", "Type of ISL", {"LanAdaptation", "Interconnect", "None"});
+	types->addEnumType("channel_type", "Channel", {"Upward", "Downward", "Executor"});
+	types->addEnumType("scheduling_policy", "Scheduling Policy", {"other", "fifo", "rr"});
+	types->addEnumType("tap_sharing", "TAP Sharing", {"Per Terminal", "VLAN", "MAC"});
 
 	auto entity = infrastructure_model->getRoot()->addComponent("entity", "Emulated Entity");
 	auto entity_type = entity->addParameter("entity_type", "Entity Type", types->getType("entity_type"));
@@ -253,6 +259,36 @@ void OpenSandModelConf::createModels()
 		terminal->addParameter("qos_server_port", "QoS server Host Port", types->getType("ushort"))->setAdvanced(true);
 	}
 
+	{
+		auto terminals = entity->addComponent("entity_st_multi", "Terminals", "Specific infrastructure information for several Terminals emulated by a single process");
+		infrastructure_model->setReference(terminals, entity_type);
+		auto expected_str = std::dynamic_pointer_cast<OpenSANDConf::DataValue<std::string>>(terminals->getReferenceData());
+		expected_str->set("Terminals");
+		terminals->addParameter("entity_id", "First Terminal ID", types->getType("ushort"));
+		terminals->addParameter("terminal_count", "Terminal Count", types->getType("ushort"),
+		                        "Number of terminals emulated, with consecutive IDs starting from the first one");
+		terminals->addParameter("emu_address", "Emulation Address", types->getType("string"),
+		                        "Address these satellite terminals should listen on for messages from the satellite");
+		terminals->addParameter("tap_iface", "TAP Interface", types->getType("string"),
+		                        "Name of the TAP interface shared by the terminals, or prefix of the name "
+		                        "of the TAP interface of each terminal, followed by its ID");
+		auto tap_sharing = terminals->addParameter("tap_sharing", "TAP Sharing", types->getType("tap_sharing"),
+		                                           "How the traffic of the terminals is mapped on the TAP interfaces: "
+		                                           "one interface per terminal, or a single interface on which "
+		                                           "the terminals are told apart by VLAN ID or by source MAC address");
+		auto vlan_base = terminals->addParameter("vlan_base", "VLAN ID Base", types->getType("ushort"),
+		                                         "The VLAN ID of a terminal on the shared TAP interface is this "
+		                                         "base plus its terminal ID");
+		infrastructure_model->setReference(vlan_base, tap_sharing);
+		auto expected_sharing = std::dynamic_pointer_cast<OpenSANDConf::DataValue<std::string>>(vlan_base->getReferenceData());
+		expected_sharing->set("VLAN");
+		terminals->addParameter("executors", "Shared Executors", types->getType("ushort"),
+		                        "Number of threads running the terminals stacks, named Terminals.<n>; "
+		                        "0 runs each channel on its own thread")->setAdvanced(true);
+		terminals->addParameter("qos_server_host", "QoS server Host Agent", types->getType("string"))->setAdvanced(true);
+		terminals->addParameter("qos_server_port", "QoS server Host Port", types->getType("ushort"))->setAdvanced(true);
+	}
+
 	auto log_levels = infrastructure_model->getRoot()->addComponent("logs", "Logs");
 	log_levels->addComponent("init", "init")->addParameter("level", "Log Level", types->getType("log_level"));
 	log_levels->addComponent("lan_adaptation", "lan_adaptation")->addParameter("level", "Log Level", types->getType("log_level"));
@@ -288,6 +324,28 @@ void OpenSandModelConf::createModels()
 	expected->set(true);
 	collector_probes->setAdvanced(true);
 
+	auto threads = infrastructure_model->getRoot()->addComponent("threads", "Threads",
+	                                                             "Placement and scheduling of the blocks channels threads");
+	threads->setAdvanced(true);
+	auto lock_memory = threads->addParameter("lock_memory", "Lock Process Memory", types->getType("bool"));
+	auto stack_prefault = threads->addParameter("stack_prefault", "Stack Prefaulted per Thread", types->getType("uint"));
+	stack_prefault->setUnit("kB");
+	infrastructure_model->setReference(stack_prefault, lock_memory);
+	expected = std::dynamic_pointer_cast<OpenSANDConf::DataValue<bool>>(stack_prefault->getReferenceData());
+	expected->set(true);
+	auto channel_threads = threads->addList("channels", "Channels Threads", "channel")->getPattern();
+	channel_threads->addParameter("block", "Block Name", types->getType("string"),
+	                              "Name of the block, e.g. Dvb, or of the shared executor for the Executor channel");
+	channel_threads->addParameter("channel_type", "Channel", types->getType("channel_type"));
+	channel_threads->addParameter("cpus", "CPU List", types->getType("string"),
+	                              "CPUs the thread may run on, e.g. 0-3,6; empty to keep the process affinity");
+	channel_threads->addParameter("policy", "Scheduling Policy", types->getType("scheduling_policy"));
+	channel_threads->addParameter("priority", "Real-Time Priority", types->getType("int"),
+	                              "Priority used with the fifo and rr policies, from 1 to 99");
+	channel_threads->addParameter("executor", "Shared Executor", types->getType("string"),
+	                              "Name of the executor running this channel with others on a single thread; "
+	                              "empty to run it on its own thread");
+
 	auto infra = infrastructure_model->getRoot()->addComponent("infrastructure", "Infrastructure");
 	infra->setAdvanced(true);
 	infra->setReadOnly(true);
@@ -598,7 +656,7 @@ bool OpenSandModelConf::readTopology(const std::string& filename)
 		createModels();
 	}
 
-	topology = OpenSANDConf::fromXML(topology_model, filename);
+	topology = loadDataModel(topology_model, filename);
 	if (topology == nullptr)
 	{
 		LOG(log, LEVEL_ERROR, "parse error when reading topology file");
@@ -707,7 +765,7 @@ bool OpenSandModelConf::readInfrastructure(const std::string& filename)
 	}
 
 	entities_type.clear();
-	infrastructure = OpenSANDConf::fromXML(infrastructure_model, filename);
+	infrastructure = loadDataModel(infrastructure_model, filename);
 	if (infrastructure == nullptr) {
 		LOG(log, LEVEL_ERROR, "parse error when reading infrastructure file");
 		return false;
@@ -749,7 +807,7 @@ bool OpenSandModelConf::readProfile(const std::string& filename)
 		createModels();
 	}
 
-	profile = OpenSANDConf::fromXML(profile_model, filename);
+	profile = loadDataModel(profile_model, filename);
 	if (profile == nullptr)
 	{
 		LOG(log, LEVEL_ERROR, "parse error when reading profile file");
@@ -760,6 +818,48 @@ bool OpenSandModelConf::readProfile(const std::string& filename)
 }
 
 
+void OpenSandModelConf::setSnapshotsEnabled(bool enabled)
+{
+	use_snapshots = enabled;
+}
+
+
+std::shared_ptr<OpenSANDConf::DataModel> OpenSandModelConf::loadDataModel(std::shared_ptr<OpenSANDConf::MetaModel> model,
+                                                                          const std::string &filename) const
+{
+	std::string snapshot = filename + ".snapshot";
+
+	// the snapshot stores the size and modification time of the XML file
+	// it was written from, any difference means the file was replaced,
+	// even with an older file (cp -p, tar, rsync -t, git checkout)
+	struct stat xml_status;
+	std::string source;
+	if (use_snapshots && stat(filename.c_str(), &xml_status) == 0)
+	{
+		source = std::to_string(xml_status.st_size) + " " +
+		         std::to_string(xml_status.st_mtim.tv_sec) + "." +
+		         std::to_string(xml_status.st_mtim.tv_nsec);
+
+		// the snapshot is rejected if it was written for another model
+		auto datamodel = OpenSANDConf::fromBinary(model, snapshot, source);
+		if (datamodel != nullptr)
+		{
+			LOG(log, LEVEL_INFO, "configuration read from snapshot %s", snapshot.c_str());
+			return datamodel;
+		}
+		LOG(log, LEVEL_NOTICE, "snapshot %s is missing or stale, reading %s", snapshot.c_str(), filename.c_str());
+	}
+
+	auto datamodel = OpenSANDConf::fromXML(model, filename);
+	if (datamodel != nullptr && !source.empty() &&
+	    !OpenSANDConf::toBinary(model, datamodel, snapshot, source))
+	{
+		LOG(log, LEVEL_NOTICE, "cannot write snapshot %s", snapshot.c_str());
+	}
+	return datamodel;
+}
+
+
 Component OpenSandModelConf::getComponentType() const
 {
 	if (infrastructure == nullptr) {
@@ -771,7 +871,7 @@ Component OpenSandModelConf::getComponentType() const
 
 	if (component_type == "Satellite") {
 		return Component::satellite;
-	} else if (component_type == "Terminal") {
+	} else if (component_type == "Terminal" || component_type == "Terminals") {
 		return Component::terminal;
 	} else if (component_type == "Gateway" || component_type == "Gateway Net Access" || component_type == "Gateway Phy") {
 		return Component::gateway;
@@ -795,6 +895,8 @@ bool OpenSandModelConf::getComponentType(std::string &type, tal_id_t &id) const
 		type = "sat";
 	} else if (component_type == "Terminal") {
 		type = "st";
+	} else if (component_type == "Terminals") {
+		type = "st_multi";
 	} else if (component_type == "Gateway") {
 		type = "gw";
 	} else if (component_type == "Gateway Net Access") {
@@ -914,7 +1016,7 @@ bool OpenSandModelConf::getGroundInfrastructure(std::string &ip_address, std::st
 	}
 
 	auto entity = infrastructure->getRoot()->getComponent("entity")->getComponent("entity_" + type);
-	if (type == "st" || type == "gw") {
+	if (type == "st" || type == "st_multi" || type == "gw") {
 		if (!extractParameterData(entity, "emu_address", ip_address)) {
 			return false;
 		}
@@ -1112,7 +1214,7 @@ bool OpenSandModelConf::getQosServerHost(std::string &qos_server_host_agent, uin
 		return false;
 	}
 
-	if (type != "st") {
+	if (type != "st" && type != "st_multi") {
 		return false;
 	}
 
@@ -1127,6 +1229,135 @@ bool OpenSandModelConf::getQosServerHost(std::string &qos_server_host_agent, uin
 }
 
 
+bool OpenSandModelConf::getTerminalsInfrastructure(terminals_infrastructure &terminals) const
+{
+	if (infrastructure == nullptr) {
+		return false;
+	}
+
+	std::string type;
+	tal_id_t first_id;
+	if (!this->getComponentType(type, first_id)) {
+		return false;
+	}
+
+	if (type != "st_multi") {
+		return false;
+	}
+
+	auto entity = infrastructure->getRoot()->getComponent("entity")->getComponent("entity_" + type);
+	uint16_t terminal_count;
+	if (!extractParameterData(entity, "terminal_count", terminal_count)) {
+		return false;
+	}
+	if (terminal_count == 0 || first_id + terminal_count - 1 >= BROADCAST_TAL_ID) {
+		LOG(this->log, LEVEL_ERROR,
+		    "Invalid range of %u terminals starting from terminal %u",
+		    terminal_count, first_id);
+		return false;
+	}
+	terminals.tal_ids.clear();
+	for (uint16_t index = 0; index < terminal_count; ++index) {
+		terminals.tal_ids.push_back(first_id + index);
+	}
+
+	std::string tap_sharing;
+	if (!extractParameterData(entity, "tap_sharing", tap_sharing)) {
+		return false;
+	}
+	terminals.vlan_base = 0;
+	if (tap_sharing == "Per Terminal") {
+		terminals.tap_sharing = TapSharing::PerTerminal;
+	} else if (tap_sharing == "VLAN") {
+		terminals.tap_sharing = TapSharing::Vlan;
+		if (!extractParameterData(entity, "vlan_base", terminals.vlan_base)) {
+			return false;
+		}
+		if (terminals.vlan_base + first_id == 0 || terminals.vlan_base + first_id + terminal_count - 1 > 4094) {
+			LOG(this->log, LEVEL_ERROR,
+			    "The VLAN IDs of the terminals do not fit in 1-4094 with base %u",
+			    terminals.vlan_base);
+			return false;
+		}
+	} else if (tap_sharing == "MAC") {
+		terminals.tap_sharing = TapSharing::Mac;
+	} else {
+		LOG(this->log, LEVEL_ERROR,
+		    "The TAP sharing %s is not supported", tap_sharing.c_str());
+		return false;
+	}
+
+	uint16_t executors = std::thread::hardware_concurrency();
+	extractParameterData(entity, "executors", executors);
+	terminals.executors = executors;
+
+	return true;
+}
+
+
+bool OpenSandModelConf::getThreadsSettings(bool &lock_memory,
+                                           unsigned int &stack_prefault_kb,
+                                           std::vector<channel_thread> &channels) const
+{
+	if (infrastructure == nullptr) {
+		return false;
+	}
+
+	// Default values
+	lock_memory = false;
+	stack_prefault_kb = 0;
+	channels.clear();
+
+	auto threads = infrastructure->getRoot()->getComponent("threads");
+	if (threads == nullptr) {
+		return true;
+	}
+
+	extractParameterData(threads, "lock_memory", lock_memory);
+	if (lock_memory) {
+		extractParameterData(threads, "stack_prefault", stack_prefault_kb);
+	}
+
+	for (auto& channel_item : threads->getList("channels")->getItems()) {
+		auto channel = std::dynamic_pointer_cast<OpenSANDConf::DataComponent>(channel_item);
+
+		channel_thread thread;
+		if (!extractParameterData(channel, "block", thread.block)) {
+			return false;
+		}
+		if (!extractParameterData(channel, "channel_type", thread.channel_type)) {
+			return false;
+		}
+
+		std::string cpus;
+		if (extractParameterData(channel, "cpus", cpus) && !cpus.empty() &&
+		    !Rt::parseCpuList(cpus, thread.settings.cpus)) {
+			LOG(log, LEVEL_ERROR,
+			    "invalid CPU list '%s' for the %s channel of block %s",
+			    cpus.c_str(), thread.channel_type.c_str(), thread.block.c_str());
+			return false;
+		}
+
+		std::string policy;
+		if (extractParameterData(channel, "policy", policy) &&
+		    !Rt::parseSchedulingPolicy(policy, thread.settings.policy)) {
+			LOG(log, LEVEL_ERROR,
+			    "invalid scheduling policy '%s' for the %s channel of block %s",
+			    policy.c_str(), thread.channel_type.c_str(), thread.block.c_str());
+			return false;
+		}
+		extractParameterData(channel, "priority", thread.settings.priority);
+		if (thread.channel_type != "Executor") {
+			extractParameterData(channel, "executor", thread.settings.executor);
+		}
+
+		channels.push_back(thread);
+	}
+
+	return true;
+}
+
+
 bool OpenSandModelConf::getS2WaveFormsDefinition(std::vector<fmt_definition_parameters> &fmt_definitions) const
 {
 	if(topology == nullptr) {
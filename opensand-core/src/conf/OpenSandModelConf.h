@@ -49,6 +49,7 @@
 #include <opensand_conf/DataParameter.h>
 #include <opensand_conf/DataValue.h>
 #include <opensand_output/Output.h>
+#include <opensand_rt/ThreadSettings.h>
 
 #include "OpenSandCore.h"
 #include "SpotComponentPair.h"
@@ -116,6 +117,19 @@ public:
 		std::vector<OpenSandModelConf::carrier> carriers;
 	};
 
+	struct channel_thread {
+		std::string block;
+		std::string channel_type;
+		Rt::ThreadSettings settings;
+	};
+
+	struct terminals_infrastructure {
+		std::vector<tal_id_t> tal_ids;
+		TapSharing tap_sharing;
+		uint16_t vlan_base;
+		unsigned int executors;
+	};
+
 	static std::shared_ptr<OpenSandModelConf> Get();
 	~OpenSandModelConf();
 
@@ -149,6 +163,14 @@ public:
 	bool readInfrastructure(const std::string& filename);
 	bool readProfile(const std::string& filename);
 
+	/**
+	 * @brief Enable or disable the binary snapshots of the configuration
+	 *        files (<file>.snapshot), read instead of the XML files when
+	 *        written from a file of the same size and modification time,
+	 *        written after parsing them otherwise
+	 */
+	void setSnapshotsEnabled(bool enabled);
+
 	template<typename T>
 	static bool extractParameterData(std::shared_ptr<const OpenSANDConf::DataParameter> parameter, T &result);
 
@@ -178,6 +200,24 @@ public:
 	bool getSarp(SarpTable &sarp_table) const;
 	bool getNccPorts(uint16_t &pep_tcp_port, uint16_t &svno_tcp_port) const;
 	bool getQosServerHost(std::string &qos_server_host_agent, uint16_t &qos_server_host_port) const;
+	/**
+	 * @brief: get the terminals emulated by a multi-terminal entity
+	 *
+	 * @param: terminals  The IDs of the terminals, how they share the TAP
+	 *                    interface and the number of executors running them
+	 */
+	bool getTerminalsInfrastructure(terminals_infrastructure &terminals) const;
+	/**
+	 * @brief: get the placement and scheduling of the channels threads
+	 *
+	 * @param: lock_memory        Whether the process memory should be locked
+	 * @param: stack_prefault_kb  The size of stack to prefault per thread when
+	 *                            the memory is locked
+	 * @param: channels           The settings of the configured channels threads
+	 */
+	bool getThreadsSettings(bool &lock_memory,
+	                        unsigned int &stack_prefault_kb,
+	                        std::vector<channel_thread> &channels) const;
 	bool getS2WaveFormsDefinition(std::vector<fmt_definition_parameters> &fmt_definitions) const;
 	bool getRcs2WaveFormsDefinition(std::vector<fmt_definition_parameters> &fmt_definitions,
 	                                vol_sym_t req_burst_length) const;
@@ -232,11 +272,16 @@ private:
 	std::shared_ptr<OpenSANDConf::DataModel> profile;
 
 	std::shared_ptr<OutputLog> log;
+
+	bool use_snapshots;
 	
 	std::unordered_map<tal_id_t, Component> entities_type;
 	std::unordered_map<spot_id_t, SpotTopology> spots_topology;
 
 	bool getSpotCarriers(uint16_t gw_id, OpenSandModelConf::spot &spot, bool forward) const;
+
+	std::shared_ptr<OpenSANDConf::DataModel> loadDataModel(std::shared_ptr<OpenSANDConf::MetaModel> model,
+	                                                       const std::string &filename) const;
 };
 
 
@@ -52,6 +52,7 @@
 
 #include <errno.h>
 #include <cstring>
+#include <chrono>
 #include <opensand_rt/TcpListenEvent.h>
 #include <opensand_rt/MessageEvent.h>
 #include <opensand_rt/TimerEvent.h>
@@ -140,7 +141,8 @@ Rt::DownwardChannel<BlockDvbNcc>::DownwardChannel(const std::string &name, dvb_s
 	fwd_timer{-1},
 	scpc_timers{},
 	spot{nullptr},
-	probe_frame_interval{nullptr}
+	probe_frame_interval{nullptr},
+	probe_dama_time{nullptr}
 {
 }
 
@@ -239,6 +241,9 @@ bool Rt::DownwardChannel<BlockDvbNcc>::onInit()
 	this->probe_frame_interval = Output::Get()->registerProbe<float>(prefix + "Perf.Frames_interval",
 																	 "ms", true,
 																	 SAMPLE_LAST);
+	this->probe_dama_time = Output::Get()->registerProbe<float>(prefix + "Perf.DAMA_computation_time",
+																"ms", true,
+																SAMPLE_MAX);
 
 	return true;
 }
@@ -284,6 +289,7 @@ bool Rt::DownwardChannel<BlockDvbNcc>::initTimers()
 	}
 	LOG(this->log_init, LEVEL_NOTICE,
 		"pep_alloc_delay set to %d ms\n", this->pep_alloc_delay);
+	this->pep_interface.setAllocationDelay(time_ms_t(this->pep_alloc_delay));
 
 	time_ms_t acm_period_ms;
 	if (!Conf->getAcmRefreshPeriod(acm_period_ms))
@@ -297,20 +303,6 @@ bool Rt::DownwardChannel<BlockDvbNcc>::initTimers()
 		"ACM period set to %f ms\n",
 		acm_period_ms);
 
-	// create timer
-	if (!spot)
-	{
-		LOG(this->log_init, LEVEL_WARNING,
-			"Error when getting spot %d\n",
-			spot_id);
-		return false;
-	}
-	spot->setPepCmdApplyTimer(this->addTimerEvent("pep_request",
-												  pep_alloc_delay,
-												  false, // no rearm
-												  false	 // do not start
-												  ));
-
 	return true;
 }
 
@@ -510,11 +502,17 @@ bool Rt::DownwardChannel<BlockDvbNcc>::onEvent(const TimerEvent &event)
 		// send Start Of Frame
 		this->sendSOF(spot->getSofCarrierId());
 
+		// apply the resources allocations/releases received
+		// during the previous superframe
+		this->applyNccRequests();
+
 		if (spot->checkDama())
 		{
 			return true;
 		}
 
+		auto dama_start = std::chrono::high_resolution_clock::now();
+
 		// Update Fmt here for TTP
 		spot->updateFmt();
 
@@ -525,6 +523,12 @@ bool Rt::DownwardChannel<BlockDvbNcc>::onEvent(const TimerEvent &event)
 
 		// send TTP computed by DAMA
 		this->sendTTP();
+
+		if (this->probe_dama_time->isEnabled())
+		{
+			std::chrono::duration<float, std::milli> dama_time = std::chrono::high_resolution_clock::now() - dama_start;
+			this->probe_dama_time->put(dama_time.count());
+		}
 	}
 	else if (event == this->fwd_timer)
 	{
@@ -543,20 +547,6 @@ bool Rt::DownwardChannel<BlockDvbNcc>::onEvent(const TimerEvent &event)
 			return false;
 		}
 	}
-	else if (event == spot->getPepCmdApplyTimer())
-	{
-		// it is time to apply the command sent by the external
-		// PEP component
-
-		std::unique_ptr<PepRequest> pep_request;
-
-		LOG(this->log_receive, LEVEL_NOTICE,
-			"apply PEP requests now\n");
-		while ((pep_request = this->pep_interface.getNextPepRequest()))
-		{
-			spot->applyPepCommand(std::move(pep_request));
-		}
-	}
 	else
 	{
 		LOG(this->log_receive, LEVEL_INFO,
@@ -653,31 +643,37 @@ bool Rt::DownwardChannel<BlockDvbNcc>::onEvent(const NetSocketEvent &event)
 			return false;
 		}
 
-		// set delay for applying the commands
+		// the allocations are applied with the first superframe after
+		// their delay, the releases with the next superframe
 		if (this->pep_interface.getPepRequestType() == PEP_REQUEST_ALLOCATION)
 		{
-			if (!this->startTimer(spot->getPepCmdApplyTimer()))
-			{
-				LOG(this->log_receive, LEVEL_ERROR,
-					"cannot start pep timer");
-				return false;
-			}
 			LOG(this->log_receive, LEVEL_NOTICE,
 				"PEP Allocation request, apply a %dms delay\n",
 				pep_alloc_delay);
 		}
 		else if (this->pep_interface.getPepRequestType() == PEP_REQUEST_RELEASE)
 		{
-			this->raiseTimer(spot->getPepCmdApplyTimer());
 			LOG(this->log_receive, LEVEL_NOTICE,
 				"PEP Release request, no delay to apply\n");
 		}
-		else
+		else if (!this->pep_interface.isBinary())
 		{
 			LOG(this->log_receive, LEVEL_ERROR,
 				"cannot determine request type!\n");
 			return false;
 		}
+		else
+		{
+			LOG(this->log_receive, LEVEL_DEBUG,
+				"PEP binary message not complete yet\n");
+		}
+
+		// the binary protocol keeps the connection for the next messages
+		if (this->pep_interface.isBinary())
+		{
+			return true;
+		}
+
 		// Free the socket
 		if (shutdown(this->pep_interface.getPepClientSocket(), SHUT_RDWR) != 0)
 		{
@@ -713,30 +709,60 @@ bool Rt::DownwardChannel<BlockDvbNcc>::onEvent(const NetSocketEvent &event)
 			return false;
 		}
 		// we have received a set of commands from the
-		// SVNO component, let's apply the resources
-		// allocations/releases they contain
+		// SVNO component, the resources allocations/releases
+		// they contain are applied on the next superframe
+	}
+
+	return true;
+}
 
-		std::unique_ptr<SvnoRequest> request = this->svno_interface.getNextSvnoRequest();
-		while (request != nullptr)
+void Rt::DownwardChannel<BlockDvbNcc>::applyNccRequests()
+{
+	std::unique_ptr<PepRequest> pep_request;
+	unsigned int nb_releases = 0;
+	while ((pep_request = this->pep_interface.getNextPepRelease()))
+	{
+		// without DAMA, requests are only dropped
+		if (!spot->checkDama())
 		{
-			if (!spot)
-			{
-				LOG(this->log_receive, LEVEL_WARNING,
-					"Error when getting spot\n");
-				return false;
-			}
+			spot->applyPepCommand(std::move(pep_request));
+			nb_releases++;
+		}
+	}
+	if (nb_releases != 0)
+	{
+		LOG(this->log_receive, LEVEL_NOTICE,
+			"SF#%u: %u PEP releases applied\n",
+			this->super_frame_counter, nb_releases);
+	}
 
-			if (!spot->applySvnoCommand(std::move(request)))
-			{
-				LOG(this->log_receive, LEVEL_ERROR,
-					"Cannot apply SVNO interface request\n");
-				return false;
-			}
-			request = this->svno_interface.getNextSvnoRequest();
+	unsigned int nb_requests = 0;
+	while ((pep_request = this->pep_interface.getNextPepRequest()))
+	{
+		// without DAMA, requests are only dropped
+		if (!spot->checkDama())
+		{
+			spot->applyPepCommand(std::move(pep_request));
+			nb_requests++;
 		}
 	}
+	if (nb_requests != 0)
+	{
+		LOG(this->log_receive, LEVEL_NOTICE,
+			"SF#%u: %u PEP requests applied\n",
+			this->super_frame_counter, nb_requests);
+	}
 
-	return true;
+	std::unique_ptr<SvnoRequest> svno_request;
+	while ((svno_request = this->svno_interface.getNextSvnoRequest()))
+	{
+		if (!spot->applySvnoCommand(std::move(svno_request)))
+		{
+			LOG(this->log_receive, LEVEL_ERROR,
+				"SF#%u: cannot apply SVNO interface request\n",
+				this->super_frame_counter);
+		}
+	}
 }
 
 bool Rt::DownwardChannel<BlockDvbNcc>::onEvent(const TcpListenEvent &event)
@@ -754,8 +780,7 @@ bool Rt::DownwardChannel<BlockDvbNcc>::onEvent(const TcpListenEvent &event)
 			"NCC is now connected to PEP\n");
 		// add a fd to handle events on the client socket
 		this->addNetSocketEvent("pep_client",
-								this->pep_interface.getPepClientSocket(),
-								200);
+								this->pep_interface.getPepClientSocket());
 	}
 	else if (event == this->svno_interface.getSvnoListenSocket())
 	{
@@ -771,8 +796,7 @@ bool Rt::DownwardChannel<BlockDvbNcc>::onEvent(const TcpListenEvent &event)
 			"NCC is now connected to SVNO\n");
 		// add a fd to handle events on the client socket
 		this->addNetSocketEvent("svno_client",
-								this->svno_interface.getSvnoClientSocket(),
-								200);
+								this->svno_interface.getSvnoClientSocket());
 	}
 
 	return true;
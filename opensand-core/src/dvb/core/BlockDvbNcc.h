@@ -189,6 +189,13 @@ class Rt::DownwardChannel<class BlockDvbNcc>: public DvbChannel, public Channels
 	 */
 	void sendSOF(unsigned int sof_carrier_id);
 
+	/**
+	 * @brief Apply the requests received from the PEP and SVNO components
+	 *        since the previous superframe, in one batch, the PEP
+	 *        allocations once their delay expired
+	 */
+	void applyNccRequests();
+
 	/**
 	 *  @brief Handle a logon request transmitted by the opposite
 	 *         block
@@ -231,6 +238,9 @@ class Rt::DownwardChannel<class BlockDvbNcc>: public DvbChannel, public Channels
 
 	// Frame interval
 	std::shared_ptr<Probe<float>> probe_frame_interval;
+
+	// Time spent in DAMA from the FMT update to the TTP emission
+	std::shared_ptr<Probe<float>> probe_dama_time;
 };
 
 
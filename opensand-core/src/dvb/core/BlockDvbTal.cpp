@@ -143,6 +143,7 @@ void BlockDvbTal::generateConfiguration(std::shared_ptr<OpenSANDConf::MetaParame
 	pattern->getOrCreateParameter("name", "Name", types->getType("string"));
 	pattern->getOrCreateParameter("capacity", "Capacity", types->getType("ushort"))->setUnit("packets");
 	pattern->getOrCreateParameter("access_type", "Access Type", types->getType("st_fifo_access_type"));
+	DvbFifo::addFairQueuingParameters(pattern);
 
 	{ // Access section when control plane is disabled
 		auto access = Conf->getOrCreateComponent("access2", "Access", "MAC layer configuration");
@@ -545,6 +546,10 @@ bool Rt::DownwardChannel<BlockDvbTal>::initMacFifo()
 		}
 
 		auto fifo = std::make_unique<DvbFifo>(fifo_priority, fifo_name, fifo_access_type, fifo_size);
+		// the MAC FIFOs are only accessed by this channel
+		fifo->setSingleOwner(true);
+
+		fifo->configureFairQueuing(fifo_item);
 
 		LOG(this->log_init, LEVEL_NOTICE,
 			"Fifo priority = %u, FIFO name %s, size %u, "
@@ -83,7 +83,6 @@ SpotDownward::SpotDownward(spot_id_t spot_id,
 	fwd_fmt_groups(),
 	ret_fmt_groups(),
 	cni(100),
-	pep_cmd_apply_timer(),
 	request_simu(nullptr),
 	event_file(nullptr),
 	simulate(none_simu),
@@ -133,6 +132,7 @@ void SpotDownward::generateConfiguration(std::shared_ptr<OpenSANDConf::MetaParam
 	types->addEnumType("ncc_simulation", "Simulated Requests", {"None", "Random", "File"});
 	types->addEnumType("gw_fifo_access_type", "Access Type", {"ACM", "VCM0", "VCM1", "VCM2", "VCM3"});
 	types->addEnumType("dama_algorithm", "DAMA Algorithm", {"Legacy",});
+	types->addEnumType("ttp_layout", "TTP Layout", {"Indexed", "Legacy"});
 
 	auto conf = Conf->getOrCreateComponent("network", "Network", "The DVB layer configuration");
 	auto fifos = conf->addList("gw_fifos", "FIFOs to send messages to Terminals", "gw_fifo")->getPattern();
@@ -140,6 +140,7 @@ void SpotDownward::generateConfiguration(std::shared_ptr<OpenSANDConf::MetaParam
 	fifos->addParameter("name", "Name", types->getType("string"));
 	fifos->addParameter("capacity", "Capacity", types->getType("ushort"))->setUnit("packets");
 	fifos->addParameter("access_type", "Access Type", types->getType("gw_fifo_access_type"));
+	DvbFifo::addFairQueuingParameters(fifos);
 	auto simulation = conf->addParameter("simulation",
 	                                     "Simulated Requests",
 	                                     types->getType("ncc_simulation"),
@@ -186,6 +187,11 @@ void SpotDownward::generateConfiguration(std::shared_ptr<OpenSANDConf::MetaParam
 	Conf->setProfileReference(fca, disable_ctrl_plane, false);
 	auto dama_algo = conf->addParameter("dama_algorithm", "DAMA Algorithm", types->getType("dama_algorithm"));
 	Conf->setProfileReference(dama_algo, disable_ctrl_plane, false);
+	auto ttp_layout = conf->addParameter("ttp_layout", "TTP Layout", types->getType("ttp_layout"),
+	                                     "Indexed lets each terminal find its time plans without "
+	                                     "reading the whole TTP, Legacy is for former terminals");
+	ttp_layout->setAdvanced(true);
+	Conf->setProfileReference(ttp_layout, disable_ctrl_plane, false);
 }
 
 
@@ -518,6 +524,28 @@ bool SpotDownward::initDama()
 	}
 	this->dama_ctrl->setRecordFile(this->event_file);
 
+	// the TTP layout is optional, indexed by default
+	std::string ttp_layout = "Indexed";
+	OpenSandModelConf::extractParameterData(ncc->getParameter("ttp_layout"), ttp_layout);
+	if(ttp_layout == "Indexed")
+	{
+		this->dama_ctrl->setTtpLayout(TtpLayout::Indexed);
+	}
+	else if(ttp_layout == "Legacy")
+	{
+		this->dama_ctrl->setTtpLayout(TtpLayout::Legacy);
+	}
+	else
+	{
+		LOG(this->log_init_channel, LEVEL_ERROR,
+		    "section 'ncc': bad value '%s' for "
+		    "parameter 'ttp_layout'\n",
+		    ttp_layout.c_str());
+		return false;
+	}
+	LOG(this->log_init_channel, LEVEL_NOTICE,
+	    "TTP layout: %s\n", ttp_layout.c_str());
+
 	return true;
 }
 
@@ -627,6 +655,10 @@ bool SpotDownward::initFifo(std::shared_ptr<fifos_t> fifos)
 		}
 
 		auto fifo = std::make_unique<DvbFifo>(fifo_priority, fifo_name, fifo_access_type, fifo_size);
+		// the MAC FIFOs are only accessed by this channel
+		fifo->setSingleOwner(true);
+
+		fifo->configureFairQueuing(fifo_item);
 
 		LOG(this->log_init_channel, LEVEL_NOTICE,
 		    "Fifo priority = %u, FIFO name %s, size %u, "
@@ -1190,16 +1222,6 @@ std::list<Rt::Ptr<DvbFrame>> &SpotDownward::getCompleteDvbFrames()
 	return this->complete_dvb_frames;
 }
 
-Rt::event_id_t SpotDownward::getPepCmdApplyTimer()
-{
-	return this->pep_cmd_apply_timer;
-}
-
-void SpotDownward::setPepCmdApplyTimer(Rt::event_id_t pep_cmd_a_timer)
-{
-	this->pep_cmd_apply_timer = pep_cmd_a_timer;
-}
-
 bool SpotDownward::handleSac(Rt::Ptr<DvbFrame> dvb_frame)
 {
 	if(!this->dama_ctrl->hereIsSAC(dvb_frame_upcast<Sac>(std::move(dvb_frame))))
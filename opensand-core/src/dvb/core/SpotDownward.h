@@ -177,9 +177,6 @@ public:
 
 	std::list<Rt::Ptr<DvbFrame>> &getCompleteDvbFrames();
 
-	void setPepCmdApplyTimer(Rt::event_id_t pep_cmd_a_timer);
-	Rt::event_id_t getPepCmdApplyTimer();
-
 protected:
 	/**
 	 * Read configuration for the downward timers
@@ -306,9 +303,6 @@ protected:
 	//  MODCOD id for terminals (not this one)
 	double cni;
 
-	/// timer used for applying resources allocations received from PEP
-	Rt::event_id_t pep_cmd_apply_timer;
-
 	std::unique_ptr<RequestSimulator> request_simu;
 
 	/// parameters for request simulation
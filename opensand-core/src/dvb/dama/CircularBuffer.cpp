@@ -32,6 +32,7 @@
  */
 
 
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
@@ -98,8 +99,7 @@ CircularBuffer::~CircularBuffer()
  */
 void CircularBuffer::Update(rate_kbps_t value)
 {
-	size_t i;
-	rate_kbps_t min = 0;
+	rate_kbps_t min = value;
 
 	if(this->values == nullptr)
 	{
@@ -119,7 +119,7 @@ void CircularBuffer::Update(rate_kbps_t value)
 
 	// minimum update
 	// if the new value is smaller it becames the MIN
-	if(value <= this->min_value)
+	if(this->nbr_values == 1 || value <= this->min_value)
 	{
 		this->min_value = value;
 	}
@@ -128,11 +128,9 @@ void CircularBuffer::Update(rate_kbps_t value)
 	else if(this->values[this->index] == this->min_value)
 	{
 		// minimum calculation
-		for(i = 0; i < this->nbr_values; i++)
+		for(size_t i = 0; i < this->nbr_values; i++)
 		{
-			if(i == this->index)
-				min = std::min(min, value);
-			else
+			if(i != this->index)
 				min = std::min(min, this->values[i]);
 		}
 		this->min_value = min;
@@ -222,26 +220,6 @@ rate_kbps_t CircularBuffer::GetSum()
 		return this->sum;
 }
 
-/**
- * Get the sum of a part of the value stored in the circular buffer starting
- * from the newest value (return 0 if the buffer is empty)
- *
- * @return the partial sum
- */
-rate_kbps_t CircularBuffer::GetPartialSumFromPrevious(int value_number)
-{
-	rate_kbps_t partial_sum_kbps = 0;
-	if (this->values == nullptr)
-		LOG(this->log_circular_buffer, LEVEL_ERROR,
-		    "circular buffer not initialized\n");
-	else
-	{   
-		for(int i = 0; i < value_number; i++) 
-			partial_sum_kbps += (this->GetValueIndex(-i));
-	}   
-	return partial_sum_kbps;
-}
-
 /**
  * Get the value at index (return 0 if the buffer is empty)
  *
@@ -249,7 +227,7 @@ rate_kbps_t CircularBuffer::GetPartialSumFromPrevious(int value_number)
  */
 rate_kbps_t CircularBuffer::GetValueIndex(int i)
 {
-	double value;
+	rate_kbps_t value;
 	if(this->values == nullptr)
 	{
 		LOG(this->log_circular_buffer, LEVEL_ERROR,
@@ -258,8 +236,9 @@ rate_kbps_t CircularBuffer::GetValueIndex(int i)
 	}     
 	else
 	{
-		i = (i + this->index) % this->size;
-		value = this->values[i];
+		// relative index, may be negative to go back to older values
+		long offset = (long)(i % (long)this->size) + (long)this->size;
+		value = this->values[(this->index + offset) % this->size];
 	}
 	return value;
 }
@@ -72,7 +72,6 @@ public:
 	rate_kbps_t GetMean();
 	rate_kbps_t GetMin();
 	rate_kbps_t GetSum();
-	rate_kbps_t GetPartialSumFromPrevious(int value_number);
 	rate_kbps_t GetValueIndex(int i);
 	void Debug();
 };
@@ -56,6 +56,8 @@ DamaAgentRcs2::DamaAgentRcs2(const FmtDefinitionTable &ret_modcod_def):
 	dynamic_allocation_kb(0),
 	remaining_allocation_b(0),
 	rbdc_request_buffer(nullptr),
+	rbdc_fifos(),
+	vbdc_fifos(),
 	ret_schedule(nullptr),
 	rbdc_timer_sf(0),
 	ret_modcod_def(ret_modcod_def),
@@ -114,6 +116,22 @@ bool DamaAgentRcs2::init(spot_id_t)
 		return false;
 	}
 
+	// sort the FIFOs once, the set of FIFOs does not change afterwards
+	for(auto&& it: *(this->dvb_fifos))
+	{
+		switch(it.second->getAccessType().return_access_type)
+		{
+			case ReturnAccessType::dama_rbdc:
+				this->rbdc_fifos.push_back(it.second.get());
+				break;
+			case ReturnAccessType::dama_vbdc:
+				this->vbdc_fifos.push_back(it.second.get());
+				break;
+			default:
+				break;
+		}
+	}
+
 	try
 	{
 		this->ret_schedule = std::make_unique<ReturnSchedulingRcs2>(this->packet_handler, this->dvb_fifos);
@@ -196,7 +214,7 @@ bool DamaAgentRcs2::hereIsTTP(Rt::Ptr<Ttp> ttp)
 {
 	rate_kbps_t alloc_kbps;
 	fmt_id_t prev_modcod_id;
-	std::map<uint8_t, emu_tp_t> tp;
+	TimePlans tps;
 
 	this->allocated_kb = 0;
 	if(this->group_id != ttp->getGroupId())
@@ -207,13 +225,13 @@ bool DamaAgentRcs2::hereIsTTP(Rt::Ptr<Ttp> ttp)
 		return true;
 	}
 
-	if(!ttp->getTp(this->tal_id, tp))
+	if(!ttp->getTimePlans(this->tal_id, tps))
 	{
 		// Update stats and probes
 		this->probe_st_total_allocation->put(0);
 		return true;
 	}
-	if(tp.size() > 1)
+	if(tps.size() > 1)
 	{
 		LOG(this->log_ttp, LEVEL_WARNING,
 		    "Received more than one TP in TTP, "
@@ -223,20 +241,20 @@ bool DamaAgentRcs2::hereIsTTP(Rt::Ptr<Ttp> ttp)
 
 	prev_modcod_id = this->modcod_id;
 	this->allocated_kb = 0;
-	for(std::map<uint8_t, emu_tp_t>::iterator it = tp.begin();
-	    it != tp.end(); ++it)
+	for(std::size_t i = 0; i < tps.size(); ++i)
 	{
 		vol_kb_t assign_kb;
+		emu_tp_t tp = tps.getTimePlan(i);
 
 		LOG(this->log_ttp, LEVEL_DEBUG,
 		    "SF#%u: frame#%u: offset:%u, assignment_count:%u kb, "
 		    "fmt_id:%u priority:%u\n", ttp->getSuperframeCount(),
-		    (*it).first, (*it).second.offset, (*it).second.assignment_count,
-		    (*it).second.fmt_id, (*it).second.priority);
+		    tps.getFrameNumber(i), tp.offset, tp.assignment_count,
+		    tp.fmt_id, tp.priority);
 
 		// we can directly assign here because we should have
 		// received only one TTP
-		this->modcod_id = (*it).second.fmt_id;
+		this->modcod_id = tp.fmt_id;
 		if(prev_modcod_id != this->modcod_id)
 		{
 			// update the packet length in function of MODCOD
@@ -245,7 +263,7 @@ bool DamaAgentRcs2::hereIsTTP(Rt::Ptr<Ttp> ttp)
 			    ttp->getSuperframeCount(), this->modcod_id);
 		}
 		
-		assign_kb = (*it).second.assignment_count;
+		assign_kb = tp.assignment_count;
 		try
 		{
 			FmtDefinition &fmt_def = this->ret_modcod_def.getDefinition(this->modcod_id);
@@ -422,9 +440,9 @@ bool DamaAgentRcs2::buildSAC(ReturnAccessType,
 		this->rbdc_request_buffer->Update(rbdc_request_kbps);
 
 		// reset counter of arrival packets in MAC FIFOs related to RBDC
-		for(auto &&it: *(this->dvb_fifos))
+		for(auto &&fifo: this->rbdc_fifos)
 		{
-			it.second->resetNew(ReturnAccessType::dama_rbdc);
+			fifo->resetNew(ReturnAccessType::dama_rbdc);
 		}
 
 		// Update statistics
@@ -475,13 +493,10 @@ vol_b_t DamaAgentRcs2::getMacBufferLength(ReturnAccessType cr_type)
 	vol_b_t nb_b_in_fifo; // absolute data length in fifo
 
 	nb_b_in_fifo = 0;
-	for(auto&& it: *(this->dvb_fifos))
+	for(auto&& fifo: this->getMacFifos(cr_type))
 	{
-		if(it.second->getAccessType() == cr_type)
-		{
-			vol_bytes_t length = it.second->getCurrentDataLength();
-			nb_b_in_fifo += (length << 3);
-		}
+		vol_bytes_t length = fifo->getCurrentDataLength();
+		nb_b_in_fifo += (length << 3);
 	}
 
 	return nb_b_in_fifo;
@@ -493,15 +508,27 @@ vol_b_t DamaAgentRcs2::getMacBufferArrivals(ReturnAccessType cr_type)
 	vol_b_t nb_b_input; // data that filled the queue since last RBDC request
 
 	nb_b_input = 0;
-	for(auto&& it: *(this->dvb_fifos))
+	for(auto&& fifo: this->getMacFifos(cr_type))
 	{
-		if(it.second->getAccessType() == cr_type)
-		{
-			vol_bytes_t length = it.second->getNewDataLength();
-			nb_b_input += (length << 3);
-		}
+		vol_bytes_t length = fifo->getNewDataLength();
+		nb_b_input += (length << 3);
 	}
 
 	return nb_b_input;
 }
 
+const std::vector<DvbFifo *> &DamaAgentRcs2::getMacFifos(ReturnAccessType cr_type) const
+{
+	static const std::vector<DvbFifo *> none;
+
+	switch(cr_type)
+	{
+		case ReturnAccessType::dama_rbdc:
+			return this->rbdc_fifos;
+		case ReturnAccessType::dama_vbdc:
+			return this->vbdc_fifos;
+		default:
+			return none;
+	}
+}
+
@@ -44,6 +44,8 @@
 
 #include <opensand_output/OutputLog.h>
 
+#include <vector>
+
 class DamaAgentRcs2 : public DamaAgent
 {
 public:
@@ -76,6 +78,11 @@ protected:
 	/** Circular buffer to store previous RBDC requests */
 	std::unique_ptr<CircularBuffer> rbdc_request_buffer;
 
+	/** The MAC FIFOs sorted by access type at init, for per-superframe
+	 *  computations that only visit the concerned FIFOs */
+	std::vector<DvbFifo *> rbdc_fifos;
+	std::vector<DvbFifo *> vbdc_fifos;
+
 	/** Uplink Scheduling functions */
 	std::unique_ptr<ReturnSchedulingRcs2> ret_schedule;
 
@@ -114,6 +121,16 @@ protected:
 	 */
 	vol_b_t getMacBufferArrivals(ReturnAccessType cr_type);
 
+	/**
+	 * @brief Get the MAC FIFOs associated to the concerned CR type
+	 *
+	 * @param cr_type            the type of capacity request
+	 *
+	 * @return                  the FIFOs, empty if the type is neither
+	 *                          RBDC nor VBDC
+	 */
+	const std::vector<DvbFifo *> &getMacFifos(ReturnAccessType cr_type) const;
+
 	/**
 	 * @brief Compute RBDC request
 	 *
@@ -59,6 +59,7 @@ DamaCtrl::DamaCtrl(spot_id_t spot):
 	input_sts(NULL),
 	input_modcod_def(NULL),
 	simulated(false),
+	ttp_layout(TtpLayout::Indexed),
 	spot_id(spot)
 {
 	// Output Log
@@ -135,6 +136,13 @@ bool DamaCtrl::initOutput()
 {
 	auto output = Output::Get();
 
+	// the per terminal probes are indexed by terminal ID
+	this->probes_st_cra_alloc.resize(BROADCAST_TAL_ID + 1);
+	this->probes_st_rbdc_alloc.resize(BROADCAST_TAL_ID + 1);
+	this->probes_st_rbdc_max.resize(BROADCAST_TAL_ID + 1);
+	this->probes_st_vbdc_alloc.resize(BROADCAST_TAL_ID + 1);
+	this->probes_st_fca_alloc.resize(BROADCAST_TAL_ID + 1);
+
 	// RBDC request number
 	this->probe_gw_rbdc_req_num =
 	    output->registerProbe<int>(output_prefix + "RBDC.RBDC request number", "", true, SAMPLE_LAST);
@@ -197,26 +205,26 @@ bool DamaCtrl::initOutput()
 		tal_id_t tal_id = 0;
 		auto probe_cra = output->registerProbe<int>(output_prefix + "Simulated_ST.CRA allocation",
 		                                            "Kbits/s", true, SAMPLE_MAX);
-		this->probes_st_cra_alloc.emplace(tal_id, probe_cra);
+		this->probes_st_cra_alloc[tal_id] = probe_cra;
 
 		auto probe_rbdc_max = output->registerProbe<int>(output_prefix + "Simulated_ST.RBDC max",
 		                                                 "Kbits/s", true, SAMPLE_MAX);
-		this->probes_st_rbdc_max.emplace(tal_id, probe_rbdc_max);
+		this->probes_st_rbdc_max[tal_id] = probe_rbdc_max;
 
 		auto probe_rbdc = output->registerProbe<int>(output_prefix + "Simulated_ST.RBDC allocation",
 		                                             "Kbits/s", true, SAMPLE_MAX);
-		this->probes_st_rbdc_alloc.emplace(tal_id, probe_rbdc);
+		this->probes_st_rbdc_alloc[tal_id] = probe_rbdc;
 
 		auto probe_vbdc = output->registerProbe<int>(output_prefix + "Simulated_ST.VBDC allocation",
 		                                             "Kbits", true, SAMPLE_SUM);
-		this->probes_st_vbdc_alloc.emplace(tal_id, probe_vbdc);
+		this->probes_st_vbdc_alloc[tal_id] = probe_vbdc;
 
 		// only create FCA probe if it is enabled
 		if(this->fca_kbps != 0)
 		{
 			auto probe_fca = output->registerProbe<int>(output_prefix + "Simulated_ST.FCA allocation",
 			                                            "Kbits/s", true, SAMPLE_MAX);
-			this->probes_st_fca_alloc.emplace(tal_id, probe_fca);
+			this->probes_st_fca_alloc[tal_id] = probe_fca;
 		}
 	}
 
@@ -295,7 +303,8 @@ bool DamaCtrl::hereIsLogon(Rt::Ptr<LogonRequest> logon)
 			return false;
 		}
 
-		if(tal_id < BROADCAST_TAL_ID)
+		// the probes are kept if the terminal logs on again
+		if(tal_id < BROADCAST_TAL_ID && !this->probes_st_cra_alloc[tal_id])
 		{
 			auto output = Output::Get();
 
@@ -304,26 +313,26 @@ bool DamaCtrl::hereIsLogon(Rt::Ptr<LogonRequest> logon)
 			// Output probes and stats
 			auto probe_cra = output->registerProbe<int>(prefix + "CRA allocation",
 			                                            "Kbits/s", true, SAMPLE_MAX);
-			this->probes_st_cra_alloc.emplace(tal_id, probe_cra);
+			this->probes_st_cra_alloc[tal_id] = probe_cra;
 
 			auto probe_rbdc_max = output->registerProbe<int>(prefix + "RBDC max",
 			                                                 "Kbits/s", true, SAMPLE_MAX);
-			this->probes_st_rbdc_max.emplace(tal_id, probe_rbdc_max);
+			this->probes_st_rbdc_max[tal_id] = probe_rbdc_max;
 
 			auto probe_rbdc = output->registerProbe<int>(prefix + "RBDC allocation",
 			                                             "Kbits/s", true, SAMPLE_MAX);
-			this->probes_st_rbdc_alloc.emplace(tal_id, probe_rbdc);
+			this->probes_st_rbdc_alloc[tal_id] = probe_rbdc;
 
 			auto probe_vbdc = output->registerProbe<int>(prefix + "VBDC allocation",
 			                                             "Kbits", true, SAMPLE_SUM);
-			this->probes_st_vbdc_alloc.emplace(tal_id, probe_vbdc);
+			this->probes_st_vbdc_alloc[tal_id] = probe_vbdc;
 
 			// only create FCA probe if it is enabled
 			if(this->fca_kbps != 0)
 			{
 				auto probe_fca = output->registerProbe<int>(prefix + "FCA allocation",
 				                                            "Kbits/s", true, SAMPLE_MAX);
-				this->probes_st_fca_alloc.emplace(tal_id, probe_fca);
+				this->probes_st_fca_alloc[tal_id] = probe_fca;
 			}
 		}
 
@@ -551,13 +560,17 @@ void DamaCtrl::setRecordFile(std::ostream *event_stream)
 	this->record_event("# --------------------------------------\n");
 }
 
+void DamaCtrl::setTtpLayout(TtpLayout layout)
+{
+	this->ttp_layout = layout;
+}
+
 // TODO disable timers on probes if output is disabled
 // and event to reactivate them ?!
 void DamaCtrl::updateStatistics(time_ms_t UNUSED(period_ms))
 {
 	int simu_cra = 0;
 	int simu_rbdc = 0;
-	TerminalCategories<TerminalCategoryDama>::iterator cat_it;
 
 	// Update probes and stats
 	this->probe_gw_st_num->put(this->gw_st_num);
@@ -587,32 +600,69 @@ void DamaCtrl::updateStatistics(time_ms_t UNUSED(period_ms))
 		this->probes_st_rbdc_max[0]->put(simu_rbdc);
 	}
 	this->probe_gw_return_remaining_capacity->put(this->gw_remaining_capacity);
-	for(cat_it = this->categories.begin();
-	    cat_it != categories.end(); ++cat_it)
+	for(auto &&stats: this->categories_stats)
 	{
-		std::shared_ptr<TerminalCategoryDama> category = cat_it->second;
-		std::string label = category->getLabel();
-		this->probes_category_return_remaining_capacity[label]->put(
-			this->category_return_remaining_capacity[label]);
-		for (auto &&carriers: category->getCarriersGroups())
+		stats.probe_return_remaining_capacity->put(stats.return_remaining_capacity);
+		for(auto &&carriers_stats: stats.carriers)
 		{
-			unsigned int carrier_id = carriers.getCarriersId();
+			carriers_stats->probe_return_remaining_capacity->put(
+				carriers_stats->return_remaining_capacity);
+		}
+	}
+}
 
-			// Create the probes if they don't exist yet
-			// (necessary in case of carrier modifications with SVNO interface)
-			auto &probes_remain_capa = this->probes_carrier_return_remaining_capacity[label];
-			if (probes_remain_capa.find(carrier_id) == probes_remain_capa.end())
-			{
-				auto probe = this->generateCarrierCapacityProbe(label, carrier_id, "Remaining");
-				probes_remain_capa.emplace(carrier_id, probe);
-			}
-			auto &remain_capa = this->carrier_return_remaining_capacity[label];
-			if(remain_capa.find(carrier_id) == remain_capa.end())
-			{
-				remain_capa.insert({carrier_id, 0});
-			}
-			probes_remain_capa[carrier_id]->put(remain_capa[carrier_id]);
+void DamaCtrl::initCategoriesStats()
+{
+	this->categories_stats.clear();
+	this->categories_stats.reserve(this->categories.size());
+	for(auto &&category_it: this->categories)
+	{
+		CategoryStats &stats = this->categories_stats.emplace_back();
+		std::string label = category_it.second->getLabel();
+
+		stats.category = category_it.second;
+		stats.probe_return_capacity = this->generateCategoryCapacityProbe(label, "Available");
+		stats.probe_return_remaining_capacity = this->generateCategoryCapacityProbe(label, "Remaining");
+		stats.return_remaining_capacity = 0;
+		this->syncCarriersStats(stats);
+	}
+}
+
+void DamaCtrl::syncCarriersStats(CategoryStats &stats)
+{
+	std::vector<CarriersGroupDama> &carriers_groups = stats.category->getCarriersGroups();
+	bool synced = (carriers_groups.size() == stats.carriers.size());
+	for(std::size_t index = 0; synced && index < carriers_groups.size(); ++index)
+	{
+		synced = (carriers_groups[index].getCarriersId() == stats.carriers[index]->carriers_id);
+	}
+	if(synced)
+	{
+		return;
+	}
+
+	// the carriers groups changed, the probes of the known
+	// carriers groups are kept as they cannot be registered twice
+	std::string label = stats.category->getLabel();
+	stats.carriers.clear();
+	for(auto &&carriers: carriers_groups)
+	{
+		unsigned int carrier_id = carriers.getCarriersId();
+		auto known_it = stats.known_carriers.find(carrier_id);
+		if(known_it == stats.known_carriers.end())
+		{
+			CarriersGroupStats carriers_stats;
+			carriers_stats.carriers_id = carrier_id;
+			carriers_stats.log_context = "carrier " + std::to_string(carrier_id) +
+			                             ", category " + label + ":";
+			carriers_stats.probe_return_capacity =
+				this->generateCarrierCapacityProbe(label, carrier_id, "Available");
+			carriers_stats.probe_return_remaining_capacity =
+				this->generateCarrierCapacityProbe(label, carrier_id, "Remaining");
+			carriers_stats.return_remaining_capacity = 0;
+			known_it = stats.known_carriers.emplace(carrier_id, carriers_stats).first;
 		}
+		stats.carriers.push_back(&known_it->second);
 	}
 }
 
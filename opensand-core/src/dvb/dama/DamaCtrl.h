@@ -48,6 +48,7 @@
 
 #include <cstdio>
 #include <map>
+#include <vector>
 
 
 class OutputLog;
@@ -169,6 +170,13 @@ public:
 	 */
 	virtual void setRecordFile(std::ostream *event_stream);
 
+	/**
+	 * @brief Set how the Time Plans are laid out in the TTP
+	 *
+	 * @param layout  The TTP layout
+	 */
+	void setTtpLayout(TtpLayout layout);
+
 	/**
 	 * @brief    Get a pointer to the categories
 	 * @warning  the categories can be modified
@@ -178,6 +186,30 @@ public:
 	TerminalCategories<TerminalCategoryDama> *getCategories();
 
 protected:
+	/// Output probes, stats and log context of a carriers group
+	struct CarriersGroupStats
+	{
+		unsigned int carriers_id;
+		/// "carrier <id>, category <label>:", used as log prefix
+		std::string log_context;
+		std::shared_ptr<Probe<int>> probe_return_capacity;
+		std::shared_ptr<Probe<int>> probe_return_remaining_capacity;
+		int return_remaining_capacity;
+	};
+
+	/// Output probes and stats of a category and of its carriers groups
+	struct CategoryStats
+	{
+		std::shared_ptr<TerminalCategoryDama> category;
+		std::shared_ptr<Probe<int>> probe_return_capacity;
+		std::shared_ptr<Probe<int>> probe_return_remaining_capacity;
+		int return_remaining_capacity;
+		/// the stats of all the carriers groups ever seen in the category
+		std::map<unsigned int, CarriersGroupStats> known_carriers;
+		/// the stats of the carriers groups, in the category order
+		std::vector<CarriersGroupStats *> carriers;
+	};
+
 	/**
 	 * @brief 	Init the output probes and stats
 	 *
@@ -185,6 +217,20 @@ protected:
 	 */
 	bool initOutput();
 
+	/**
+	 * @brief  Give each category a dense index, the one of its stats in
+	 *         categories_stats, and create its probes
+	 */
+	void initCategoriesStats();
+
+	/**
+	 * @brief  Make the carriers stats of a category follow its carriers
+	 *         groups, they may be changed by the SVNO interface
+	 *
+	 * @param  stats  the category stats
+	 */
+	void syncCarriersStats(CategoryStats &stats);
+
 	/**
 	 * @brief  Generate a probe for Gw capacity
 	 *
@@ -359,6 +405,9 @@ protected:
 	/** Whethter we used simulated requests */
 	bool simulated;
 
+	/** How the Time Plans are laid out in the TTP */
+	TtpLayout ttp_layout;
+
 	/// if set to other than NULL, the fd where recording events
 	std::ostream* event_file;
 	template<typename Arg, typename... Args>
@@ -366,10 +415,8 @@ protected:
 
 	/// Output probe and stats
 
-	typedef std::map<tal_id_t, std::shared_ptr<Probe<int> > > ProbeListPerTerminal;
-	typedef std::map<std::string, std::shared_ptr<Probe<int> > > ProbeListPerCategory;
-	typedef std::map<unsigned int, std::shared_ptr<Probe<int> > > ProbeListPerCarrier;
-	typedef std::map<std::string, ProbeListPerCarrier> ProbeListPerCategoryPerCarrier;
+	/// Probes indexed by terminal ID, index 0 is used for the simulated terminals
+	typedef std::vector<std::shared_ptr<Probe<int> > > ProbeListPerTerminal;
 
 	/* RBDC request number */
 	std::shared_ptr<Probe<int>> probe_gw_rbdc_req_num;
@@ -417,14 +464,8 @@ protected:
 	std::shared_ptr<Probe<int>> probe_gw_return_total_capacity;
 	std::shared_ptr<Probe<int>> probe_gw_return_remaining_capacity;
 	int gw_remaining_capacity;
-		// Capacity per category
-	ProbeListPerCategory probes_category_return_capacity;
-	ProbeListPerCategory probes_category_return_remaining_capacity;
-	std::map<std::string, int> category_return_remaining_capacity;
-		// Capacity per carrier
-	ProbeListPerCategoryPerCarrier probes_carrier_return_capacity;
-	ProbeListPerCategoryPerCarrier probes_carrier_return_remaining_capacity;
-	std::map<std::string, std::map<unsigned int, int> >  carrier_return_remaining_capacity;
+		// Capacity per category and per carrier, in the categories order
+	std::vector<CategoryStats> categories_stats;
 
 	// Spot ID
 	spot_id_t spot_id;
@@ -92,6 +92,9 @@ bool DamaCtrlRcs2::init()
 		    "Unit converter generation failed.\n");
 		return false;
 	}
+
+	// Output probes and stats
+	this->initCategoriesStats();
 	
 	return true;
 }
@@ -228,7 +231,7 @@ bool DamaCtrlRcs2::buildTTP(Ttp &ttp)
 			}
 		}
 	}
-	ttp.build();
+	ttp.build(this->ttp_layout);
 
 	return true;
 }
@@ -278,7 +281,10 @@ bool DamaCtrlRcs2::applyPepCommand(std::unique_ptr<PepRequest> request)
 		// Output probes and stats
 		this->gw_rbdc_max_kbps += max_rbdc_kbps;
 		this->probe_gw_rbdc_max->put(this->gw_rbdc_max_kbps);
-		this->probes_st_rbdc_max[terminal->getTerminalId()]->put(max_rbdc_kbps);
+		if(terminal->getTerminalId() < BROADCAST_TAL_ID)
+		{
+			this->probes_st_rbdc_max[terminal->getTerminalId()]->put(max_rbdc_kbps);
+		}
 	}
 
 	// inject one RDBC allocation ?
@@ -368,6 +374,7 @@ bool DamaCtrlRcs2::updateWaveForms()
 		tal_id_t tal_id = terminal->getTerminalId();
 		unsigned int required_fmt;
 		unsigned int available_fmt = 0; // not in the table
+		unsigned int previous_carrier_id = terminal->getCarrierId();
 
 		// get the required Fmt for the current terminal
 		FmtDefinition *fmt_def = terminal->getRequiredFmt();
@@ -450,6 +457,11 @@ bool DamaCtrlRcs2::updateWaveForms()
 		}
 		// it will be 0 if the terminal cannot be served
 		terminal->setFmt(&(this->input_modcod_def->getDefinition(available_fmt)));
+
+		if(terminal->getCarrierId() != previous_carrier_id)
+		{
+			category_it->second->invalidateTerminalsTables();
+		}
 	}
 	return true;
 }
@@ -548,6 +560,12 @@ bool DamaCtrlRcs2::resetTerminalsAllocations()
 		}
 	}
 
+	// the allocations are computed on the terminals tables
+	for (auto &&category_it: this->categories)
+	{
+		category_it.second->updateTerminalsTables();
+	}
+
 	return ret;
 }
 
@@ -556,15 +574,18 @@ bool DamaCtrlRcs2::resetCarriersCapacity()
 	rate_symps_t gw_return_total_capacity_symps = 0;
 
 	// Initialize the capacity of carriers
-	for (auto &&category_it: this->categories)
+	for (auto &&stats: this->categories_stats)
 	{
 		rate_symps_t category_return_capacity_symps = 0;
-		std::shared_ptr<TerminalCategoryDama> category = category_it.second;
-		std::string label = category->getLabel();
 
-		for (auto &&carriers: category->getCarriersGroups())
+		// first follow the carriers reallocation with SVNO interface
+		this->syncCarriersStats(stats);
+
+		std::vector<CarriersGroupDama> &carriers_groups = stats.category->getCarriersGroups();
+		for (std::size_t index = 0; index < carriers_groups.size(); ++index)
 		{
-			unsigned int carrier_id = carriers.getCarriersId();
+			CarriersGroupDama &carriers = carriers_groups[index];
+			CarriersGroupStats &carriers_stats = *stats.carriers[index];
 			rate_symps_t remaining_capacity_symps;
 			rate_pktpf_t remaining_capacity_pktpf;
 
@@ -580,33 +601,20 @@ bool DamaCtrlRcs2::resetCarriersCapacity()
 			    "SF#%u: Capacity before DAMA computation for "
 			    "carrier %u: %u packet (per frame) (%u sym/s)\n",
 			    this->current_superframe_sf,
-			    carrier_id,
+			    carriers_stats.carriers_id,
 			    remaining_capacity_pktpf,
 			    remaining_capacity_symps);
 
 			// Output probes and stats
-			// first create probes that don't exist in case of carriers
-			// reallocation with SVNO interface
-			auto &probes_capa = this->probes_carrier_return_capacity[label];
-			if(probes_capa.find(carrier_id) == probes_capa.end())
-			{
-				auto probe = this->generateCarrierCapacityProbe(label, carrier_id, "Available");
-				probes_capa.emplace(carrier_id, probe);
-			}
-			if(this->carrier_return_remaining_capacity[label].find(carrier_id)
-			   == this->carrier_return_remaining_capacity[label].end())
-			{
-				this->carrier_return_remaining_capacity[label].emplace(carrier_id, 0);
-			}
-			probes_capa[carrier_id]->put(remaining_capacity_symps);
+			carriers_stats.probe_return_capacity->put(remaining_capacity_symps);
 			gw_return_total_capacity_symps += remaining_capacity_symps;
 			category_return_capacity_symps += remaining_capacity_symps;
-			this->carrier_return_remaining_capacity[label][carrier_id] = remaining_capacity_symps;
+			carriers_stats.return_remaining_capacity = remaining_capacity_symps;
 		}
 
 		// Output probes and stats
-		this->probes_category_return_capacity[label]->put(category_return_capacity_symps);
-		this->category_return_remaining_capacity[label] = category_return_capacity_symps;
+		stats.probe_return_capacity->put(category_return_capacity_symps);
+		stats.return_remaining_capacity = category_return_capacity_symps;
 	}
 
 	//Output probes and stats
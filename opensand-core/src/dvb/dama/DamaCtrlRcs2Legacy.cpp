@@ -42,7 +42,6 @@
 
 #include <math.h>
 #include <string>
-#include <sstream>
 
 
 /**
@@ -72,7 +71,6 @@ bool DamaCtrlRcs2Legacy::init()
 	for (auto &&category_it: this->categories)
 	{
 		std::shared_ptr<TerminalCategoryDama> category = category_it.second;
-		std::string label = category->getLabel();
 
 		for (auto &&carriers: category->getCarriersGroups())
 		{
@@ -90,27 +88,7 @@ bool DamaCtrlRcs2Legacy::init()
 				    "group for DVB-RCS2 Legacy DAMA\n");
 				return false;
 			}
-			// Output probes and stats
-			std::shared_ptr<Probe<int>> probe_carrier;
-			unsigned int carrier_id = carriers.getCarriersId();
-			probe_carrier = this->generateCarrierCapacityProbe(label, carrier_id, "Available");
-			this->probes_carrier_return_capacity[label].emplace(carrier_id, probe_carrier);
-
-			probe_carrier = this->generateCarrierCapacityProbe(label, carrier_id, "Remaining");
-			this->probes_carrier_return_remaining_capacity[label].emplace(carrier_id, probe_carrier);
-
-			this->carrier_return_remaining_capacity[label].emplace(carrier_id, 0);
 		}
-		// Output probes and stats
-		std::shared_ptr<Probe<int>> probe_category;
-
-		probe_category = this->generateCategoryCapacityProbe(label, "Available");
-		this->probes_category_return_capacity.emplace(label, probe_category);
-
-		probe_category = this->generateCategoryCapacityProbe(label, "Remaining");
-		this->probes_category_return_remaining_capacity.emplace(label, probe_category);
-
-		this->category_return_remaining_capacity.emplace(label, 0);
 	}
 
 	return true;
@@ -122,19 +100,20 @@ bool DamaCtrlRcs2Legacy::computeTerminalsCraAllocation()
 	rate_kbps_t gw_cra_request_kbps = 0;
 
 	this->gw_cra_alloc_kbps = 0;
-	for (auto &&category_it: this->categories)
+	for (auto &&stats: this->categories_stats)
 	{
-		std::shared_ptr<TerminalCategoryDama> category = category_it.second;
+		std::vector<CarriersGroupDama> &carriers_groups = stats.category->getCarriersGroups();
 
 		// we can compute CRA per carriers group because a terminal
 		// is assigned to one on each frame, depending on its DRA
-		for (auto &&carriers: category->getCarriersGroups())
+		for (std::size_t index = 0; index < carriers_groups.size(); ++index)
 		{
 			rate_kbps_t cra_request_kbps = 0;
 			rate_kbps_t cra_alloc_kbps = 0;
 
-			this->computeDamaCraPerCarrier(carriers,
-			                               category,
+			this->computeDamaCraPerCarrier(carriers_groups[index],
+			                               stats,
+			                               *stats.carriers[index],
 				                           cra_request_kbps,
 				                           cra_alloc_kbps);
 			gw_cra_request_kbps += cra_request_kbps;
@@ -156,18 +135,19 @@ bool DamaCtrlRcs2Legacy::computeTerminalsRbdcAllocation()
 	rate_kbps_t gw_rbdc_request_kbps = 0;
 	rate_kbps_t gw_rbdc_alloc_kbps = 0;
 
-	for (auto &&category_it: this->categories)
+	for (auto &&stats: this->categories_stats)
 	{
-		std::shared_ptr<TerminalCategoryDama> category = category_it.second;
+		std::vector<CarriersGroupDama> &carriers_groups = stats.category->getCarriersGroups();
 		// we ca compute RBDC per carriers group because a terminal
 		// is assigned to one on each frame, depending on its DRA
-		for (auto &&carriers: category->getCarriersGroups())
+		for (std::size_t index = 0; index < carriers_groups.size(); ++index)
 		{
 			rate_kbps_t rbdc_request_kbps = 0;
 			rate_kbps_t rbdc_alloc_kbps = 0;
 
-			this->computeDamaRbdcPerCarrier(carriers,
-			                                category,
+			this->computeDamaRbdcPerCarrier(carriers_groups[index],
+			                                stats,
+			                                *stats.carriers[index],
 			                                rbdc_request_kbps,
 			                                rbdc_alloc_kbps);
 			gw_rbdc_request_kbps += rbdc_request_kbps;
@@ -189,16 +169,17 @@ bool DamaCtrlRcs2Legacy::computeTerminalsVbdcAllocation()
 	vol_kb_t gw_vbdc_request_kb = 0;
 	vol_kb_t gw_vbdc_alloc_kb = 0;
 
-	for (auto &&category_it: this->categories)
+	for (auto &&stats: this->categories_stats)
 	{
-		std::shared_ptr<TerminalCategoryDama> category = category_it.second;
-		for (auto &&carriers: category->getCarriersGroups())
+		std::vector<CarriersGroupDama> &carriers_groups = stats.category->getCarriersGroups();
+		for (std::size_t index = 0; index < carriers_groups.size(); ++index)
 		{
 			vol_kb_t vbdc_request_kb = 0;
 			vol_kb_t vbdc_alloc_kb = 0;
 
-			this->computeDamaVbdcPerCarrier(carriers,
-			                                category,
+			this->computeDamaVbdcPerCarrier(carriers_groups[index],
+			                                stats,
+			                                *stats.carriers[index],
 			                                vbdc_request_kb,
 			                                vbdc_alloc_kb);
 			gw_vbdc_request_kb += vbdc_request_kb;
@@ -227,15 +208,16 @@ bool DamaCtrlRcs2Legacy::computeTerminalsFcaAllocation()
 		return true;
 	}
 
-	for (auto &&category_it: this->categories)
+	for (auto &&stats: this->categories_stats)
 	{
-		std::shared_ptr<TerminalCategoryDama> category = category_it.second;
-		for (auto &&carriers: category->getCarriersGroups())
+		std::vector<CarriersGroupDama> &carriers_groups = stats.category->getCarriersGroups();
+		for (std::size_t index = 0; index < carriers_groups.size(); ++index)
 		{
 			rate_kbps_t fca_alloc_kbps = 0;
 
-			this->computeDamaFcaPerCarrier(carriers,
-			                               category,
+			this->computeDamaFcaPerCarrier(carriers_groups[index],
+			                               stats,
+			                               *stats.carriers[index],
 			                               fca_alloc_kbps);
 			gw_fca_alloc_kbps += fca_alloc_kbps;
 		}
@@ -249,82 +231,80 @@ bool DamaCtrlRcs2Legacy::computeTerminalsFcaAllocation()
 }
 
 void DamaCtrlRcs2Legacy::computeDamaCraPerCarrier(CarriersGroupDama &carriers,
-                                                  std::shared_ptr<const TerminalCategoryDama> category,
+                                                  CategoryStats &UNUSED(category_stats),
+                                                  CarriersGroupStats &carriers_stats,
                                                   rate_kbps_t &request_rate_kbps,
                                                   rate_kbps_t &alloc_rate_kbps)
 {
-	std::ostringstream buf;
-	std::string label = category->getLabel();
-	std::string debug;
-
-	unsigned int carrier_id = carriers.getCarriersId();
 	rate_pktpf_t remaining_capacity_pktpf;
 	rate_pktpf_t total_capacity_pktpf;
 	rate_kbps_t simu_cra_kbps = 0;
 
-	buf << "SF#" << this->current_superframe_sf << " carrier "
-	    << carrier_id << ", category " << label << ":";
-	debug = buf.str();
-
 	// Get the remaining capacity in timeslot number (per frame)
 	remaining_capacity_pktpf = carriers.getRemainingCapacity();
 	total_capacity_pktpf = this->converter->symToPkt(carriers.getTotalCapacity());
 
 	LOG(this->log_run_dama, LEVEL_INFO,
-	    "%s remaining capacity = %u packets per superframe before CRA allocation (total: %u packets)\n",
-	    debug.c_str(), remaining_capacity_pktpf, total_capacity_pktpf);
+	    "SF#%u %s remaining capacity = %u packets per superframe before CRA allocation (total: %u packets)\n",
+	    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+	    remaining_capacity_pktpf, total_capacity_pktpf);
 
-	auto tal = category->getTerminalsInCarriersGroup<TerminalContextDamaRcs>(carrier_id);
+	TerminalTableDama &tal = carriers.getTerminals();
 
 	// get total CRA allocation
-	for (auto &&terminal: tal)
+	for(std::size_t row = 0; row < tal.size(); ++row)
 	{
 		FmtDefinition *fmt_def;
 		rate_pktpf_t cra_pktpf;
 		rate_kbps_t cra_kbps;
 
-		tal_id_t tal_id = terminal->getTerminalId();
-		fmt_def = terminal->getFmt();
+		tal_id_t tal_id = tal.getTerminalId(row);
+		fmt_def = tal.getFmt(row);
 		if(fmt_def == nullptr)
 		{
 			continue;
 		}
 		this->converter->setModulationEfficiency(fmt_def->getModulationEfficiency());
 
-		cra_kbps = terminal->getRequiredCra();
+		cra_kbps = tal.getRequiredCra(row);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: CRA %u kb/s",
-		    debug.c_str(), tal_id, cra_kbps);
+		    "SF#%u %s ST%d: CRA %u kb/s",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, cra_kbps);
 
 		request_rate_kbps += cra_kbps;
 
 		cra_kbps = fmt_def->addFec(cra_kbps);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: CRA with FEC %u kb/s",
-		    debug.c_str(), tal_id, cra_kbps);
+		    "SF#%u %s ST%d: CRA with FEC %u kb/s",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, cra_kbps);
 
 		cra_pktpf = this->converter->kbpsToPktpf(cra_kbps);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: CRA %u packets per frame",
-		    debug.c_str(), tal_id, cra_pktpf);
+		    "SF#%u %s ST%d: CRA %u packets per frame",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, cra_pktpf);
 
 		// Evaluate the real requested rate (multiple of the timeslot rate)
 		cra_kbps = this->converter->pktpfToKbps(cra_pktpf);
 		cra_kbps = fmt_def->removeFec(cra_kbps);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: Updated CRA %u kb/s to timeslot use consequence",
-		    debug.c_str(), tal_id, cra_kbps);
+		    "SF#%u %s ST%d: Updated CRA %u kb/s to timeslot use consequence",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, cra_kbps);
 
 		if(remaining_capacity_pktpf < cra_pktpf)
 		{
 			LOG(this->log_run_dama, LEVEL_ERROR,
-			    "%s ST%d: Cannot allocate CRA %u packets per superframe (%u kb/s)\n",
-			    debug.c_str(), tal_id, cra_pktpf, cra_kbps);
+			    "SF#%u %s ST%d: Cannot allocate CRA %u packets per superframe (%u kb/s)\n",
+			    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+			    tal_id, cra_pktpf, cra_kbps);
 			continue;
 		}
 		remaining_capacity_pktpf -= cra_pktpf;
 		alloc_rate_kbps += cra_kbps;
-		terminal->setCraAllocation(cra_kbps);
+		tal.setCraAllocation(row, cra_kbps);
 
 		// Output probes and stats
 		if(tal_id > BROADCAST_TAL_ID)
@@ -343,14 +323,16 @@ void DamaCtrlRcs2Legacy::computeDamaCraPerCarrier(CarriersGroupDama &carriers,
 	}
 
 	LOG(this->log_run_dama, LEVEL_INFO,
-	    "%s remaining capacity = %u packets per superframe after CRA allocation (total: %u packets)\n",
-	    debug.c_str(), remaining_capacity_pktpf, total_capacity_pktpf);
+	    "SF#%u %s remaining capacity = %u packets per superframe after CRA allocation (total: %u packets)\n",
+	    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+	    remaining_capacity_pktpf, total_capacity_pktpf);
 
 	carriers.setRemainingCapacity(remaining_capacity_pktpf);
 }
 
 void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
-                                                   std::shared_ptr<const TerminalCategoryDama> category,
+                                                   CategoryStats &category_stats,
+                                                   CarriersGroupStats &carriers_stats,
                                                    rate_kbps_t &request_rate_kbps,
                                                    rate_kbps_t &alloc_rate_kbps)
 {
@@ -360,24 +342,14 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 	rate_kbps_t rbdc_alloc_kbps;
 	double fair_share;
 	rate_pktpf_t rbdc_alloc_pktpf = 0;
-	unsigned int carrier_id = carriers.getCarriersId();
 	rate_pktpf_t remaining_capacity_pktpf;
 	rate_pktpf_t total_capacity_pktpf;
 	int simu_rbdc = 0;
-	std::ostringstream buf;
-	std::string label = category->getLabel();
-	std::string debug;
-
-	std::map<tal_id_t, rate_pktpf_t> tal_request_pktpf;
 
 	// set default values
 	request_rate_kbps = 0;
 	alloc_rate_kbps = 0;
 
-	buf << "SF#" << this->current_superframe_sf << " carrier "
-	    << carrier_id << ", category " << label << ":";
-	debug = buf.str();
-
 	// Get the remaining capacity in timeslot number (per frame)
 	remaining_capacity_pktpf = carriers.getRemainingCapacity();
 	total_capacity_pktpf = this->converter->symToPkt(carriers.getTotalCapacity());
@@ -385,50 +357,55 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 	if(remaining_capacity_pktpf == 0)
 	{
 		LOG(this->log_run_dama, LEVEL_INFO,
-		    "%s skipping RBDC allocation: Not enough "
-		    "capacity\n", debug.c_str());
+		    "SF#%u %s skipping RBDC allocation: Not enough "
+		    "capacity\n", this->current_superframe_sf, carriers_stats.log_context.c_str());
 		return;
 	}
 
 	LOG(this->log_run_dama, LEVEL_INFO,
-	    "%s remaining capacity = %u packets per superframe before RBDC allocation (total: %u packets)\n",
-	    debug.c_str(), remaining_capacity_pktpf, total_capacity_pktpf);
+	    "SF#%u %s remaining capacity = %u packets per superframe before RBDC allocation (total: %u packets)\n",
+	    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+	    remaining_capacity_pktpf, total_capacity_pktpf);
 
-	auto tal = category->getTerminalsInCarriersGroup<TerminalContextDamaRcs>(carrier_id);
+	TerminalTableDama &tal = carriers.getTerminals();
 
 	// get total RBDC requests
-	for (auto &&terminal: tal)
+	for(std::size_t row = 0; row < tal.size(); ++row)
 	{
-		tal_id_t tal_id = terminal->getTerminalId();
-		FmtDefinition *fmt_def = terminal->getFmt();
+		tal_id_t tal_id = tal.getTerminalId(row);
+		FmtDefinition *fmt_def = tal.getFmt(row);
 		if(fmt_def == nullptr)
 		{
 			continue;
 		}
 		this->converter->setModulationEfficiency(fmt_def->getModulationEfficiency());
 
-		request_kbps = terminal->getRequiredRbdc();
+		request_kbps = tal.getRequiredRbdc(row);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: RBDC request %u kb/s",
-		    debug.c_str(), tal_id, request_kbps);
+		    "SF#%u %s ST%d: RBDC request %u kb/s",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, request_kbps);
 
 		request_kbps = fmt_def->addFec(request_kbps);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: RBDC request with FEC %u kb/s",
-		    debug.c_str(), tal_id, request_kbps);
+		    "SF#%u %s ST%d: RBDC request with FEC %u kb/s",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, request_kbps);
 
 		request_pktpf = this->converter->kbpsToPktpf(request_kbps);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: RBDC request %u packets per frame",
-		    debug.c_str(), tal_id, request_pktpf);
-		tal_request_pktpf[tal_id] = request_pktpf;
+		    "SF#%u %s ST%d: RBDC request %u packets per frame",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, request_pktpf);
+		tal.requestPktpf(row) = request_pktpf;
 
 		// Evaluate the real requested rate (multiple of the timeslot rate)
 		request_kbps = this->converter->pktpfToKbps(request_pktpf);
 		request_kbps = fmt_def->removeFec(request_kbps);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: Updated RBDC request %u kb/s to timeslot use consequence",
-		    debug.c_str(), tal_id, request_kbps);
+		    "SF#%u %s ST%d: Updated RBDC request %u kb/s to timeslot use consequence",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, request_kbps);
 
 		total_request_pktpf += request_pktpf;
 
@@ -443,12 +420,12 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 	if(total_request_pktpf == 0)
 	{
 		LOG(this->log_run_dama, LEVEL_INFO,
-		    "%s no RBDC request for this frame.\n", debug.c_str());
+		    "SF#%u %s no RBDC request for this frame.\n", this->current_superframe_sf, carriers_stats.log_context.c_str());
 
 		// Output stats and probes
-		for (auto &&terminal: tal)
+		for(std::size_t row = 0; row < tal.size(); ++row)
 		{
-			tal_id_t tal_id = terminal->getTerminalId();
+			tal_id_t tal_id = tal.getTerminalId(row);
 			if(tal_id < BROADCAST_TAL_ID)
 			{
 				this->probes_st_rbdc_alloc[tal_id]->put(0);
@@ -473,19 +450,19 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 	}
 
 	LOG(this->log_run_dama, LEVEL_INFO,
-	    "%s: sum of all RBDC requests = %u packets per superframe, "
-	    "fair share=%f\n", debug.c_str(),
+	    "SF#%u %s: sum of all RBDC requests = %u packets per superframe, "
+	    "fair share=%f\n", this->current_superframe_sf, carriers_stats.log_context.c_str(),
 	    total_request_pktpf, fair_share);
 
 	// first step : serve the integer part of the fair RBDC
 	alloc_rate_kbps = 0;
-	for (auto &&terminal: tal)
+	for(std::size_t row = 0; row < tal.size(); ++row)
 	{
 		rate_symps_t rbdc_alloc_symps;
 		double fair_rbdc_pktpf;
 
-		tal_id_t tal_id = terminal->getTerminalId();
-		FmtDefinition *fmt_def = terminal->getFmt();
+		tal_id_t tal_id = tal.getTerminalId(row);
+		FmtDefinition *fmt_def = tal.getFmt(row);
 		if(fmt_def == nullptr)
 		{
 			if(tal_id <= BROADCAST_TAL_ID)
@@ -497,26 +474,29 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 		this->converter->setModulationEfficiency(fmt_def->getModulationEfficiency());
 
 		// apply the fair share coef to all requests
-		request_pktpf = tal_request_pktpf[tal_id];
+		request_pktpf = tal.requestPktpf(row);
 		fair_rbdc_pktpf = (double) (request_pktpf / fair_share);
 
 		// take the integer part of fair RBDC
 		rbdc_alloc_pktpf = floor(fair_rbdc_pktpf);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: RBDC allocation %u packets per frame",
-		    debug.c_str(), tal_id, rbdc_alloc_pktpf);
+		    "SF#%u %s ST%d: RBDC allocation %u packets per frame",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, rbdc_alloc_pktpf);
 
 		rbdc_alloc_kbps = this->converter->pktpfToKbps(rbdc_alloc_pktpf);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: RBDC allocation with FEC %u kb/s",
-		    debug.c_str(), tal_id, rbdc_alloc_kbps);
+		    "SF#%u %s ST%d: RBDC allocation with FEC %u kb/s",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, rbdc_alloc_kbps);
 
 		rbdc_alloc_kbps = fmt_def->removeFec(rbdc_alloc_kbps);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%d: RBDC allocation %u kb/s",
-		    debug.c_str(), tal_id, rbdc_alloc_kbps);
+		    "SF#%u %s ST%d: RBDC allocation %u kb/s",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, rbdc_alloc_kbps);
 
-		terminal->setRbdcAllocation(rbdc_alloc_kbps);
+		tal.setRbdcAllocation(row, rbdc_alloc_kbps);
 		alloc_rate_kbps += rbdc_alloc_kbps;
 
 		// decrease the total capacity
@@ -532,8 +512,8 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 			this->probes_st_rbdc_alloc[tal_id]->put(rbdc_alloc_kbps);
 		}
 		rbdc_alloc_symps = this->converter->pktpfToSymps(rbdc_alloc_pktpf);
-		this->carrier_return_remaining_capacity[label][carrier_id] -= rbdc_alloc_symps;
-		this->category_return_remaining_capacity[label] -= rbdc_alloc_symps;
+		carriers_stats.return_remaining_capacity -= rbdc_alloc_symps;
+		category_stats.return_remaining_capacity -= rbdc_alloc_symps;
 		this->gw_remaining_capacity -= rbdc_alloc_symps;
 
 		if(fair_share > 1.0)
@@ -543,11 +523,11 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 				* this->converter->getPacketBitLength()
 				/ (double)(this->converter->getFrameDuration().count());
 			rbdc_credit_kbps /= (fmt_def->getCodingRate());
-			terminal->addRbdcCredit(rbdc_credit_kbps);
+			tal.addRbdcCredit(row, rbdc_credit_kbps);
 
 			LOG(this->log_run_dama, LEVEL_DEBUG,
-				"%s ST%u: RBDC credit %u kb/s\n",
-				debug.c_str(), tal_id, rbdc_credit_kbps);
+				"SF#%u %s ST%u: RBDC credit %u kb/s\n",
+				this->current_superframe_sf, carriers_stats.log_context.c_str(), tal_id, rbdc_credit_kbps);
 		}
 	}
 	if(this->simulated)
@@ -558,20 +538,16 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 	// second step : RBDC decimal part treatment
 	if(fair_share > 1.0)
 	{
-		// sort terminal according to their remaining credit
-		std::stable_sort(tal.begin(), tal.end(),
-		                 TerminalContextDamaRcs::sortByRemainingCredit);
-		for (auto &&terminal: tal)
+		// serve terminals according to their remaining credit
+		std::size_t row;
+		tal.startCreditOrder();
+		while(0 < remaining_capacity_pktpf && tal.popHighestCredit(row))
 		{
-			if (remaining_capacity_pktpf <= 0)
-			{
-				break;
-			}
 			rate_kbps_t slot_kbps;
 			double credit_kbps;
 
-			tal_id_t tal_id = terminal->getTerminalId();
-			FmtDefinition *fmt_def = terminal->getFmt();
+			tal_id_t tal_id = tal.getTerminalId(row);
+			FmtDefinition *fmt_def = tal.getFmt(row);
 			if(fmt_def == nullptr)
 			{
 				continue;
@@ -579,10 +555,10 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 			this->converter->setModulationEfficiency(fmt_def->getModulationEfficiency());
 
 			slot_kbps = fmt_def->removeFec(this->converter->pktpfToKbps(1));
-			credit_kbps = terminal->getRbdcCredit();
+			credit_kbps = tal.getRbdcCredit(row);
 			LOG(this->log_run_dama, LEVEL_DEBUG,
-			    "%s step 2 scanning ST%u remaining capacity=%u packet "
-			    "credit=%f packet\n", debug.c_str(),
+			    "SF#%u %s step 2 scanning ST%u remaining capacity=%u packet "
+			    "credit=%f packet\n", this->current_superframe_sf, carriers_stats.log_context.c_str(),
 			    tal_id, remaining_capacity_pktpf,
 			    credit_kbps / slot_kbps);
 			if(credit_kbps > slot_kbps)
@@ -590,25 +566,26 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 				rate_kbps_t cra_kbps;
 				rate_kbps_t max_rbdc_kbps;
 
-				max_rbdc_kbps = terminal->getMaxRbdc();
-				cra_kbps = terminal->getCraAllocation();
-				rbdc_alloc_kbps = terminal->getRbdcAllocation();
+				max_rbdc_kbps = tal.getMaxRbdc(row);
+				cra_kbps = tal.getCraAllocation(row);
+				rbdc_alloc_kbps = tal.getRbdcAllocation(row);
 
 				if(max_rbdc_kbps - rbdc_alloc_kbps - cra_kbps > slot_kbps)
 				{
 					rate_symps_t slot_symps;
 					// enough capacity to allocate
-					terminal->setRbdcAllocation(rbdc_alloc_kbps + slot_kbps);
-					terminal->addRbdcCredit(-slot_kbps);
+					tal.setRbdcAllocation(row, rbdc_alloc_kbps + slot_kbps);
+					tal.addRbdcCredit(row, -slot_kbps);
 					alloc_rate_kbps += slot_kbps;
 					remaining_capacity_pktpf--;
 					LOG(this->log_run_dama, LEVEL_DEBUG,
-					    "%s step 2 allocating 1 timeslot to ST%u\n",
-					    debug.c_str(), tal_id);
+					    "SF#%u %s step 2 allocating 1 timeslot to ST%u\n",
+					    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+					    tal_id);
 					// Update probes and stats
 					slot_symps = this->converter->pktpfToSymps(1);
-					this->carrier_return_remaining_capacity[label][carrier_id] -= slot_symps;
-					this->category_return_remaining_capacity[label] -= slot_symps;
+					carriers_stats.return_remaining_capacity -= slot_symps;
+					category_stats.return_remaining_capacity -= slot_symps;
 					this->gw_remaining_capacity -= slot_symps;
 				}
 			}
@@ -616,47 +593,41 @@ void DamaCtrlRcs2Legacy::computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
 	}
 
 	LOG(this->log_run_dama, LEVEL_INFO,
-	    "%s remaining capacity = %u packets per superframe after RBDC allocation (total: %u packets)\n",
-	    debug.c_str(), remaining_capacity_pktpf, total_capacity_pktpf);
+	    "SF#%u %s remaining capacity = %u packets per superframe after RBDC allocation (total: %u packets)\n",
+	    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+	    remaining_capacity_pktpf, total_capacity_pktpf);
 
 	carriers.setRemainingCapacity(remaining_capacity_pktpf);
 }
 
 void DamaCtrlRcs2Legacy::computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
-                                                   std::shared_ptr<const TerminalCategoryDama> category,
+                                                   CategoryStats &category_stats,
+                                                   CarriersGroupStats &carriers_stats,
                                                    vol_kb_t &request_vol_kb,
                                                    vol_kb_t &alloc_vol_kb)
 {
-	unsigned int carrier_id = carriers.getCarriersId();
 	rate_pktpf_t remaining_capacity_pktpf;
 	rate_pktpf_t total_capacity_pktpf;
 	int simu_vbdc = 0;
-	std::ostringstream buf;
-	std::string label = category->getLabel();
-	std::string debug;
 
 	request_vol_kb = 0;
 	alloc_vol_kb = 0;
 
-	buf << "SF#" << this->current_superframe_sf << " carrier "
-	    << carrier_id << ", category " << label << ":";
-	debug = buf.str();
-
 	// Get the remaining capacity in timeslot number (per frame)
 	remaining_capacity_pktpf = carriers.getRemainingCapacity();
 	total_capacity_pktpf = this->converter->symToPkt(carriers.getTotalCapacity());
 
-	auto tal = category->getTerminalsInCarriersGroup<TerminalContextDamaRcs>(carrier_id);
+	TerminalTableDama &tal = carriers.getTerminals();
 	if(remaining_capacity_pktpf == 0)
 	{
 		LOG(this->log_run_dama, LEVEL_NOTICE,
-		    "%s skipping VBDC dama computation: Not enough "
-		    "capacity\n", debug.c_str());
+		    "SF#%u %s skipping VBDC dama computation: Not enough "
+		    "capacity\n", this->current_superframe_sf, carriers_stats.log_context.c_str());
 
 		// Output stats and probes
-		for (auto &&terminal: tal)
+		for(std::size_t row = 0; row < tal.size(); ++row)
 		{
-			tal_id_t tal_id = terminal->getTerminalId();
+			tal_id_t tal_id = tal.getTerminalId(row);
 			if(tal_id < BROADCAST_TAL_ID)
 			{
 				this->probes_st_vbdc_alloc[tal_id]->put(0);
@@ -671,8 +642,9 @@ void DamaCtrlRcs2Legacy::computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
 	}
 
 	LOG(this->log_run_dama, LEVEL_INFO,
-	    "%s remaining capacity = %u packets per superframe before VBDC allocation (total: %u packets)\n",
-	    debug.c_str(), remaining_capacity_pktpf, total_capacity_pktpf);
+	    "SF#%u %s remaining capacity = %u packets per superframe before VBDC allocation (total: %u packets)\n",
+	    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+	    remaining_capacity_pktpf, total_capacity_pktpf);
 
 	if(tal.empty())
 	{
@@ -682,11 +654,10 @@ void DamaCtrlRcs2Legacy::computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
 
 	// try to serve the required VBDC
 	// the setVbdcAllocation functions had updated the VBDC requests
-	// sort terminal according to their new VBDC requests
-	decltype(tal)::iterator tal_it;
-	std::stable_sort(tal.begin(), tal.end(),
-	                 TerminalContextDamaRcs::sortByVbdcReq);
-	for(tal_it = tal.begin(); tal_it != tal.end() && 0 < remaining_capacity_pktpf; ++tal_it)
+	// serve terminals according to their new VBDC requests, the
+	// terminals without request are not visited
+	std::size_t row;
+	while(0 < remaining_capacity_pktpf && tal.popHighestVbdcReq(row))
 	{
 		vol_kb_t request_kb;
 		vol_pkt_t request_pkt;
@@ -695,9 +666,8 @@ void DamaCtrlRcs2Legacy::computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
 		rate_symps_t alloc_symps;
 		FmtDefinition *fmt_def;
 
-		auto terminal = *tal_it;
-		tal_id_t tal_id = terminal->getTerminalId();
-		fmt_def = terminal->getFmt();
+		tal_id_t tal_id = tal.getTerminalId(row);
+		fmt_def = tal.getFmt(row);
 		if(fmt_def == nullptr)
 		{
 			// Output probes and stats
@@ -709,20 +679,23 @@ void DamaCtrlRcs2Legacy::computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
 		}
 		this->converter->setModulationEfficiency(fmt_def->getModulationEfficiency());
 
-		request_kb = terminal->getRequiredVbdc();
+		request_kb = tal.getRequiredVbdc(row);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%u: VBDC request %u kb",
-		    debug.c_str(), tal_id, request_kb);
+		    "SF#%u %s ST%u: VBDC request %u kb",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, request_kb);
 
 		request_kb = fmt_def->addFec(request_kb);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%u: VBDC request with FEC %u kb",
-		    debug.c_str(), tal_id, request_kb);
+		    "SF#%u %s ST%u: VBDC request with FEC %u kb",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, request_kb);
 
 		request_pkt = this->converter->kbitsToPkt(request_kb);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%u: VBDC request %u packets",
-		    debug.c_str(), tal_id, request_pkt);
+		    "SF#%u %s ST%u: VBDC request %u packets",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, request_pkt);
 
 		if(request_pkt <= 0)
 		{
@@ -742,21 +715,24 @@ void DamaCtrlRcs2Legacy::computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
 			alloc_pkt = remaining_capacity_pktpf;
 		}
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%u: VBDC allocation %u packets",
-		    debug.c_str(), tal_id, alloc_pkt);
+		    "SF#%u %s ST%u: VBDC allocation %u packets",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, alloc_pkt);
 		remaining_capacity_pktpf -= alloc_pkt;
 
 		alloc_kb = this->converter->pktToKbits(alloc_pkt);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%u: VBDC allocation with FEC %u kb",
-		    debug.c_str(), tal_id, alloc_kb);
+		    "SF#%u %s ST%u: VBDC allocation with FEC %u kb",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, alloc_kb);
 
 		alloc_kb = fmt_def->removeFec(alloc_kb);
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%u: VBDC allocation %u kb",
-		    debug.c_str(), tal_id, alloc_kb);
+		    "SF#%u %s ST%u: VBDC allocation %u kb",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, alloc_kb);
 
-		terminal->setVbdcAllocation(alloc_kb);
+		tal.setVbdcAllocation(row, alloc_kb);
 		alloc_vol_kb += alloc_kb;
 
 		// Output probes and stats
@@ -769,8 +745,8 @@ void DamaCtrlRcs2Legacy::computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
 			this->probes_st_vbdc_alloc[tal_id]->put(alloc_kb);
 		}
 		alloc_symps = this->converter->pktpfToSymps(alloc_pkt);
-		this->carrier_return_remaining_capacity[label][carrier_id] -= alloc_symps;
-		this->category_return_remaining_capacity[label] -= alloc_symps;
+		carriers_stats.return_remaining_capacity -= alloc_symps;
+		category_stats.return_remaining_capacity -= alloc_symps;
 		this->gw_remaining_capacity -= alloc_symps;
 	}
 
@@ -780,21 +756,14 @@ void DamaCtrlRcs2Legacy::computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
 	}
 
 	// Check if other terminals required capacity
-	for(; tal_it != tal.end(); ++tal_it)
-	{
-		vol_kb_t request_kb;
-		auto terminal = *tal_it;
-		request_kb = terminal->getRequiredVbdc();
-		if(request_kb > 0)
-		{
-			request_vol_kb += request_kb;
-			this->gw_vbdc_req_num++;
-		}
-	}
+	request_vol_kb += tal.getQueuedVbdcReq();
+	this->gw_vbdc_req_num += tal.getQueuedVbdcReqCount();
+	tal.restoreVbdcOrder();
 
 	LOG(this->log_run_dama, LEVEL_INFO,
-	    "%s remaining capacity = %u packets per superframe after VBDC allocation (total: %u packets)\n",
-	    debug.c_str(), remaining_capacity_pktpf, total_capacity_pktpf);
+	    "SF#%u %s remaining capacity = %u packets per superframe after VBDC allocation (total: %u packets)\n",
+	    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+	    remaining_capacity_pktpf, total_capacity_pktpf);
 
 	carriers.setRemainingCapacity(remaining_capacity_pktpf);
 }
@@ -804,27 +773,19 @@ void DamaCtrlRcs2Legacy::computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
 //      (in the same category and with supported MODCOD value) in which there
 //      is still capacity
 void DamaCtrlRcs2Legacy::computeDamaFcaPerCarrier(CarriersGroupDama &carriers,
-                                                  std::shared_ptr<const TerminalCategoryDama> category,
+                                                  CategoryStats &category_stats,
+                                                  CarriersGroupStats &carriers_stats,
                                                   rate_kbps_t &alloc_rate_kbps)
 {
-	unsigned int carrier_id = carriers.getCarriersId();
 	rate_pktpf_t remaining_capacity_pktpf;
 	rate_pktpf_t total_capacity_pktpf;
 	rate_pktpf_t fca_pktpf;
 	int simu_fca = 0;
-	std::ostringstream buf;
-	std::string label = category->getLabel();
-	std::string debug;
 
 	alloc_rate_kbps = 0;
 
-	buf << "SF#" << this->current_superframe_sf << " carrier "
-	    << carrier_id << ", category " << label << ":";
-	debug = buf.str();
-
-	auto tal = category->getTerminalsInCarriersGroup<TerminalContextDamaRcs>(carrier_id);
-	auto tal_it = tal.begin();
-	if(tal_it == tal.end())
+	TerminalTableDama &tal = carriers.getTerminals();
+	if(tal.empty())
 	{
 		// no ST
 		return;
@@ -837,14 +798,13 @@ void DamaCtrlRcs2Legacy::computeDamaFcaPerCarrier(CarriersGroupDama &carriers,
 	{
 		// Be careful to use probes only if FCA is enabled
 		// Output probes and stats
-		while(tal_it != tal.end())
+		for(std::size_t row = 0; row < tal.size(); ++row)
 		{
-			tal_id_t tal_id = (*tal_it)->getTerminalId();
+			tal_id_t tal_id = tal.getTerminalId(row);
 			if(tal_id < BROADCAST_TAL_ID)
 			{
 				this->probes_st_fca_alloc[tal_id]->put(0);
 			}
-			tal_it++;
 		}
 		if(this->simulated)
 		{
@@ -852,27 +812,26 @@ void DamaCtrlRcs2Legacy::computeDamaFcaPerCarrier(CarriersGroupDama &carriers,
 		}
 
 		LOG(this->log_run_dama, LEVEL_NOTICE,
-		    "%s skipping FCA dama computaiton. Not enough "
-		    "capacity\n", debug.c_str());
+		    "SF#%u %s skipping FCA dama computaiton. Not enough "
+		    "capacity\n", this->current_superframe_sf, carriers_stats.log_context.c_str());
 		return;
 	}
 
 	LOG(this->log_run_dama, LEVEL_INFO,
-	    "%s remaining capacity = %u packets per superframe before FCA allocation (total: %u packets)\n",
-	    debug.c_str(), remaining_capacity_pktpf, total_capacity_pktpf);
+	    "SF#%u %s remaining capacity = %u packets per superframe before FCA allocation (total: %u packets)\n",
+	    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+	    remaining_capacity_pktpf, total_capacity_pktpf);
 
-	// sort terminal according to their remaining credit
+	// serve terminals according to their remaining credit
 	// this is a random but logical choice
-	std::stable_sort(tal.begin(), tal.end(),
-	                 TerminalContextDamaRcs::sortByRemainingCredit);
-
-	while(tal_it != tal.end() && 0 < remaining_capacity_pktpf)
+	std::size_t row;
+	tal.startCreditOrder();
+	while(0 < remaining_capacity_pktpf && tal.popHighestCredit(row))
 	{
 		rate_pktpf_t fca_alloc_pktpf;
 		rate_kbps_t fca_alloc_kbps;
-		auto terminal = *tal_it;
-		tal_id_t tal_id = terminal->getTerminalId();
-		FmtDefinition *fmt_def = terminal->getFmt();
+		tal_id_t tal_id = tal.getTerminalId(row);
+		FmtDefinition *fmt_def = tal.getFmt(row);
 		if(fmt_def == nullptr)
 		{
 			continue;
@@ -890,14 +849,16 @@ void DamaCtrlRcs2Legacy::computeDamaFcaPerCarrier(CarriersGroupDama &carriers,
 			remaining_capacity_pktpf = 0;
 		}
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%u: FCA alloc %u packets per superframe",
-		    debug.c_str(), tal_id, fca_alloc_pktpf);
+		    "SF#%u %s ST%u: FCA alloc %u packets per superframe",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, fca_alloc_pktpf);
 
 		fca_alloc_kbps = fmt_def->removeFec(this->converter->pktpfToKbps(fca_alloc_pktpf));
 		LOG(this->log_run_dama, LEVEL_DEBUG,
-		    "%s ST%u: FCA alloc %u kb/s",
-		    debug.c_str(), tal_id, fca_alloc_kbps);
-		terminal->setFcaAllocation(fca_alloc_kbps);
+		    "SF#%u %s ST%u: FCA alloc %u kb/s",
+		    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+		    tal_id, fca_alloc_kbps);
+		tal.setFcaAllocation(row, fca_alloc_kbps);
 		alloc_rate_kbps += fca_alloc_kbps;
 
 		// Output probes and stats
@@ -909,11 +870,9 @@ void DamaCtrlRcs2Legacy::computeDamaFcaPerCarrier(CarriersGroupDama &carriers,
 		{
 			this->probes_st_fca_alloc[tal_id]->put(fca_alloc_kbps);
 		}
-		this->carrier_return_remaining_capacity[label][carrier_id] -= fca_alloc_kbps;
-		this->category_return_remaining_capacity[label] -= fca_alloc_kbps;
+		carriers_stats.return_remaining_capacity -= fca_alloc_kbps;
+		category_stats.return_remaining_capacity -= fca_alloc_kbps;
 		this->gw_remaining_capacity -= fca_alloc_kbps;
-
-		tal_it++;
 	}
 	if(this->simulated)
 	{
@@ -921,8 +880,9 @@ void DamaCtrlRcs2Legacy::computeDamaFcaPerCarrier(CarriersGroupDama &carriers,
 	}
 
 	LOG(this->log_run_dama, LEVEL_INFO,
-	    "%s remaining capacity = %u packets per superframe after FCA allocation (total: %u packets)\n",
-	    debug.c_str(), remaining_capacity_pktpf, total_capacity_pktpf);
+	    "SF#%u %s remaining capacity = %u packets per superframe after FCA allocation (total: %u packets)\n",
+	    this->current_superframe_sf, carriers_stats.log_context.c_str(),
+	    remaining_capacity_pktpf, total_capacity_pktpf);
 
 	carriers.setRemainingCapacity(remaining_capacity_pktpf);
 }
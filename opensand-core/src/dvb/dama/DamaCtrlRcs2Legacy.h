@@ -74,12 +74,14 @@ private:
 	 * @brief Compute CRA per carriers group
 	 *
 	 * @param carriers           The carrier group
-	 * @param category           The terminal category containing the carrier
+	 * @param category_stats     The stats of the category containing the carrier
+	 * @param carriers_stats     The stats of the carrier group
 	 * @param request_rate_kbps  The requested rate in kbit/s
 	 * @param alloc_rate_kbps    The allocated rate in kbit/s
 	 */
 	void computeDamaCraPerCarrier(CarriersGroupDama &carriers,
-	                              std::shared_ptr<const TerminalCategoryDama> category,
+	                              CategoryStats &category_stats,
+	                              CarriersGroupStats &carriers_stats,
 	                              rate_kbps_t &request_rate_kbps,
 	                              rate_kbps_t &alloc_rate_kbps);
 
@@ -87,12 +89,14 @@ private:
 	 * @brief Compute RBDC per carriers group
 	 *
 	 * @param carriers           The carrier group
-	 * @param category           The terminal category containing the carrier
+	 * @param category_stats     The stats of the category containing the carrier
+	 * @param carriers_stats     The stats of the carrier group
 	 * @param request_rate_kbps  The requested rate in kbit/s
 	 * @param alloc_rate_kbps    The allocated rate in kbit/s
 	 */
 	void computeDamaRbdcPerCarrier(CarriersGroupDama &carriers,
-	                               std::shared_ptr<const TerminalCategoryDama> category,
+	                               CategoryStats &category_stats,
+	                               CarriersGroupStats &carriers_stats,
 	                               rate_kbps_t &request_rate_kbps,
 	                               rate_kbps_t &alloc_rate_kbps);
 
@@ -100,12 +104,14 @@ private:
 	 * @brief Compute VBDC per carriers group
 	 *
 	 * @param carriers        The carrier group
-	 * @param category        The terminal category containing the carrier
+	 * @param category_stats  The stats of the category containing the carrier
+	 * @param carriers_stats  The stats of the carrier group
 	 * @param request_vol_kb  The requested volume in kbit
 	 * @param alloc_vol_kb    The allocated volume in kbit
 	 */
 	void computeDamaVbdcPerCarrier(CarriersGroupDama &carriers,
-	                               std::shared_ptr<const TerminalCategoryDama> category,
+	                               CategoryStats &category_stats,
+	                               CarriersGroupStats &carriers_stats,
 	                               vol_kb_t &request_vol_kb,
 	                               vol_kb_t &alloc_vol_kb);
 
@@ -113,11 +119,13 @@ private:
 	 * @brief Compute FCA per carriers group
 	 *
 	 * @param carriers           The carrier group
-	 * @param category           The terminal category containing the carrier
+	 * @param category_stats     The stats of the category containing the carrier
+	 * @param carriers_stats     The stats of the carrier group
 	 * @param alloc_rate_kbps    The allocated rate in kbit/s
 	 */
 	void computeDamaFcaPerCarrier(CarriersGroupDama &carriers,
-	                              std::shared_ptr<const TerminalCategoryDama> category,
+	                              CategoryStats &category_stats,
+	                              CarriersGroupStats &carriers_stats,
 	                              rate_kbps_t &alloc_rate_kbps);
 
 };
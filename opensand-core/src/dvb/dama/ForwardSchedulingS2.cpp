@@ -37,6 +37,7 @@
 
 
 #include <opensand_output/Output.h>
+#include <limits>
 
 #include "ForwardSchedulingS2.h"
 #include "DvbFifo.h"
@@ -98,7 +99,9 @@ ForwardSchedulingS2::ForwardSchedulingS2(time_us_t fwd_timer,
 	Scheduling(packet_handler, fifos, fwd_sts),
 	fwd_timer(fwd_timer),
 	incomplete_bb_frames(),
-	incomplete_bb_frames_ordered(),
+	incomplete_bb_frames_count(0),
+	eligible_fifos(),
+	eligible_carriers_ids(),
 	pending_bbframes(),
 	fwd_modcod_def(fwd_modcod_def),
 	category(category),
@@ -128,6 +131,17 @@ ForwardSchedulingS2::ForwardSchedulingS2(time_us_t fwd_timer,
 	                                                        "modcod index",
 	                                                        true, SAMPLE_LAST);
 
+	// one slot per MODCOD, the slot 0 is the head of the created order chain
+	this->incomplete_bb_frames.reserve(std::numeric_limits<fmt_id_t>::max() + 1);
+	for(unsigned int modcod_id = 0;
+	    modcod_id <= std::numeric_limits<fmt_id_t>::max();
+	    ++modcod_id)
+	{
+		this->incomplete_bb_frames.push_back({Rt::make_ptr<BBFrame>(nullptr), 0, 0});
+	}
+
+	this->updateEligibleFifos();
+
 	for (auto &&carriers: this->category->getCarriersGroups())
 	{
 		std::vector<std::shared_ptr<Probe<int>>> remain_probes;
@@ -147,40 +161,38 @@ ForwardSchedulingS2::ForwardSchedulingS2(time_us_t fwd_timer,
 
 ForwardSchedulingS2::~ForwardSchedulingS2()
 {
-	this->incomplete_bb_frames_ordered.clear();
 	this->incomplete_bb_frames.clear();
 	this->pending_bbframes.clear();
 }
 
 
-bool ForwardSchedulingS2::schedule(const time_sf_t current_superframe_sf,
-                                   std::list<Rt::Ptr<DvbFrame>> &complete_dvb_frames,
-                                   uint32_t &remaining_allocation)
+void ForwardSchedulingS2::updateEligibleFifos()
 {
-	vol_sym_t init_capacity_sym;
-	int total_capa = 0;
+	auto &carriers_group = this->category->getCarriersGroups();
 
-	auto& carriers_group = this->category->getCarriersGroups();
-	for (auto&& carriers : carriers_group)
+	bool up_to_date = (carriers_group.size() == this->eligible_carriers_ids.size());
+	for(std::size_t index = 0; up_to_date && index < carriers_group.size(); ++index)
+	{
+		up_to_date = (carriers_group[index].getCarriersId() == this->eligible_carriers_ids[index] &&
+		              carriers_group[index].getVcmCarriers().size() == this->eligible_fifos[index].size());
+	}
+	if(up_to_date)
+	{
+		return;
+	}
+
+	this->eligible_fifos.clear();
+	this->eligible_carriers_ids.clear();
+	for(auto &&carriers: carriers_group)
 	{
-		unsigned int vcm_id = 0;
 		auto &vcm_carriers = carriers.getVcmCarriers();
+		std::vector<std::vector<DvbFifo *>> &carriers_fifos = this->eligible_fifos.emplace_back();
+		this->eligible_carriers_ids.push_back(carriers.getCarriersId());
+
 		// if no VCM, getVcm() will return only one carrier
-		for(auto&& vcm : vcm_carriers)
+		for(unsigned int vcm_id = 0; vcm_id < vcm_carriers.size(); ++vcm_id)
 		{
-			vol_sym_t capacity_sym;
-			vol_sym_t previous_sym;
-
-			// initialize carriers capacity, remaining capacity should be 0
-			// as we use previous capacity to keep track of unused capacity here
-			init_capacity_sym = vcm.getTotalCapacity() + vcm.getRemainingCapacity();
-			vcm.setRemainingCapacity(init_capacity_sym);
-			total_capa += init_capacity_sym;
-
-			capacity_sym = init_capacity_sym;
-			previous_sym = vcm.getPreviousCapacity(current_superframe_sf);
-			capacity_sym += previous_sym;
-
+			std::vector<DvbFifo *> &vcm_fifos = carriers_fifos.emplace_back();
 			for(auto&& [_key, fifo] : *(this->dvb_fifos))
 			{
 				// check if the FIFO can emit on this carriers group
@@ -190,9 +202,8 @@ bool ForwardSchedulingS2::schedule(const time_sf_t current_superframe_sf,
 					if(fifo->getAccessType() != ForwardOrReturnAccessType{ForwardAccessType::acm})
 					{
 						LOG(this->log_scheduling, LEVEL_DEBUG,
-						    "SF#%u: Ignore carriers with id %u in category %s "
+						    "Ignore carriers with id %u in category %s "
 						    "for non-ACM fifo %s\n",
-						    current_superframe_sf,
 						    carriers.getCarriersId(),
 						    this->category->getLabel().c_str(),
 						    fifo->getName());
@@ -205,9 +216,8 @@ bool ForwardSchedulingS2::schedule(const time_sf_t current_superframe_sf,
 					if(fifo->getAccessType() != ForwardOrReturnAccessType{ForwardAccessType::vcm})
 					{
 						LOG(this->log_scheduling, LEVEL_DEBUG,
-						    "SF#%u: Ignore carriers with id %u in category %s "
+						    "Ignore carriers with id %u in category %s "
 						    "for non-VCM fifo %s\n",
-						    current_superframe_sf,
 						    carriers.getCarriersId(),
 						    this->category->getLabel().c_str(),
 						    fifo->getName());
@@ -219,12 +229,80 @@ bool ForwardSchedulingS2::schedule(const time_sf_t current_superframe_sf,
 					}
 				}
 				LOG(this->log_scheduling, LEVEL_DEBUG,
-				    "SF#%u: Can send data from fifo %s on carriers group "
+				    "Can send data from fifo %s on carriers group "
 				    "%u in category %s\n",
-				    current_superframe_sf,
 				    fifo->getName(), carriers.getCarriersId(),
 				    this->category->getLabel().c_str());
+				vcm_fifos.push_back(fifo.get());
+			}
+		}
+	}
+}
+
+
+void ForwardSchedulingS2::addIncompleteBBFrame(fmt_id_t modcod_id, Rt::Ptr<BBFrame> bbframe)
+{
+	IncompleteBBFrame &head = this->incomplete_bb_frames[0];
+	IncompleteBBFrame &slot = this->incomplete_bb_frames[modcod_id];
+
+	slot.bbframe = std::move(bbframe);
+	slot.next = 0;
+	slot.previous = head.previous;
+	this->incomplete_bb_frames[head.previous].next = modcod_id;
+	head.previous = modcod_id;
+	this->incomplete_bb_frames_count++;
+}
+
 
+Rt::Ptr<BBFrame> ForwardSchedulingS2::removeIncompleteBBFrame(fmt_id_t modcod_id)
+{
+	IncompleteBBFrame &slot = this->incomplete_bb_frames[modcod_id];
+
+	this->incomplete_bb_frames[slot.previous].next = slot.next;
+	this->incomplete_bb_frames[slot.next].previous = slot.previous;
+	slot.previous = 0;
+	slot.next = 0;
+	this->incomplete_bb_frames_count--;
+
+	Rt::Ptr<BBFrame> bbframe = std::move(slot.bbframe);
+	slot.bbframe = Rt::make_ptr<BBFrame>(nullptr);
+	return bbframe;
+}
+
+
+bool ForwardSchedulingS2::schedule(const time_sf_t current_superframe_sf,
+                                   std::list<Rt::Ptr<DvbFrame>> &complete_dvb_frames,
+                                   uint32_t &remaining_allocation)
+{
+	vol_sym_t init_capacity_sym;
+	int total_capa = 0;
+
+	// follow the carriers reallocation with SVNO interface
+	this->updateEligibleFifos();
+
+	auto& carriers_group = this->category->getCarriersGroups();
+	for (std::size_t carriers_index = 0; carriers_index < carriers_group.size(); ++carriers_index)
+	{
+		unsigned int vcm_id = 0;
+		auto &vcm_carriers = carriers_group[carriers_index].getVcmCarriers();
+		// if no VCM, getVcm() will return only one carrier
+		for(auto&& vcm : vcm_carriers)
+		{
+			vol_sym_t capacity_sym;
+			vol_sym_t previous_sym;
+
+			// initialize carriers capacity, remaining capacity should be 0
+			// as we use previous capacity to keep track of unused capacity here
+			init_capacity_sym = vcm.getTotalCapacity() + vcm.getRemainingCapacity();
+			vcm.setRemainingCapacity(init_capacity_sym);
+			total_capa += init_capacity_sym;
+
+			capacity_sym = init_capacity_sym;
+			previous_sym = vcm.getPreviousCapacity(current_superframe_sf);
+			capacity_sym += previous_sym;
+
+			for(auto&& fifo : this->eligible_fifos[carriers_index][vcm_id])
+			{
 				if(!this->scheduleEncapPackets(*fifo,
 				                               current_superframe_sf,
 				                               complete_dvb_frames,
@@ -246,16 +324,15 @@ bool ForwardSchedulingS2::schedule(const time_sf_t current_superframe_sf,
 
 			// try to fill the BBFrames list with the remaining
 			// incomplete BBFrames
-			for(auto it = this->incomplete_bb_frames_ordered.begin();
-			    it != this->incomplete_bb_frames_ordered.end();
-			    it = this->incomplete_bb_frames_ordered.erase(it))
+			fmt_id_t modcod_id = this->incomplete_bb_frames[0].next;
+			while(modcod_id != 0)
 			{
 				if(capacity_sym <= 0)
 				{
 					break;
 				}
 
-				auto& current_bbframe = this->incomplete_bb_frames.at(*it);
+				auto& current_bbframe = this->incomplete_bb_frames[modcod_id].bbframe;
 				auto ret = this->addCompleteBBFrame(complete_dvb_frames,
 				                                    current_bbframe,
 				                                    current_superframe_sf,
@@ -266,8 +343,9 @@ bool ForwardSchedulingS2::schedule(const time_sf_t current_superframe_sf,
 				}
 				else if(ret == sched_status::ok)
 				{
-					this->incomplete_bb_frames.erase(*it);
-					// incomplete ordered erased in loop
+					fmt_id_t next_modcod_id = this->incomplete_bb_frames[modcod_id].next;
+					this->removeIncompleteBBFrame(modcod_id);
+					modcod_id = next_modcod_id;
 				}
 				else if(ret == sched_status::full)
 				{
@@ -347,7 +425,6 @@ sched_status ForwardSchedulingS2::schedulePacket(const time_sf_t current_superfr
 {
 	while (encap_packet)
 	{
-		Rt::Ptr<NetPacket> data = Rt::make_ptr<NetPacket>(nullptr);
 		// retrieve the ST ID associated to the packet
 		tal_id_t tal_id = encap_packet->getDstTalId();
 		// This is a broadcast/multicast destination
@@ -374,36 +451,43 @@ sched_status ForwardSchedulingS2::schedulePacket(const time_sf_t current_superfr
 			    tal_id);
 		}
 	
-		std::map<unsigned int, Rt::Ptr<BBFrame>>::iterator current_bbframe_it;
+		fmt_id_t modcod;
 		if(!this->prepareIncompleteBBFrame(tal_id, carriers,
 		                                   current_superframe_sf,
-		                                   current_bbframe_it))
+		                                   modcod))
 		{
 			// cannot initialize incomplete BB Frame
 			return sched_status::error;
 		}
-		else if(current_bbframe_it == this->incomplete_bb_frames.end())
+		else if(modcod == 0)
 		{
 			// cannot get modcod for the ST delete the element
 			return sched_status::ok;
 		}
 	
-		auto modcod = current_bbframe_it->first;
-		Rt::Ptr<BBFrame>& current_bbframe = current_bbframe_it->second;
+		Rt::Ptr<BBFrame>& current_bbframe = this->incomplete_bb_frames[modcod].bbframe;
 	
 		LOG(this->log_scheduling, LEVEL_DEBUG,
 		    "SF#%u: Got the BBFrame for packet #%u, "
 		    "there is now %zu complete BBFrames and %zu "
 		    "incomplete\n", current_superframe_sf,
 		    sent_packets + 1, complete_dvb_frames.size(),
-		    this->incomplete_bb_frames.size());
+		    this->incomplete_bb_frames_count);
 	
-		// Encapsulate packet
+		// Encapsulate packet directly in the BBFrame
 		auto encap_packet_total_length = encap_packet->getTotalLength();
-		if(!this->packet_handler->encapNextPacket(std::move(encap_packet),
-		                                          current_bbframe->getFreeSpace(),
-		                                          current_bbframe->getPacketsCount() == 0,
-		                                          data, this->remaining_data))
+		bool new_burst = current_bbframe->getPacketsCount() == 0;
+		std::size_t data_length = 0;
+		auto encap = [&](uint8_t *dst, std::size_t dst_length, std::size_t &written)
+		{
+			bool status = this->packet_handler->encapInto(std::move(encap_packet),
+			                                              dst, dst_length,
+			                                              new_burst, written,
+			                                              this->remaining_data);
+			data_length = written;
+			return status;
+		};
+		if(!current_bbframe->writePacket(encap))
 		{
 			LOG(this->log_scheduling, LEVEL_ERROR,
 			    "SF#%u: error while processing packet "
@@ -411,30 +495,14 @@ sched_status ForwardSchedulingS2::schedulePacket(const time_sf_t current_superfr
 			    sent_packets + 1);
 		}
 		bool partial_encap = this->remaining_data != nullptr;
-		if(data)
+		if(data_length > 0)
 		{
-			// Add data
-			if(!current_bbframe->addPacket(*data))
-			{
-				LOG(this->log_scheduling, LEVEL_ERROR,
-				    "SF#%u: failed to add encapsulation "
-				    "packet #%u->in BB frame with MODCOD ID %u "
-				    "(packet length %zu, free space %zu)",
-				    current_superframe_sf,
-				    sent_packets + 1,
-				    current_bbframe->getModcodId(),
-				    data->getTotalLength(),
-				    current_bbframe->getFreeSpace());
-				return sched_status::error;
-			}
-
 			if(partial_encap)
 			{
 				LOG(this->log_scheduling, LEVEL_INFO,
 				    "SF#%u: packet fragmented",
 				    current_superframe_sf);
 			}
-			// delete the NetPacket once it has been copied in the BBFrame
 			sent_packets++;
 		}
 		else
@@ -463,9 +531,7 @@ sched_status ForwardSchedulingS2::schedulePacket(const time_sf_t current_superfr
 			}
 			else
 			{
-				Rt::Ptr<BBFrame> pending_bbframe = std::move(current_bbframe);
-				this->incomplete_bb_frames_ordered.remove(modcod);
-				this->incomplete_bb_frames.erase(modcod);
+				Rt::Ptr<BBFrame> pending_bbframe = this->removeIncompleteBBFrame(modcod);
 				if(ret == sched_status::full)
 				{
 					time_sf_t next_sf = current_superframe_sf + 1;
@@ -522,7 +588,7 @@ bool ForwardSchedulingS2::scheduleEncapPackets(DvbFifo &fifo,
 	// all the previous capacity was not consumed, remove it as we are not on
 	// pending frames anymore of if there is no incomplete frame
 	// (we consider incomplete frames can use previous capacity)
-	if(this->incomplete_bb_frames.size() == 0)
+	if(this->incomplete_bb_frames_count == 0)
 	{
 		capacity_sym = std::min(init_capa, capacity_sym);
 	}
@@ -698,9 +764,9 @@ unsigned int ForwardSchedulingS2::getBBFrameSizeBytes(unsigned int modcod_id)
 bool ForwardSchedulingS2::prepareIncompleteBBFrame(tal_id_t tal_id,
                                                    CarriersGroupDama &carriers,
                                                    const time_sf_t current_superframe_sf,
-                                                   std::map<unsigned int, Rt::Ptr<BBFrame>>::iterator &it)
+                                                   fmt_id_t &modcod_id)
 {
-	it = this->incomplete_bb_frames.end();
+	modcod_id = 0;
 
 	// retrieve the current MODCOD for the ST
 	if(!this->simu_sts->isStPresent(tal_id))
@@ -719,7 +785,7 @@ bool ForwardSchedulingS2::prepareIncompleteBBFrame(tal_id_t tal_id,
 	}
 
 	// get best modcod ID according to carrier
-	unsigned int modcod_id = carriers.getNearestFmtId(desired_modcod);
+	modcod_id = carriers.getNearestFmtId(desired_modcod);
 	if(modcod_id == 0)
 	{
 		LOG(this->log_scheduling, LEVEL_WARNING,
@@ -734,8 +800,7 @@ bool ForwardSchedulingS2::prepareIncompleteBBFrame(tal_id_t tal_id,
 	    current_superframe_sf, tal_id, modcod_id);
 
 	// find if the BBFrame exists
-	it = this->incomplete_bb_frames.find(modcod_id);
-	if(it != this->incomplete_bb_frames.end() && it->second != nullptr)
+	if(this->incomplete_bb_frames[modcod_id].bbframe != nullptr)
 	{
 		LOG(this->log_scheduling, LEVEL_DEBUG,
 		    "SF#%u: Found a BBFrame for MODCOD %u\n",
@@ -754,9 +819,8 @@ bool ForwardSchedulingS2::prepareIncompleteBBFrame(tal_id_t tal_id,
 			return false;
 		}
 
-		// add the BBFrame in the map and list
-		it = this->incomplete_bb_frames.emplace(modcod_id, std::move(bbframe)).first;
-		this->incomplete_bb_frames_ordered.push_back(modcod_id);
+		// add the BBFrame at the end of the incomplete BBFrames
+		this->addIncompleteBBFrame(modcod_id, std::move(bbframe));
 	}
 
 	return true;
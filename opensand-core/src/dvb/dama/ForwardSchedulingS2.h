@@ -81,11 +81,27 @@ protected:
 	/** The timer for forward scheduling */
 	time_us_t fwd_timer;
 
-	/** the BBFrame being built identified by their modcod */
-	std::map<unsigned int, Rt::Ptr<BBFrame>> incomplete_bb_frames;
+	/// A BBFrame being built, chained with the others in their created order
+	struct IncompleteBBFrame
+	{
+		Rt::Ptr<BBFrame> bbframe;
+		fmt_id_t previous;
+		fmt_id_t next;
+	};
 
-	/** the BBframe being built in their created order (modcod only) */
-	std::list<unsigned int> incomplete_bb_frames_ordered;
+	/** the BBFrames being built indexed by their modcod, the slot 0 (invalid
+	 *  MODCOD) is the head of the created order chain */
+	std::vector<IncompleteBBFrame> incomplete_bb_frames;
+
+	/** the number of BBFrames being built */
+	std::size_t incomplete_bb_frames_count;
+
+	/** the FIFOs that can emit on each VCM carrier of each carriers group,
+	 *  in the category order and by FIFO priority */
+	std::vector<std::vector<std::vector<DvbFifo *>>> eligible_fifos;
+
+	/** the carriers groups IDs the eligible FIFOs were computed for */
+	std::vector<unsigned int> eligible_carriers_ids;
 
 	/** the pending BBFrame list if there was not enough space in previous iteration
 	 *  for the corresponding MODCOD */
@@ -138,6 +154,30 @@ protected:
                                 std::list<Rt::Ptr<DvbFrame>> &complete_dvb_frames,
                                 Rt::Ptr<NetPacket> encap_packet);
 
+	/**
+	 * @brief Compute the FIFOs that can emit on each VCM carrier of
+	 *        each carriers group, if the carriers groups changed since
+	 *        the last computation (at init or with SVNO interface)
+	 */
+	void updateEligibleFifos();
+
+	/**
+	 * @brief Chain a new BBFrame at the end of the incomplete BBFrames
+	 *
+	 * @param modcod_id  the BBFrame modcod, there should be no incomplete
+	 *                   BBFrame for it
+	 * @param bbframe    the BBFrame
+	 */
+	void addIncompleteBBFrame(fmt_id_t modcod_id, Rt::Ptr<BBFrame> bbframe);
+
+	/**
+	 * @brief Remove a BBFrame from the incomplete BBFrames
+	 *
+	 * @param modcod_id  the BBFrame modcod
+	 * @return the BBFrame, if it was not already released
+	 */
+	Rt::Ptr<BBFrame> removeIncompleteBBFrame(fmt_id_t modcod_id);
+
 	/**
 	 * @brief Create an incomplete BB frame
 	 *
@@ -156,13 +196,14 @@ protected:
 	 * @param tal_id    the terminal ID we want to send the frame
 	 * @paarm carriers  the carriers group to which the terminal belongs
 	 * @param current_superframe_sf  The current superframe number
-	 * @param it OUT:   Iterator to the modcod and the incomplete BBframe for this packet
+	 * @param modcod_id OUT: the modcod of the incomplete BBframe for this
+	 *                  packet, 0 if the terminal cannot be served
 	 * @return          true on success, false otherwise
 	 */
 	bool prepareIncompleteBBFrame(tal_id_t tal_id,
 	                              CarriersGroupDama &carriers,
 	                              const time_sf_t current_superframe_sf,
-	                              std::map<unsigned int, Rt::Ptr<BBFrame>>::iterator &it);
+	                              fmt_id_t &modcod_id);
 
 	/**
 	 * @brief Add a BBframe to the list of complete BB frames
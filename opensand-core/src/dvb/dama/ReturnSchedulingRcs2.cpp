@@ -52,7 +52,8 @@ constexpr const uint32_t max_allocation = std::numeric_limits<vol_kb_t>::max();
 ReturnSchedulingRcs2::ReturnSchedulingRcs2(std::shared_ptr<EncapPlugin> packet_handler,
                                            std::shared_ptr<fifos_t> fifos):
 	Scheduling(packet_handler, fifos, nullptr),
-	max_burst_length_b(0)
+	max_burst_length_b(0),
+	frame_max_size_bytes(0)
 {
 }
 
@@ -69,6 +70,16 @@ void ReturnSchedulingRcs2::setMaxBurstLength(vol_b_t length_b)
 	LOG(this->log_scheduling, LEVEL_DEBUG,
 	    "DVB-RCS frame max burst length: %u bits (%u bytes)\n",
 	    this->max_burst_length_b, this->max_burst_length_b >> 3);
+
+	// the frame size only changes with the burst length, compute it here
+	// rather than for each allocated frame
+	this->frame_max_size_bytes = 0;
+	if((this->max_burst_length_b >> 3) > 0)
+	{
+		this->frame_max_size_bytes = std::min<vol_bytes_t>(
+			(this->max_burst_length_b >> 3) + sizeof(T_DVB_ENCAP_BURST),
+			MSG_DVB_RCS_SIZE_MAX);
+	}
 }
 
 
@@ -416,22 +427,8 @@ bool ReturnSchedulingRcs2::macSchedule(const time_sf_t current_superframe_sf,
 
 bool ReturnSchedulingRcs2::allocateDvbRcsFrame(Rt::Ptr<DvbRcsFrame> &incomplete_dvb_frame)
 {
-	vol_bytes_t length_bytes;
-
-	try
-	{
-		incomplete_dvb_frame = Rt::make_ptr<DvbRcsFrame>();
-	}
-	catch (const std::bad_alloc&)
-	{ 
-		LOG(this->log_scheduling, LEVEL_ERROR,
-		    "failed to create DVB-RCS2 frame\n");
-		return false;
-	}
-
 	// Get the max burst length
-	length_bytes = this->max_burst_length_b >> 3;
-	if(length_bytes <= 0)
+	if(this->frame_max_size_bytes <= 0)
 	{
 		incomplete_dvb_frame.reset();
 		LOG(this->log_scheduling, LEVEL_ERROR,
@@ -439,16 +436,18 @@ bool ReturnSchedulingRcs2::allocateDvbRcsFrame(Rt::Ptr<DvbRcsFrame> &incomplete_
 		return false;
 	}
 
-	length_bytes += incomplete_dvb_frame->getHeaderLength();
-	//length_bytes += sizeof(T_DVB_PHY);
-	if(MSG_DVB_RCS_SIZE_MAX < length_bytes)
+	// the frame buffer is allocated once with the burst size, so that
+	// the encapsulation packets are appended without reallocation
+	try
 	{
-		length_bytes = MSG_DVB_RCS_SIZE_MAX;
+		incomplete_dvb_frame = Rt::make_ptr<DvbRcsFrame>(std::size_t(this->frame_max_size_bytes));
+	}
+	catch (const std::bad_alloc&)
+	{ 
+		LOG(this->log_scheduling, LEVEL_ERROR,
+		    "failed to create DVB-RCS2 frame\n");
+		return false;
 	}
-
-	// set the max size of the DVB-RCS2 frame, also set the type
-	// of encapsulation packets the DVB-RCS2 frame will contain
-	incomplete_dvb_frame->setMaxSize(length_bytes);
 
 	LOG(this->log_scheduling, LEVEL_DEBUG,
 	    "new DVB-RCS2 frame with max length %u bytes (<= %u bytes), "
@@ -66,6 +66,10 @@ protected:
 	/// The maximum burst length in bits
 	vol_b_t max_burst_length_b;
 
+	/// The size of the DVB-RCS2 frames built for one burst (header
+	/// included), updated with the burst length
+	vol_bytes_t frame_max_size_bytes;
+
 	/**
 	 * @brief schedule the DVB packets that are stored in the MAC Fifo
 	 *
@@ -330,13 +330,20 @@ sched_status ScpcScheduling::schedulePacket(const time_sf_t current_superframe_s
 		    sent_packets + 1, complete_dvb_frames.size(),
 		    this->incomplete_bb_frames.size());
 
-		// Encapsulate packet
+		// Encapsulate packet directly in the BBFrame
 		auto encap_packet_total_length = encap_packet->getTotalLength();
-		Rt::Ptr<NetPacket> data = Rt::make_ptr<NetPacket>(nullptr);
-		if(!this->packet_handler->encapNextPacket(std::move(encap_packet),
-		                                          current_bbframe->getFreeSpace(),
-		                                          current_bbframe->getPacketsCount() == 0,
-		                                          data, this->remaining_data))
+		bool new_burst = current_bbframe->getPacketsCount() == 0;
+		std::size_t data_length = 0;
+		auto encap = [&](uint8_t *dst, std::size_t dst_length, std::size_t &written)
+		{
+			bool status = this->packet_handler->encapInto(std::move(encap_packet),
+			                                              dst, dst_length,
+			                                              new_burst, written,
+			                                              this->remaining_data);
+			data_length = written;
+			return status;
+		};
+		if(!current_bbframe->writePacket(encap))
 		{
 			LOG(this->log_scheduling, LEVEL_ERROR,
 			    "SF#%u: error while processing packet "
@@ -345,7 +352,7 @@ sched_status ScpcScheduling::schedulePacket(const time_sf_t current_superframe_s
 		}
 
 		bool partial_encap = this->remaining_data != nullptr;
-		if(!data && !partial_encap)
+		if(data_length == 0 && !partial_encap)
 		{
 			LOG(this->log_scheduling, LEVEL_ERROR,
 			    "SF#%u: bad getChunk function "
@@ -355,23 +362,8 @@ sched_status ScpcScheduling::schedulePacket(const time_sf_t current_superframe_s
 			throw BadPrecondition("getChunk function returned neither data nor partial"
 			                      "_data in ScpcScheduling::scheduleEncapPackets");
 		}
-		if(data)
+		if(data_length > 0)
 		{
-			// Add data
-			if(!current_bbframe->addPacket(*data))
-			{
-				LOG(this->log_scheduling, LEVEL_ERROR,
-				    "SF#%u: failed to add encapsulation "
-				    "packet #%u->in BB frame with MODCOD ID %u "
-				    "(packet length %zu, free space %zu)",
-				    current_superframe_sf,
-				    sent_packets + 1,
-				    current_bbframe->getModcodId(),
-				    data->getTotalLength(),
-				    current_bbframe->getFreeSpace());
-				return sched_status::error;
-			}
-
 			if(partial_encap)
 			{
 				LOG(this->log_scheduling, LEVEL_INFO,
@@ -379,7 +371,6 @@ sched_status ScpcScheduling::schedulePacket(const time_sf_t current_superframe_s
 				    current_superframe_sf);
 			}
 
-			// delete the NetPacket once it has been copied in the BBFrame
 			sent_packets++;
 		}
 		else
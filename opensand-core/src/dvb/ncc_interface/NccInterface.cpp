@@ -48,6 +48,7 @@ NccInterface::NccInterface()
 	this->socket_listen = -1;
 	this->socket_client = -1;
 	this->is_connected = false;
+	this->is_binary = false;
 
 	// Output log
 	this->log_ncc_interface = Output::Get()->registerLog(LEVEL_WARNING, "Dvb.Ncc.Interface");
@@ -93,6 +94,14 @@ void NccInterface::setSocketClient(int socket_client)
 void NccInterface::setIsConnected(bool is_connected)
 {
 	this->is_connected = is_connected;
+	// a new connection decides its protocol
+	this->is_binary = false;
+	this->rx_buffer.clear();
+}
+
+bool NccInterface::isBinary() const
+{
+	return this->is_binary;
 }
 
 bool NccInterface::initSocket(uint16_t tcp_port)
@@ -160,3 +169,51 @@ close_socket:
 error:
 	return false;
 }
+
+bool NccInterface::handleReceivedData(const Rt::Data &data)
+{
+	if(!this->is_binary)
+	{
+		if(data.empty() || data[0] != NCC_MSG_MAGIC)
+		{
+			// text protocol, one message per read
+			return this->parseTextMessage(data);
+		}
+		LOG(this->log_ncc_interface, LEVEL_NOTICE,
+		    "binary protocol used by the connected component\n");
+		this->is_binary = true;
+	}
+
+	this->rx_buffer.append(data);
+
+	bool status = true;
+	std::size_t offset = 0;
+	while(this->rx_buffer.size() - offset >= sizeof(ncc_msg_hdr_t))
+	{
+		ncc_msg_hdr_t header;
+		memcpy(&header, this->rx_buffer.data() + offset, sizeof(ncc_msg_hdr_t));
+		uint32_t length = ntohl(header.length);
+		if(header.magic != NCC_MSG_MAGIC ||
+		   header.version != NCC_MSG_VERSION ||
+		   length > NCC_MSG_MAX_LENGTH)
+		{
+			LOG(this->log_ncc_interface, LEVEL_ERROR,
+			    "bad binary message header (magic 0x%02x, version %u, "
+			    "length %u)\n", header.magic, header.version, length);
+			this->rx_buffer.clear();
+			return false;
+		}
+		if(this->rx_buffer.size() - offset - sizeof(ncc_msg_hdr_t) < length)
+		{
+			// wait for the end of the message
+			break;
+		}
+		offset += sizeof(ncc_msg_hdr_t);
+		status &= this->parseBinaryMessage(this->rx_buffer.data() + offset,
+		                                   length, ntohs(header.count));
+		offset += length;
+	}
+	this->rx_buffer.erase(0, offset);
+
+	return status;
+}
@@ -40,6 +40,28 @@
 
 #include <opensand_output/Output.h>
 #include <opensand_rt/Rt.h>
+#include <opensand_rt/Data.h>
+
+
+/// The first byte of a binary message, text commands start with a digit
+#define NCC_MSG_MAGIC 0xCA
+/// The version of the binary protocol
+#define NCC_MSG_VERSION 1
+/// The maximum length of the commands in a binary message
+#define NCC_MSG_MAX_LENGTH 65536
+
+/**
+ * @brief The header of a binary message sent by a PEP or SVNO component,
+ *        followed by length bytes containing count commands.
+ *        Fields are in network byte order.
+ */
+typedef struct
+{
+	uint8_t magic;    ///< NCC_MSG_MAGIC
+	uint8_t version;  ///< NCC_MSG_VERSION
+	uint16_t count;   ///< The number of commands in the message
+	uint32_t length;  ///< The length of the commands
+} __attribute__((packed)) ncc_msg_hdr_t;
 
 /**
  * @class NccInterface
@@ -61,13 +83,19 @@ protected:
 	/** Whether an element is connected or not */
 	bool is_connected;
 
+	/** Whether the connected element uses the binary protocol */
+	bool is_binary;
+
+	/** The received bytes of an incomplete binary message */
+	Rt::Data rx_buffer;
+
 	/** Output Log */
 	std::shared_ptr<OutputLog> log_ncc_interface;
 
 public:
 	/**** constructor/destructor ****/
 	NccInterface();
-	~NccInterface();
+	virtual ~NccInterface();
 
 	/**** accessors ****/
 	int getSocketListen();
@@ -82,6 +110,45 @@ public:
 	
 	/*create a TCP socket connected to the component */
 	bool initSocket(uint16_t tcp_port);
+
+	/**
+	 * @brief Whether the connected component uses the binary protocol,
+	 *        its connection is then kept open between messages
+	 */
+	bool isBinary() const;
+
+protected:
+	/**
+	 * @brief Handle data read on the client socket
+	 *
+	 * Text messages are parsed as they are read. Binary messages may span
+	 * several reads: the data are appended to the bytes left by the
+	 * previous reads and each complete message is parsed.
+	 *
+	 * @param data  The data read on the client socket
+	 * @return true on success, false if the data could not be parsed
+	 */
+	bool handleReceivedData(const Rt::Data &data);
+
+	/**
+	 * @brief Parse a text message
+	 *
+	 * @param message  The message
+	 * @return true on success, false otherwise
+	 */
+	virtual bool parseTextMessage(const Rt::Data &message) = 0;
+
+	/**
+	 * @brief Parse the commands of a binary message
+	 *
+	 * @param commands  The commands
+	 * @param length    The length of the commands
+	 * @param count     The number of commands
+	 * @return true on success, false otherwise
+	 */
+	virtual bool parseBinaryMessage(const uint8_t *commands,
+	                                std::size_t length,
+	                                uint16_t count) = 0;
 };
 
 #endif
@@ -42,6 +42,7 @@
 #include <errno.h>
 #include <stdio.h>
 
+#include <cstring>
 #include <sstream>
 
 
@@ -50,7 +51,12 @@
  */
 NccPepInterface::NccPepInterface():
 	NccInterface(),
-	requests_list()
+	requests_list(),
+	allocation_delay(time_ms_t::zero()),
+	releases_list(),
+	allocations_received(false),
+	releases_received(false),
+	last_st_id(0)
 {
 }
 
@@ -60,9 +66,9 @@ NccPepInterface::NccPepInterface():
  */
 NccPepInterface::~NccPepInterface()
 {
-	// free all PEP requests stored in list
+	// free all PEP requests stored in lists
 	this->requests_list.clear();
-	this->~NccInterface();
+	this->releases_list.clear();
 }
 
 
@@ -89,45 +95,77 @@ int NccPepInterface::getPepClientSocket()
 
 
 /**
- * @brief Get the type of current PEP requests
+ * @brief Get the type of the PEP requests received by the last read
  *
- * @return  PEP_REQUEST_ALLOCATION or PEP_REQUEST_RELEASE
+ * The requests received before, still waiting to be applied, are not
+ * considered. A binary connection may bring several messages in a read,
+ * the allocations are reported first as they are the ones to delay.
+ *
+ * @return  PEP_REQUEST_ALLOCATION if allocations were received,
+ *          PEP_REQUEST_RELEASE if only releases were received,
+ *          PEP_REQUEST_UNKNOWN if no request was received
  */
 pep_request_type_t NccPepInterface::getPepRequestType()
 {
-	pep_request_type_t type;
-
-	if(this->requests_list.empty())
+	if(this->allocations_received)
 	{
-		type = PEP_REQUEST_UNKNOWN;
+		return PEP_REQUEST_ALLOCATION;
 	}
-	else
+	if(this->releases_received)
 	{
-		type = this->requests_list.front()->getType();
+		return PEP_REQUEST_RELEASE;
 	}
+	return PEP_REQUEST_UNKNOWN;
+}
+
 
-	return type;
+/**
+ * @brief Set the delay before applying the PEP allocation requests
+ *
+ * @param delay  the delay after the reception of a request
+ */
+void NccPepInterface::setAllocationDelay(time_ms_t delay)
+{
+	this->allocation_delay = delay;
 }
 
 
 /**
- * @brief Get the first request of the list of PEP requests
+ * @brief Get the first request of the list of PEP allocation requests
+ *        if it was received at least the allocation delay ago
  *
- * @return  the first request of the list of PEP requests,
- *          NULL if no request is available
+ * @return  the first request of the list of PEP allocation requests,
+ *          NULL if no request is available yet
  */
 std::unique_ptr<PepRequest> NccPepInterface::getNextPepRequest()
 {
-	if (!this->requests_list.empty())
+	// the requests are stored in reception order, so in date order
+	if (!this->requests_list.empty() &&
+	    this->requests_list.front().first <= std::chrono::high_resolution_clock::now())
+	{
+		// take the first request of the list then remove it
+		std::unique_ptr<PepRequest> request = std::move(this->requests_list.front().second);
+		this->requests_list.pop_front();
+		return request;
+	}
+
+	return {nullptr};
+}
+
+
+/**
+ * @brief Get the first request of the list of PEP release requests
+ *
+ * @return  the first request of the list of PEP release requests,
+ *          NULL if no request is available
+ */
+std::unique_ptr<PepRequest> NccPepInterface::getNextPepRelease()
+{
+	if (!this->releases_list.empty())
 	{
-		// get the first request of the list and make a copy of it.
-		// the erase() method calls the object's destructor,
-		// so we have to deference the request object in order to preserve it.
-		auto it = this->requests_list.begin();
-		std::unique_ptr<PepRequest> request = std::move(*it);
-
-		// remove the first request of the list
-		this->requests_list.erase(it);
+		// take the first request of the list then remove it
+		std::unique_ptr<PepRequest> request = std::move(this->releases_list.front());
+		this->releases_list.pop_front();
 		return request;
 	}
 
@@ -160,10 +198,10 @@ bool NccPepInterface::readPepMessage(const Rt::NetSocketEvent& event, tal_id_t &
 		return false;
 	}
 
-	Rt::Data recv_buffer = event.getData();
-
 	// parse message received from PEP
-	if(this->parsePepMessage(recv_buffer, tal_id) != true)
+	this->allocations_received = false;
+	this->releases_received = false;
+	if(!this->handleReceivedData(event.getData()))
 	{
 		// an error occured when parsing the PEP message
 		LOG(this->log_ncc_interface, LEVEL_ERROR,
@@ -171,6 +209,10 @@ bool NccPepInterface::readPepMessage(const Rt::NetSocketEvent& event, tal_id_t &
 		    "component\n");
 		goto close;
 	}
+	if(this->allocations_received || this->releases_received)
+	{
+		tal_id = this->last_st_id;
+	}
 
 	return true;
 
@@ -183,7 +225,7 @@ close:
 
 
 /**
- * @brief Parse a message sent by the PEP component
+ * @brief Parse a text message sent by the PEP component
  *
  * A message contains one or more lines. Every line is a command. There are
  * allocation commands or release commands. All the commands in a message
@@ -192,17 +234,19 @@ close:
  * @param message   the message sent by the PEP component
  * @return          true if message was successfully parsed, false otherwise
  */
-bool NccPepInterface::parsePepMessage(const Rt::Data& message, tal_id_t &tal_id)
+bool NccPepInterface::parseTextMessage(const Rt::Data& message)
 {
-	unsigned char cmd[64];
+	std::string cmd;
 	int all_cmds_type = -1; /* initialized because GCC is not smart enough
 	                           to find that the variable can not be used
 	                           uninitialized */
 
 	// for every command in the message...
 	unsigned int nb_cmds = 0;
-	Rt::DataStream stream(message);
-	while(stream.getline(cmd, 64))
+	// the commands are text, a stream of unsigned char has no facet to
+	// parse them
+	std::istringstream stream(std::string(message.begin(), message.end()));
+	while(std::getline(stream, cmd))
 	{
 		// parse the command
 		std::unique_ptr<PepRequest> request = this->parsePepCommand(cmd);
@@ -214,36 +258,121 @@ bool NccPepInterface::parsePepMessage(const Rt::Data& message, tal_id_t &tal_id)
 			continue;
 		}
 
-		tal_id = request->getStId();
+		this->storePepRequest(std::move(request), nb_cmds, all_cmds_type);
+	}
 
-		// check that all commands are of of the same type
-		// (ie. all allocations or all de-allocations)
-		if(nb_cmds == 0)
-		{
-			// first command, set the type
-			all_cmds_type = request->getType();
-		}
-		else if(request->getType() != all_cmds_type)
+	if(nb_cmds == 0)
+	{
+		// no request correctly processed
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Parse the commands of a binary message sent by the PEP component
+ *
+ * The commands are pep_cmd_t structures. As for text messages, all the
+ * commands in a message must be of the same type.
+ *
+ * @param commands  the commands of the message
+ * @param length    the length of the commands
+ * @param count     the number of commands
+ * @return          true if message was successfully parsed, false otherwise
+ */
+bool NccPepInterface::parseBinaryMessage(const uint8_t *commands,
+                                         std::size_t length,
+                                         uint16_t count)
+{
+	int all_cmds_type = -1;
+	unsigned int nb_cmds = 0;
+
+	if(length != count * sizeof(pep_cmd_t))
+	{
+		LOG(this->log_ncc_interface, LEVEL_ERROR,
+		    "bad PEP message length %zu for %u commands\n",
+		    length, count);
+		return false;
+	}
+
+	for(uint16_t index = 0; index < count; index++)
+	{
+		pep_cmd_t cmd;
+		memcpy(&cmd, commands + index * sizeof(pep_cmd_t), sizeof(pep_cmd_t));
+
+		if(cmd.type != PEP_REQUEST_ALLOCATION && cmd.type != PEP_REQUEST_RELEASE)
 		{
 			LOG(this->log_ncc_interface, LEVEL_ERROR,
-			    "command #%d is not of the same type "
-			    "as command #1, this is not accepted, "
-			    "so ignore the command\n", nb_cmds);
+			    "bad request type %u in PEP command #%u, "
+			    "should be %u or %u, skip the command\n",
+			    cmd.type, index + 1,
+			    PEP_REQUEST_ALLOCATION, PEP_REQUEST_RELEASE);
 			continue;
 		}
 
-		// store the command parameters in context
-		this->requests_list.push_back(std::move(request));
-
-		nb_cmds++;
+		auto request = std::make_unique<PepRequest>((pep_request_type_t) cmd.type,
+		                                             ntohs(cmd.st_id),
+		                                             ntohl(cmd.cra_kbps),
+		                                             ntohl(cmd.rbdc_kbps),
+		                                             ntohl(cmd.rbdc_max_kbps));
+		this->storePepRequest(std::move(request), nb_cmds, all_cmds_type);
 	}
 
+	LOG(this->log_ncc_interface, LEVEL_INFO,
+	    "%u PEP commands out of %u received\n", nb_cmds, count);
+
+	return true;
+}
+
+
+/**
+ * @brief Store a PEP request if it has the type of the first request
+ *        of its message
+ *
+ * @param request        the request
+ * @param nb_cmds        the number of requests stored for the message
+ * @param all_cmds_type  the type of the first request of the message
+ * @return               true if the request was stored, false otherwise
+ */
+bool NccPepInterface::storePepRequest(std::unique_ptr<PepRequest> request,
+                                      unsigned int &nb_cmds,
+                                      int &all_cmds_type)
+{
+	// check that all commands are of of the same type
+	// (ie. all allocations or all de-allocations)
 	if(nb_cmds == 0)
 	{
-		// no request correctly processed
+		// first command, set the type
+		all_cmds_type = request->getType();
+	}
+	else if(request->getType() != all_cmds_type)
+	{
+		LOG(this->log_ncc_interface, LEVEL_ERROR,
+		    "command #%d is not of the same type "
+		    "as command #1, this is not accepted, "
+		    "so ignore the command\n", nb_cmds);
 		return false;
 	}
 
+	// store the command parameters in context, the releases are kept
+	// apart so that they do not wait for the pending allocations
+	this->last_st_id = request->getStId();
+	if(request->getType() == PEP_REQUEST_RELEASE)
+	{
+		this->releases_received = true;
+		this->releases_list.push_back(std::move(request));
+	}
+	else
+	{
+		this->allocations_received = true;
+		this->requests_list.emplace_back(std::chrono::high_resolution_clock::now() +
+		                                 this->allocation_delay,
+		                                 std::move(request));
+	}
+	nb_cmds++;
+
 	return true;
 }
 
@@ -255,9 +384,9 @@ bool NccPepInterface::parsePepMessage(const Rt::Data& message, tal_id_t &tal_id)
  * @return          the created PEP request if command was successfully parsed,
  *                  NULL in case of failure
  */
-std::unique_ptr<PepRequest> NccPepInterface::parsePepCommand(const Rt::Data& cmd)
+std::unique_ptr<PepRequest> NccPepInterface::parsePepCommand(const std::string& cmd)
 {
-	Rt::IDataStream stream(cmd);
+	std::istringstream stream(cmd);
 	unsigned char c;        // the colon separator char
 	bool good = true;
 
@@ -280,12 +409,12 @@ std::unique_ptr<PepRequest> NccPepInterface::parsePepCommand(const Rt::Data& cmd
 
 	unsigned int rbdc_max;  // the RBDCmax value
 	stream >> rbdc_max;
-	good = good && stream.good();
+	good = good && !stream.fail();
 
 	if(!good)
 	{
 		LOG(this->log_ncc_interface, LEVEL_ERROR,
-		    "bad formated PEP command received: '%s'\n", cmd);
+		    "bad formated PEP command received: '%s'\n", cmd.c_str());
 		return {nullptr};
 	}
 	else
@@ -299,7 +428,7 @@ std::unique_ptr<PepRequest> NccPepInterface::parsePepCommand(const Rt::Data& cmd
 	{
 		LOG(this->log_ncc_interface, LEVEL_ERROR,
 		    "bad request type in PEP command '%s', "
-		    "should be %u or %u\n", cmd,
+		    "should be %u or %u\n", cmd.c_str(),
 		    PEP_REQUEST_ALLOCATION, PEP_REQUEST_RELEASE);
 		return {nullptr};
 	}
@@ -36,7 +36,8 @@
 
 #include "PepRequest.h"
 #include "NccInterface.h"
-#include <vector>
+#include <chrono>
+#include <deque>
 
 #include <opensand_rt/NetSocketEvent.h>
 #include <opensand_rt/Rt.h>
@@ -48,8 +49,27 @@
 class NccPepInterface: public NccInterface
 {
 private:
-	/** The list of commands received from the PEP component */
-	std::vector<std::unique_ptr<PepRequest>> requests_list;
+	using time_point_t = std::chrono::high_resolution_clock::time_point;
+
+	/** The allocation commands received from the PEP component,
+	    with the date they may be applied at */
+	std::deque<std::pair<time_point_t, std::unique_ptr<PepRequest>>> requests_list;
+
+	/** The delay before applying the allocation commands */
+	time_ms_t allocation_delay;
+
+	/** The release commands received from the PEP component,
+	    applied without delay */
+	std::deque<std::unique_ptr<PepRequest>> releases_list;
+
+	/** Whether the last read brought allocation commands */
+	bool allocations_received;
+
+	/** Whether the last read brought release commands */
+	bool releases_received;
+
+	/** The ST of the last command received */
+	tal_id_t last_st_id;
 
 public:
 	/**** constructor/destructor ****/
@@ -69,12 +89,18 @@ public:
 	/* get the TCP socket connected to the the PEP component */
 	int getPepClientSocket();
 
-	/* get the type of current PEP requests */
+	/* get the type of the PEP requests received by the last read */
 	pep_request_type_t getPepRequestType();
 
-	/* get the list of PEP requests */
+	/* set the delay before applying the PEP allocation requests */
+	void setAllocationDelay(time_ms_t delay);
+
+	/* get the next PEP allocation request whose delay expired */
 	std::unique_ptr<PepRequest> getNextPepRequest();
 
+	/* get the next PEP release request */
+	std::unique_ptr<PepRequest> getNextPepRelease();
+
 
 	/**** socket management ****/
 
@@ -91,12 +117,23 @@ public:
 	 */
 	bool readPepMessage(const Rt::NetSocketEvent& event, tal_id_t &tal_id);
 
-private:
-	/* parse a message sent by the PEP component */
-	bool parsePepMessage(const Rt::Data& message, tal_id_t & tal_id);
+protected:
+	/* parse a text message sent by the PEP component */
+	bool parseTextMessage(const Rt::Data& message) override;
 
+	/* parse the commands of a binary message sent by the PEP component */
+	bool parseBinaryMessage(const uint8_t *commands,
+	                        std::size_t length,
+	                        uint16_t count) override;
+
+private:
 	/* parse one of the commands sent in a message by the PEP component */
-	std::unique_ptr<PepRequest> parsePepCommand(const Rt::Data& cmd);
+	std::unique_ptr<PepRequest> parsePepCommand(const std::string& cmd);
+
+	/* store a request if it has the type of the message first request */
+	bool storePepRequest(std::unique_ptr<PepRequest> request,
+	                     unsigned int &nb_cmds,
+	                     int &all_cmds_type);
 };
 
 #endif
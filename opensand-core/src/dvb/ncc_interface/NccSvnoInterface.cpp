@@ -42,6 +42,7 @@
 #include <errno.h>
 #include <stdio.h>
 
+#include <cstring>
 #include <sstream>
 
 
@@ -96,14 +97,9 @@ std::unique_ptr<SvnoRequest> NccSvnoInterface::getNextSvnoRequest()
 {
 	if (!this->requests_list.empty())
 	{
-		// get the first request of the list and make a copy of it.
-		// the erase() method calls the object's destructor,
-		// so we have to deference the request object in order to preserve it.
-		auto it = this->requests_list.begin();
-		std::unique_ptr<SvnoRequest> request = std::move(*it);
-
-		// remove the first request of the list
-		this->requests_list.erase(it);
+		// take the first request of the list then remove it
+		std::unique_ptr<SvnoRequest> request = std::move(this->requests_list.front());
+		this->requests_list.pop_front();
 		return request;
 	}
 
@@ -143,15 +139,13 @@ bool NccSvnoInterface::readSvnoMessage(const Rt::NetSocketEvent& event)
 		return false;
 	}
 
-	Rt::Data recv_buffer = event.getData();
-
 	// parse message received from SVNO
-	return this->parseSvnoMessage(recv_buffer);
+	return this->handleReceivedData(event.getData());
 }
 
 
 /**
- * @brief Parse a message sent by the SVNO component
+ * @brief Parse a text message sent by the SVNO component
  *
  * A message contains one or more lines. Every line is a command. There are
  * allocation commands or release commands. All the commands in a message
@@ -160,17 +154,19 @@ bool NccSvnoInterface::readSvnoMessage(const Rt::NetSocketEvent& event)
  * @param message   the message sent by the SVNO component
  * @return          true if message was successfully parsed, false otherwise
  */
-bool NccSvnoInterface::parseSvnoMessage(const Rt::Data& message)
+bool NccSvnoInterface::parseTextMessage(const Rt::Data& message)
 {
-	unsigned char cmd[64];
+	std::string cmd;
 	int all_cmds_type = -1; /* initialized because GCC is not smart enough
 	                           to find that the variable can not be used
 	                           uninitialized */
 
 	// for every command in the message...
 	unsigned int nb_cmds = 0;
-	Rt::DataStream stream(message);
-	while(stream.getline(cmd, 64))
+	// the commands are text, a stream of unsigned char has no facet to
+	// parse them
+	std::istringstream stream(std::string(message.begin(), message.end()));
+	while(std::getline(stream, cmd))
 	{
 		// parse the command
 		std::unique_ptr<SvnoRequest> request = this->parseSvnoCommand(cmd);
@@ -182,34 +178,132 @@ bool NccSvnoInterface::parseSvnoMessage(const Rt::Data& message)
 			continue;
 		}
 
-		// check that all commands are of of the same type
-		// (ie. all allocations or all de-allocations)
-		if(nb_cmds == 0)
+		this->storeSvnoRequest(std::move(request), nb_cmds, all_cmds_type);
+	}
+
+	if(nb_cmds == 0)
+	{
+		// no request correctly processed
+		return false;
+	}
+
+	return true;
+}
+
+
+/**
+ * @brief Parse the commands of a binary message sent by the SVNO component
+ *
+ * The commands are svno_cmd_t structures, each followed by its label.
+ * As for text messages, all the commands in a message must be of the
+ * same type.
+ *
+ * @param commands  the commands of the message
+ * @param length    the length of the commands
+ * @param count     the number of commands
+ * @return          true if message was successfully parsed, false otherwise
+ */
+bool NccSvnoInterface::parseBinaryMessage(const uint8_t *commands,
+                                          std::size_t length,
+                                          uint16_t count)
+{
+	int all_cmds_type = -1;
+	unsigned int nb_cmds = 0;
+	std::size_t offset = 0;
+
+	for(uint16_t index = 0; index < count; index++)
+	{
+		svno_cmd_t cmd;
+		if(length - offset < sizeof(svno_cmd_t))
 		{
-			// first command, set the type
-			all_cmds_type = request->getType();
+			LOG(this->log_ncc_interface, LEVEL_ERROR,
+			    "truncated SVNO command #%u\n", index + 1);
+			return false;
 		}
-		else if(request->getType() != all_cmds_type)
+		memcpy(&cmd, commands + offset, sizeof(svno_cmd_t));
+		offset += sizeof(svno_cmd_t);
+		if(length - offset < cmd.label_length)
 		{
 			LOG(this->log_ncc_interface, LEVEL_ERROR,
-			    "command #%d is not of the same type "
-			    "as command #1, this is not accepted, "
-			    "so ignore the command\n", nb_cmds);
-			continue;
+			    "truncated label in SVNO command #%u\n", index + 1);
+			return false;
 		}
+		std::string label(reinterpret_cast<const char *>(commands + offset),
+		                  cmd.label_length);
+		offset += cmd.label_length;
 
-		// store the command parameters in context
-		this->requests_list.push_back(std::move(request));
+		if(cmd.type != SVNO_REQUEST_ALLOCATION && cmd.type != SVNO_REQUEST_RELEASE)
+		{
+			LOG(this->log_ncc_interface, LEVEL_ERROR,
+			    "bad request type %u in SVNO command #%u, "
+			    "type should be %u or %u, skip the command\n",
+			    cmd.type, index + 1,
+			    SVNO_REQUEST_ALLOCATION, SVNO_REQUEST_RELEASE);
+			continue;
+		}
+		if(cmd.band != FORWARD && cmd.band != RETURN)
+		{
+			LOG(this->log_ncc_interface, LEVEL_ERROR,
+			    "bad request band %u in SVNO command #%u, "
+			    "band should be %u or %u, skip the command\n",
+			    cmd.band, index + 1, FORWARD, RETURN);
+			continue;
+		}
 
-		nb_cmds++;
+		auto request = std::make_unique<SvnoRequest>(ntohs(cmd.spot_id),
+		                                             (svno_request_type_t)cmd.type,
+		                                             (band_t)cmd.band,
+		                                             label,
+		                                             ntohl(cmd.new_rate_kbps));
+		this->storeSvnoRequest(std::move(request), nb_cmds, all_cmds_type);
+	}
+	if(offset != length)
+	{
+		LOG(this->log_ncc_interface, LEVEL_WARNING,
+		    "%zu unexpected bytes after the SVNO commands\n",
+		    length - offset);
 	}
 
+	LOG(this->log_ncc_interface, LEVEL_INFO,
+	    "%u SVNO commands out of %u received\n", nb_cmds, count);
+
+	return true;
+}
+
+
+/**
+ * @brief Store a SVNO request if it has the type of the first request
+ *        of its message
+ *
+ * @param request        the request
+ * @param nb_cmds        the number of requests stored for the message
+ * @param all_cmds_type  the type of the first request of the message
+ * @return               true if the request was stored, false otherwise
+ */
+bool NccSvnoInterface::storeSvnoRequest(std::unique_ptr<SvnoRequest> request,
+                                        unsigned int &nb_cmds,
+                                        int &all_cmds_type)
+{
+	// check that all commands are of of the same type
+	// (ie. all allocations or all de-allocations)
 	if(nb_cmds == 0)
 	{
-		// no request correctly processed
+		// first command, set the type
+		all_cmds_type = request->getType();
+	}
+	else if(request->getType() != all_cmds_type)
+	{
+		LOG(this->log_ncc_interface, LEVEL_ERROR,
+		    "command #%d is not of the same type "
+		    "as command #1, this is not accepted, "
+		    "so ignore the command\n", nb_cmds);
 		return false;
 	}
 
+	// store the command parameters in context
+	this->requests_list.push_back(std::move(request));
+	nb_cmds++;
+
 	return true;
 }
 
@@ -221,21 +315,21 @@ bool NccSvnoInterface::parseSvnoMessage(const Rt::Data& message)
  * @return          the created SVNO request if command was successfully parsed,
  *                  NULL in case of failure
  */
-std::unique_ptr<SvnoRequest> NccSvnoInterface::parseSvnoCommand(const Rt::Data& cmd)
+std::unique_ptr<SvnoRequest> NccSvnoInterface::parseSvnoCommand(const std::string& cmd)
 {
 	unsigned int spot_id;
 	unsigned int type;      // allocation or release request
 	unsigned int band;      // band
-	Rt::Data label;      // label 
+	std::string label;      // label 
 	rate_kbps_t new_rate_kbps; // new rate
 
 	// retrieve values in the command
-	Rt::IDataStream cmd_s(cmd);
+	std::istringstream cmd_s(cmd);
 	cmd_s >> spot_id >> type >> band >> label >> new_rate_kbps;
 	if(cmd_s.fail())
 	{
 		LOG(this->log_ncc_interface, LEVEL_ERROR,
-		    "bad formated SVNO command received: '%s'\n", cmd);
+		    "bad formated SVNO command received: '%s'\n", cmd.c_str());
 		return nullptr;
 	}
 
@@ -244,7 +338,7 @@ std::unique_ptr<SvnoRequest> NccSvnoInterface::parseSvnoCommand(const Rt::Data&
 	{
 		LOG(this->log_ncc_interface, LEVEL_ERROR,
 		    "bad request type in SVNO command '%s', "
-		    "type should be %u or %u\n", cmd,
+		    "type should be %u or %u\n", cmd.c_str(),
 		    SVNO_REQUEST_ALLOCATION, SVNO_REQUEST_RELEASE);
 		return nullptr;
 	}
@@ -254,7 +348,7 @@ std::unique_ptr<SvnoRequest> NccSvnoInterface::parseSvnoCommand(const Rt::Data&
 	{
 		LOG(this->log_ncc_interface, LEVEL_ERROR,
 		    "bad request band in SVNO command '%s', "
-		    "band is %u but should be %u or %u\n", cmd,
+		    "band is %u but should be %u or %u\n", cmd.c_str(),
 		    band, FORWARD, RETURN);
 		return nullptr;
 	}
@@ -270,6 +364,6 @@ std::unique_ptr<SvnoRequest> NccSvnoInterface::parseSvnoCommand(const Rt::Data&
 	return std::make_unique<SvnoRequest>(spot_id,
 	                                     (svno_request_type_t)type,
 	                                     (band_t)band,
-	                                     reinterpret_cast<const char*>(label.c_str()),
+	                                     label,
 	                                     new_rate_kbps);
 }
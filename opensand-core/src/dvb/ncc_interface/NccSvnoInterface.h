@@ -36,7 +36,7 @@
 
 #include "SvnoRequest.h"
 #include "NccInterface.h"
-#include <vector>
+#include <deque>
 
 #include <opensand_rt/NetSocketEvent.h>
 #include <opensand_rt/Rt.h>
@@ -49,7 +49,7 @@ class NccSvnoInterface: public NccInterface
 {
 private:
 	/** The list of commands received from the SVNO component */
-	std::vector<std::unique_ptr<SvnoRequest>> requests_list;
+	std::deque<std::unique_ptr<SvnoRequest>> requests_list;
 
 public:
 	/**** constructor/destructor ****/
@@ -88,12 +88,23 @@ public:
 	 */
 	bool readSvnoMessage(const Rt::NetSocketEvent& event);
 
-private:
-	/* parse a message sent by the SVNO component */
-	bool parseSvnoMessage(const Rt::Data& message);
+protected:
+	/* parse a text message sent by the SVNO component */
+	bool parseTextMessage(const Rt::Data& message) override;
+
+	/* parse the commands of a binary message sent by the SVNO component */
+	bool parseBinaryMessage(const uint8_t *commands,
+	                        std::size_t length,
+	                        uint16_t count) override;
 
+private:
 	/* parse one of the commands sent in a message by the SVNO component */
-	std::unique_ptr<SvnoRequest> parseSvnoCommand(const Rt::Data& cmd);
+	std::unique_ptr<SvnoRequest> parseSvnoCommand(const std::string& cmd);
+
+	/* store a request if it has the type of the message first request */
+	bool storeSvnoRequest(std::unique_ptr<SvnoRequest> request,
+	                      unsigned int &nb_cmds,
+	                      int &all_cmds_type);
 };
 
 #endif
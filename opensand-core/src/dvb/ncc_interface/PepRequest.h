@@ -46,6 +46,20 @@ typedef enum
 	PEP_REQUEST_UNKNOWN = 2,     /**< for error handling */
 } pep_request_type_t;
 
+/**
+ * @brief A command in a binary message from the PEP
+ *        (fields in network byte order)
+ */
+typedef struct
+{
+	uint8_t type;            ///< The pep_request_type_t
+	uint8_t reserved;
+	uint16_t st_id;          ///< The ST the request is for
+	uint32_t cra_kbps;       ///< The CRA, 0 to keep it
+	uint32_t rbdc_kbps;      ///< The RBDC to inject, 0 for none
+	uint32_t rbdc_max_kbps;  ///< The RBDCmax, 0 to keep it
+} __attribute__((packed)) pep_cmd_t;
+
 
 
 /**
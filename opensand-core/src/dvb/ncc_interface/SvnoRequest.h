@@ -54,6 +54,20 @@ typedef enum
 	RETURN = 1,
 } band_t;
 
+/**
+ * @brief A command in a binary message from the SVNO, followed by
+ *        label_length bytes of category label
+ *        (fields in network byte order)
+ */
+typedef struct
+{
+	uint16_t spot_id;        ///< The spot concerned by the request
+	uint8_t type;            ///< The svno_request_type_t
+	uint8_t band;            ///< The band_t
+	uint32_t new_rate_kbps;  ///< The new rate of the category
+	uint8_t label_length;    ///< The length of the label that follows
+} __attribute__((packed)) svno_cmd_t;
+
 /**
  * @class SvnoRequest
  * @brief Allocation or release request from a SVNO component
@@ -0,0 +1,481 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ * Copyright © 2019 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/**
+ * @file test_ncc_interface.cpp
+ * @brief Feed PEP messages to the NCC interface through a socket and check
+ *        the framing of the binary protocol (messages split across reads,
+ *        several messages in a read, bad headers), the type reported
+ *        for each read and the delay of the allocations
+ * @author Viveris Technologies
+ */
+
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <thread>
+#include <utility>
+#include <vector>
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <opensand_rt/NetSocketEvent.h>
+
+#include "NccPepInterface.h"
+
+
+static std::pair<int, int> socketPair()
+{
+	int fds[2] = {-1, -1};
+	if(socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0)
+	{
+		perror("socketpair");
+	}
+	return {fds[0], fds[1]};
+}
+
+
+/**
+ * @brief A PEP interface connected to one end of a socket pair, the
+ *        test writes the messages on the other end
+ */
+class TestPepInterface
+{
+public:
+	TestPepInterface():
+		TestPepInterface{socketPair()}
+	{
+	}
+
+	TestPepInterface(std::pair<int, int> fds):
+		pep{},
+		event{"pep_client", fds.first},
+		peer{fds.second}
+	{
+		this->pep.setSocketClient(fds.first);
+		this->pep.setIsConnected(true);
+	}
+
+	~TestPepInterface()
+	{
+		close(this->peer);
+	}
+
+	/**
+	 * @brief Send bytes to the interface and read them as one event
+	 */
+	bool receive(const Rt::Data &bytes)
+	{
+		if(write(this->peer, bytes.data(), bytes.size()) != static_cast<ssize_t>(bytes.size()) ||
+		   !this->event.handle())
+		{
+			return false;
+		}
+		tal_id_t tal_id;
+		return this->pep.readPepMessage(this->event, tal_id);
+	}
+
+	std::size_t countRequests()
+	{
+		std::size_t count = 0;
+		while(this->pep.getNextPepRequest())
+		{
+			count++;
+		}
+		return count;
+	}
+
+	std::size_t countReleases()
+	{
+		std::size_t count = 0;
+		while(this->pep.getNextPepRelease())
+		{
+			count++;
+		}
+		return count;
+	}
+
+	NccPepInterface pep;
+
+private:
+	Rt::NetSocketEvent event;
+	int peer;
+};
+
+
+static Rt::Data binaryMessage(const std::vector<pep_request_type_t> &types,
+                              uint8_t version = NCC_MSG_VERSION)
+{
+	ncc_msg_hdr_t header;
+	header.magic = NCC_MSG_MAGIC;
+	header.version = version;
+	header.count = htons(types.size());
+	header.length = htonl(types.size() * sizeof(pep_cmd_t));
+	Rt::Data message(reinterpret_cast<const unsigned char *>(&header), sizeof(header));
+
+	uint16_t st_id = 1;
+	for(auto &&type: types)
+	{
+		pep_cmd_t cmd;
+		memset(&cmd, 0, sizeof(cmd));
+		cmd.type = type;
+		cmd.st_id = htons(st_id++);
+		cmd.cra_kbps = htonl(100);
+		cmd.rbdc_kbps = htonl(200);
+		cmd.rbdc_max_kbps = htonl(300);
+		message.append(reinterpret_cast<const unsigned char *>(&cmd), sizeof(cmd));
+	}
+	return message;
+}
+
+
+static Rt::Data textMessage(const char *text)
+{
+	return Rt::Data(reinterpret_cast<const unsigned char *>(text), strlen(text));
+}
+
+
+int main()
+{
+	// text message, one per connection
+	{
+		TestPepInterface test;
+		if(!test.receive(textMessage("1:2:100:200:300\n1:3:100:200:300\n")))
+		{
+			fprintf(stderr, "text message\n");
+			return 1;
+		}
+		if(test.pep.isBinary())
+		{
+			fprintf(stderr, "text protocol\n");
+			return 1;
+		}
+		if(test.pep.getPepRequestType() != PEP_REQUEST_ALLOCATION)
+		{
+			fprintf(stderr, "text allocation type\n");
+			return 1;
+		}
+		if(test.countRequests() != 2)
+		{
+			fprintf(stderr, "text allocations\n");
+			return 1;
+		}
+	}
+	{
+		TestPepInterface test;
+		if(!test.receive(textMessage("0:2:0:0:0\n1:3:100:200:300\n")))
+		{
+			fprintf(stderr, "mixed text message\n");
+			return 1;
+		}
+		if(test.pep.getPepRequestType() != PEP_REQUEST_RELEASE)
+		{
+			fprintf(stderr, "text release type\n");
+			return 1;
+		}
+		if(test.countReleases() != 1)
+		{
+			fprintf(stderr, "text releases, other type ignored\n");
+			return 1;
+		}
+		if(test.countRequests() != 0)
+		{
+			fprintf(stderr, "text allocations, other type ignored\n");
+			return 1;
+		}
+	}
+
+	// binary message split across reads
+	{
+		TestPepInterface test;
+		Rt::Data message = binaryMessage({PEP_REQUEST_ALLOCATION, PEP_REQUEST_ALLOCATION});
+		if(!test.receive(message.substr(0, 3)))
+		{
+			fprintf(stderr, "partial header\n");
+			return 1;
+		}
+		if(!test.pep.isBinary())
+		{
+			fprintf(stderr, "binary protocol\n");
+			return 1;
+		}
+		if(test.pep.getPepRequestType() != PEP_REQUEST_UNKNOWN)
+		{
+			fprintf(stderr, "partial header type\n");
+			return 1;
+		}
+		if(!test.receive(message.substr(3, sizeof(ncc_msg_hdr_t) + 5)))
+		{
+			fprintf(stderr, "partial commands\n");
+			return 1;
+		}
+		if(test.pep.getPepRequestType() != PEP_REQUEST_UNKNOWN)
+		{
+			fprintf(stderr, "partial commands type\n");
+			return 1;
+		}
+		if(test.countRequests() != 0)
+		{
+			fprintf(stderr, "no request before the message end\n");
+			return 1;
+		}
+		if(!test.receive(message.substr(sizeof(ncc_msg_hdr_t) + 8)))
+		{
+			fprintf(stderr, "message end\n");
+			return 1;
+		}
+		if(test.pep.getPepRequestType() != PEP_REQUEST_ALLOCATION)
+		{
+			fprintf(stderr, "split message type\n");
+			return 1;
+		}
+		if(test.countRequests() != 2)
+		{
+			fprintf(stderr, "split message allocations\n");
+			return 1;
+		}
+	}
+
+	// several binary messages of different types in a read, then the
+	// end of the last one in the next read
+	{
+		TestPepInterface test;
+		Rt::Data messages = binaryMessage({PEP_REQUEST_RELEASE}) +
+		                    binaryMessage({PEP_REQUEST_ALLOCATION, PEP_REQUEST_ALLOCATION}) +
+		                    binaryMessage({PEP_REQUEST_RELEASE, PEP_REQUEST_RELEASE});
+		std::size_t split = messages.size() - 4;
+		if(!test.receive(messages.substr(0, split)))
+		{
+			fprintf(stderr, "several messages\n");
+			return 1;
+		}
+		if(test.pep.getPepRequestType() != PEP_REQUEST_ALLOCATION)
+		{
+			fprintf(stderr, "several messages type\n");
+			return 1;
+		}
+		if(test.countRequests() != 2)
+		{
+			fprintf(stderr, "several messages allocations\n");
+			return 1;
+		}
+		if(test.countReleases() != 1)
+		{
+			fprintf(stderr, "several messages releases\n");
+			return 1;
+		}
+		if(!test.receive(messages.substr(split)))
+		{
+			fprintf(stderr, "last message end\n");
+			return 1;
+		}
+		if(test.pep.getPepRequestType() != PEP_REQUEST_RELEASE)
+		{
+			fprintf(stderr, "last message type\n");
+			return 1;
+		}
+		if(test.countReleases() != 2)
+		{
+			fprintf(stderr, "last message releases\n");
+			return 1;
+		}
+	}
+
+	// a release received while an allocation is pending is reported
+	// as such and does not release the allocation
+	{
+		TestPepInterface test;
+		if(!test.receive(binaryMessage({PEP_REQUEST_ALLOCATION})))
+		{
+			fprintf(stderr, "pending allocation\n");
+			return 1;
+		}
+		if(test.pep.getPepRequestType() != PEP_REQUEST_ALLOCATION)
+		{
+			fprintf(stderr, "pending allocation type\n");
+			return 1;
+		}
+		if(!test.receive(binaryMessage({PEP_REQUEST_RELEASE})))
+		{
+			fprintf(stderr, "release\n");
+			return 1;
+		}
+		if(test.pep.getPepRequestType() != PEP_REQUEST_RELEASE)
+		{
+			fprintf(stderr, "release type\n");
+			return 1;
+		}
+		if(test.countReleases() != 1)
+		{
+			fprintf(stderr, "release queued apart\n");
+			return 1;
+		}
+		if(test.countRequests() != 1)
+		{
+			fprintf(stderr, "allocation still pending\n");
+			return 1;
+		}
+	}
+
+	// the allocations are available once their delay expired, those
+	// received later wait for their own delay
+	{
+		TestPepInterface test;
+		test.pep.setAllocationDelay(time_ms_t(100));
+		if(!test.receive(binaryMessage({PEP_REQUEST_ALLOCATION})))
+		{
+			fprintf(stderr, "delayed allocation\n");
+			return 1;
+		}
+		if(test.countRequests() != 0)
+		{
+			fprintf(stderr, "allocation not available before its delay\n");
+			return 1;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(60));
+		if(!test.receive(binaryMessage({PEP_REQUEST_ALLOCATION, PEP_REQUEST_ALLOCATION})))
+		{
+			fprintf(stderr, "later allocations\n");
+			return 1;
+		}
+		if(!test.receive(binaryMessage({PEP_REQUEST_RELEASE})))
+		{
+			fprintf(stderr, "release with pending allocations\n");
+			return 1;
+		}
+		if(test.countReleases() != 1)
+		{
+			fprintf(stderr, "release available without delay\n");
+			return 1;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(60));
+		if(test.countRequests() != 1)
+		{
+			fprintf(stderr, "first allocation available after its delay\n");
+			return 1;
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(60));
+		if(test.countRequests() != 2)
+		{
+			fprintf(stderr, "later allocations available after their delay\n");
+			return 1;
+		}
+	}
+
+	// bad headers close the connection
+	{
+		TestPepInterface test;
+		if(!test.receive(binaryMessage({PEP_REQUEST_ALLOCATION})))
+		{
+			fprintf(stderr, "first message\n");
+			return 1;
+		}
+		if(test.receive(textMessage("1:2:100:200:300\n")))
+		{
+			fprintf(stderr, "bad magic\n");
+			return 1;
+		}
+		if(test.pep.getIsConnected())
+		{
+			fprintf(stderr, "bad magic closes\n");
+			return 1;
+		}
+	}
+	{
+		TestPepInterface test;
+		if(test.receive(binaryMessage({PEP_REQUEST_ALLOCATION}, NCC_MSG_VERSION + 1)))
+		{
+			fprintf(stderr, "bad version\n");
+			return 1;
+		}
+		if(test.countRequests() != 0)
+		{
+			fprintf(stderr, "bad version ignored\n");
+			return 1;
+		}
+	}
+	{
+		TestPepInterface test;
+		Rt::Data message = binaryMessage({PEP_REQUEST_ALLOCATION});
+		ncc_msg_hdr_t header;
+		memcpy(&header, message.data(), sizeof(header));
+		header.length = htonl(NCC_MSG_MAX_LENGTH + 1);
+		message.replace(0, sizeof(header), reinterpret_cast<const unsigned char *>(&header), sizeof(header));
+		if(test.receive(message))
+		{
+			fprintf(stderr, "too long message\n");
+			return 1;
+		}
+	}
+	{
+		TestPepInterface test;
+		Rt::Data message = binaryMessage({PEP_REQUEST_ALLOCATION, PEP_REQUEST_ALLOCATION});
+		ncc_msg_hdr_t header;
+		memcpy(&header, message.data(), sizeof(header));
+		header.count = htons(3);
+		message.replace(0, sizeof(header), reinterpret_cast<const unsigned char *>(&header), sizeof(header));
+		if(test.receive(message))
+		{
+			fprintf(stderr, "commands count not matching the length\n");
+			return 1;
+		}
+		if(test.countRequests() != 0)
+		{
+			fprintf(stderr, "bad count ignored\n");
+			return 1;
+		}
+	}
+
+	// bad commands are skipped
+	{
+		TestPepInterface test;
+		Rt::Data message = binaryMessage({PEP_REQUEST_ALLOCATION, PEP_REQUEST_UNKNOWN,
+		                                  PEP_REQUEST_RELEASE});
+		if(!test.receive(message))
+		{
+			fprintf(stderr, "message with bad commands\n");
+			return 1;
+		}
+		if(test.countRequests() != 1)
+		{
+			fprintf(stderr, "bad commands skipped\n");
+			return 1;
+		}
+		if(test.countReleases() != 0)
+		{
+			fprintf(stderr, "other type skipped\n");
+			return 1;
+		}
+	}
+
+	printf("NCC interface tests passed\n");
+	return 0;
+}
@@ -43,6 +43,9 @@
 #include "TerminalCategorySaloha.h"
 #include "OpenSandModelConf.h"
 
+#include <algorithm>
+#include <numeric>
+
 
 SlottedAloha::SlottedAloha():
 	sf_per_saframe(),
@@ -87,3 +90,35 @@ bool SlottedAloha::isSalohaFrameTick(time_sf_t superframe_counter)
 	return !(superframe_counter % this->sf_per_saframe);
 }
 
+void SlottedAloha::drawTimeSlots(CounterRng &rng,
+                                 std::vector<uint16_t> &positions,
+                                 unsigned int slots_per_carrier,
+                                 unsigned int carriers_number,
+                                 unsigned int count,
+                                 std::vector<uint16_t> &time_slots)
+{
+	time_slots.clear();
+	if(!slots_per_carrier || !carriers_number)
+	{
+		return;
+	}
+
+	// the permutation does not need to be reset between draws as
+	// a partial shuffle of any permutation gives uniform unique positions
+	if(positions.size() != slots_per_carrier)
+	{
+		positions.resize(slots_per_carrier);
+		std::iota(positions.begin(), positions.end(), 0);
+	}
+	count = std::min(count, slots_per_carrier);
+
+	for(unsigned int i = 0; i < count; i++)
+	{
+		unsigned int j = i + rng.below(slots_per_carrier - i);
+		std::swap(positions[i], positions[j]);
+		time_slots.push_back(rng.below(carriers_number) * slots_per_carrier +
+		                     positions[i]);
+	}
+	std::sort(time_slots.begin(), time_slots.end());
+}
+
@@ -39,8 +39,11 @@
 #include "EncapPlugin.h"
 #include "DvbFrame.h"
 #include "SlottedAlohaPacket.h"
+#include "CounterRng.h"
 #include <opensand_output/Output.h>
 
+#include <vector>
+
 
 /**
  * @class SlottedAloha
@@ -90,6 +93,26 @@ public:
 	 */
 	virtual bool onRcvFrame(Rt::Ptr<DvbFrame> frame) = 0;
 
+	/**
+	 * @brief Draw random unique time slots: unique positions in one carrier
+	 *        (to keep concept of chronology) with a partial Fisher-Yates
+	 *        shuffle, then a random carrier for each position to simulate
+	 *        frequency changes
+	 *
+	 * @param rng                The random generator
+	 * @param positions          The positions permutation, kept between draws
+	 * @param slots_per_carrier  The number of slots per carrier
+	 * @param carriers_number    The number of carriers
+	 * @param count              The number of time slots to draw
+	 * @param time_slots         OUT: the sorted time slots
+	 */
+	static void drawTimeSlots(CounterRng &rng,
+	                          std::vector<uint16_t> &positions,
+	                          unsigned int slots_per_carrier,
+	                          unsigned int carriers_number,
+	                          unsigned int count,
+	                          std::vector<uint16_t> &time_slots);
+
 protected:
 	/**
 	 * Return check if current tick is a Slotted Aloha frame tick
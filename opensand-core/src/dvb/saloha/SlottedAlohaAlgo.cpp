@@ -38,7 +38,10 @@
 #include "SlottedAlohaAlgo.h"
 
 
-SlottedAlohaAlgo::SlottedAlohaAlgo()
+SlottedAlohaAlgo::SlottedAlohaAlgo():
+	decoded(),
+	first_decoded(0),
+	last_decoded(0)
 {
 	this->log_saloha = Output::Get()->registerLog(LEVEL_WARNING, "Dvb.SlottedAlohaAlgo");
 }
@@ -46,3 +49,39 @@ SlottedAlohaAlgo::SlottedAlohaAlgo()
 SlottedAlohaAlgo::~SlottedAlohaAlgo()
 {
 }
+
+void SlottedAlohaAlgo::accept(Rt::Ptr<SlottedAlohaPacketData> packet)
+{
+	std::size_t bucket = packet->getNbReplicas() ? packet->getReplica(0) : packet->getTs();
+	if(bucket >= this->decoded.size())
+	{
+		this->decoded.resize(bucket + 1);
+	}
+	if(this->first_decoded == this->last_decoded)
+	{
+		this->first_decoded = bucket;
+		this->last_decoded = bucket + 1;
+	}
+	else
+	{
+		this->first_decoded = std::min(this->first_decoded, bucket);
+		this->last_decoded = std::max(this->last_decoded, bucket + 1);
+	}
+	this->decoded[bucket].push_back(std::move(packet));
+}
+
+void SlottedAlohaAlgo::flushAccepted(saloha_packets_data_t &accepted_packets)
+{
+	for(std::size_t bucket = this->first_decoded;
+	    bucket < this->last_decoded;
+	    ++bucket)
+	{
+		for(auto &&packet: this->decoded[bucket])
+		{
+			accepted_packets.push_back(std::move(packet));
+		}
+		this->decoded[bucket].clear();
+	}
+	this->first_decoded = 0;
+	this->last_decoded = 0;
+}
@@ -42,6 +42,7 @@
 #include <algorithm>
 #include <map>
 #include <set>
+#include <vector>
 
 
 /// A list of TS
@@ -70,15 +71,42 @@ public:
 	/**
 	 * Remove collisions with a specific algorithm
 	 *
-	 * @param slots    Slots containing the received Slotted Aloha data packets
-	 * @param fifo     the packets that are not collisionned
+	 * @param slots    Slots containing the received Slotted Aloha data packets,
+	 *                 emptied
+	 * @param fifo     the packets that are not collisionned, appended ordered
+	 *                 by their first replica slot
 	 * @return the number of collisionned packets
 	 */
-	virtual uint16_t removeCollisions(std::map<unsigned int, std::shared_ptr<Slot>> &slots,
+	virtual uint16_t removeCollisions(const saloha_slots_t &slots,
 	                                  saloha_packets_data_t &accepted_packets) = 0;
 
 protected:
+	/**
+	 * Keep a decoded packet until the end of the collisions removal
+	 *
+	 * @param packet  The decoded packet
+	 */
+	void accept(Rt::Ptr<SlottedAlohaPacketData> packet);
+
+	/**
+	 * Move the decoded packets in the accepted packets ordered by their
+	 * first replica slot, to be propagated in the order they were sent
+	 * by each terminal
+	 *
+	 * @param accepted_packets  The accepted packets
+	 */
+	void flushAccepted(saloha_packets_data_t &accepted_packets);
+
 	std::shared_ptr<OutputLog> log_saloha;
+
+private:
+	/// The decoded packets, per first replica slot; the buckets are kept
+	/// between Slotted Aloha frames to avoid allocations
+	std::vector<saloha_packets_data_t> decoded;
+
+	/// The range of non-empty buckets in decoded
+	std::size_t first_decoded;
+	std::size_t last_decoded;
 };
 
 
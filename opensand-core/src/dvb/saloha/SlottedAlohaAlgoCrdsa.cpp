@@ -47,7 +47,7 @@ SlottedAlohaAlgoCrdsa::~SlottedAlohaAlgoCrdsa()
 {
 }
 
-uint16_t SlottedAlohaAlgoCrdsa::removeCollisions(std::map<unsigned int, std::shared_ptr<Slot>> &slots,
+uint16_t SlottedAlohaAlgoCrdsa::removeCollisions(const saloha_slots_t &slots,
                                                  saloha_packets_data_t &accepted_packets)
 {
 	std::map<tal_id_t, std::vector<saloha_id_t> > accepted_ids;
@@ -61,9 +61,8 @@ uint16_t SlottedAlohaAlgoCrdsa::removeCollisions(std::map<unsigned int, std::sha
 	do
 	{
 		stop = true;
-		for(auto&& slot_it : slots)
+		for(auto&& slot : slots)
 		{
-			std::shared_ptr<Slot> slot = slot_it.second;
 			if(!slot->size())
 			{
 				continue;
@@ -111,7 +110,8 @@ uint16_t SlottedAlohaAlgoCrdsa::removeCollisions(std::map<unsigned int, std::sha
 				}
 
 				accepted_ids[tal_id].push_back(packet->getUniqueId());
-				accepted_packets.push_back(std::move(packet));
+				this->accept(std::move(packet));
+				slot->clear();
 				// packet is decoded, we need to restart the check all slots
 				// to remove the signal of this packet when a duplicate was found
 				stop = false;
@@ -129,9 +129,8 @@ uint16_t SlottedAlohaAlgoCrdsa::removeCollisions(std::map<unsigned int, std::sha
 	}
 	while(!stop);
 
-	for(auto&& slot_it : slots)
+	for(auto&& slot : slots)
 	{
-		std::shared_ptr<Slot> slot = slot_it.second;
 		// check for collisions here, we do not count collisions that were avoided
 		if(slot->size() > 1)
 		{
@@ -142,6 +141,7 @@ uint16_t SlottedAlohaAlgoCrdsa::removeCollisions(std::map<unsigned int, std::sha
 		}
 		slot->clear();
 	}
+	this->flushAccepted(accepted_packets);
 	return nbr_collisions;
 }
 
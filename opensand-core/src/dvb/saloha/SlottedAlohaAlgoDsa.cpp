@@ -47,16 +47,15 @@ SlottedAlohaAlgoDsa::~SlottedAlohaAlgoDsa()
 {
 }
 
-uint16_t SlottedAlohaAlgoDsa::removeCollisions(std::map<unsigned int, std::shared_ptr<Slot>> &slots,
+uint16_t SlottedAlohaAlgoDsa::removeCollisions(const saloha_slots_t &slots,
                                                saloha_packets_data_t &accepted_packets)
 {
 	std::map<tal_id_t, std::vector<saloha_id_t> > accepted_ids;
 	uint16_t nbr_collisions = 0;
 
 	// cf: DSA algorithm
-	for(auto&& slot_it : slots)
+	for(auto&& slot : slots)
 	{
-		std::shared_ptr<Slot> slot = slot_it.second;
 		saloha_packets_data_t::iterator pkt_it;
 		if(!slot->size())
 		{
@@ -84,7 +83,7 @@ uint16_t SlottedAlohaAlgoDsa::removeCollisions(std::map<unsigned int, std::share
 			{
 				// packet was not already received on another slot
 				accepted_ids[tal_id].push_back(packet->getUniqueId());
-				accepted_packets.push_back(std::move(packet));
+				this->accept(std::move(packet));
 				LOG(this->log_saloha, LEVEL_DEBUG,
 				    "No collision, keep packet from terminal %u\n",
 				    tal_id);
@@ -98,6 +97,7 @@ uint16_t SlottedAlohaAlgoDsa::removeCollisions(std::map<unsigned int, std::share
 		}
 		slot->clear();
 	}
+	this->flushAccepted(accepted_packets);
 	return nbr_collisions;
 }
 
@@ -51,7 +51,7 @@ public:
 	~SlottedAlohaAlgoDsa();
 
 private:
-	uint16_t removeCollisions(std::map<unsigned int, std::shared_ptr<Slot>> &slots,
+	uint16_t removeCollisions(const saloha_slots_t &slots,
 	                          saloha_packets_data_t &accepted_packets) override;
 };
 
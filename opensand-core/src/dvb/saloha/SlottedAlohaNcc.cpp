@@ -43,6 +43,7 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <algorithm>
 #include <opensand_rt/Types.h>
 
 
@@ -57,7 +58,8 @@ SlottedAlohaNcc::SlottedAlohaNcc():
 	spot_id(0),
 	terminals(),
 	algo(nullptr),
-	simu()
+	simu(),
+	probes()
 {
 }
 
@@ -86,6 +88,11 @@ void SlottedAlohaNcc::generateConfiguration(std::shared_ptr<OpenSANDConf::MetaPa
 	simu_list->addParameter("max_packets", "Max Packets", types->getType("ushort"))->setUnit("packets");
 	simu_list->addParameter("replicas", "Replicas", types->getType("ushort"))->setUnit("packets");
 	simu_list->addParameter("ratio", "Ratio", types->getType("ubyte"));
+	auto seed = simu_list->addParameter("seed",
+	                                    "Random Seed",
+	                                    types->getType("uint"),
+	                                    "Combined with the category to draw the simulated time slots");
+	seed->setAdvanced(true);
 }
 
 bool SlottedAlohaNcc::init(const TerminalCategories<TerminalCategorySaloha> &categories,
@@ -131,18 +138,19 @@ bool SlottedAlohaNcc::init(const TerminalCategories<TerminalCategorySaloha> &cat
 	{
 		cat->computeSlotsNumber(converter);
 
-		std::shared_ptr<Probe<int>> probe_coll = output->registerProbe<int>("Aloha.collisions." + label,
-		                                                                    true, SAMPLE_SUM);
+		SalohaCategoryProbes probes;
+		probes.collisions = output->registerProbe<int>("Aloha.collisions." + label,
+		                                               true, SAMPLE_SUM);
 		// disable by default
-		std::shared_ptr<Probe<int>> probe_coll_before = output->registerProbe<int>("Aloha.collisions.before_algo." + label,
-		                                                                            false, SAMPLE_SUM);
+		probes.collisions_before = output->registerProbe<int>("Aloha.collisions.before_algo." + label,
+		                                                      false, SAMPLE_SUM);
 		// disable by default
-		std::shared_ptr<Probe<int>> probe_coll_ratio = output->registerProbe<int>("Aloha.collisions_ratio." + label,
-		                                                                          "%", false, SAMPLE_AVG);
+		probes.collisions_ratio = output->registerProbe<int>("Aloha.collisions_ratio." + label,
+		                                                     "%", false, SAMPLE_AVG);
 
-		this->probe_collisions_before.emplace(label, probe_coll_before);
-		this->probe_collisions.emplace(label, probe_coll);
-		this->probe_collisions_ratio.emplace(label, probe_coll_ratio);
+		// categories are not modified after init, so the probes follow
+		// their iteration order
+		this->probes.push_back(probes);
 	}
 
 	if(!OpenSandModelConf::extractParameterData(conf->getComponent("random_access")->getParameter("saloha_algo"),
@@ -208,6 +216,10 @@ bool SlottedAlohaNcc::init(const TerminalCategories<TerminalCategorySaloha> &cat
 			return false;
 		}
 
+		// optional, 0 by default
+		uint32_t seed = 0;
+		OpenSandModelConf::extractParameterData(simulated_traffic->getParameter("seed"), seed);
+
 		// FIXME: as in manager we need at least one element in a table
 		//        to add a new line, we will have at least one line here.
 		//        So this is a way to ignore it
@@ -233,7 +245,8 @@ bool SlottedAlohaNcc::init(const TerminalCategories<TerminalCategorySaloha> &cat
 		this->simu.emplace_back(cat_iter->second,
 		                        nb_max_packets,
 		                        nb_replicas,
-		                        ratio);
+		                        ratio,
+		                        seed);
 	}
 
 	return true;
@@ -293,15 +306,14 @@ bool SlottedAlohaNcc::onRcvFrame(Rt::Ptr<DvbFrame> dvb_frame)
 		auto category = this->categories[terminal->getCurrentCategory()];
 
 		// Add replicas in the corresponding slots
-		auto slots = category->getSlots();
-		auto slot_it = slots.find(sa_packet->getTs());
-		if(slot_it == slots.end())
+		Slot *slot = category->getSlot(sa_packet->getTs());
+		if(!slot)
 		{
 			LOG(this->log_saloha, LEVEL_ERROR,
 			    "packet received on a slot that does not exist\n");
 			continue;
 		}
-		slot_it->second->push_back(std::move(sa_packet));
+		slot->push_back(std::move(sa_packet));
 		category->increaseReceivedPacketsNbr();
 	}
 
@@ -317,9 +329,11 @@ bool SlottedAlohaNcc::schedule(Rt::Ptr<NetBurst> &burst,
 	{
 		return true;
 	}
+	std::size_t index = 0;
 	for(auto &&[label, category]: this->categories)
 	{
-		if(!this->scheduleCategory(category, burst, complete_dvb_frames))
+		if(!this->scheduleCategory(category, this->probes[index++],
+		                           burst, complete_dvb_frames))
 		{
 			return false;
 		}
@@ -329,14 +343,15 @@ bool SlottedAlohaNcc::schedule(Rt::Ptr<NetBurst> &burst,
 
 
 bool SlottedAlohaNcc::scheduleCategory(std::shared_ptr<TerminalCategorySaloha> category,
+                                       SalohaCategoryProbes &probes,
                                        Rt::Ptr<NetBurst> &burst,
                                        std::list<Rt::Ptr<DvbFrame>> &complete_dvb_frames)
 {
 	Rt::Ptr<SlottedAlohaFrameCtrl> frame = Rt::make_ptr<SlottedAlohaFrameCtrl>(nullptr);
 	// refresh the probe in case of no traffic
-	this->probe_collisions[category->getLabel()]->put(0);
-	this->probe_collisions_before[category->getLabel()]->put(0);
-	this->probe_collisions_ratio[category->getLabel()]->put(0);
+	probes.collisions->put(0);
+	probes.collisions_before->put(0);
+	probes.collisions_ratio->put(0);
 	if(!category->getReceivedPacketsNbr())
 	{
 		LOG(this->log_saloha, LEVEL_DEBUG,
@@ -356,7 +371,7 @@ bool SlottedAlohaNcc::scheduleCategory(std::shared_ptr<TerminalCategorySaloha> c
 		return false;
 	}
 
-	for (const SlottedAlohaSimu& simulation: this->simu)
+	for (SlottedAlohaSimu& simulation: this->simu)
 	{
 		if (simulation.getCategory() == category->getLabel())
 		{
@@ -368,7 +383,7 @@ bool SlottedAlohaNcc::scheduleCategory(std::shared_ptr<TerminalCategorySaloha> c
 	LOG(this->log_saloha, LEVEL_DEBUG,
 	    "Remove collisions on category %s\n",
 	    category->getLabel().c_str());
-	this->removeCollisions(category); // Call specific algorithm to remove collisions
+	this->removeCollisions(category, probes); // Call specific algorithm to remove collisions
 
 	// create the Slotted Aloha control frame
 	try
@@ -503,84 +518,69 @@ Rt::Ptr<NetPacket> SlottedAlohaNcc::removeSalohaHeader(Rt::Ptr<SlottedAlohaPacke
 }
 
 
-void SlottedAlohaNcc::removeCollisions(std::shared_ptr<TerminalCategorySaloha> category)
+void SlottedAlohaNcc::removeCollisions(std::shared_ptr<TerminalCategorySaloha> category,
+                                       SalohaCategoryProbes &probes)
 {
 	// we remove collision per category as in the same category
 	// we do as if there was only one big carrier
 	uint16_t nbr;
-	unsigned int slots_per_carrier = floor(category->getSlotsNumber() / category->getCarriersNumber());
-	auto slots = category->getSlots();
-	AlohaPacketComparator comparator(slots_per_carrier);
+	const saloha_slots_t &slots = category->getSlots();
 	saloha_packets_data_t &accepted_packets = category->getAcceptedPackets();
 
-	if(this->probe_collisions_before[category->getLabel()]->isEnabled())
+	if(probes.collisions_before->isEnabled())
 	{
 		uint16_t coll = 0;
-		for (auto &&slot_it: slots)
+		for (auto &&slot: slots)
 		{
-			auto slot_size = slot_it.second->size();
+			auto slot_size = slot->size();
 			if(slot_size > 1)
 			{
 				coll += slot_size;
 			}
 		}
-		this->probe_collisions_before[category->getLabel()]->put(coll);
+		probes.collisions_before->put(coll);
 	}
+	// the algorithm gives the packets ordered by their first replica slot
+	// (i.e. in the order terminals sent them), no need to sort them
 	nbr = this->algo->removeCollisions(slots, accepted_packets);
-	this->probe_collisions[category->getLabel()]->put(nbr);
-	this->probe_collisions_ratio[category->getLabel()]->put(nbr * 100 / category->getSlotsNumber());
-	// Because of CRDSA algorithm for example, need to sort packets
-	sort(accepted_packets.begin(), accepted_packets.end(), comparator);
+	probes.collisions->put(nbr);
+	probes.collisions_ratio->put(nbr * 100 / category->getSlotsNumber());
 }
 
 void SlottedAlohaNcc::simulateTraffic(std::shared_ptr<TerminalCategorySaloha> category,
-                                      const SlottedAlohaSimu &simulation)
+                                      SlottedAlohaSimu &simulation)
 {
-	for(unsigned int cpt = 0; cpt < simulation.getNbTal(); cpt++)
+	uint16_t nb_replicas = simulation.getNbReplicas();
+	if(!nb_replicas)
 	{
-		saloha_ts_list_t tmp;
-		saloha_ts_list_t time_slots;
-		saloha_ts_list_t::iterator it;
-		uint16_t slots_per_carrier;
-		uint16_t slot;
-		uint16_t pdu_id;
-
-		slots_per_carrier = floor(category->getSlotsNumber() /
-		                          category->getCarriersNumber());
+		return;
+	}
+	uint16_t replicas[nb_replicas];
 
+	for(unsigned int cpt = 0; cpt < simulation.getNbTal(); cpt++)
+	{
 		// see SlottedAlohaTal
-		tmp.clear();
-		time_slots.clear();
-		while(tmp.size() < simulation.getNbPacketsPerTal())
-		{
-			slot = (rand() / (double)RAND_MAX) * slots_per_carrier;
-			tmp.insert(slot);
-		}
-		for(it = tmp.begin(); it != tmp.end(); ++it)
-		{
-			unsigned int slot_id = *it;
-			slot = (int)((rand() / (double)RAND_MAX) * category->getCarriersNumber()) *
-			       slots_per_carrier + slot_id;
-			time_slots.insert(slot);
-		}
+		const std::vector<uint16_t> &time_slots = simulation.drawTimeSlots();
+		uint16_t pdu_id = 0;
 
-
-		pdu_id = 0;
-		it = time_slots.begin();
-		while(it != time_slots.end())
+		for(std::size_t first = 0;
+		    first + nb_replicas <= time_slots.size();
+		    first += nb_replicas)
 		{
-			auto slots = category->getSlots();
-			uint16_t nb_replicas = simulation.getNbReplicas();
-			uint16_t replicas[nb_replicas];
-			for(uint16_t rep_cpt = 0; rep_cpt < nb_replicas; rep_cpt++)
-			{
-				replicas[rep_cpt] = *it;
-				it++;
-			}
- 
+			std::copy_n(time_slots.begin() + first, nb_replicas, replicas);
+
 			for(uint16_t rep_cpt = 0; rep_cpt < nb_replicas; rep_cpt++)
 			{
 				uint16_t slot_id = replicas[rep_cpt];
+				Slot *slot = category->getSlot(slot_id);
+				if(!slot)
+				{
+					LOG(this->log_saloha, LEVEL_WARNING,
+					    "simulated packet on slot %u that does not exist "
+					    "in category %s\n", slot_id,
+					    category->getLabel().c_str());
+					continue;
+				}
 				// we need a PDU ID else removeCollision will consider all
 				// packets the same, this will mislead CRDSA algorithm
 				auto sa_packet = Rt::make_ptr<SlottedAlohaPacketData>(
@@ -596,9 +596,7 @@ void SlottedAlohaNcc::simulateTraffic(std::shared_ptr<TerminalCategorySaloha> ca
 				sa_packet->setSrcTalId(BROADCAST_TAL_ID + 1 + cpt);
 				sa_packet->setReplicas(replicas, nb_replicas);
 				sa_packet->setTs(slot_id);
-				// no need to check here if id exists as we directly
-				// get info from the map itself to get IDs
-				slots[slot_id]->push_back(std::move(sa_packet));
+				slot->push_back(std::move(sa_packet));
 			}
 			pdu_id++;
 		}
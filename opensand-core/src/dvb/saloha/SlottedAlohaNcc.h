@@ -47,9 +47,20 @@
 #include "opensand_conf/MetaParameter.h"
 
 #include <list>
+#include <vector>
 
 class SlottedAlohaSimu;
 
+/**
+ * @brief The Slotted Aloha statistics of a category
+ */
+struct SalohaCategoryProbes
+{
+	std::shared_ptr<Probe<int>> collisions;
+	std::shared_ptr<Probe<int>> collisions_before;
+	std::shared_ptr<Probe<int>> collisions_ratio;
+};
+
 /**
  * @class SlottedAlohaNcc
  * @brief The Slotted Aloha class for NCC
@@ -81,11 +92,8 @@ private:
 	/// Parameters to simulate Slotted Aloha traffic
 	std::vector<SlottedAlohaSimu> simu;
 
-	typedef std::map<std::string, std::shared_ptr<Probe<int> > > probe_per_cat_t;
-	/// Statistics
-	probe_per_cat_t probe_collisions;
-	probe_per_cat_t probe_collisions_before;
-	probe_per_cat_t probe_collisions_ratio;
+	/// Statistics, per category index in categories
+	std::vector<SalohaCategoryProbes> probes;
 
 public:
 	SlottedAlohaNcc();
@@ -148,8 +156,10 @@ private:
 	 * @brief Call a specific algorithm to remove all collided packets
 	 *
 	 * @param category  The terminal category
+	 * @param probes    The statistics of the category
 	 */
-	void removeCollisions(std::shared_ptr<TerminalCategorySaloha> category);
+	void removeCollisions(std::shared_ptr<TerminalCategorySaloha> category,
+	                      SalohaCategoryProbes &probes);
 
 	/**
 	 * @brief Simulate traffic to get some performance statistics with minimal plateform
@@ -158,12 +168,13 @@ private:
 	 * @param simulation  The simulation parameters
 	 */
 	void simulateTraffic(std::shared_ptr<TerminalCategorySaloha> category,
-	                     const SlottedAlohaSimu &simulation);
+	                     SlottedAlohaSimu &simulation);
 
 	/**
 	 * Schedule Slotted Aloha packets per category
 	 *
 	 * @param category              The category to schedule on
+	 * @param probes                The statistics of the category
 	 * @param burst                 burst to build containing packets to
 	 *                              propagate to encap block
 	 * @param complete_dvb_frames   frames to attach Slotted Aloha frame to send
@@ -171,53 +182,11 @@ private:
 	 * @return true if packets were successful scheduled, false otherwise
 	 */
 	bool scheduleCategory(std::shared_ptr<TerminalCategorySaloha> category,
+	                      SalohaCategoryProbes &probes,
 	                      Rt::Ptr<NetBurst> &burst,
 	                      std::list<Rt::Ptr<DvbFrame>> &complete_dvb_frames);
 };
 
-/**
- * @class AlohaPacketComparator
- * @brief Functor to compare data Aloha packets for the std::sort function
- */
-class AlohaPacketComparator
-{
-public:
-	AlohaPacketComparator(uint16_t slots_per_carrier):
-		slots_per_carrier(slots_per_carrier)
-	{};
-
-	/**
-	 * Sort packets after removing algorithm to propagate packets to encap block
-	 * in the correct order. This method is a std::sort callback called for
-	 * each iteration
-	 *
-	 * @param pkt1  first packet to compare
-	 * @param pkt2  second packet to compare
-	 *
-	 * @return true if order is good, false otherwise
-	 */
-	bool operator()(const Rt::Ptr<SlottedAlohaPacketData>& pkt1,
-	                const Rt::Ptr<SlottedAlohaPacketData>& pkt2)
-	{
-		uint16_t replica_1 = pkt1->getReplica(0);
-		uint16_t replica_2 = pkt2->getReplica(0);
-
-		// First replica slot allows ordering
-		// TODO in terminal, we use slots sorted in the entire category,
-		// not per carrier => no module here !
-		return (((replica_1 /*% this->slots_per_carrier*/) <
-		         (replica_2 /*% this->slots_per_carrier*/)) &&
-		        (pkt1->getSrcTalId() == pkt2->getSrcTalId()) &&
-		        (pkt1->getSrcTalId())); // no need to sort simulated traffic
-	};
-
-private:
-	/// The slots per carrier
-	uint16_t slots_per_carrier; // TODO we work per category, not useful,
-	                            //      see upper todo
-};
-
-
 /**
  * @class SlottedAlohaSimu
  * @brief Parameters for Slotted Aloha traffic simulation on a category
@@ -232,34 +201,50 @@ public:
 	 * @param nb_max_packets  The maximum number of packets on the category
 	 * @param nb_replicas     The number of replicas
 	 * @param ratio           The ratio of the band the traffic should occupy
+	 * @param seed            The seed of the simulation, combined with the
+	 *                        category label to draw the time slots
 	 */
 	SlottedAlohaSimu(std::shared_ptr<const TerminalCategorySaloha> category,
 	                 uint16_t nb_max_packets,
 	                 uint16_t nb_replicas,
-	                 uint8_t ratio):
+	                 uint8_t ratio,
+	                 uint32_t seed):
 		cat_label(category->getLabel()),
-		nb_replicas(nb_replicas)
+		nb_replicas(nb_replicas),
+		slots_per_carrier(0),
+		nb_carriers(category->getCarriersNumber()),
+		rng(),
+		positions(),
+		time_slots()
 	{
 		uint16_t nb_packets;
 		uint16_t nb_slots;
-		uint16_t slots_per_carrier;
+		uint32_t label_hash = 2166136261U;
+
+		// FNV-1a hash of the label, so each category gets its own stream
+		for(unsigned char c: this->cat_label)
+		{
+			label_hash = (label_hash ^ c) * 16777619U;
+		}
+		this->rng = CounterRng{(uint64_t(seed) << 32) | label_hash};
 
 		this->log_init = Output::Get()->registerLog(LEVEL_WARNING, "Dvb.init");
-		slots_per_carrier = floor(category->getSlotsNumber() /
-		                          category->getCarriersNumber());
-	
+
+		this->slots_per_carrier = floor(category->getSlotsNumber() /
+		                                category->getCarriersNumber());
+
 		nb_slots = round((category->getSlotsNumber() * ratio) / 100);
 		nb_packets = nb_slots * this->nb_replicas;
 		this->nb_tal = floor(nb_slots / nb_max_packets);
 		this->nb_packets_per_tal = floor(nb_slots / nb_tal) * this->nb_replicas;
-		if(this->nb_packets_per_tal > slots_per_carrier)
+		if(this->nb_packets_per_tal > this->slots_per_carrier)
 		{
 			LOG(this->log_init, LEVEL_WARNING,
 			    "The simulation traffic is too high for category %s, "
 			    "please consider modifying nb_max_packets. Too many packet "
 			    "per terminal\n", this->cat_label.c_str());
 			// set maxium packets per terminal and adjust terminal number
-			this->nb_packets_per_tal = floor(slots_per_carrier / this->nb_replicas) *
+			this->nb_packets_per_tal = floor(this->slots_per_carrier / this->nb_replicas) *
 			                           this->nb_replicas;
 			this->nb_tal = floor(nb_packets /
 			                     (this->nb_packets_per_tal / this->nb_replicas));
@@ -315,6 +300,21 @@ public:
 		return this->nb_replicas;
 	};
 
+	/**
+	 * @brief Draw the random unique time slots of one simulated terminal
+	 *
+	 * @return the sorted time slots, valid until the next draw
+	 */
+	const std::vector<uint16_t> &drawTimeSlots(void)
+	{
+		SlottedAloha::drawTimeSlots(this->rng, this->positions,
+		                            this->slots_per_carrier,
+		                            this->nb_carriers,
+		                            this->nb_packets_per_tal,
+		                            this->time_slots);
+		return this->time_slots;
+	};
+
 protected:
 	// TODO this would be better to do something more random with mean nbr of pkt per tal,
 	//      mean number of tal
@@ -326,6 +326,16 @@ protected:
 	tal_id_t nb_tal;
 	/// The number of packets per terminal
 	uint16_t nb_packets_per_tal;
+	/// The slots per carrier
+	unsigned int slots_per_carrier;
+	/// The number of carriers
+	unsigned int nb_carriers;
+	/// The random generator of the simulated traffic
+	CounterRng rng;
+	/// The positions permutation used to draw time slots
+	std::vector<uint16_t> positions;
+	/// The time slots of the current simulated terminal
+	std::vector<uint16_t> time_slots;
 	/// Logger
 	std::shared_ptr<OutputLog> log_init;
 };
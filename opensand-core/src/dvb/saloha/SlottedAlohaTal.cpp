@@ -60,7 +60,10 @@ SlottedAlohaTal::SlottedAlohaTal():
 	base_id(0),
 	backoff(nullptr),
 	category(NULL),
-	dvb_fifos()
+	dvb_fifos(),
+	rng(),
+	positions(),
+	drawn_slots()
 {
 }
 
@@ -105,6 +108,7 @@ bool SlottedAlohaTal::init(tal_id_t tal_id,
 	}
 
 	this->tal_id = tal_id;
+	this->rng = CounterRng{tal_id};
 	this->category = category;
 	this->category->computeSlotsNumber(converter);
 
@@ -575,12 +579,9 @@ skip:
 
 saloha_ts_list_t SlottedAlohaTal::getTimeSlots(void)
 {
-	saloha_ts_list_t tmp;
 	saloha_ts_list_t time_slots;
 	uint16_t max;
 	uint16_t nb_packets;
-	uint16_t slot;
-	saloha_ts_list_t::iterator id;
 	// slots per carrier is a mean because we may have carriers groups
 	// with different parameters
 	unsigned int slots_per_carrier = floor(this->category->getSlotsNumber() /
@@ -602,23 +603,16 @@ saloha_ts_list_t SlottedAlohaTal::getTimeSlots(void)
 		    "Compute timeslots, %u packets to send\n", max / this->nb_replicas);
 	}
 
-	// First step: generate random unique time slots about number of slots for
-	//             one carrier (to keep concept of chronology)
-	while(tmp.size() < max)
+	SlottedAloha::drawTimeSlots(this->rng, this->positions,
+	                            slots_per_carrier,
+	                            this->category->getCarriersNumber(),
+	                            max, this->drawn_slots);
+	for(uint16_t slot: this->drawn_slots)
 	{
-		slot = (rand() / (double)RAND_MAX) * slots_per_carrier;
-		tmp.insert(slot);
-	}
-	// Second step: calculate a random position between carriers, to simulate
-	//              frequency changes
-	for(id = tmp.begin(); id != tmp.end(); ++id)
-	{
-		slot = (int)((rand() / (double)RAND_MAX) * this->category->getCarriersNumber()) *
-		       slots_per_carrier + (*id);
-		time_slots.insert(slot);
 		LOG(this->log_saloha, LEVEL_DEBUG,
 		    "Add random time slot %u\n", slot);
 	}
+	time_slots.insert(this->drawn_slots.begin(), this->drawn_slots.end());
 	// time slots is a ordonned set
 	return time_slots;
 }
@@ -96,6 +96,15 @@ private:
 	/// The DVB fifos
 	std::shared_ptr<fifos_t> dvb_fifos;
 
+	/// The random generator for time slots, keyed by the terminal ID
+	CounterRng rng;
+
+	/// The positions permutation used to draw time slots
+	std::vector<uint16_t> positions;
+
+	/// The drawn time slots
+	std::vector<uint16_t> drawn_slots;
+
 	//TODO in opensandcore.h
 	typedef std::map<qos_t, std::shared_ptr<Probe<int> > > probe_per_qos_t;
 	/// Statistics
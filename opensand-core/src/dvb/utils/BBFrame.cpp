@@ -98,17 +98,23 @@ bool BBFrame::addPacket(const NetPacket &packet)
 	is_added = DvbFrameTpl<T_DVB_BBFRAME>::addPacket(packet);
 	if(is_added)
 	{
-		this->setMessageLength(this->getMessageLength() + packet.getTotalLength());
-		this->frame()->data_length = htons(this->num_packets);
+		this->packetAdded(packet.getTotalLength());
 	}
 
 	return is_added;
 }
 
+void BBFrame::packetAdded(std::size_t length)
+{
+	this->setMessageLength(this->getMessageLength() + length);
+	this->frame()->data_length = htons(this->num_packets);
+}
+
 // TODO not used => remove ?!
 void BBFrame::empty()
 {
 	// remove the payload
+	this->finishWrite();
 	this->data.erase(sizeof(T_DVB_BBFRAME));
 	this->num_packets = 0;
 
@@ -84,6 +84,11 @@ public:
 	bool addPacket(const NetPacket &packet) override;
 	void empty() override;
 
+protected:
+	void packetAdded(std::size_t length) override;
+
+public:
+
 	// BB frame specific
 
 	/**
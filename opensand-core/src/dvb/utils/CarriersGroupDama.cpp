@@ -48,7 +48,8 @@ CarriersGroupDama::CarriersGroupDama(unsigned int carriers_id,
 	remaining_capacity(0),
 	previous_capacity(0),
 	previous_sf(0),
-	vcm_carriers()
+	vcm_carriers(),
+	terminals()
 {
 }
 
@@ -139,3 +140,8 @@ std::vector<CarriersGroupDama> &CarriersGroupDama::getVcmCarriers()
 {
 	return this->vcm_carriers;
 }
+
+TerminalTableDama &CarriersGroupDama::getTerminals()
+{
+	return this->terminals;
+}
@@ -38,6 +38,7 @@
 #define _CARRIERS_GROUP_DAMA_H_
 
 #include "CarriersGroup.h"
+#include "TerminalTableDama.h"
 
 
 /**
@@ -128,6 +129,13 @@ public:
 	 */
 	std::vector<CarriersGroupDama> &getVcmCarriers();
 
+	/**
+	 * @brief Get the terminals currently served by this carriers group
+	 *
+	 * @return the terminals table
+	 */
+	TerminalTableDama &getTerminals();
+
 protected:
 	/** The remaining capacity on the current frame */
 	unsigned int remaining_capacity;
@@ -142,6 +150,10 @@ protected:
 	 *  the entire frame (total ratio, total capacity, ...) and each VCM part
 	 *  is instantiated into a new carriers group */
 	std::vector<CarriersGroupDama> vcm_carriers;
+
+	/** The terminals served by this carriers group,
+	 *  maintained by the terminal category */
+	TerminalTableDama terminals;
 };
 
 
@@ -35,12 +35,55 @@
 
 #include <unistd.h>
 #include <stdlib.h>
+#include <algorithm>
+#include <cmath>
 #include <cstring>
+#include <netinet/in.h>
 
 #include <opensand_output/Output.h>
 
 #include "DvbFifo.h"
 #include "FifoElement.h"
+#include "NetPacket.h"
+#include "OpenSandModelConf.h"
+
+
+/// The number of flows of the fair queuing discipline
+constexpr const std::size_t FQ_FLOWS_NUMBER = 1024;
+/// The bytes a flow may send per round of the fair queuing discipline
+constexpr const int32_t FQ_QUANTUM = MAX_ETHERNET_SIZE;
+/// The default acceptable sojourn time of the fair queuing discipline
+constexpr const uint32_t FQ_CODEL_TARGET_MS = 5;
+/// The default time above target before dropping of the fair queuing discipline
+constexpr const uint32_t FQ_CODEL_INTERVAL_MS = 100;
+
+
+/**
+ * @brief Add a value to a counter that has a single writer at a time,
+ *        without the cost of an atomic read-modify-write
+ *
+ * @param counter  the counter
+ * @param value    the value to add
+ */
+template<typename T>
+static inline void addToCounter(std::atomic<T> &counter, T value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) + value,
+	              std::memory_order_relaxed);
+}
+
+/**
+ * @brief Substract a value from a counter that has a single writer at a time
+ *
+ * @param counter  the counter
+ * @param value    the value to substract
+ */
+template<typename T>
+static inline void subFromCounter(std::atomic<T> &counter, T value)
+{
+	counter.store(counter.load(std::memory_order_relaxed) - value,
+	              std::memory_order_relaxed);
+}
 
 
 ForwardOrReturnAccessType::ForwardOrReturnAccessType():
@@ -118,7 +161,13 @@ DvbFifo::DvbFifo(unsigned int fifo_priority, std::string fifo_name,
 	cur_length_bytes(0),
 	new_length_bytes(0),
 	carrier_id(0),
-	cni(0)
+	cni(0),
+	fair_queuing(false),
+	codel_target(5),
+	codel_interval(100),
+	flows(),
+	new_flows(),
+	old_flows()
 {
 	// Output log
 	this->log_dvb_fifo = Output::Get()->registerLog(LEVEL_WARNING, "Dvb.Fifo");
@@ -170,7 +219,13 @@ DvbFifo::DvbFifo(uint8_t carrier_id,
 	new_size_pkt(0),
 	cur_length_bytes(0),
 	new_length_bytes(0),
-	carrier_id(carrier_id)
+	carrier_id(carrier_id),
+	fair_queuing(false),
+	codel_target(5),
+	codel_interval(100),
+	flows(),
+	new_flows(),
+	old_flows()
 {
 	// Output log
 	this->log_dvb_fifo = Output::Get()->registerLog(LEVEL_WARNING, "Dvb.Fifo");
@@ -209,30 +264,27 @@ uint8_t DvbFifo::getCarrierId() const
 
 vol_pkt_t DvbFifo::getNewSize() const
 {
-	Rt::Lock lock(this->fifo_mutex);
-	return this->new_size_pkt;
+	return this->new_size_pkt.load(std::memory_order_relaxed);
 }
 
 vol_bytes_t DvbFifo::getNewDataLength() const
 {
-	Rt::Lock lock(this->fifo_mutex);
-	return this->new_length_bytes;
+	return this->new_length_bytes.load(std::memory_order_relaxed);
 }
 
 void DvbFifo::resetNew(const ForwardOrReturnAccessType cr_type)
 {
 	if(this->access_type == cr_type)
 	{
-		Rt::Lock lock(this->fifo_mutex);
-		this->new_size_pkt = 0;
-		this->new_length_bytes = 0;
+		auto lock = this->acquire();
+		this->new_size_pkt.store(0, std::memory_order_relaxed);
+		this->new_length_bytes.store(0, std::memory_order_relaxed);
 	}
 }
 
 vol_bytes_t DvbFifo::getCurrentDataLength() const
 {
-	Rt::Lock lock(this->fifo_mutex);
-	return this->cur_length_bytes;
+	return this->cur_length_bytes.load(std::memory_order_relaxed);
 }
 
 void DvbFifo::setCni(uint8_t cni)
@@ -249,8 +301,44 @@ bool DvbFifo::push(Rt::Ptr<NetContainer> elem, time_ms_t duration)
 {
 	vol_bytes_t length = elem->getTotalLength();
 
-	Rt::Lock lock(this->fifo_mutex);
-	if (!this->DelayFifo::push(std::move(elem), duration))
+	auto lock = this->acquire();
+	if (this->fair_queuing)
+	{
+		std::size_t flow_id = getFlowId(*elem);
+		if (this->queue.size() >= this->max_size_pkt)
+		{
+			this->dropFromBiggestFlow();
+		}
+		FifoFlow &flow = this->flows[flow_id];
+		// the packets of a flow are served in order, they must be ready
+		// in order too so that the oldest ready packet is a flow head
+		if (!flow.packets.empty())
+		{
+			auto last_date = flow.packets.back()->first;
+			auto end_date = std::chrono::high_resolution_clock::now() + duration;
+			if (end_date < last_date)
+			{
+				duration = std::chrono::ceil<time_ms_t>(last_date - end_date + duration);
+			}
+		}
+		auto pos = this->insert(std::move(elem), duration);
+		if (pos == this->queue.end())
+		{
+			this->stat_context.drop_pkt_nbr++;
+			this->stat_context.drop_bytes += length;
+			return false;
+		}
+
+		flow.packets.push_back(pos);
+		flow.length_bytes += length;
+		if (!flow.active)
+		{
+			flow.active = true;
+			flow.deficit = FQ_QUANTUM;
+			this->new_flows.push_back(flow_id);
+		}
+	}
+	else if (!this->DelayFifo::push(std::move(elem), duration))
 	{
 		this->stat_context.drop_pkt_nbr++;
 		this->stat_context.drop_bytes += length;
@@ -258,17 +346,17 @@ bool DvbFifo::push(Rt::Ptr<NetContainer> elem, time_ms_t duration)
 	}
 
 	// update counter
-	this->new_size_pkt++;
+	addToCounter<vol_pkt_t>(this->new_size_pkt, 1);
 	this->stat_context.current_pkt_nbr = this->queue.size();
 	this->stat_context.in_pkt_nbr++;
-	this->new_length_bytes += length;
-	this->cur_length_bytes += length;
+	addToCounter(this->new_length_bytes, length);
+	addToCounter(this->cur_length_bytes, length);
 	this->stat_context.current_length_bytes += length;
 	this->stat_context.in_length_bytes += length;
 
 	LOG(this->log_dvb_fifo, LEVEL_INFO,
 	    "Added %u bytes, new size is %u bytes\n",
-	    length, this->cur_length_bytes);
+	    length, this->getCurrentDataLength());
 
 	return true;
 }
@@ -276,57 +364,426 @@ bool DvbFifo::push(Rt::Ptr<NetContainer> elem, time_ms_t duration)
 
 std::unique_ptr<FifoElement> DvbFifo::pop()
 {
-	Rt::Lock lock(this->fifo_mutex);
+	auto lock = this->acquire();
 
-	auto elem = this->queue.begin();
-	if (elem != this->queue.end())
+	if (!this->fair_queuing)
+	{
+		auto elem = this->queue.begin();
+		if (elem != this->queue.end())
+		{
+			return this->extract(elem, false);
+		}
+		return {nullptr};
+	}
+
+	// deficit round robin over the active flows, the new ones first,
+	// the flows whose head is not ready yet are set aside for this round
+	auto now = std::chrono::high_resolution_clock::now();
+	std::deque<std::size_t> waiting_new_flows;
+	std::deque<std::size_t> waiting_old_flows;
+	std::unique_ptr<FifoElement> result{nullptr};
+	while (!this->new_flows.empty() || !this->old_flows.empty())
+	{
+		bool is_new = !this->new_flows.empty();
+		auto &active_flows = is_new ? this->new_flows : this->old_flows;
+		std::size_t flow_id = active_flows.front();
+		FifoFlow &flow = this->flows[flow_id];
+
+		if (flow.deficit <= 0)
+		{
+			flow.deficit += FQ_QUANTUM;
+			active_flows.pop_front();
+			this->old_flows.push_back(flow_id);
+			continue;
+		}
+
+		result = this->dequeueFlow(flow, now);
+		if (!result && !flow.packets.empty())
+		{
+			active_flows.pop_front();
+			(is_new ? waiting_new_flows : waiting_old_flows).push_back(flow_id);
+			continue;
+		}
+		if (!result)
+		{
+			// an emptied new flow goes through the old ones once so that
+			// a flow cannot get ahead by sending packets one at a time
+			active_flows.pop_front();
+			if (is_new)
+			{
+				this->old_flows.push_back(flow_id);
+			}
+			else
+			{
+				flow.active = false;
+			}
+			continue;
+		}
+
+		flow.deficit -= result->getTotalLength();
+		break;
+	}
+
+	// the flows set aside keep their place
+	this->new_flows.insert(this->new_flows.begin(),
+	                       waiting_new_flows.begin(), waiting_new_flows.end());
+	this->old_flows.insert(this->old_flows.begin(),
+	                       waiting_old_flows.begin(), waiting_old_flows.end());
+	return result;
+}
+
+
+std::unique_ptr<FifoElement> DvbFifo::extract(queue_iterator_t pos, bool dropped)
+{
+	std::unique_ptr<FifoElement> result = std::move(pos->second);
+	vol_bytes_t length = result->getTotalLength();
+
+	// remove the packet
+	this->queue.erase(pos);
+	this->updateSize();
+	subFromCounter(this->cur_length_bytes, length);
+
+	// update counters
+	this->stat_context.current_pkt_nbr = this->queue.size();
+	this->stat_context.current_length_bytes -= length;
+	if (dropped)
+	{
+		this->stat_context.drop_pkt_nbr++;
+		this->stat_context.drop_bytes += length;
+	}
+	else
 	{
-		std::unique_ptr<FifoElement> result = std::move(elem->second);
-		vol_bytes_t length = result->getTotalLength();
-	
-		// remove the packet
-		this->queue.erase(elem);
-		this->cur_length_bytes -= length;
-	
-		// update counters
-		this->stat_context.current_pkt_nbr = this->queue.size();
 		this->stat_context.out_pkt_nbr++;
-	
-		this->stat_context.current_length_bytes -= length;
 		this->stat_context.out_length_bytes += length;
-	
-		LOG(this->log_dvb_fifo, LEVEL_INFO,
-		    "Removed %u bytes, new size is %u bytes\n",
-		    length, this->cur_length_bytes);
+	}
+
+	LOG(this->log_dvb_fifo, LEVEL_INFO,
+	    "%s %u bytes, new size is %u bytes\n",
+	    dropped ? "Dropped" : "Removed",
+	    length, this->getCurrentDataLength());
+
+	return result;
+}
+
 
-		return result;
+std::unique_ptr<FifoElement> DvbFifo::dequeueFlow(FifoFlow &flow, time_point_t now)
+{
+	auto control_law = [this](uint32_t count)
+	{
+		return std::chrono::duration_cast<std::chrono::high_resolution_clock::duration>(
+			this->codel_interval / std::sqrt(count));
+	};
+
+	// whether a ready packet other than the one at pos remains in the fifo
+	auto other_ready = [this, now](queue_iterator_t pos)
+	{
+		auto first = this->queue.begin();
+		if (first == pos)
+		{
+			++first;
+		}
+		return first != this->queue.end() && first->first <= now;
+	};
+
+	while (!flow.packets.empty() && flow.packets.front()->first <= now)
+	{
+		queue_iterator_t pos = flow.packets.front();
+		flow.packets.pop_front();
+		vol_bytes_t length = pos->second->getTotalLength();
+		flow.length_bytes -= std::min(length, flow.length_bytes);
+
+		// never drop the last ready packet of the fifo, the scheduling
+		// expects an element as long as the oldest one is ready
+		bool above_target = (now - pos->first) > this->codel_target &&
+		                    other_ready(pos);
+		if (!above_target)
+		{
+			flow.first_above_time = time_point_t{};
+			flow.dropping = false;
+			return this->extract(pos, false);
+		}
+
+		if (!flow.dropping)
+		{
+			if (flow.first_above_time == time_point_t{})
+			{
+				flow.first_above_time = now + this->codel_interval;
+				return this->extract(pos, false);
+			}
+			if (now < flow.first_above_time)
+			{
+				return this->extract(pos, false);
+			}
+			// above target for a whole interval, start dropping
+			flow.dropping = true;
+			flow.drop_count = 1;
+			flow.drop_next = now + control_law(flow.drop_count);
+			this->extract(pos, true);
+			continue;
+		}
+
+		if (now < flow.drop_next)
+		{
+			return this->extract(pos, false);
+		}
+		flow.drop_count++;
+		flow.drop_next += control_law(flow.drop_count);
+		this->extract(pos, true);
 	}
 
 	return {nullptr};
 }
 
 
+void DvbFifo::dropFromBiggestFlow()
+{
+	FifoFlow *biggest = nullptr;
+	for (auto &&flow: this->flows)
+	{
+		if (!flow.packets.empty() &&
+		    (biggest == nullptr || flow.length_bytes > biggest->length_bytes))
+		{
+			biggest = &flow;
+		}
+	}
+	if (biggest == nullptr)
+	{
+		return;
+	}
+
+	queue_iterator_t pos = biggest->packets.front();
+	biggest->packets.pop_front();
+	vol_bytes_t length = pos->second->getTotalLength();
+	biggest->length_bytes -= std::min(length, biggest->length_bytes);
+	this->extract(pos, true);
+}
+
+
+std::size_t DvbFifo::getFlowId(const NetContainer &elem)
+{
+	// FNV-1a over the fields identifying the flow
+	uint32_t hash = 2166136261u;
+	auto add = [&hash](const uint8_t *bytes, std::size_t length)
+	{
+		for (std::size_t i = 0; i < length; i++)
+		{
+			hash = (hash ^ bytes[i]) * 16777619u;
+		}
+	};
+
+	const NetPacket *packet = dynamic_cast<const NetPacket *>(&elem);
+	if (packet == nullptr)
+	{
+		return 0;
+	}
+
+	uint8_t tal_ids[2] = {packet->getSrcTalId(), packet->getDstTalId()};
+	add(tal_ids, sizeof(tal_ids));
+
+	const uint8_t *data = packet->getRawData();
+	std::size_t length = packet->getTotalLength();
+	std::size_t offset = 0;
+	uint16_t ether_type = 0;
+	switch (packet->getType())
+	{
+		case NET_PROTO::ETH:
+			// skip the MAC addresses and the VLAN tags
+			offset = 12;
+			while (offset + 2 <= length)
+			{
+				ether_type = (data[offset] << 8) | data[offset + 1];
+				offset += 2;
+				if (ether_type != ETH_P_8021Q && ether_type != ETH_P_8021AD &&
+				    ether_type != uint16_t(NET_PROTO::IEEE_802_1AD))
+				{
+					break;
+				}
+				offset += 2;
+			}
+			break;
+		case NET_PROTO::IP:
+		case NET_PROTO::IPV4:
+		case NET_PROTO::IPV6:
+			if (length > 0)
+			{
+				ether_type = (data[0] >> 4) == 6 ? ETH_P_IPV6 : ETH_P_IP;
+			}
+			break;
+		default:
+			break;
+	}
+
+	// addresses, protocol and ports of the L3/L4 headers
+	std::size_t l4_offset = 0;
+	uint8_t protocol = 0;
+	if (ether_type == ETH_P_IP && offset + 20 <= length)
+	{
+		protocol = data[offset + 9];
+		add(data + offset + 12, 8);
+		l4_offset = offset + (data[offset] & 0x0f) * 4;
+	}
+	else if (ether_type == ETH_P_IPV6 && offset + 40 <= length)
+	{
+		protocol = data[offset + 6];
+		add(data + offset + 8, 32);
+		l4_offset = offset + 40;
+	}
+	add(&protocol, 1);
+	if ((protocol == IPPROTO_TCP || protocol == IPPROTO_UDP) &&
+	    l4_offset + 4 <= length)
+	{
+		add(data + l4_offset, 4);
+	}
+
+	return hash % FQ_FLOWS_NUMBER;
+}
+
+
 void DvbFifo::flush()
 {
-	Rt::Lock lock(this->fifo_mutex);
+	auto lock = this->acquire();
 	this->queue.clear();
-	this->new_size_pkt = 0;
-	this->new_length_bytes = 0;
-	this->cur_length_bytes = 0;
+	this->updateSize();
+	for (auto &&flow: this->flows)
+	{
+		flow = FifoFlow{};
+	}
+	this->new_flows.clear();
+	this->old_flows.clear();
+	this->new_size_pkt.store(0, std::memory_order_relaxed);
+	this->new_length_bytes.store(0, std::memory_order_relaxed);
+	this->cur_length_bytes.store(0, std::memory_order_relaxed);
 	this->resetStats();
 }
 
 
+void DvbFifo::enableFairQueuing(time_ms_t target, time_ms_t interval)
+{
+	auto lock = this->acquire();
+	if (this->fair_queuing)
+	{
+		return;
+	}
+
+	this->codel_target = target;
+	this->codel_interval = interval;
+	this->flows.assign(FQ_FLOWS_NUMBER, FifoFlow{});
+	// already queued packets are spread in their flows, in arrival order
+	for (auto pos = this->queue.begin(); pos != this->queue.end(); ++pos)
+	{
+		std::size_t flow_id = 0;
+		vol_bytes_t length = 0;
+		if (pos->second && *(pos->second))
+		{
+			Rt::Ptr<NetContainer> elem = pos->second->releaseElem();
+			flow_id = getFlowId(*elem);
+			length = elem->getTotalLength();
+			pos->second->setElem(std::move(elem));
+		}
+		FifoFlow &flow = this->flows[flow_id];
+		flow.packets.push_back(pos);
+		flow.length_bytes += length;
+		if (!flow.active)
+		{
+			flow.active = true;
+			flow.deficit = FQ_QUANTUM;
+			this->new_flows.push_back(flow_id);
+		}
+	}
+	this->fair_queuing = true;
+
+	LOG(this->log_dvb_fifo, LEVEL_NOTICE,
+	    "FIFO %s: fair queuing enabled (target %u ms, interval %u ms)\n",
+	    this->fifo_name.c_str(), target.count(), interval.count());
+}
+
+
+void DvbFifo::addFairQueuingParameters(std::shared_ptr<OpenSANDConf::MetaComponent> fifo)
+{
+	auto types = OpenSandModelConf::Get()->getModelTypesDefinition();
+
+	auto fair_queuing = fifo->getOrCreateParameter("fair_queuing", "Fair Queuing", types->getType("bool"),
+	                                               "Serve the flows of the FIFO fairly and drop "
+	                                               "the packets staying too long in it");
+	fair_queuing->setAdvanced(true);
+	auto codel_target = fifo->getOrCreateParameter("codel_target", "Target Sojourn Time", types->getType("uint"),
+	                                               "Acceptable time spent in the FIFO, "
+	                                               "defaults to " + std::to_string(FQ_CODEL_TARGET_MS) + " ms");
+	codel_target->setUnit("ms");
+	codel_target->setAdvanced(true);
+	auto codel_interval = fifo->getOrCreateParameter("codel_interval", "Sojourn Time Interval", types->getType("uint"),
+	                                                 "Time spent above the target sojourn time before dropping, "
+	                                                 "defaults to " + std::to_string(FQ_CODEL_INTERVAL_MS) + " ms");
+	codel_interval->setUnit("ms");
+	codel_interval->setAdvanced(true);
+}
+
+
+void DvbFifo::configureFairQueuing(std::shared_ptr<OpenSANDConf::DataComponent> fifo)
+{
+	bool fair_queuing = false;
+	OpenSandModelConf::extractParameterData(fifo->getParameter("fair_queuing"), fair_queuing);
+	if (!fair_queuing)
+	{
+		return;
+	}
+
+	uint32_t codel_target = FQ_CODEL_TARGET_MS;
+	uint32_t codel_interval = FQ_CODEL_INTERVAL_MS;
+	OpenSandModelConf::extractParameterData(fifo->getParameter("codel_target"), codel_target);
+	OpenSandModelConf::extractParameterData(fifo->getParameter("codel_interval"), codel_interval);
+	this->enableFairQueuing(time_ms_t(codel_target), time_ms_t(codel_interval));
+}
+
+
+bool DvbFifo::isFairQueuing() const
+{
+	return this->fair_queuing;
+}
+
+
+DelayFifo::iterator_wrapper DvbFifo::erase(iterator_wrapper pos)
+{
+	auto lock = this->acquire();
+	if (this->fair_queuing && pos != this->wend())
+	{
+		// forget the element in the flow holding it
+		const std::unique_ptr<FifoElement> *elem = &(*pos);
+		for (auto &&flow: this->flows)
+		{
+			auto found = std::find_if(flow.packets.begin(), flow.packets.end(),
+			                          [elem](const queue_iterator_t &queued)
+			                          {
+			                            return &queued->second == elem;
+			                          });
+			if (found != flow.packets.end())
+			{
+				if (*elem && *(*elem))
+				{
+					vol_bytes_t length = (*elem)->getTotalLength();
+					flow.length_bytes -= std::min(length, flow.length_bytes);
+				}
+				flow.packets.erase(found);
+				break;
+			}
+		}
+	}
+	return this->DelayFifo::erase(pos);
+}
+
+
 void DvbFifo::increaseFifoSize(vol_bytes_t length)
 {
-	this->cur_length_bytes += length;
+	auto lock = this->acquire();
+	addToCounter(this->cur_length_bytes, length);
 	this->stat_context.current_length_bytes += length;
 }
 
 
 void DvbFifo::decreaseFifoSize(vol_bytes_t length)
 {
-	this->cur_length_bytes -= length;
+	auto lock = this->acquire();
+	subFromCounter(this->cur_length_bytes, length);
 	this->stat_context.current_length_bytes -= length;
 	this->stat_context.current_pkt_nbr = this->queue.size();
 }
@@ -334,7 +791,7 @@ void DvbFifo::decreaseFifoSize(vol_bytes_t length)
 
 void DvbFifo::getStatsCxt(mac_fifo_stat_context_t &stat_info)
 {
-	Rt::Lock lock(this->fifo_mutex);
+	auto lock = this->acquire();
 	stat_info.current_pkt_nbr = this->stat_context.current_pkt_nbr;
 	stat_info.current_length_bytes = this->stat_context.current_length_bytes;
 	stat_info.in_pkt_nbr = this->stat_context.in_pkt_nbr;
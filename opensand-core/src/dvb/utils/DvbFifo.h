@@ -38,13 +38,21 @@
 #include <opensand_rt/RtMutex.h>
 #include <opensand_output/OutputLog.h>
 
+#include <atomic>
 #include <deque>
 #include <map>
+#include <vector>
 
 #include "DelayFifo.h"
 #include "Sac.h"
 
 
+namespace OpenSANDConf {
+	class MetaComponent;
+	class DataComponent;
+}
+
+
 ///> The priority of FIFO that indicates the MAC QoS which is sometimes equivalent
 ///>  to Diffserv IP QoS
 
@@ -227,7 +235,95 @@ public:
 	void increaseFifoSize(vol_bytes_t length);
 	void decreaseFifoSize(vol_bytes_t length);
 
+	/**
+	 * @brief Serve the flows of the fifo fairly instead of in arrival order
+	 *
+	 * Packets are spread among flows hashed over their L3/L4 header, or
+	 * their terminal IDs for other protocols. Flows are served with a
+	 * deficit round robin, packets staying in the fifo longer than the
+	 * target for a whole interval are dropped at dequeue, and a full fifo
+	 * drops from its biggest flow instead of the incoming packet
+	 * (FQ-CoDel like). Only the ready packets are served, those of a
+	 * flow become ready in arrival order.
+	 *
+	 * @param target    the acceptable sojourn time in the fifo
+	 * @param interval  the time the sojourn time may stay above target
+	 *                  before dropping
+	 */
+	void enableFairQueuing(time_ms_t target, time_ms_t interval);
+
+	/**
+	 * @brief Declare the fair queuing parameters of a FIFO
+	 *
+	 * @param fifo  the FIFO description in the configuration model
+	 */
+	static void addFairQueuingParameters(std::shared_ptr<OpenSANDConf::MetaComponent> fifo);
+
+	/**
+	 * @brief Enable the fair queuing if the FIFO configuration asks for it
+	 *
+	 * @param fifo  the FIFO configuration
+	 */
+	void configureFairQueuing(std::shared_ptr<OpenSANDConf::DataComponent> fifo);
+
+	/**
+	 * @brief Whether the flows of the fifo are served fairly
+	 *
+	 * @return true if fair queuing is enabled, false otherwise
+	 */
+	bool isFairQueuing() const;
+
+	iterator_wrapper erase(iterator_wrapper pos) override;
+
 protected:
+	using queue_iterator_t = iterator_wrapper::wrapped_iterator;
+
+	/// A flow of the fair queuing discipline
+	struct FifoFlow
+	{
+		std::deque<queue_iterator_t> packets; ///< the flow packets, in arrival order
+		vol_bytes_t length_bytes;             ///< the length of data in the flow
+		int32_t deficit;                      ///< the DRR deficit, in bytes
+		bool active;                          ///< whether the flow is scheduled
+		time_point_t first_above_time;        ///< CoDel: end of the interval above target
+		time_point_t drop_next;               ///< CoDel: next drop date
+		uint32_t drop_count;                  ///< CoDel: drops since dropping
+		bool dropping;                        ///< CoDel: whether the flow is dropping
+	};
+
+	/**
+	 * @brief Get the flow of an element
+	 *
+	 * @param elem  the element
+	 * @return the flow index
+	 */
+	static std::size_t getFlowId(const NetContainer &elem);
+
+	/**
+	 * @brief Remove an element from the queue and update the counters
+	 *
+	 * @param pos      the element position in the queue
+	 * @param dropped  whether the element is dropped or sent
+	 * @return the element
+	 */
+	std::unique_ptr<FifoElement> extract(queue_iterator_t pos, bool dropped);
+
+	/**
+	 * @brief Dequeue the head of a flow, dropping the packets that stayed
+	 *        too long in the fifo
+	 *
+	 * @param flow  the flow
+	 * @param now   the current date
+	 * @return the element, nullptr if the flow is empty or its head
+	 *         is not ready yet
+	 */
+	std::unique_ptr<FifoElement> dequeueFlow(FifoFlow &flow, time_point_t now);
+
+	/**
+	 * @brief Drop the head of the biggest flow to make room in a full fifo
+	 */
+	void dropFromBiggestFlow();
+
 	/**
 	 * @brief Remove an element at the head of the list
 	 *
@@ -245,16 +341,25 @@ protected:
 	std::string fifo_name;          ///< the MAC fifo name: for ST (EF, AF, BE, ...) or SAT
 	ForwardOrReturnAccessType access_type;   ///< the forward or return access type
 	unsigned int vcm_id;            ///< the associated VCM id (if VCM access type)
-	vol_pkt_t new_size_pkt;         ///< the number of packets that filled the fifo
-	                                ///< since previous check
-	vol_bytes_t cur_length_bytes;   ///< the size of data that filled the fifo
-	vol_bytes_t new_length_bytes;   ///< the size of data that filled the fifo
-	                                ///< since previous check
+	// the counters are written by one thread at a time (the owner or the
+	// mutex holder) and may be read without lock from other threads
+	std::atomic<vol_pkt_t> new_size_pkt;       ///< the number of packets that filled the fifo
+	                                           ///< since previous check
+	std::atomic<vol_bytes_t> cur_length_bytes; ///< the size of data that filled the fifo
+	std::atomic<vol_bytes_t> new_length_bytes; ///< the size of data that filled the fifo
+	                                           ///< since previous check
 	uint8_t carrier_id;             ///< the carrier id of the fifo (for SAT and GW purposes)
 	mac_fifo_stat_context_t stat_context; ///< statistics context used by MAC layer
 
 	uint8_t cni;                    ///< is Scpc mode add cni as option into gse packet
 
+	bool fair_queuing;              ///< whether the flows are served fairly
+	time_ms_t codel_target;         ///< acceptable sojourn time in the fifo
+	time_ms_t codel_interval;       ///< time above target before dropping
+	std::vector<FifoFlow> flows;    ///< the fair queuing flows
+	std::deque<std::size_t> new_flows; ///< flows that became active recently
+	std::deque<std::size_t> old_flows; ///< other active flows
+
 	// Output log
 	std::shared_ptr<OutputLog> log_dvb_fifo;
 };
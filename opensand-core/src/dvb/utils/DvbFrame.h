@@ -38,6 +38,7 @@
 #define DVB_FRAME_H
 
 #include <arpa/inet.h>
+#include <algorithm>
 
 #include <opensand_rt/Ptr.h>
 
@@ -63,6 +64,10 @@ protected:
 	/** The carrier Id */
 	uint8_t carrier_id;
 
+	/** The end of the data while packets are written in place, the
+	    buffer is then kept at the maximum size; 0 otherwise */
+	size_t write_end;
+
 public:
 	using DvbHeaderType = T;
 
@@ -76,7 +81,8 @@ public:
 		NetContainer(data, length),
 		max_size(sizeof(T)),
 		num_packets(0),
-		carrier_id(-1)
+		carrier_id(-1),
+		write_end(0)
 	{
 		this->name = "DvbFrame";
 		this->trailer_length = this->getTotalLength() - this->getMessageLength();
@@ -92,7 +98,8 @@ public:
 		NetContainer(data),
 		max_size(sizeof(T)),
 		num_packets(0),
-		carrier_id(0)
+		carrier_id(0),
+		write_end(0)
 	{
 		this->name = "DvbFrame";
 		this->trailer_length = this->getTotalLength() - this->getMessageLength();
@@ -109,7 +116,8 @@ public:
 		NetContainer(data, length),
 		max_size(sizeof(T)),
 		num_packets(0),
-		carrier_id(0)
+		carrier_id(0),
+		write_end(0)
 	{
 		this->name = "DvbFrame";
 		this->trailer_length = this->getTotalLength() - this->getMessageLength();
@@ -120,10 +128,22 @@ public:
 	 * Build an empty DVB frame
 	 */
 	DvbFrameTpl():
+		DvbFrameTpl(sizeof(T))
+	{
+	};
+
+	/**
+	 * Build an empty DVB frame whose buffer is allocated once for its
+	 * maximum size, so that adding packets never reallocates it
+	 *
+	 * @param max_size  the maximum size (in bytes) of the DVB frame
+	 */
+	explicit DvbFrameTpl(size_t max_size):
 		NetContainer(),
-		max_size(sizeof(T)),
+		max_size(std::max(max_size, sizeof(T))),
 		num_packets(0),
-		carrier_id(0)
+		carrier_id(0),
+		write_end(0)
 	{
 		T header{};  // zero-initialization of pod-type
 		this->name = "DvbFrame";
@@ -224,6 +244,7 @@ public:
 	 */
 	void setMaxSize(unsigned int size)
 	{
+		this->finishWrite();
 		this->max_size = size;
 		this->data.reserve(size);
 		// we need to do that again because data may have moved
@@ -261,6 +282,20 @@ public:
 		return (this->max_size - this->getTotalLength());
 	};
 
+	/**
+	 * Get the length of the DVB frame, the written packets included
+	 *
+	 * @return  the length (in bytes) of the DVB frame
+	 */
+	std::size_t getTotalLength() const override
+	{
+		if(this->write_end != 0)
+		{
+			return this->write_end;
+		}
+		return this->data.length();
+	};
+
 	/**
 	 * Add an encapsulation packet to the DVB frame
 	 *
@@ -277,12 +312,53 @@ public:
 			return false;
 		}
 
+		this->finishWrite();
 		this->data.append(packet.getData());
 		this->num_packets++;
 
 		return true;
 	};
 
+	/**
+	 * Write an encapsulation packet in place, in the free space of the
+	 * DVB frame
+	 *
+	 * The writer is called as write(dst, dst_length, written) and shall
+	 * return false on error, written being the number of bytes it put
+	 * in dst (0 if the packet does not fit).
+	 *
+	 * The buffer is grown to the maximum size on the first write only,
+	 * growing it for each packet would zero its whole free space each
+	 * time; it is cut to the written data by finishWrite.
+	 *
+	 * @param write  the writer filling the frame
+	 * @return       the status returned by the writer
+	 */
+	template<class Writer>
+	bool writePacket(Writer &&write)
+	{
+		if(this->write_end == 0)
+		{
+			// the buffer is reserved with the max size, so this does
+			// not reallocate
+			this->write_end = this->data.length();
+			this->data.resize(std::max(this->max_size, this->write_end));
+		}
+		std::size_t free_space = this->getFreeSpace();
+		std::size_t written = 0;
+
+		bool status = write(this->data.data() + this->write_end, free_space, written);
+		written = std::min(written, free_space);
+		this->write_end += written;
+		if(written > 0)
+		{
+			this->num_packets++;
+			this->packetAdded(written);
+		}
+
+		return status;
+	};
+
 	/**
 	 * Get the encapsulation packets count into the DVB frame
 	 *
@@ -305,9 +381,17 @@ public:
 	 */
 	double getCn() const
 	{
-		size_t msg_length = this->getMessageLength();
-		Rt::Data phy_data = this->getData(msg_length);
-		return ncntoh(reinterpret_cast<T_DVB_PHY*>(phy_data.data())->cn_previous);
+		return ncntoh(this->getPhyTrailer().cn_previous);
+	};
+
+	/**
+	 * Get the C/N value carried by the frame, in linear scale
+	 *
+	 * @return the linear C/N value
+	 */
+	double getLinearCn() const
+	{
+		return ncntolin(this->getPhyTrailer().cn_previous);
 	};
 
 	/**
@@ -321,6 +405,7 @@ public:
 		phy.cn_previous = hcnton(cn);
 
 		unsigned char *raw_phy = reinterpret_cast<unsigned char *>(&phy);
+		this->finishWrite();
 		if(this->trailer_length == 0)
 		{
 			this->data.append(raw_phy, sizeof(T_DVB_PHY));
@@ -334,6 +419,19 @@ public:
 		}
 	};
 
+	/**
+	 * @brief Cut the buffer to the packets written in place, once the
+	 *        frame is complete or before appending to it
+	 */
+	void finishWrite()
+	{
+		if(this->write_end != 0)
+		{
+			this->data.resize(this->write_end);
+			this->write_end = 0;
+		}
+	};
+
 	/**
 	 * @brief Accessor on the frame data
 	 */
@@ -348,6 +446,25 @@ public:
 
 	template<typename DVB> friend Rt::Ptr<DVB> dvb_frame_upcast(Rt::Ptr<DvbFrameTpl<>> ptr);
 	template<typename DVB> friend DVB& dvb_frame_upcast(DvbFrameTpl<>& frame);
+
+protected:
+	/**
+	 * @brief Update the frame header once a packet was written in place
+	 *
+	 * @param length  the length of the written packet
+	 */
+	virtual void packetAdded(std::size_t)
+	{
+	};
+
+private:
+	/**
+	 * @brief Accessor on the physical layer trailer, read in place
+	 */
+	const T_DVB_PHY &getPhyTrailer() const
+	{
+		return *reinterpret_cast<const T_DVB_PHY *>(this->data.data() + this->getMessageLength());
+	}
 };
 
 
@@ -379,6 +496,8 @@ Rt::Ptr<DvbFrame> dvb_frame_downcast(Rt::Ptr<DVB_FRAME> ptr)
 {
 	static_assert(std::is_base_of<DvbFrameTpl<typename DVB_FRAME::DvbHeaderType>, DVB_FRAME>::value,
 	              "Trying to cast a non dvb frame into a dvb frame");
+	// the frame leaves its builder, its data must be final
+	ptr->finishWrite();
 	return {reinterpret_cast<DvbFrame*>(ptr.release()), std::move(ptr.get_deleter())};
 }
 
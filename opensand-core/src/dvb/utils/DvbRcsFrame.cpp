@@ -70,11 +70,16 @@ DvbRcsFrame::DvbRcsFrame(const Rt::Data &data, size_t length):
 
 
 DvbRcsFrame::DvbRcsFrame():
-	DvbFrameTpl<T_DVB_ENCAP_BURST>()
+	DvbRcsFrame(MSG_DVB_RCS_SIZE_MAX)
+{
+}
+
+
+DvbRcsFrame::DvbRcsFrame(size_t max_size):
+	DvbFrameTpl<T_DVB_ENCAP_BURST>(max_size)
 {
 	this->name = "DVB-RCS frame";
 	// no data given as input, so create the DVB-RCS header
-	this->setMaxSize(MSG_DVB_RCS_SIZE_MAX);
 	this->setMessageLength(sizeof(T_DVB_ENCAP_BURST));
 	this->setMessageType(EmulatedMessageType::DvbBurst);
 	this->frame()->qty_element = 0; // no encapsulation packet at the beginning
@@ -90,15 +95,21 @@ bool DvbRcsFrame::addPacket(const NetPacket &packet)
 	{
 		return false;
 	}
-	this->setMessageLength(this->getMessageLength() + packet.getTotalLength());
-	this->frame()->qty_element = htons(this->num_packets);
+	this->packetAdded(packet.getTotalLength());
 	return true;
 }
 
+void DvbRcsFrame::packetAdded(std::size_t length)
+{
+	this->setMessageLength(this->getMessageLength() + length);
+	this->frame()->qty_element = htons(this->num_packets);
+}
+
 // TODO not used => remove ?!
 void DvbRcsFrame::empty()
 {
 	// remove the payload
+	this->finishWrite();
 	this->data.erase(sizeof(T_DVB_ENCAP_BURST));
 	this->num_packets = 0;
 
@@ -76,6 +76,15 @@ public:
 	 */
 	DvbRcsFrame();
 
+	/**
+	 * Build an empty DVB-RCS frame with a buffer allocated for its
+	 * maximum size
+	 *
+	 * @param max_size  the maximum size of the frame (in bytes),
+	 *                  header included
+	 */
+	explicit DvbRcsFrame(size_t max_size);
+
 	/**
 	 * Destroy the DVB-RCS frame
 	 */
@@ -105,6 +114,9 @@ public:
 	// implementation of virtual functions
 	bool addPacket(const NetPacket &packet) override;
 	void empty() override;
+
+protected:
+	void packetAdded(std::size_t length) override;
 };
 
 #endif
@@ -81,7 +81,7 @@ bool Sac::addRequest(uint8_t prio, ReturnAccessType type, uint32_t value)
 	info.value = value;
 	emu_cr_t cr;
 
-	if(this->request_nbr + 1 >= NBR_MAX_CR)
+	if(this->request_nbr >= NBR_MAX_CR)
 	{
 		LOG(sac_log, LEVEL_ERROR, 
 		    "Cannot add more request\n");
@@ -37,6 +37,9 @@
 
 #include "SlottedAlohaPacketData.h"
 
+#include <memory>
+#include <vector>
+
 /**
  * @class Slot
  * @brief Represent a RCS slot in a carrier (i.e. a list of packets + attributes)
@@ -90,5 +93,8 @@ private:
 	unsigned int slot_id;
 };
 
+/// The slots of a terminal category indexed by their ID
+typedef std::vector<std::shared_ptr<Slot>> saloha_slots_t;
+
 
 #endif
@@ -224,7 +224,7 @@ public:
 	 *
 	 * @param  terminal  terminal to be added.
 	 */
-	void addTerminal(std::shared_ptr<TerminalContext> terminal)
+	virtual void addTerminal(std::shared_ptr<TerminalContext> terminal)
 	{
 		terminal->setCurrentCategory(this->label);
 		this->terminals.push_back(terminal);
@@ -236,7 +236,7 @@ public:
 	 * @param  terminal  terminal to be removed.
 	 * @return true on success, false otherwise
 	 */
-	bool removeTerminal(std::shared_ptr<TerminalContext> terminal)
+	virtual bool removeTerminal(std::shared_ptr<TerminalContext> terminal)
 	{
 		const tal_id_t tal_id = terminal->getTerminalId();
 		auto terminal_it = std::find_if(this->terminals.begin(),
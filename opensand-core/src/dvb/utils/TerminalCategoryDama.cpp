@@ -36,6 +36,7 @@
 
 #include "TerminalCategoryDama.h"
 #include "CarriersGroupDama.h"
+#include "TerminalContextDamaRcs.h"
 
 #include <opensand_output/Output.h>
 
@@ -43,7 +44,9 @@
 
 
 TerminalCategoryDama::TerminalCategoryDama(const std::string& label, AccessType access_type):
-	TerminalCategory<CarriersGroupDama>(label, access_type)
+	TerminalCategory<CarriersGroupDama>(label, access_type),
+	tables_dirty(true),
+	tables_groups_count(0)
 {
 }
 
@@ -51,3 +54,58 @@ TerminalCategoryDama::~TerminalCategoryDama()
 {
 }
 
+void TerminalCategoryDama::addTerminal(std::shared_ptr<TerminalContext> terminal)
+{
+	TerminalCategory<CarriersGroupDama>::addTerminal(terminal);
+	this->tables_dirty = true;
+}
+
+bool TerminalCategoryDama::removeTerminal(std::shared_ptr<TerminalContext> terminal)
+{
+	// tables keep raw pointers on contexts, always drop them
+	this->tables_dirty = true;
+	return TerminalCategory<CarriersGroupDama>::removeTerminal(terminal);
+}
+
+void TerminalCategoryDama::invalidateTerminalsTables()
+{
+	this->tables_dirty = true;
+}
+
+void TerminalCategoryDama::updateTerminalsTables()
+{
+	if(this->tables_dirty ||
+	   this->tables_groups_count != this->carriers_groups.size())
+	{
+		for(auto &&carriers: this->carriers_groups)
+		{
+			carriers.getTerminals().clear();
+		}
+		// keep the terminals order of the category in each table
+		for(auto &&terminal: this->terminals)
+		{
+			auto rcs_terminal = std::dynamic_pointer_cast<TerminalContextDamaRcs>(terminal);
+			if(!rcs_terminal)
+			{
+				continue;
+			}
+			auto carriers_it = std::find_if(this->carriers_groups.begin(),
+			                                this->carriers_groups.end(),
+			                                [&rcs_terminal](const CarriersGroupDama &carriers)
+			                                { return carriers.getCarriersId() == rcs_terminal->getCarrierId(); });
+			if(carriers_it != this->carriers_groups.end())
+			{
+				carriers_it->getTerminals().addTerminal(rcs_terminal.get());
+			}
+		}
+		this->tables_groups_count = this->carriers_groups.size();
+		this->tables_dirty = false;
+		return;
+	}
+
+	for(auto &&carriers: this->carriers_groups)
+	{
+		carriers.getTerminals().refresh();
+	}
+}
+
@@ -58,32 +58,30 @@ class TerminalCategoryDama: public TerminalCategory<CarriersGroupDama>
 
 	~TerminalCategoryDama();
 
+	void addTerminal(std::shared_ptr<TerminalContext> terminal) override;
+	bool removeTerminal(std::shared_ptr<TerminalContext> terminal) override;
+
 	/**
-	 * @brief  Get the terminal list in a specific carriers group
-	 *
-	 * @tparam T            a terminal context
-	 * @param  carrier_id   the carrier ID
-	 * @return  terminal list in the carriers group
+	 * @brief  Notify that the carriers group of a terminal has changed,
+	 *         the terminals tables will be rebuilt on next update
 	 */
-	template<class T>
-	std::vector<std::shared_ptr<T>> getTerminalsInCarriersGroup(unsigned int carrier_id) const;
-};
+	void invalidateTerminalsTables();
+
+	/**
+	 * @brief  Update the terminals table of each carriers group:
+	 *         rows are rebuilt if terminals or carriers groups changed,
+	 *         then the columns are refreshed from the terminal contexts.
+	 *         To be called once per superframe before DAMA computation.
+	 */
+	void updateTerminalsTables();
 
+ private:
+	/** Whether the terminals tables must be rebuilt */
+	bool tables_dirty;
 
-template<class T>
-std::vector<std::shared_ptr<T>> TerminalCategoryDama::getTerminalsInCarriersGroup(unsigned int carrier_id) const
-{
-	std::vector<std::shared_ptr<T>> entries;
-	for (auto &&t: this->terminals)
-	{
-		std::shared_ptr<T> terminal = std::dynamic_pointer_cast<T>(t);
-		if(terminal->getCarrierId() == carrier_id)
-		{
-			entries.push_back(terminal);
-		}
-	}
-	return entries;
-}
+	/** The number of carriers groups when the tables were built */
+	std::size_t tables_groups_count;
+};
 
 
 #endif
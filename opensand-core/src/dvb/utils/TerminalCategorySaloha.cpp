@@ -42,6 +42,7 @@
 
 TerminalCategorySaloha::TerminalCategorySaloha(const std::string& label, AccessType access_type):
 	TerminalCategory<CarriersGroupSaloha>{label, access_type},
+	slots{},
 	accepted_packets{},
 	received_packets_nbr{0}
 {
@@ -51,6 +52,7 @@ TerminalCategorySaloha::TerminalCategorySaloha(const std::string& label, AccessT
 TerminalCategorySaloha::~TerminalCategorySaloha()
 {
 	this->accepted_packets.clear();
+	this->slots.clear();
 }
 
 
@@ -81,6 +83,19 @@ void TerminalCategorySaloha::computeSlotsNumber(UnitConverter &converter)
 		total += carriers.getSlotsNumber();
 		last = total;
 	}
+
+	this->slots.clear();
+	this->slots.resize(total, nullptr);
+	for (auto &&carriers: this->carriers_groups)
+	{
+		for (auto &&[slot_id, slot]: carriers.getSlots())
+		{
+			if(slot_id < total)
+			{
+				this->slots[slot_id] = slot;
+			}
+		}
+	}
 }
 
 unsigned int TerminalCategorySaloha::getSlotsNumber() const
@@ -93,16 +108,18 @@ unsigned int TerminalCategorySaloha::getSlotsNumber() const
 	return total;
 }
 
-std::map<unsigned int, std::shared_ptr<Slot>> TerminalCategorySaloha::getSlots() const
+const saloha_slots_t &TerminalCategorySaloha::getSlots() const
 {
-	std::map<unsigned int, std::shared_ptr<Slot>> slots;
-	for (auto &&carriers: this->carriers_groups)
-	{
-		const std::map<unsigned int, std::shared_ptr<Slot>> &sl = carriers.getSlots();
+	return this->slots;
+}
 
-		slots.insert(sl.begin(), sl.end());
+Slot *TerminalCategorySaloha::getSlot(unsigned int slot_id) const
+{
+	if(slot_id >= this->slots.size())
+	{
+		return nullptr;
 	}
-	return slots;
+	return this->slots[slot_id].get();
 }
 
 saloha_packets_data_t &TerminalCategorySaloha::getAcceptedPackets()
@@ -77,9 +77,17 @@ public:
 	/**
 	 * @brief Get the slots in the category
 	 *
-	 * @return the slots from all carriers
+	 * @return the slots from all carriers, indexed by their ID
 	 */
-	std::map<unsigned int, std::shared_ptr<Slot>> getSlots() const;
+	const saloha_slots_t &getSlots() const;
+
+	/**
+	 * @brief Get a slot in the category
+	 *
+	 * @param slot_id  The slot ID
+	 * @return the slot, nullptr if it does not exist
+	 */
+	Slot *getSlot(unsigned int slot_id) const;
 
 	/**
 	 * @brief Get the packets that can be transmitted to
@@ -105,6 +113,10 @@ public:
 	void resetReceivedPacketsNbr();
 
 private:
+	/// The slots of all carriers groups, built once and emptied by the
+	/// collisions removal on each Slotted Aloha frame
+	saloha_slots_t slots;
+
 	/// A FIFO containing packet to be transmitted to encapsulation block
 	saloha_packets_data_t accepted_packets;
 
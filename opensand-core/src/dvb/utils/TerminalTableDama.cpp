@@ -0,0 +1,312 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ * Copyright © 2019 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file    TerminalTableDama.cpp
+ * @brief   The terminals served by a DAMA carriers group, stored column-wise
+ * @author  Viveris Technologies
+ */
+
+
+#include "TerminalTableDama.h"
+#include "TerminalContextDamaRcs.h"
+
+#include <algorithm>
+#include <numeric>
+
+
+TerminalTableDama::TerminalTableDama():
+	contexts(),
+	tal_ids(),
+	fmts(),
+	cra_request_kbps(),
+	max_rbdc_kbps(),
+	rbdc_request_kbps(),
+	rbdc_credit(),
+	vbdc_request_kb(),
+	cra_alloc_kbps(),
+	rbdc_alloc_kbps(),
+	vbdc_alloc_kb(),
+	fca_alloc_kbps(),
+	request_pktpf(),
+	order(),
+	order_end(0),
+	vbdc_heap(),
+	vbdc_heap_pos(),
+	vbdc_visited(),
+	queued_vbdc_kb(0),
+	queued_vbdc_count(0)
+{
+}
+
+void TerminalTableDama::clear()
+{
+	this->contexts.clear();
+	this->tal_ids.clear();
+	this->fmts.clear();
+	this->cra_request_kbps.clear();
+	this->max_rbdc_kbps.clear();
+	this->rbdc_request_kbps.clear();
+	this->rbdc_credit.clear();
+	this->vbdc_request_kb.clear();
+	this->cra_alloc_kbps.clear();
+	this->rbdc_alloc_kbps.clear();
+	this->vbdc_alloc_kb.clear();
+	this->fca_alloc_kbps.clear();
+	this->request_pktpf.clear();
+	this->order.clear();
+	this->order_end = 0;
+	this->vbdc_heap.clear();
+	this->vbdc_heap_pos.clear();
+	this->vbdc_visited.clear();
+	this->queued_vbdc_kb = 0;
+	this->queued_vbdc_count = 0;
+}
+
+void TerminalTableDama::addTerminal(TerminalContextDamaRcs *terminal)
+{
+	this->contexts.push_back(terminal);
+	this->tal_ids.push_back(terminal->getTerminalId());
+	this->fmts.push_back(terminal->getFmt());
+	this->cra_request_kbps.push_back(terminal->getRequiredCra());
+	this->max_rbdc_kbps.push_back(terminal->getMaxRbdc());
+	this->rbdc_request_kbps.push_back(terminal->getRequiredRbdc());
+	this->rbdc_credit.push_back(terminal->getRbdcCredit());
+	this->vbdc_request_kb.push_back(terminal->getRequiredVbdc());
+	this->cra_alloc_kbps.push_back(terminal->getCraAllocation());
+	this->rbdc_alloc_kbps.push_back(terminal->getRbdcAllocation());
+	this->vbdc_alloc_kb.push_back(terminal->getVbdcAllocation());
+	this->fca_alloc_kbps.push_back(terminal->getFcaAllocation());
+	this->request_pktpf.push_back(0);
+	this->order.push_back(this->order.size());
+	this->vbdc_heap_pos.push_back(npos);
+	this->queueVbdcRow(this->contexts.size() - 1);
+}
+
+void TerminalTableDama::refresh()
+{
+	const std::size_t rows = this->contexts.size();
+	for(std::size_t row = 0; row < rows; ++row)
+	{
+		const TerminalContextDamaRcs *terminal = this->contexts[row];
+		this->fmts[row] = terminal->getFmt();
+		this->cra_request_kbps[row] = terminal->getRequiredCra();
+		this->max_rbdc_kbps[row] = terminal->getMaxRbdc();
+		this->rbdc_request_kbps[row] = terminal->getRequiredRbdc();
+		this->rbdc_credit[row] = terminal->getRbdcCredit();
+		// only the terminals with a new request move in the VBDC queue
+		this->updateVbdcReq(row, terminal->getRequiredVbdc());
+		this->cra_alloc_kbps[row] = terminal->getCraAllocation();
+		this->rbdc_alloc_kbps[row] = terminal->getRbdcAllocation();
+		this->vbdc_alloc_kb[row] = terminal->getVbdcAllocation();
+		this->fca_alloc_kbps[row] = terminal->getFcaAllocation();
+		this->request_pktpf[row] = 0;
+	}
+}
+
+void TerminalTableDama::setCraAllocation(std::size_t row, rate_kbps_t val_kbps)
+{
+	this->cra_alloc_kbps[row] = val_kbps;
+	this->contexts[row]->setCraAllocation(val_kbps);
+}
+
+void TerminalTableDama::setRbdcAllocation(std::size_t row, rate_kbps_t val_kbps)
+{
+	this->rbdc_alloc_kbps[row] = val_kbps;
+	this->contexts[row]->setRbdcAllocation(val_kbps);
+}
+
+void TerminalTableDama::addRbdcCredit(std::size_t row, double credit_kbps)
+{
+	this->contexts[row]->addRbdcCredit(credit_kbps);
+	this->rbdc_credit[row] = this->contexts[row]->getRbdcCredit();
+}
+
+void TerminalTableDama::setVbdcAllocation(std::size_t row, vol_kb_t val_kb)
+{
+	// the context updates the remaining request on allocation
+	this->contexts[row]->setVbdcAllocation(val_kb);
+	this->vbdc_alloc_kb[row] = val_kb;
+	this->updateVbdcReq(row, this->contexts[row]->getRequiredVbdc());
+}
+
+void TerminalTableDama::setFcaAllocation(std::size_t row, rate_kbps_t val_kbps)
+{
+	this->fca_alloc_kbps[row] = val_kbps;
+	this->contexts[row]->setFcaAllocation(val_kbps);
+}
+
+void TerminalTableDama::startCreditOrder()
+{
+	std::iota(this->order.begin(), this->order.end(), 0);
+	// std heaps put the greatest element first, hence the reversed operands
+	std::make_heap(this->order.begin(), this->order.end(),
+	               [this](std::size_t r1, std::size_t r2)
+	               { return this->isBeforeByCredit(r2, r1); });
+	this->order_end = this->order.size();
+}
+
+bool TerminalTableDama::popHighestCredit(std::size_t &row)
+{
+	if(this->order_end == 0)
+	{
+		return false;
+	}
+	std::pop_heap(this->order.begin(), this->order.begin() + this->order_end,
+	              [this](std::size_t r1, std::size_t r2)
+	              { return this->isBeforeByCredit(r2, r1); });
+	--this->order_end;
+	row = this->order[this->order_end];
+	return true;
+}
+
+bool TerminalTableDama::popHighestVbdcReq(std::size_t &row)
+{
+	if(this->vbdc_heap.empty() ||
+	   this->vbdc_request_kb[this->vbdc_heap.front()] == 0)
+	{
+		return false;
+	}
+	row = this->vbdc_heap.front();
+	std::size_t last = this->vbdc_heap.back();
+	this->vbdc_heap.pop_back();
+	if(!this->vbdc_heap.empty())
+	{
+		this->placeVbdc(0, last);
+		this->siftDownVbdc(0);
+	}
+	this->vbdc_heap_pos[row] = npos;
+	this->queued_vbdc_kb -= this->vbdc_request_kb[row];
+	this->queued_vbdc_count--;
+	this->vbdc_visited.push_back(row);
+	return true;
+}
+
+void TerminalTableDama::restoreVbdcOrder()
+{
+	for(auto &&row: this->vbdc_visited)
+	{
+		this->queueVbdcRow(row);
+	}
+	this->vbdc_visited.clear();
+}
+
+void TerminalTableDama::updateVbdcReq(std::size_t row, vol_kb_t request_kb)
+{
+	vol_kb_t previous_kb = this->vbdc_request_kb[row];
+	if(previous_kb == request_kb)
+	{
+		return;
+	}
+	this->vbdc_request_kb[row] = request_kb;
+
+	std::size_t pos = this->vbdc_heap_pos[row];
+	if(pos == npos)
+	{
+		// visited in the current pass, queued again at the end of it
+		return;
+	}
+	this->queued_vbdc_kb += request_kb;
+	this->queued_vbdc_kb -= previous_kb;
+	if(previous_kb == 0)
+	{
+		this->queued_vbdc_count++;
+	}
+	else if(request_kb == 0)
+	{
+		this->queued_vbdc_count--;
+	}
+	if(request_kb > previous_kb)
+	{
+		this->siftUpVbdc(pos);
+	}
+	else
+	{
+		this->siftDownVbdc(pos);
+	}
+}
+
+void TerminalTableDama::queueVbdcRow(std::size_t row)
+{
+	this->vbdc_heap.push_back(row);
+	this->vbdc_heap_pos[row] = this->vbdc_heap.size() - 1;
+	this->siftUpVbdc(this->vbdc_heap.size() - 1);
+	this->queued_vbdc_kb += this->vbdc_request_kb[row];
+	if(this->vbdc_request_kb[row] > 0)
+	{
+		this->queued_vbdc_count++;
+	}
+}
+
+void TerminalTableDama::siftUpVbdc(std::size_t pos)
+{
+	std::size_t row = this->vbdc_heap[pos];
+	while(pos > 0)
+	{
+		std::size_t parent = (pos - 1) / 2;
+		if(!this->isBeforeByVbdcReq(row, this->vbdc_heap[parent]))
+		{
+			break;
+		}
+		this->placeVbdc(pos, this->vbdc_heap[parent]);
+		pos = parent;
+	}
+	this->placeVbdc(pos, row);
+}
+
+void TerminalTableDama::siftDownVbdc(std::size_t pos)
+{
+	const std::size_t count = this->vbdc_heap.size();
+	std::size_t row = this->vbdc_heap[pos];
+	while(true)
+	{
+		std::size_t child = 2 * pos + 1;
+		if(child >= count)
+		{
+			break;
+		}
+		if(child + 1 < count &&
+		   this->isBeforeByVbdcReq(this->vbdc_heap[child + 1], this->vbdc_heap[child]))
+		{
+			child++;
+		}
+		if(!this->isBeforeByVbdcReq(this->vbdc_heap[child], row))
+		{
+			break;
+		}
+		this->placeVbdc(pos, this->vbdc_heap[child]);
+		pos = child;
+	}
+	this->placeVbdc(pos, row);
+}
+
+void TerminalTableDama::placeVbdc(std::size_t pos, std::size_t row)
+{
+	this->vbdc_heap[pos] = row;
+	this->vbdc_heap_pos[row] = pos;
+}
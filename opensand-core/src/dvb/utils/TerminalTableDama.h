@@ -0,0 +1,249 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ * Copyright © 2019 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file    TerminalTableDama.h
+ * @brief   The terminals served by a DAMA carriers group, stored column-wise
+ * @author  Viveris Technologies
+ */
+
+#ifndef _TERMINAL_TABLE_DAMA_H_
+#define _TERMINAL_TABLE_DAMA_H_
+
+#include "OpenSandCore.h"
+
+#include <vector>
+
+
+class TerminalContextDamaRcs;
+class FmtDefinition;
+
+
+/**
+ * @class TerminalTableDama
+ * @brief Persistent table of the terminals served by a DAMA carriers group.
+ *
+ * The rows are only added or removed when the terminals log on, log off or
+ * change carriers group; the columns are refreshed from the terminal contexts
+ * once per superframe, before the allocations computation, so the DAMA passes
+ * iterate over contiguous arrays instead of terminal contexts.
+ * Allocation setters write through to the terminal context so that the
+ * contexts stay the reference for the TTP building.
+ *
+ * The VBDC requests are kept in an indexed heap that lives as long as the
+ * rows: a row is only moved in the heap when its request changes (new SAC
+ * or VBDC allocation), so that a VBDC pass only pays for the terminals it
+ * actually serves instead of sorting the whole group each superframe.
+ * Ties are broken by row index so that the order is the one of a stable
+ * sort of the table.
+ */
+class TerminalTableDama
+{
+public:
+	TerminalTableDama();
+
+	/**
+	 * @brief  Remove all the rows, keeping the allocated memory
+	 */
+	void clear();
+
+	/**
+	 * @brief  Append a terminal at the end of the table
+	 *
+	 * @param  terminal  the terminal context
+	 */
+	void addTerminal(TerminalContextDamaRcs *terminal);
+
+	/**
+	 * @brief  Reload the request columns from the terminal contexts
+	 */
+	void refresh();
+
+	/**
+	 * @brief  Get the number of terminals in the table
+	 *
+	 * @return  the number of rows
+	 */
+	inline std::size_t size() const { return this->tal_ids.size(); };
+
+	/**
+	 * @brief  Whether there is no terminal in the table
+	 *
+	 * @return  true if the table is empty
+	 */
+	inline bool empty() const { return this->tal_ids.empty(); };
+
+	inline TerminalContextDamaRcs *getContext(std::size_t row) const { return this->contexts[row]; };
+	inline tal_id_t getTerminalId(std::size_t row) const { return this->tal_ids[row]; };
+	inline FmtDefinition *getFmt(std::size_t row) const { return this->fmts[row]; };
+	inline rate_kbps_t getRequiredCra(std::size_t row) const { return this->cra_request_kbps[row]; };
+	inline rate_kbps_t getMaxRbdc(std::size_t row) const { return this->max_rbdc_kbps[row]; };
+	inline rate_kbps_t getRequiredRbdc(std::size_t row) const { return this->rbdc_request_kbps[row]; };
+	inline double getRbdcCredit(std::size_t row) const { return this->rbdc_credit[row]; };
+	inline vol_kb_t getRequiredVbdc(std::size_t row) const { return this->vbdc_request_kb[row]; };
+	inline rate_kbps_t getCraAllocation(std::size_t row) const { return this->cra_alloc_kbps[row]; };
+	inline rate_kbps_t getRbdcAllocation(std::size_t row) const { return this->rbdc_alloc_kbps[row]; };
+
+	/**
+	 * @brief  Scratch column used to keep a per terminal request in
+	 *         packets between two steps of an allocation pass
+	 */
+	inline rate_pktpf_t &requestPktpf(std::size_t row) { return this->request_pktpf[row]; };
+
+	void setCraAllocation(std::size_t row, rate_kbps_t val_kbps);
+	void setRbdcAllocation(std::size_t row, rate_kbps_t val_kbps);
+	void addRbdcCredit(std::size_t row, double credit_kbps);
+	void setVbdcAllocation(std::size_t row, vol_kb_t val_kb);
+	void setFcaAllocation(std::size_t row, rate_kbps_t val_kbps);
+
+	/**
+	 * @brief  Start iterating over the rows by descending RBDC credit
+	 *         (in table order for equal credits)
+	 *
+	 * The credits change for all the terminals at each superframe, so the
+	 * order is built in linear time and only the rows actually visited
+	 * with popHighestCredit are ordered.
+	 */
+	void startCreditOrder();
+
+	/**
+	 * @brief  Get the next row by descending RBDC credit
+	 *
+	 * The credit of the returned row may be modified without disturbing
+	 * the iteration over the remaining rows.
+	 *
+	 * @param  row  OUT: the row with the highest credit among the remaining ones
+	 * @return  false if all the rows were visited, true otherwise
+	 */
+	bool popHighestCredit(std::size_t &row);
+
+	/**
+	 * @brief  Get the next row by descending VBDC request
+	 *         (in table order for equal requests)
+	 *
+	 * The returned row leaves the queue until restoreVbdcOrder is called,
+	 * its allocation may be set in the meantime.
+	 *
+	 * @param  row  OUT: the queued row with the highest VBDC request
+	 * @return  false if no queued terminal has a VBDC request, true otherwise
+	 */
+	bool popHighestVbdcReq(std::size_t &row);
+
+	/**
+	 * @brief  Put back in the queue all the rows returned by
+	 *         popHighestVbdcReq, must be called at the end of each VBDC pass
+	 */
+	void restoreVbdcOrder();
+
+	/**
+	 * @brief  Get the sum of the VBDC requests of the queued rows
+	 *
+	 * @return  the VBDC requests of the terminals not visited yet (kb)
+	 */
+	inline vol_kb_t getQueuedVbdcReq() const { return this->queued_vbdc_kb; };
+
+	/**
+	 * @brief  Get the number of queued rows with a VBDC request
+	 *
+	 * @return  the number of terminals not visited yet with a VBDC request
+	 */
+	inline std::size_t getQueuedVbdcReqCount() const { return this->queued_vbdc_count; };
+
+private:
+	/**
+	 * @brief  Update the VBDC request of a row and its place in the queue
+	 *
+	 * @param  row         the row
+	 * @param  request_kb  the new VBDC request
+	 */
+	void updateVbdcReq(std::size_t row, vol_kb_t request_kb);
+
+	/**
+	 * @brief  Insert a row in the VBDC queue
+	 *
+	 * @param  row  the row
+	 */
+	void queueVbdcRow(std::size_t row);
+
+	/**
+	 * @brief  Whether a row is visited before another one by credit
+	 */
+	inline bool isBeforeByCredit(std::size_t r1, std::size_t r2) const
+	{
+		return this->rbdc_credit[r1] > this->rbdc_credit[r2] ||
+		       (this->rbdc_credit[r1] == this->rbdc_credit[r2] && r1 < r2);
+	};
+
+	/**
+	 * @brief  Whether a row is served before another one in VBDC
+	 */
+	inline bool isBeforeByVbdcReq(std::size_t r1, std::size_t r2) const
+	{
+		return this->vbdc_request_kb[r1] > this->vbdc_request_kb[r2] ||
+		       (this->vbdc_request_kb[r1] == this->vbdc_request_kb[r2] && r1 < r2);
+	};
+
+	void siftUpVbdc(std::size_t pos);
+	void siftDownVbdc(std::size_t pos);
+	void placeVbdc(std::size_t pos, std::size_t row);
+
+	std::vector<TerminalContextDamaRcs *> contexts;
+	std::vector<tal_id_t> tal_ids;
+	std::vector<FmtDefinition *> fmts;
+	std::vector<rate_kbps_t> cra_request_kbps;
+	std::vector<rate_kbps_t> max_rbdc_kbps;
+	std::vector<rate_kbps_t> rbdc_request_kbps;
+	std::vector<double> rbdc_credit;
+	std::vector<vol_kb_t> vbdc_request_kb;
+	std::vector<rate_kbps_t> cra_alloc_kbps;
+	std::vector<rate_kbps_t> rbdc_alloc_kbps;
+	std::vector<vol_kb_t> vbdc_alloc_kb;
+	std::vector<rate_kbps_t> fca_alloc_kbps;
+	std::vector<rate_pktpf_t> request_pktpf;
+
+	/** The rows not visited yet, as a heap on the RBDC credit */
+	std::vector<std::size_t> order;
+	/** The number of rows of order not visited yet */
+	std::size_t order_end;
+
+	/** The queued rows, as a heap on the VBDC request */
+	std::vector<std::size_t> vbdc_heap;
+	/** The position of each row in vbdc_heap, npos when it is out of the queue */
+	std::vector<std::size_t> vbdc_heap_pos;
+	/** The rows taken out of the VBDC queue during the current pass */
+	std::vector<std::size_t> vbdc_visited;
+	/** The sum of the VBDC requests of the queued rows */
+	vol_kb_t queued_vbdc_kb;
+	/** The number of queued rows with a VBDC request */
+	std::size_t queued_vbdc_count;
+
+	static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+};
+
+
+#endif
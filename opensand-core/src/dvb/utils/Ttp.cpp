@@ -39,6 +39,7 @@
 
 #include <opensand_output/Output.h>
 
+#include <algorithm>
 #include <cstring>
 #include <arpa/inet.h>
 
@@ -116,14 +117,32 @@ bool Ttp::addTimePlan(time_frame_t frame_id,
 }
 
 
-bool Ttp::build(void)
+bool Ttp::build(TtpLayout layout)
+{
+	size_t ttp_length = sizeof(T_DVB_TTP);
+	if(layout == TtpLayout::Indexed)
+	{
+		ttp_length += this->buildIndexed();
+	}
+	else
+	{
+		ttp_length += this->buildLegacy();
+	}
+	// update message length
+	// TODO we may use getPayloadLength, this should be the same value
+	this->setMessageLength(ttp_length);
+
+	return true;
+}
+
+
+std::size_t Ttp::buildLegacy()
 {
 	unsigned int frame_count = 0;
 	time_plans_t::iterator tp_it;
 	unsigned int tp_count;
 	size_t ttp_length = 0;
 
-	ttp_length = sizeof(T_DVB_TTP);
 	// get the beginning of the frame
 	for(auto&& frame_it : this->frames)
 	{
@@ -145,15 +164,67 @@ bool Ttp::build(void)
 		frame_count++;
 	}
 	this->frame()->ttp.ttp_info.frame_loop_count = frame_count;
-	// update message length
-	// TODO we may use getPayloadLength, this should be the same value
-	this->setMessageLength(ttp_length);
 
-	return true;
+	return ttp_length;
+}
+
+
+std::size_t Ttp::buildIndexed()
+{
+	std::vector<emu_indexed_tp_t> tps;
+	for(auto&& frame_it : this->frames)
+	{
+		for(auto&& tp : frame_it.second)
+		{
+			tps.push_back({frame_it.first, tp});
+		}
+	}
+	// keep the frames order of each terminal
+	std::stable_sort(tps.begin(), tps.end(),
+	                 [](const emu_indexed_tp_t &a, const emu_indexed_tp_t &b)
+	                 {
+	                   return ntohs(a.tp.tal_id) < ntohs(b.tp.tal_id);
+	                 });
+
+	std::vector<emu_tp_index_t> index;
+	for(std::size_t position = 0; position < tps.size(); ++position)
+	{
+		if(index.empty() || index.back().tal_id != tps[position].tp.tal_id)
+		{
+			index.push_back({tps[position].tp.tal_id, htons(position)});
+		}
+	}
+
+	emu_ttp_index_t header;
+	header.index_count = htons(index.size());
+	header.tp_count = htons(tps.size());
+	this->data.append((unsigned char *)&header, sizeof(emu_ttp_index_t));
+	this->data.append((unsigned char *)index.data(), index.size() * sizeof(emu_tp_index_t));
+	this->data.append((unsigned char *)tps.data(), tps.size() * sizeof(emu_indexed_tp_t));
+	this->frame()->ttp.ttp_info.frame_loop_count = TTP_INDEXED_LAYOUT | this->frames.size();
+
+	return sizeof(emu_ttp_index_t) +
+	       index.size() * sizeof(emu_tp_index_t) +
+	       tps.size() * sizeof(emu_indexed_tp_t);
 }
 
 
 bool Ttp::getTp(tal_id_t tal_id, std::map<uint8_t, emu_tp_t> &tps)
+{
+	TimePlans time_plans;
+	if(!this->getTimePlans(tal_id, time_plans))
+	{
+		return false;
+	}
+	for(std::size_t i = 0; i < time_plans.size(); i++)
+	{
+		tps[time_plans.getFrameNumber(i)] = time_plans.getTimePlan(i);
+	}
+	return true;
+}
+
+
+bool Ttp::getTimePlans(tal_id_t tal_id, TimePlans &tps)
 {
 	size_t length = this->getMessageLength();
 	emu_ttp_t *ttp;
@@ -162,6 +233,8 @@ bool Ttp::getTp(tal_id_t tal_id, std::map<uint8_t, emu_tp_t> &tps)
 	// on pointers as frame size is not constant
 	unsigned char *frame_start;
 
+	tps = TimePlans();
+
 	/* check that data contains DVB header, superframe_count and
 	 * frame_loop_count */
 	if(length < sizeof(T_DVB_TTP))
@@ -180,6 +253,58 @@ bool Ttp::getTp(tal_id_t tal_id, std::map<uint8_t, emu_tp_t> &tps)
 
 	length -= sizeof(ttp_info_t);
 	frame_start = (unsigned char *)(&ttp->frames);
+
+	if(this->isIndexed())
+	{
+		const emu_ttp_index_t *header = (const emu_ttp_index_t *)frame_start;
+		if(length < sizeof(emu_ttp_index_t))
+		{
+			LOG(ttp_log, LEVEL_ERROR,
+			    "Length is too small for the TTP index\n");
+			return false;
+		}
+		uint16_t index_count = ntohs(header->index_count);
+		uint16_t tp_count = ntohs(header->tp_count);
+		if(length < sizeof(emu_ttp_index_t) +
+		            index_count * sizeof(emu_tp_index_t) +
+		            tp_count * sizeof(emu_indexed_tp_t))
+		{
+			LOG(ttp_log, LEVEL_ERROR,
+			    "Length is too small for the given tp number\n");
+			return false;
+		}
+
+		// the index is sorted by terminal ID
+		const emu_tp_index_t *index_begin = header->index;
+		const emu_tp_index_t *index_end = index_begin + index_count;
+		const emu_tp_index_t *found = std::lower_bound(index_begin, index_end, tal_id,
+		                                               [](const emu_tp_index_t &entry, tal_id_t id)
+		                                               {
+		                                                 return ntohs(entry.tal_id) < id;
+		                                               });
+		if(found == index_end || ntohs(found->tal_id) != tal_id)
+		{
+			LOG(ttp_log, LEVEL_DEBUG,
+			    "SF#%u: no TP for ST%u\n",
+			    this->getSuperframeCount(), tal_id);
+			return true;
+		}
+
+		uint16_t first = ntohs(found->first_tp);
+		uint16_t last = found + 1 == index_end ? tp_count : ntohs((found + 1)->first_tp);
+		if(first > last || last > tp_count)
+		{
+			LOG(ttp_log, LEVEL_ERROR,
+			    "SF#%u: bad TTP index for ST%u\n",
+			    this->getSuperframeCount(), tal_id);
+			return false;
+		}
+		const emu_indexed_tp_t *time_plans = (const emu_indexed_tp_t *)index_end;
+		tps = TimePlans(time_plans + first, last - first);
+		return true;
+	}
+
+	this->legacy_tps.clear();
 	for(unsigned int i = 0; i < ttp->ttp_info.frame_loop_count; i++)
 	{
 		emu_tp_t *tp;
@@ -212,23 +337,24 @@ bool Ttp::getTp(tal_id_t tal_id, std::map<uint8_t, emu_tp_t> &tps)
 				tp = tp + 1;
 				continue;
 			}
-			tp->offset = ntohl(tp->offset);
-			tp->assignment_count = ntohs(tp->assignment_count);
-			tps[emu_frame->frame_info.frame_number] = *tp;
+			// the TP is kept in network byte order, as in the TTP
+			this->legacy_tps.push_back({emu_frame->frame_info.frame_number, *tp});
 			LOG(ttp_log, LEVEL_DEBUG,
 			    "SF#%u: frame#%u tbtp#%u: tal_id:%u, "
 			    "offset:%u, assignment_count:%u, "
 			    "fmt_id:%u priority:%u\n",
 			    this->getSuperframeCount(), i, j,
-			    tal_id, tp->offset, tp->assignment_count,
+			    tal_id, ntohl(tp->offset), ntohs(tp->assignment_count),
 			    tp->fmt_id, tp->priority);
 			// increase from 1 * sizeof(tp), we do not need to
 			// use an unsigned char * for arithmetic operation here
 			tp = tp + 1;
 		}
 		// go to next frame
-		frame_start = frame_start + emu_frame->frame_info.tp_loop_count * sizeof(emu_tp_t);
+		frame_start = frame_start + sizeof(frame_info_t) +
+		              emu_frame->frame_info.tp_loop_count * sizeof(emu_tp_t);
 	}
+	tps = TimePlans(this->legacy_tps.data(), this->legacy_tps.size());
 
 	return true;
 }
@@ -95,6 +95,42 @@ typedef struct
 	emu_frame_t frames[0];  ///< The first frames in the superframe
 } __attribute__((packed)) emu_ttp_t;
 
+/// The flag of frame_loop_count telling the TTP has the indexed layout
+constexpr const uint8_t TTP_INDEXED_LAYOUT = 0x80;
+
+/** The emulated Time Plan in the indexed layout */
+typedef struct
+{
+	uint8_t frame_number;  ///< The frame number within the superframe
+	emu_tp_t tp;           ///< The Time Plan
+} __attribute__((packed)) emu_indexed_tp_t;
+
+/** The position of the Time Plans of a terminal in the indexed layout */
+typedef struct
+{
+	tal_id_t tal_id;    ///< The terminal ID
+	uint16_t first_tp;  ///< The position of its first Time Plan, the
+	                    //   following ones are up to the next terminal's
+} __attribute__((packed)) emu_tp_index_t;
+
+/**
+ * The emulated TTP field in the indexed layout, following the TTP info:
+ * the index sorted by terminal ID, then the Time Plans in the same order
+ */
+typedef struct
+{
+	uint16_t index_count;      ///< The number of terminals in the index
+	uint16_t tp_count;         ///< The number of Time Plans
+	emu_tp_index_t index[0];   ///< The first terminal of the index
+} __attribute__((packed)) emu_ttp_index_t;
+
+/** How the Time Plans are laid out in the TTP */
+enum class TtpLayout
+{
+	Indexed,  ///< sorted by terminal ID and indexed
+	Legacy,   ///< as added, per frame
+};
+
 /**
  * Time Burst Time plan, essentially A basic DVB Header
  * followed by an array descriptor of frame structures
@@ -106,6 +142,53 @@ typedef struct
 } __attribute__((packed)) T_DVB_TTP;
 
 
+/**
+ * @class TimePlans
+ * @brief The Time Plans of a terminal, read where they are in the TTP
+ */
+class TimePlans
+{
+public:
+	TimePlans(): tps{nullptr}, count{0} {};
+
+	TimePlans(const emu_indexed_tp_t *tps, std::size_t count): tps{tps}, count{count} {};
+
+	std::size_t size() const { return this->count; };
+
+	bool empty() const { return this->count == 0; };
+
+	/**
+	 * @brief Get the frame of a Time Plan
+	 *
+	 * @param index  The position of the Time Plan
+	 * @return the frame number within the superframe
+	 */
+	uint8_t getFrameNumber(std::size_t index) const
+	{
+		return this->tps[index].frame_number;
+	};
+
+	/**
+	 * @brief Get a Time Plan
+	 *
+	 * @param index  The position of the Time Plan
+	 * @return the Time Plan in host byte order
+	 */
+	emu_tp_t getTimePlan(std::size_t index) const
+	{
+		emu_tp_t tp = this->tps[index].tp;
+		tp.tal_id = ntohs(tp.tal_id);
+		tp.offset = ntohl(tp.offset);
+		tp.assignment_count = ntohs(tp.assignment_count);
+		return tp;
+	};
+
+private:
+	const emu_indexed_tp_t *tps;
+	std::size_t count;
+};
+
+
 class Ttp: public DvbFrameTpl<T_DVB_TTP>
 {
 public:
@@ -152,9 +235,10 @@ public:
 	/**
 	 * @brief Build the TTP
 	 *
+	 * @param layout  How the Time Plans are laid out
 	 * @return true on success, false othertwise
 	 */
-	bool build(void);
+	bool build(TtpLayout layout = TtpLayout::Indexed);
 
 	/**
 	 * @brief Get the Time Plan for a terminal
@@ -162,10 +246,31 @@ public:
 	 * @param tal_id The terminal ID for which we want the TP
 	 * @param tp     The Time Plans per superframe id
 	 *
-	 * @return true if a TP is found, false otherwise
+	 * @return false if the TTP is malformed, true otherwise
 	 */
 	bool getTp(tal_id_t tal_id, std::map<uint8_t, emu_tp_t> &tps);
 
+	/**
+	 * @brief Get the Time Plans for a terminal, in O(log n) and without
+	 *        copy with the indexed layout, the legacy layout is scanned
+	 *
+	 * @param tal_id The terminal ID for which we want the TP
+	 * @param tps    OUT: the Time Plans, valid as long as the TTP is
+	 *
+	 * @return false if the TTP is malformed, true otherwise
+	 */
+	bool getTimePlans(tal_id_t tal_id, TimePlans &tps);
+
+	/**
+	 * @brief  Whether the TTP has the indexed layout
+	 *
+	 * @return true for the indexed layout, false for the legacy one
+	 */
+	bool isIndexed() const
+	{
+		return this->frame()->ttp.ttp_info.frame_loop_count & TTP_INDEXED_LAYOUT;
+	};
+
 	/**
 	 * @brief  Get the group Id
 	 *
@@ -195,8 +300,25 @@ private:
 	/// The list of frames and their TP
 	typedef std::map<uint8_t, time_plans_t> frames_t;
 
+	/**
+	 * @brief Append the Time Plans in the indexed layout
+	 *
+	 * @return the length of the appended data
+	 */
+	std::size_t buildIndexed();
+
+	/**
+	 * @brief Append the Time Plans in the legacy layout
+	 *
+	 * @return the length of the appended data
+	 */
+	std::size_t buildLegacy();
+
 	/// The frames, completed each time we add a TP
 	frames_t frames;
+
+	/// The Time Plans of a terminal found in a TTP with the legacy layout
+	std::vector<emu_indexed_tp_t> legacy_tps;
 };
 
 
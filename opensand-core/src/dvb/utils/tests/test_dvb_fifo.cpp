@@ -0,0 +1,417 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ * Copyright © 2019 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/**
+ * @file test_dvb_fifo.cpp
+ * @brief Check the fair queuing of the DVB fifos: flow hashing, deficit
+ *        round robin between flows, packets not ready yet, drops on
+ *        sojourn time and drops from the biggest flow of a full fifo
+ * @author Viveris Technologies
+ */
+
+
+#include <chrono>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include <netinet/in.h>
+
+#include "DvbFifo.h"
+#include "FifoElement.h"
+#include "NetPacket.h"
+
+
+static const std::size_t packet_length = 1000;
+
+
+/**
+ * @brief A fair queuing fifo giving access to its flows
+ */
+class TestFifo: public DvbFifo
+{
+public:
+	TestFifo(vol_pkt_t max_size_pkt, time_ms_t target, time_ms_t interval):
+		DvbFifo{0, "EF", "DAMA_RBDC", max_size_pkt}
+	{
+		this->setSingleOwner(true);
+		this->enableFairQueuing(target, interval);
+	}
+
+	using DvbFifo::getFlowId;
+	using DvbFifo::pop;
+
+	/**
+	 * @brief Pop the ready packets and get their source port
+	 */
+	std::vector<uint16_t> popPorts()
+	{
+		std::vector<uint16_t> ports;
+		for(auto &&elem: *this)
+		{
+			ports.push_back(port(*elem->releaseElem<NetPacket>()));
+		}
+		return ports;
+	}
+
+	/**
+	 * @brief Get the source port of an UDP over IPv4 packet
+	 */
+	static uint16_t port(const NetPacket &packet)
+	{
+		const uint8_t *data = packet.getRawData();
+		return (data[20] << 8) | data[21];
+	}
+};
+
+
+/**
+ * @brief Build an UDP over IPv4 packet
+ */
+static Rt::Data udpPacket(uint16_t src_port, uint16_t dst_port = 5000)
+{
+	Rt::Data data(packet_length, 0);
+	data[0] = 0x45;
+	data[9] = IPPROTO_UDP;
+	data[12] = 192;
+	data[13] = 168;
+	data[15] = 1;
+	data[16] = 192;
+	data[17] = 168;
+	data[19] = 2;
+	data[20] = src_port >> 8;
+	data[21] = src_port & 0xff;
+	data[22] = dst_port >> 8;
+	data[23] = dst_port & 0xff;
+	return data;
+}
+
+
+static Rt::Ptr<NetPacket> ipPacket(const Rt::Data &data, uint8_t src_tal_id = 1)
+{
+	return Rt::make_ptr<NetPacket>(data, data.size(), "IP", NET_PROTO::IP,
+	                               0, src_tal_id, 0, 20);
+}
+
+
+static bool push(TestFifo &fifo, uint16_t src_port, time_ms_t duration = time_ms_t::zero())
+{
+	return fifo.push(ipPacket(udpPacket(src_port)), duration);
+}
+
+
+static bool testFlowId()
+{
+	std::size_t flow = TestFifo::getFlowId(*ipPacket(udpPacket(1000)));
+	if(flow != TestFifo::getFlowId(*ipPacket(udpPacket(1000))))
+	{
+		fprintf(stderr, "same flow, same id\n");
+		return false;
+	}
+	if(flow == TestFifo::getFlowId(*ipPacket(udpPacket(1001))))
+	{
+		fprintf(stderr, "source port in the flow id\n");
+		return false;
+	}
+	if(flow == TestFifo::getFlowId(*ipPacket(udpPacket(1000, 5001))))
+	{
+		fprintf(stderr, "destination port in the flow id\n");
+		return false;
+	}
+	if(flow == TestFifo::getFlowId(*ipPacket(udpPacket(1000), 2)))
+	{
+		fprintf(stderr, "terminal in the flow id\n");
+		return false;
+	}
+
+	Rt::Data payload = udpPacket(1000);
+	payload[packet_length - 1] = 0xff;
+	if(flow != TestFifo::getFlowId(*ipPacket(payload)))
+	{
+		fprintf(stderr, "payload not in the flow id\n");
+		return false;
+	}
+
+	// the same packet in a VLAN tagged Ethernet frame
+	Rt::Data frame(12, 0);
+	frame += Rt::Data{0x81, 0x00, 0x00, 0x01, 0x08, 0x00};
+	frame += udpPacket(1000);
+	NetPacket eth{frame, frame.size(), "Ethernet", NET_PROTO::ETH, 0, 1, 0, 18};
+	if(flow != TestFifo::getFlowId(eth))
+	{
+		fprintf(stderr, "Ethernet frame in the IP flow\n");
+		return false;
+	}
+
+	NetContainer container{Rt::Data(packet_length, 0)};
+	if(TestFifo::getFlowId(container) != 0)
+	{
+		fprintf(stderr, "other containers in the first flow\n");
+		return false;
+	}
+	return true;
+}
+
+
+static bool testFairness()
+{
+	TestFifo fifo{100, time_ms_t(1000), time_ms_t(1000)};
+	for(unsigned int i = 0; i < 10; i++)
+	{
+		push(fifo, 1000);
+	}
+	for(unsigned int i = 0; i < 3; i++)
+	{
+		push(fifo, 2000);
+	}
+
+	std::vector<uint16_t> ports = fifo.popPorts();
+	if(ports.size() != 13)
+	{
+		fprintf(stderr, "all packets served\n");
+		return false;
+	}
+	if(!(fifo.getCurrentSize() == 0 && fifo.getCurrentDataLength() == 0))
+	{
+		fprintf(stderr, "fifo emptied\n");
+		return false;
+	}
+
+	// the late flow is served after one quantum of the first one instead
+	// of waiting for all its packets
+	std::size_t last = 0;
+	unsigned int served = 0;
+	for(std::size_t i = 0; i < ports.size(); i++)
+	{
+		if(ports[i] == 2000)
+		{
+			last = i;
+			served++;
+		}
+	}
+	if(served != 3)
+	{
+		fprintf(stderr, "late flow served\n");
+		return false;
+	}
+	if(last >= 10)
+	{
+		fprintf(stderr, "late flow served within the first flow\n");
+		return false;
+	}
+	if(ports.front() != 1000)
+	{
+		fprintf(stderr, "first flow served first\n");
+		return false;
+	}
+	return true;
+}
+
+
+static bool testNotReady()
+{
+	TestFifo fifo{100, time_ms_t(1000), time_ms_t(1000)};
+	push(fifo, 1000, time_ms_t(100));
+	push(fifo, 2000);
+	// a packet of the delayed flow may not get ahead of the delayed one
+	push(fifo, 1000);
+
+	std::vector<uint16_t> ports = fifo.popPorts();
+	if(!(ports.size() == 1 && ports.front() == 2000))
+	{
+		fprintf(stderr, "ready flow served only\n");
+		return false;
+	}
+	if(fifo.pop())
+	{
+		fprintf(stderr, "delayed flow not served\n");
+		return false;
+	}
+	if(fifo.getCurrentSize() != 2)
+	{
+		fprintf(stderr, "delayed packets kept\n");
+		return false;
+	}
+
+	std::this_thread::sleep_for(std::chrono::milliseconds(120));
+	ports = fifo.popPorts();
+	if(!(ports.size() == 2 && ports[0] == 1000 && ports[1] == 1000))
+	{
+		fprintf(stderr, "delayed flow served when ready\n");
+		return false;
+	}
+	if(fifo.getCurrentSize() != 0)
+	{
+		fprintf(stderr, "fifo emptied once ready\n");
+		return false;
+	}
+	return true;
+}
+
+
+static bool testSojournDrops()
+{
+	mac_fifo_stat_context_t stats;
+	TestFifo fifo{100, time_ms_t(5), time_ms_t(20)};
+	for(unsigned int i = 0; i < 20; i++)
+	{
+		push(fifo, 1000);
+	}
+	fifo.getStatsCxt(stats);
+
+	// above target, the first packet starts the interval
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	if(fifo.pop() == nullptr)
+	{
+		fprintf(stderr, "served at the start of the interval\n");
+		return false;
+	}
+	fifo.getStatsCxt(stats);
+	if(!(stats.drop_pkt_nbr == 0 && stats.out_pkt_nbr == 1))
+	{
+		fprintf(stderr, "no drop at the start of the interval\n");
+		return false;
+	}
+
+	// still above target after the interval, packets are dropped
+	std::this_thread::sleep_for(std::chrono::milliseconds(25));
+	if(fifo.pop() == nullptr)
+	{
+		fprintf(stderr, "served while dropping\n");
+		return false;
+	}
+	fifo.getStatsCxt(stats);
+	if(stats.drop_pkt_nbr < 1)
+	{
+		fprintf(stderr, "dropped after the interval\n");
+		return false;
+	}
+	if(stats.drop_pkt_nbr + stats.out_pkt_nbr + fifo.getCurrentSize() != 19)
+	{
+		fprintf(stderr, "dropped packets accounted\n");
+		return false;
+	}
+
+	// the last ready packet is never dropped, even if a delayed one
+	// is still in the fifo
+	TestFifo last{100, time_ms_t(5), time_ms_t(20)};
+	push(last, 1000);
+	push(last, 1000);
+	push(last, 2000, time_ms_t(1000));
+	last.getStatsCxt(stats);
+	std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	if(last.pop() == nullptr)
+	{
+		fprintf(stderr, "first ready packet served\n");
+		return false;
+	}
+	std::this_thread::sleep_for(std::chrono::milliseconds(25));
+	if(last.pop() == nullptr)
+	{
+		fprintf(stderr, "last ready packet served\n");
+		return false;
+	}
+	last.getStatsCxt(stats);
+	if(!(stats.drop_pkt_nbr == 0 && stats.out_pkt_nbr == 2))
+	{
+		fprintf(stderr, "last ready packet not dropped\n");
+		return false;
+	}
+	if(last.getCurrentSize() != 1)
+	{
+		fprintf(stderr, "delayed packet kept\n");
+		return false;
+	}
+	return true;
+}
+
+
+static bool testOverflow()
+{
+	mac_fifo_stat_context_t stats;
+	TestFifo fifo{10, time_ms_t(1000), time_ms_t(1000)};
+	for(unsigned int i = 0; i < 10; i++)
+	{
+		if(!push(fifo, 1000))
+		{
+			fprintf(stderr, "fill the fifo\n");
+			return false;
+		}
+	}
+	if(!push(fifo, 2000))
+	{
+		fprintf(stderr, "full fifo accepts another flow\n");
+		return false;
+	}
+	if(fifo.getCurrentSize() != 10)
+	{
+		fprintf(stderr, "full fifo size kept\n");
+		return false;
+	}
+	if(fifo.getCurrentDataLength() != 10 * packet_length)
+	{
+		fprintf(stderr, "full fifo length kept\n");
+		return false;
+	}
+	fifo.getStatsCxt(stats);
+	if(!(stats.drop_pkt_nbr == 1 && stats.drop_bytes == packet_length))
+	{
+		fprintf(stderr, "biggest flow dropped\n");
+		return false;
+	}
+
+	std::vector<uint16_t> ports = fifo.popPorts();
+	unsigned int served = 0;
+	for(auto &&port: ports)
+	{
+		served += port == 2000;
+	}
+	if(ports.size() != 10)
+	{
+		fprintf(stderr, "remaining packets served\n");
+		return false;
+	}
+	if(served != 1)
+	{
+		fprintf(stderr, "incoming packet kept\n");
+		return false;
+	}
+	return true;
+}
+
+
+int main()
+{
+	if(!testFlowId() || !testFairness() || !testNotReady() ||
+	   !testSojournDrops() || !testOverflow())
+	{
+		return 1;
+	}
+	printf("DVB fifo tests passed\n");
+	return 0;
+}
@@ -0,0 +1,219 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ * Copyright © 2019 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/**
+ * @file test_terminal_table.cpp
+ * @brief Replay SAC traces on a DAMA terminals table and check that the
+ *        incremental VBDC queue and the credit ordering serve the terminals
+ *        exactly as a stable sort of the whole table did
+ * @author Viveris Technologies
+ */
+
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "TerminalContextDamaRcs.h"
+#include "TerminalTableDama.h"
+
+
+static const unsigned int nbr_terminals = 200;
+static const unsigned int nbr_superframes = 2000;
+static const vol_kb_t max_vbdc_kb = 5000;
+static const rate_kbps_t max_rbdc_kbps = 2000;
+
+
+/**
+ * @brief The reference VBDC pass: stable sort on the requests then serve
+ *        the terminals until there is no more capacity
+ */
+static void referenceVbdc(const std::vector<vol_kb_t> &requests,
+                          vol_kb_t capacity_kb,
+                          std::vector<std::pair<std::size_t, vol_kb_t>> &served,
+                          vol_kb_t &pending_kb,
+                          std::size_t &pending_count)
+{
+	std::vector<std::size_t> rows(requests.size());
+	std::iota(rows.begin(), rows.end(), 0);
+	std::stable_sort(rows.begin(), rows.end(),
+	                 [&requests](std::size_t r1, std::size_t r2)
+	                 { return requests[r1] > requests[r2]; });
+
+	auto it = rows.begin();
+	for(; it != rows.end() && 0 < capacity_kb; ++it)
+	{
+		if(requests[*it] == 0)
+		{
+			continue;
+		}
+		vol_kb_t alloc_kb = std::min(requests[*it], capacity_kb);
+		capacity_kb -= alloc_kb;
+		served.emplace_back(*it, alloc_kb);
+	}
+	pending_kb = 0;
+	pending_count = 0;
+	for(; it != rows.end(); ++it)
+	{
+		if(requests[*it] > 0)
+		{
+			pending_kb += requests[*it];
+			pending_count++;
+		}
+	}
+}
+
+
+/**
+ * @brief Build the table with the terminals in the given order
+ */
+static void buildTable(TerminalTableDama &table,
+                       std::vector<std::unique_ptr<TerminalContextDamaRcs>> &terminals,
+                       const std::vector<std::size_t> &members)
+{
+	table.clear();
+	for(auto &&index: members)
+	{
+		table.addTerminal(terminals[index].get());
+	}
+}
+
+
+int main()
+{
+	std::mt19937 gen(42);
+	std::uniform_int_distribution<unsigned int> percent(0, 99);
+	std::uniform_int_distribution<vol_kb_t> vbdc_request(0, max_vbdc_kb / 4);
+	std::uniform_int_distribution<rate_kbps_t> rbdc_request(0, max_rbdc_kbps);
+	std::uniform_real_distribution<double> credit(0.0, 10.0);
+
+	std::vector<std::unique_ptr<TerminalContextDamaRcs>> terminals;
+	std::vector<std::size_t> members;
+	for(unsigned int i = 0; i < nbr_terminals; ++i)
+	{
+		terminals.emplace_back(new TerminalContextDamaRcs(i + 1, 0, max_rbdc_kbps,
+		                                                  10, max_vbdc_kb));
+		members.push_back(i);
+	}
+
+	TerminalTableDama table;
+	buildTable(table, terminals, members);
+
+	for(unsigned int sf = 0; sf < nbr_superframes; ++sf)
+	{
+		// a terminal logs off, logs on or moves from time to time
+		if(percent(gen) < 2)
+		{
+			members.resize(nbr_terminals);
+			std::iota(members.begin(), members.end(), 0);
+			std::shuffle(members.begin(), members.end(), gen);
+			members.resize(nbr_terminals - percent(gen) % 20);
+			buildTable(table, terminals, members);
+		}
+
+		// replay the SAC received during this superframe, a lot of
+		// terminals send the same requests as before
+		for(auto &&index: members)
+		{
+			unsigned int draw = percent(gen);
+			if(draw < 20)
+			{
+				terminals[index]->setRequiredVbdc(vbdc_request(gen) * (draw % 3));
+			}
+			if(draw < 40)
+			{
+				terminals[index]->setRequiredRbdc(rbdc_request(gen));
+			}
+			terminals[index]->addRbdcCredit(credit(gen) * (draw % 2));
+		}
+		table.refresh();
+
+		// RBDC/FCA: the credit order is the stable sort one, even
+		// if the credit of a visited terminal changes
+		std::vector<std::size_t> sorted(table.size());
+		std::iota(sorted.begin(), sorted.end(), 0);
+		std::stable_sort(sorted.begin(), sorted.end(),
+		                 [&table](std::size_t r1, std::size_t r2)
+		                 { return table.getRbdcCredit(r1) > table.getRbdcCredit(r2); });
+		std::size_t visit = percent(gen) * table.size() / 100;
+		std::size_t row;
+		table.startCreditOrder();
+		for(std::size_t i = 0; i < visit; ++i)
+		{
+			if(!table.popHighestCredit(row) || row != sorted[i])
+			{
+				fprintf(stderr, "SF#%u: wrong credit order at rank %zu\n", sf, i);
+				return 1;
+			}
+			table.addRbdcCredit(row, -credit(gen));
+		}
+
+		// VBDC: serve the terminals until the capacity is exhausted
+		std::vector<vol_kb_t> requests;
+		for(std::size_t r = 0; r < table.size(); ++r)
+		{
+			requests.push_back(table.getRequiredVbdc(r));
+		}
+		vol_kb_t capacity_kb = percent(gen) * max_vbdc_kb / 4;
+		std::vector<std::pair<std::size_t, vol_kb_t>> expected;
+		vol_kb_t expected_pending_kb;
+		std::size_t expected_pending_count;
+		referenceVbdc(requests, capacity_kb, expected,
+		              expected_pending_kb, expected_pending_count);
+
+		std::size_t rank = 0;
+		while(0 < capacity_kb && table.popHighestVbdcReq(row))
+		{
+			vol_kb_t alloc_kb = std::min(table.getRequiredVbdc(row), capacity_kb);
+			if(rank >= expected.size() ||
+			   expected[rank].first != row || expected[rank].second != alloc_kb)
+			{
+				fprintf(stderr, "SF#%u: wrong VBDC allocation at rank %zu\n", sf, rank);
+				return 1;
+			}
+			capacity_kb -= alloc_kb;
+			table.setVbdcAllocation(row, alloc_kb);
+			rank++;
+		}
+		if(rank != expected.size() ||
+		   table.getQueuedVbdcReq() != expected_pending_kb ||
+		   table.getQueuedVbdcReqCount() != expected_pending_count)
+		{
+			fprintf(stderr, "SF#%u: wrong VBDC pending requests\n", sf);
+			return 1;
+		}
+		table.restoreVbdcOrder();
+	}
+
+	// everything went fine, so report success
+	return 0;
+}
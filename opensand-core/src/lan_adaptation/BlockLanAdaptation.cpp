@@ -71,7 +71,8 @@
  */
 BlockLanAdaptation::BlockLanAdaptation(const std::string &name, la_specific specific):
 	Rt::Block<BlockLanAdaptation, la_specific>{name, specific},
-	tap_iface{specific.tap_iface}
+	tap_iface{specific.tap_iface},
+	tap_dispatched{specific.tap_dispatched}
 {
 }
 
@@ -114,9 +115,9 @@ bool BlockLanAdaptation::onInit()
 	    "add lan adaptation: %s\n",
 	    plugin->getName());
 
-	// create TAP virtual interface
+	// create TAP virtual interface, unless the upper block handles it
 	int fd = -1;
-	if(!this->allocTap(fd))
+	if(!this->tap_dispatched && !allocTap(this->tap_iface, this->log_init, fd))
 	{
 		return false;
 	}
@@ -195,6 +196,11 @@ void Rt::UpwardChannel<BlockLanAdaptation>::setFd(int fd)
 
 void Rt::DownwardChannel<BlockLanAdaptation>::setFd(int fd)
 {
+	if(fd < 0)
+	{
+		// frames are read by the upper block
+		return;
+	}
 	// add file descriptor for TAP interface
 	this->addFileEvent("tap", fd, TUNTAP_BUFSIZE + 4);
 }
@@ -234,6 +240,13 @@ bool Rt::DownwardChannel<BlockLanAdaptation>::onEvent(const MessageEvent& event)
 		return true;
 	}
 
+	if(to_enum<InternalMessageType>(event.getMessageType()) == InternalMessageType::decap_data)
+	{
+		// frame read by the upper block on the shared TAP interface
+		Ptr<NetPacket> frame = event.getMessage<NetPacket>();
+		return this->onFrameFromLan(frame->getData());
+	}
+
 	// this is not a link up message, this should be a forward burst
 	LOG(this->log_receive, LEVEL_DEBUG,
 	    "Get a forward burst from opposite channel\n");
@@ -251,8 +264,12 @@ bool Rt::DownwardChannel<BlockLanAdaptation>::onEvent(const MessageEvent& event)
 bool Rt::DownwardChannel<BlockLanAdaptation>::onEvent(const FileEvent& event)
 {
 	// read  data received on tap interface
-	std::size_t length = event.getSize() - TUNTAP_FLAGS_LEN;
-	Data read_data = event.getData();
+	return this->onFrameFromLan(event.getData());
+}
+
+bool Rt::DownwardChannel<BlockLanAdaptation>::onFrameFromLan(const Data &read_data)
+{
+	std::size_t length = read_data.length() - TUNTAP_FLAGS_LEN;
 
 	if(this->state != SatelliteLinkState::UP)
 	{
@@ -533,6 +550,21 @@ bool Rt::UpwardChannel<BlockLanAdaptation>::onMsgFromDown(Ptr<NetBurst> burst)
 
 bool Rt::UpwardChannel<BlockLanAdaptation>::writePacket(const Data& packet)
 {
+	if(this->fd < 0)
+	{
+		// the upper block writes on the shared TAP interface,
+		// it needs the terminal to map the frame on it
+		Ptr<NetPacket> frame = make_ptr<NetPacket>(packet);
+		frame->setDstTalId(this->tal_id);
+		if(!this->enqueueMessage(std::move(frame), to_underlying(InternalMessageType::decap_data)))
+		{
+			LOG(this->log_receive, LEVEL_ERROR,
+			    "Unable to send data to the TAP interface handler\n");
+			return false;
+		}
+		return true;
+	}
+
 	// TODO move into its own function for delay...
 	if(write(this->fd, packet.data(), packet.length()) < 0)
 	{
@@ -544,7 +576,9 @@ bool Rt::UpwardChannel<BlockLanAdaptation>::writePacket(const Data& packet)
 	return true;
 }
 
-bool BlockLanAdaptation::allocTap(int &fd)
+bool BlockLanAdaptation::allocTap(const std::string &tap_iface,
+                                  std::shared_ptr<OutputLog> log,
+                                  int &fd)
 {
 	struct ifreq ifr;
 	int err;
@@ -552,7 +586,7 @@ bool BlockLanAdaptation::allocTap(int &fd)
 	fd = open("/dev/net/tun", O_RDWR);
 	if(fd < 0)
 	{
-		LOG(this->log_init, LEVEL_ERROR,
+		LOG(log, LEVEL_ERROR,
 		    "cannot open '/dev/net/tun': %s\n",
 		    strerror(errno));
 		return false;
@@ -566,23 +600,23 @@ bool BlockLanAdaptation::allocTap(int &fd)
 	 */
 
 	/* create TAP interface */
-	LOG(this->log_init, LEVEL_INFO,
+	LOG(log, LEVEL_INFO,
 	    "create %s interface\n",
-	    this->tap_iface.c_str());
-	memcpy(ifr.ifr_name, this->tap_iface.c_str(), IFNAMSIZ);
+	    tap_iface.c_str());
+	memcpy(ifr.ifr_name, tap_iface.c_str(), IFNAMSIZ);
 	ifr.ifr_flags = IFF_TAP;
 
 	err = ioctl(fd, TUNSETIFF, static_cast<void *>(&ifr));
 	if(err < 0)
 	{
-		LOG(this->log_init, LEVEL_ERROR,
+		LOG(log, LEVEL_ERROR,
 		    "cannot set flags on file descriptor %s\n",
 		    strerror(errno));
 		close(fd);
 		return false;
 	}
 
-	LOG(this->log_init, LEVEL_NOTICE,
+	LOG(log, LEVEL_NOTICE,
 	    "TAP handle with fd %d initialized\n", fd);
 
 	return true;
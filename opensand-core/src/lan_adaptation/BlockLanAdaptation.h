@@ -61,6 +61,9 @@ struct la_specific
 	tal_id_t connected_satellite = 0;
 	bool is_used_for_isl = false;
 	std::shared_ptr<PacketSwitch> packet_switch = nullptr;
+	/// the TAP interface is shared with other terminals and
+	/// handled by the upper block (see BlockTapDispatcher)
+	bool tap_dispatched = false;
 };
 
 
@@ -87,7 +90,8 @@ class Rt::UpwardChannel<class BlockLanAdaptation>: public Channels::Upward<Upwar
 	/**
 	 * @brief Set the network socket file descriptor
 	 *
-	 * @param fd  The socket file descriptor
+	 * @param fd  The socket file descriptor, -1 when the upper
+	 *            block handles the interface
 	 */
 	void setFd(int fd);
 
@@ -103,7 +107,8 @@ class Rt::UpwardChannel<class BlockLanAdaptation>: public Channels::Upward<Upwar
 	bool onMsgFromDown(Ptr<NetBurst> burst);
 
 	/**
-	 * @brief Actually write the TAP header + packet to TAP interface
+	 * @brief Actually write the TAP header + packet to TAP interface,
+	 *        or send it to the upper block when it handles the interface
 	 *
 	 * @param packet  Data to write on the TAP interface
 	 * @return true on success, false otherwise
@@ -113,7 +118,7 @@ class Rt::UpwardChannel<class BlockLanAdaptation>: public Channels::Upward<Upwar
 	/// SARP table
 	SarpTable sarp_table;
 
-	/// TAP file descriptor
+	/// TAP file descriptor, -1 when the upper block handles the interface
 	int fd;
 
 	/// the ethernet context
@@ -163,11 +168,20 @@ class Rt::DownwardChannel<class BlockLanAdaptation>: public Channels::Downward<D
 	/**
 	 * @brief Set the network socket file descriptor
 	 *
-	 * @param fd  The socket file descriptor
+	 * @param fd  The socket file descriptor, -1 when the upper
+	 *            block handles the interface
 	 */
 	void setFd(int fd);
 
  private:
+	/**
+	 * @brief Handle a frame read on the TAP interface
+	 *
+	 * @param read_data  The TAP header + frame
+	 * @return true on success, false otherwise
+	 */
+	bool onFrameFromLan(const Data &read_data);
+
 	/// statistic timer
 	event_id_t stats_timer;
 
@@ -202,17 +216,24 @@ public:
 	// initialization method
 	bool onInit() override;
 
-private:
-	/// The TAP interface name
-	std::string tap_iface;
-
 	/**
 	 * Create or connect to an existing TAP interface
 	 *
-	 * @param fd  OUT: the file descriptor
+	 * @param tap_iface  The TAP interface name
+	 * @param log        The log to report errors on
+	 * @param fd         OUT: the file descriptor
 	 * @return  true on success, false otherwise
 	 */
-	bool allocTap(int &fd);
+	static bool allocTap(const std::string &tap_iface,
+	                     std::shared_ptr<OutputLog> log,
+	                     int &fd);
+
+private:
+	/// The TAP interface name
+	std::string tap_iface;
+
+	/// Whether the upper block handles the TAP interface
+	bool tap_dispatched;
 };
 
 
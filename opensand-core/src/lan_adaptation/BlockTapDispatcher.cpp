@@ -0,0 +1,274 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file BlockTapDispatcher.cpp
+ * @brief Share a TAP interface between the terminals of a multi-terminal entity
+ * @author Viveris Technologies
+ */
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <arpa/inet.h>
+#include <unistd.h>
+
+#include <opensand_output/Output.h>
+#include <opensand_rt/FileEvent.h>
+#include <opensand_rt/MessageEvent.h>
+
+#include "BlockTapDispatcher.h"
+#include "BlockLanAdaptation.h"
+#include "MacAddress.h"
+#include "NetPacket.h"
+#include "OpenSandModelConf.h"
+
+
+#define TUNTAP_FLAGS_LEN 4 // Flags [2 bytes] + Proto [2 bytes]
+#define TUNTAP_BUFSIZE MAX_ETHERNET_SIZE // ethernet header + mtu + options, crc not included
+#define ETHERNET_ADDRESSES_LEN 12 // destination + source MAC addresses
+#define IEEE_802_1Q_TAG_LEN 4 // TPID [2 bytes] + TCI [2 bytes]
+
+
+BlockTapDispatcher::BlockTapDispatcher(const std::string &name,
+                                       tap_dispatcher_specific specific):
+	Rt::Block<BlockTapDispatcher, tap_dispatcher_specific>{name, specific},
+	tap_iface{specific.tap_iface}
+{
+}
+
+
+bool BlockTapDispatcher::onInit()
+{
+	int fd = -1;
+	if(!BlockLanAdaptation::allocTap(this->tap_iface, this->log_init, fd))
+	{
+		return false;
+	}
+
+	// we can share FD as one thread will write, the second will read
+	this->upward.setFd(fd);
+	this->downward.setFd(fd);
+
+	return true;
+}
+
+
+Rt::UpwardChannel<BlockTapDispatcher>::UpwardChannel(const std::string &name,
+                                                     tap_dispatcher_specific specific):
+	Channels::UpwardMux<UpwardChannel<BlockTapDispatcher>>{name},
+	fd{-1},
+	tap_sharing{specific.tap_sharing},
+	vlan_base{specific.vlan_base}
+{
+}
+
+
+void Rt::UpwardChannel<BlockTapDispatcher>::setFd(int fd)
+{
+	this->fd = fd;
+}
+
+
+bool Rt::UpwardChannel<BlockTapDispatcher>::onEvent(const Event &event)
+{
+	LOG(this->log_receive, LEVEL_ERROR,
+	    "Unexpected event received: %s",
+	    event.getName().c_str());
+	return false;
+}
+
+
+bool Rt::UpwardChannel<BlockTapDispatcher>::onEvent(const MessageEvent &event)
+{
+	if(to_enum<InternalMessageType>(event.getMessageType()) != InternalMessageType::decap_data)
+	{
+		LOG(this->log_receive, LEVEL_ERROR,
+		    "Unexpected message received: %d",
+		    event.getMessageType());
+		return false;
+	}
+
+	Ptr<NetPacket> frame = event.getMessage<NetPacket>();
+	Data packet = frame->getData();
+	if(this->tap_sharing == TapSharing::Vlan)
+	{
+		if(packet.length() < TUNTAP_FLAGS_LEN + ETHERNET_ADDRESSES_LEN)
+		{
+			LOG(this->log_receive, LEVEL_ERROR,
+			    "frame of terminal %u too short to be tagged, drop it",
+			    frame->getDstTalId());
+			return false;
+		}
+
+		// tag the frame with the VLAN of the terminal, right after the
+		// MAC addresses, the TAP header keeps the protocol of the payload
+		uint16_t tpid = htons(to_underlying(NET_PROTO::IEEE_802_1Q));
+		uint16_t tci = htons((this->vlan_base + frame->getDstTalId()) & 0x0FFF);
+		unsigned char tag[IEEE_802_1Q_TAG_LEN];
+		memcpy(tag, &tpid, sizeof(tpid));
+		memcpy(tag + sizeof(tpid), &tci, sizeof(tci));
+		packet.insert(TUNTAP_FLAGS_LEN + ETHERNET_ADDRESSES_LEN, tag, IEEE_802_1Q_TAG_LEN);
+	}
+
+	if(write(this->fd, packet.data(), packet.length()) < 0)
+	{
+		LOG(this->log_receive, LEVEL_ERROR,
+		    "Unable to write data on tap interface: %s\n",
+		    strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+
+Rt::DownwardChannel<BlockTapDispatcher>::DownwardChannel(const std::string &name,
+                                                         tap_dispatcher_specific specific):
+	Channels::DownwardDemux<DownwardChannel<BlockTapDispatcher>, tal_id_t>{name},
+	tap_sharing{specific.tap_sharing},
+	vlan_base{specific.vlan_base},
+	tal_ids{specific.tal_ids},
+	sarp_table{}
+{
+}
+
+
+bool Rt::DownwardChannel<BlockTapDispatcher>::onInit()
+{
+	if(this->tap_sharing == TapSharing::Mac &&
+	   !OpenSandModelConf::Get()->getSarp(this->sarp_table))
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+		    "cannot load the SARP table to map frames to terminals\n");
+		return false;
+	}
+	return true;
+}
+
+
+void Rt::DownwardChannel<BlockTapDispatcher>::setFd(int fd)
+{
+	// add file descriptor for TAP interface
+	this->addFileEvent("tap", fd, TUNTAP_BUFSIZE + TUNTAP_FLAGS_LEN + IEEE_802_1Q_TAG_LEN);
+}
+
+
+bool Rt::DownwardChannel<BlockTapDispatcher>::onEvent(const Event &event)
+{
+	LOG(this->log_receive, LEVEL_ERROR,
+	    "Unexpected event received: %s",
+	    event.getName().c_str());
+	return false;
+}
+
+
+bool Rt::DownwardChannel<BlockTapDispatcher>::onEvent(const FileEvent &event)
+{
+	Data frame = event.getData();
+	tal_id_t tal_id;
+	if(!this->getTerminal(frame, tal_id))
+	{
+		// not ours, the interface may carry other traffic
+		return true;
+	}
+
+	if(!this->enqueueMessage(tal_id,
+	                         make_ptr<NetPacket>(frame),
+	                         to_underlying(InternalMessageType::decap_data)))
+	{
+		LOG(this->log_receive, LEVEL_ERROR,
+		    "failed to send frame to terminal %u\n", tal_id);
+		return false;
+	}
+	return true;
+}
+
+
+bool Rt::DownwardChannel<BlockTapDispatcher>::getTerminal(Data &frame, tal_id_t &tal_id) const
+{
+	if(frame.length() < TUNTAP_FLAGS_LEN + ETHERNET_2_HEADSIZE)
+	{
+		LOG(this->log_receive, LEVEL_WARNING,
+		    "%zu-bytes frame read on TAP interface is too short, drop it\n",
+		    frame.length());
+		return false;
+	}
+
+	const unsigned char *eth = frame.data() + TUNTAP_FLAGS_LEN;
+	switch(this->tap_sharing)
+	{
+		case TapSharing::Vlan:
+		{
+			uint16_t tpid = (eth[ETHERNET_ADDRESSES_LEN] << 8) | eth[ETHERNET_ADDRESSES_LEN + 1];
+			if(tpid != to_underlying(NET_PROTO::IEEE_802_1Q))
+			{
+				LOG(this->log_receive, LEVEL_DEBUG,
+				    "untagged frame read on TAP interface, drop it\n");
+				return false;
+			}
+			uint16_t vid = ((eth[ETHERNET_ADDRESSES_LEN + 2] << 8) | eth[ETHERNET_ADDRESSES_LEN + 3]) & 0x0FFF;
+			if(vid < this->vlan_base)
+			{
+				LOG(this->log_receive, LEVEL_DEBUG,
+				    "frame read on TAP interface for unknown VLAN %u, drop it\n",
+				    vid);
+				return false;
+			}
+			tal_id = vid - this->vlan_base;
+			// the terminal sees the frame without the tag
+			frame.erase(TUNTAP_FLAGS_LEN + ETHERNET_ADDRESSES_LEN, IEEE_802_1Q_TAG_LEN);
+			break;
+		}
+		case TapSharing::Mac:
+		{
+			MacAddress src_mac{eth[6], eth[7], eth[8], eth[9], eth[10], eth[11]};
+			if(!this->sarp_table.getTalByMac(src_mac, tal_id))
+			{
+				LOG(this->log_receive, LEVEL_DEBUG,
+				    "frame read on TAP interface from unknown MAC %s, drop it\n",
+				    src_mac.str().c_str());
+				return false;
+			}
+			break;
+		}
+		default:
+			LOG(this->log_receive, LEVEL_ERROR,
+			    "TAP interface is not shared between terminals\n");
+			return false;
+	}
+
+	if(std::find(this->tal_ids.begin(), this->tal_ids.end(), tal_id) == this->tal_ids.end())
+	{
+		LOG(this->log_receive, LEVEL_DEBUG,
+		    "frame read on TAP interface for terminal %u not emulated here, drop it\n",
+		    tal_id);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,150 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file BlockTapDispatcher.h
+ * @brief Share a TAP interface between the terminals of a multi-terminal entity
+ * @author Viveris Technologies
+ */
+
+#ifndef BLOCK_TAP_DISPATCHER_H
+#define BLOCK_TAP_DISPATCHER_H
+
+
+#include <vector>
+
+#include <opensand_rt/Block.h>
+#include <opensand_rt/RtChannelMux.h>
+#include <opensand_rt/RtChannelDemux.h>
+
+#include "OpenSandCore.h"
+#include "SarpTable.h"
+
+
+struct tap_dispatcher_specific
+{
+	std::string tap_iface;          ///< the shared TAP interface
+	TapSharing tap_sharing;         ///< how the terminals are told apart on the interface
+	uint16_t vlan_base = 0;         ///< the VLAN ID of a terminal minus its ID
+	std::vector<tal_id_t> tal_ids;  ///< the terminals sharing the interface
+};
+
+
+template<>
+class Rt::UpwardChannel<class BlockTapDispatcher>: public Channels::UpwardMux<UpwardChannel<BlockTapDispatcher>>
+{
+ public:
+	UpwardChannel(const std::string &name, tap_dispatcher_specific specific);
+
+	using ChannelBase::onEvent;
+	bool onEvent(const Event &event) override;
+	bool onEvent(const MessageEvent &event) override;
+
+	/**
+	 * @brief Set the TAP interface file descriptor
+	 *
+	 * @param fd  The file descriptor
+	 */
+	void setFd(int fd);
+
+ private:
+	/// TAP file descriptor
+	int fd;
+	/// How the terminals are told apart on the interface
+	TapSharing tap_sharing;
+	/// The VLAN ID of a terminal minus its ID
+	uint16_t vlan_base;
+};
+
+
+template<>
+class Rt::DownwardChannel<class BlockTapDispatcher>: public Channels::DownwardDemux<DownwardChannel<BlockTapDispatcher>, tal_id_t>
+{
+ public:
+	DownwardChannel(const std::string &name, tap_dispatcher_specific specific);
+
+	bool onInit() override;
+
+	using ChannelBase::onEvent;
+	bool onEvent(const Event &event) override;
+	bool onEvent(const FileEvent &event) override;
+
+	/**
+	 * @brief Set the TAP interface file descriptor
+	 *
+	 * @param fd  The file descriptor
+	 */
+	void setFd(int fd);
+
+ private:
+	/**
+	 * @brief Find the terminal a frame read on the TAP interface
+	 *        belongs to, and remove its VLAN tag if it is mapped by VLAN
+	 *
+	 * @param frame   The TAP header + frame
+	 * @param tal_id  OUT: the terminal
+	 * @return true if the frame belongs to one of the terminals, false otherwise
+	 */
+	bool getTerminal(Data &frame, tal_id_t &tal_id) const;
+
+	/// How the terminals are told apart on the interface
+	TapSharing tap_sharing;
+	/// The VLAN ID of a terminal minus its ID
+	uint16_t vlan_base;
+	/// The terminals sharing the interface
+	std::vector<tal_id_t> tal_ids;
+	/// The terminals by the MAC address of their network
+	SarpTable sarp_table;
+};
+
+
+/**
+ * @class BlockTapDispatcher
+ * @brief Upper block of the terminals of a multi-terminal entity that
+ *        share a single TAP interface
+ *
+ * The frames read on the interface are sent to the Lan_Adaptation block
+ * of the terminal selected by their VLAN ID (the tag is removed) or by
+ * their source MAC address, as given by the SARP table of the
+ * infrastructure; the frames of the terminals are written on the
+ * interface, tagged with the terminal VLAN ID when mapped by VLAN.
+ */
+class BlockTapDispatcher: public Rt::Block<BlockTapDispatcher, tap_dispatcher_specific>
+{
+ public:
+	BlockTapDispatcher(const std::string &name, tap_dispatcher_specific specific);
+
+	bool onInit() override;
+
+ private:
+	/// The TAP interface name
+	std::string tap_iface;
+};
+
+
+#endif
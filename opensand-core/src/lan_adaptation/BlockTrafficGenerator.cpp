@@ -0,0 +1,641 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file BlockTrafficGenerator.cpp
+ * @brief Synthetic Ethernet traffic source and sink replacing the TAP
+ *        interface to benchmark the data plane
+ * @author Viveris Technologies
+ */
+
+
+#include <algorithm>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstring>
+#include <dirent.h>
+#include <endian.h>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <unistd.h>
+
+#include <opensand_output/Output.h>
+#include <opensand_rt/MessageEvent.h>
+#include <opensand_rt/TimerEvent.h>
+
+#include "BlockTrafficGenerator.h"
+#include "NetPacket.h"
+#include "OpenSandModelConf.h"
+#include "SarpTable.h"
+
+
+#define TUNTAP_FLAGS_LEN 4 // Flags [2 bytes] + Proto [2 bytes]
+#define BENCH_ETHER_TYPE 0x88B5 // local experimental EtherType
+#define BENCH_MAGIC "OSBM"
+#define BENCH_MAGIC_LEN 4
+#define BENCH_PAYLOAD_LEN (BENCH_MAGIC_LEN + 2 * sizeof(uint64_t)) // magic + sequence + send time
+#define BENCH_MIN_FRAME_SIZE (ETHERNET_2_HEADSIZE + BENCH_PAYLOAD_LEN)
+#define BENCH_MAX_FRAME_SIZE (ETHERNET_2_HEADSIZE + 1500)
+#define BENCH_TICK_MS 1
+#define BENCH_MAX_BURST_MS 10 // credit kept when the blocks below lag
+
+
+/**
+ * @brief Get the time elapsed since the steady clock epoch, shared by
+ *        the processes of the host
+ */
+static uint64_t steadyNanoseconds()
+{
+	auto now = std::chrono::steady_clock::now().time_since_epoch();
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(now).count();
+}
+
+
+/**
+ * @brief Get the CPU time consumed by the threads of the process,
+ *        summed per block (the channel suffix of the thread names is removed)
+ */
+static std::map<std::string, double> blocksCpuTime()
+{
+	std::map<std::string, double> cpu_times;
+	const double ticks = sysconf(_SC_CLK_TCK);
+
+	DIR *tasks = opendir("/proc/self/task");
+	if(tasks == nullptr)
+	{
+		return cpu_times;
+	}
+
+	struct dirent *task;
+	while((task = readdir(tasks)) != nullptr)
+	{
+		if(task->d_name[0] == '.')
+		{
+			continue;
+		}
+		std::string path = std::string{"/proc/self/task/"} + task->d_name;
+
+		std::string name;
+		std::ifstream comm{path + "/comm"};
+		if(!std::getline(comm, name))
+		{
+			continue;
+		}
+		// threads are named <block>.up and <block>.down, truncated
+		// to 15 characters
+		std::size_t dot = name.rfind('.');
+		if(dot != std::string::npos && dot > 0)
+		{
+			name.erase(dot);
+		}
+
+		std::string stat;
+		std::ifstream stat_file{path + "/stat"};
+		if(!std::getline(stat_file, stat))
+		{
+			continue;
+		}
+		// the thread name may contain spaces, fields start after it
+		std::size_t end = stat.rfind(')');
+		if(end == std::string::npos)
+		{
+			continue;
+		}
+		std::istringstream fields{stat.substr(end + 2)};
+		std::string field;
+		unsigned long utime = 0;
+		unsigned long stime = 0;
+		// state is field 3, utime and stime are fields 14 and 15
+		for(unsigned int index = 3; index <= 15 && fields >> field; ++index)
+		{
+			if(index == 14)
+			{
+				utime = std::stoul(field);
+			}
+			else if(index == 15)
+			{
+				stime = std::stoul(field);
+			}
+		}
+		cpu_times[name] += (utime + stime) / ticks;
+	}
+	closedir(tasks);
+
+	return cpu_times;
+}
+
+
+bool TrafficProfile::parse(const std::string &spec, TrafficProfile &profile, std::string &error)
+{
+	std::istringstream options{spec};
+	std::string option;
+	while(std::getline(options, option, ','))
+	{
+		std::size_t equal = option.find('=');
+		if(equal == std::string::npos)
+		{
+			error = "missing value for '" + option + "'";
+			return false;
+		}
+		std::string key = option.substr(0, equal);
+		std::string value = option.substr(equal + 1);
+
+		try
+		{
+			if(key == "rate")
+			{
+				profile.rate = std::stod(value);
+				if(!(profile.rate > 0))
+				{
+					error = "the rate must be positive";
+					return false;
+				}
+			}
+			else if(key == "sizes")
+			{
+				profile.sizes.clear();
+				std::istringstream sizes{value};
+				std::string size;
+				while(std::getline(sizes, size, '/'))
+				{
+					std::size_t colon = size.find(':');
+					std::size_t bytes = std::stoul(size.substr(0, colon));
+					unsigned int weight = colon == std::string::npos ? 1 : std::stoul(size.substr(colon + 1));
+					if(bytes < BENCH_MIN_FRAME_SIZE || bytes > BENCH_MAX_FRAME_SIZE)
+					{
+						error = "frame size " + std::to_string(bytes) + " out of [" +
+						        std::to_string(BENCH_MIN_FRAME_SIZE) + ", " +
+						        std::to_string(BENCH_MAX_FRAME_SIZE) + "]";
+						return false;
+					}
+					if(weight == 0 || weight > 1000)
+					{
+						error = "frame size weight " + std::to_string(weight) + " out of [1, 1000]";
+						return false;
+					}
+					profile.sizes.emplace_back(bytes, weight);
+				}
+				if(profile.sizes.empty())
+				{
+					error = "no frame size";
+					return false;
+				}
+			}
+			else if(key == "warmup")
+			{
+				profile.warmup = time_ms_t(std::lround(std::stod(value) * 1000));
+			}
+			else if(key == "duration")
+			{
+				profile.duration = time_ms_t(std::lround(std::stod(value) * 1000));
+				if(profile.duration.count() <= 0)
+				{
+					error = "the duration must be positive";
+					return false;
+				}
+			}
+			else if(key == "report")
+			{
+				profile.report = value;
+			}
+			else
+			{
+				error = "unknown option '" + key + "'";
+				return false;
+			}
+		}
+		catch(const std::exception &)
+		{
+			error = "bad value '" + value + "' for '" + key + "'";
+			return false;
+		}
+	}
+
+	if(profile.warmup.count() < 0)
+	{
+		error = "the warmup must not be negative";
+		return false;
+	}
+	return true;
+}
+
+
+BlockTrafficGenerator::BlockTrafficGenerator(const std::string &name,
+                                             traffic_specific specific):
+	Rt::Block<BlockTrafficGenerator, traffic_specific>{name, specific},
+	counters{specific.counters}
+{
+}
+
+
+bool BlockTrafficGenerator::onInit()
+{
+	// the measure window starts from here for both channels
+	this->counters->start = std::chrono::steady_clock::now();
+	return true;
+}
+
+
+Rt::UpwardChannel<BlockTrafficGenerator>::UpwardChannel(const std::string &name,
+                                                        traffic_specific specific):
+	Channels::Upward<UpwardChannel<BlockTrafficGenerator>>{name},
+	tal_id{specific.tal_id},
+	profile{specific.profile},
+	counters{specific.counters},
+	received_frames{0},
+	received_bytes{0},
+	latencies{},
+	cpu_start{},
+	cpu_end{},
+	measure_start_timer{-1},
+	measure_end_timer{-1},
+	report_timer{-1}
+{
+}
+
+
+bool Rt::UpwardChannel<BlockTrafficGenerator>::onInit()
+{
+	// one latency per frame expected at the profile rate, more are
+	// received by a gateway serving several terminals
+	double expected = this->profile->rate * this->profile->duration.count() / 1000;
+	this->latencies.reserve(std::min(expected, 1e7));
+
+	this->measure_start_timer = this->addTimerEvent("measure_start",
+	                                                ArgumentWrapper(this->profile->warmup),
+	                                                false);
+	this->measure_end_timer = this->addTimerEvent("measure_end",
+	                                              ArgumentWrapper(this->profile->warmup + this->profile->duration),
+	                                              false);
+	// let the frames still in the satellite links arrive
+	this->report_timer = this->addTimerEvent("report",
+	                                         ArgumentWrapper(this->profile->warmup + this->profile->duration + time_ms_t(1000)),
+	                                         false);
+	return true;
+}
+
+
+bool Rt::UpwardChannel<BlockTrafficGenerator>::onEvent(const Event &event)
+{
+	LOG(this->log_receive, LEVEL_ERROR,
+	    "Unexpected event received: %s",
+	    event.getName().c_str());
+	return false;
+}
+
+
+bool Rt::UpwardChannel<BlockTrafficGenerator>::onEvent(const TimerEvent &event)
+{
+	if(event == this->measure_start_timer)
+	{
+		this->cpu_start = blocksCpuTime();
+		return true;
+	}
+	if(event == this->measure_end_timer)
+	{
+		this->cpu_end = blocksCpuTime();
+		return true;
+	}
+	if(event == this->report_timer)
+	{
+		bool status = this->report();
+		// the benchmark is over, stop the entity as on a user interrupt
+		kill(getpid(), SIGTERM);
+		return status;
+	}
+
+	LOG(this->log_receive, LEVEL_ERROR,
+	    "Unknown timer event received %s",
+	    event.getName().c_str());
+	return false;
+}
+
+
+bool Rt::UpwardChannel<BlockTrafficGenerator>::onEvent(const MessageEvent &event)
+{
+	if(to_enum<InternalMessageType>(event.getMessageType()) != InternalMessageType::decap_data)
+	{
+		LOG(this->log_receive, LEVEL_ERROR,
+		    "Unexpected message received: %d",
+		    event.getMessageType());
+		return false;
+	}
+
+	uint64_t now = steadyNanoseconds();
+	Ptr<NetPacket> frame = event.getMessage<NetPacket>();
+	const Data &packet = frame->getData();
+	if(packet.length() < TUNTAP_FLAGS_LEN + BENCH_MIN_FRAME_SIZE)
+	{
+		// not generated by a benchmark (e.g. a broadcast), ignore it
+		return true;
+	}
+
+	const unsigned char *payload = packet.data() + TUNTAP_FLAGS_LEN + ETHERNET_2_HEADSIZE;
+	if(memcmp(payload, BENCH_MAGIC, BENCH_MAGIC_LEN) != 0)
+	{
+		return true;
+	}
+
+	uint64_t sent;
+	memcpy(&sent, payload + BENCH_MAGIC_LEN + sizeof(uint64_t), sizeof(sent));
+	sent = be64toh(sent);
+
+	// frames are only generated during the measure, the ones arriving
+	// after the report are late and not accounted
+	if(this->report_timer < 0)
+	{
+		return true;
+	}
+	this->received_frames += 1;
+	this->received_bytes += packet.length() - TUNTAP_FLAGS_LEN;
+	this->latencies.push_back(now > sent ? now - sent : 0);
+	return true;
+}
+
+
+bool Rt::UpwardChannel<BlockTrafficGenerator>::report()
+{
+	this->report_timer = -1;
+	double duration = this->profile->duration.count() / 1000.0;
+
+	std::sort(this->latencies.begin(), this->latencies.end());
+	auto percentile = [this](double ratio) -> double
+	{
+		if(this->latencies.empty())
+		{
+			return 0;
+		}
+		std::size_t rank = std::ceil(ratio * this->latencies.size());
+		return this->latencies[std::max<std::size_t>(rank, 1) - 1] / 1e6;
+	};
+
+	uint64_t sent_frames = this->counters->sent_frames;
+	uint64_t sent_bytes = this->counters->sent_bytes;
+
+	std::ostringstream json;
+	json << "{\"entity\": " << static_cast<unsigned int>(this->tal_id)
+	     << ", \"duration_s\": " << duration
+	     << ", \"tx\": {\"frames\": " << sent_frames
+	     << ", \"bytes\": " << sent_bytes
+	     << ", \"pkt_per_s\": " << sent_frames / duration
+	     << ", \"mbit_per_s\": " << sent_bytes * 8 / duration / 1e6 << "}"
+	     << ", \"rx\": {\"frames\": " << this->received_frames
+	     << ", \"bytes\": " << this->received_bytes
+	     << ", \"pkt_per_s\": " << this->received_frames / duration
+	     << ", \"mbit_per_s\": " << this->received_bytes * 8 / duration / 1e6 << "}"
+	     << ", \"latency_ms\": {\"p50\": " << percentile(0.5)
+	     << ", \"p99\": " << percentile(0.99)
+	     << ", \"p999\": " << percentile(0.999)
+	     << ", \"max\": " << (this->latencies.empty() ? 0 : this->latencies.back() / 1e6) << "}"
+	     << ", \"cpu_s\": {";
+	bool first = true;
+	for(auto &&block: this->cpu_end)
+	{
+		auto start = this->cpu_start.find(block.first);
+		double used = block.second - (start == this->cpu_start.end() ? 0 : start->second);
+		json << (first ? "" : ", ") << "\"" << block.first << "\": " << used;
+		first = false;
+	}
+	json << "}}" << std::endl;
+
+	if(this->profile->report.empty())
+	{
+		std::cout << json.str();
+		return true;
+	}
+
+	std::ofstream output{this->profile->report};
+	output << json.str();
+	if(!output)
+	{
+		LOG(this->log_receive, LEVEL_ERROR,
+		    "cannot write the benchmark report to %s: %s",
+		    this->profile->report.c_str(), strerror(errno));
+		return false;
+	}
+	return true;
+}
+
+
+Rt::DownwardChannel<BlockTrafficGenerator>::DownwardChannel(const std::string &name,
+                                                            traffic_specific specific):
+	Channels::Downward<DownwardChannel<BlockTrafficGenerator>>{name},
+	tal_id{specific.tal_id},
+	profile{specific.profile},
+	counters{specific.counters},
+	src_mac{},
+	dst_macs{},
+	next_dst{0},
+	sizes{},
+	next_size{0},
+	credit{0},
+	last_tick{},
+	sequence{0}
+{
+}
+
+
+bool Rt::DownwardChannel<BlockTrafficGenerator>::onInit()
+{
+	auto Conf = OpenSandModelConf::Get();
+	SarpTable sarp_table;
+	if(!Conf->getSarp(sarp_table))
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+		    "cannot load the SARP table to address the frames\n");
+		return false;
+	}
+
+	std::vector<MacAddress> macs;
+	if(!sarp_table.getMacByTal(this->tal_id, macs))
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+		    "no MAC address for entity %u in the SARP table\n",
+		    this->tal_id);
+		return false;
+	}
+	this->src_mac = macs.front();
+
+	// a terminal talks to its gateway, a gateway to its terminals
+	std::vector<tal_id_t> destinations;
+	if(Conf->isGw(this->tal_id))
+	{
+		for(tal_id_t tal_id = 0; tal_id < BROADCAST_TAL_ID; ++tal_id)
+		{
+			tal_id_t gw_id;
+			if(tal_id != this->tal_id && !Conf->isGw(tal_id) &&
+			   Conf->getGwWithTalId(tal_id, gw_id) && gw_id == this->tal_id)
+			{
+				destinations.push_back(tal_id);
+			}
+		}
+	}
+	else
+	{
+		tal_id_t gw_id;
+		if(Conf->getGwWithTalId(this->tal_id, gw_id))
+		{
+			destinations.push_back(gw_id);
+		}
+	}
+	for(auto &&destination: destinations)
+	{
+		macs.clear();
+		if(sarp_table.getMacByTal(destination, macs))
+		{
+			this->dst_macs.push_back(macs.front());
+		}
+	}
+	if(this->dst_macs.empty())
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+		    "no entity to send the benchmark traffic to\n");
+		return false;
+	}
+
+	// smooth weighted round robin, so that the sizes are interleaved
+	unsigned int total = 0;
+	for(auto &&size: this->profile->sizes)
+	{
+		total += size.second;
+	}
+	std::vector<int> current(this->profile->sizes.size(), 0);
+	for(unsigned int sent = 0; sent < total; ++sent)
+	{
+		std::size_t best = 0;
+		for(std::size_t index = 0; index < current.size(); ++index)
+		{
+			current[index] += this->profile->sizes[index].second;
+			if(current[index] > current[best])
+			{
+				best = index;
+			}
+		}
+		current[best] -= total;
+		this->sizes.push_back(this->profile->sizes[best].first);
+	}
+
+	LOG(this->log_init, LEVEL_NOTICE,
+	    "benchmark traffic: %.0f frames/s to %zu entities, measured "
+	    "during %ld ms after %ld ms\n",
+	    this->profile->rate, this->dst_macs.size(),
+	    this->profile->duration.count(), this->profile->warmup.count());
+
+	this->addTimerEvent("traffic", BENCH_TICK_MS);
+	return true;
+}
+
+
+bool Rt::DownwardChannel<BlockTrafficGenerator>::onEvent(const Event &event)
+{
+	LOG(this->log_receive, LEVEL_ERROR,
+	    "Unexpected event received: %s",
+	    event.getName().c_str());
+	return false;
+}
+
+
+bool Rt::DownwardChannel<BlockTrafficGenerator>::onEvent(const TimerEvent &)
+{
+	auto now = std::chrono::steady_clock::now();
+	auto elapsed = now - this->counters->start;
+	if(elapsed < this->profile->warmup ||
+	   elapsed >= this->profile->warmup + this->profile->duration)
+	{
+		this->last_tick = now;
+		this->credit = 0;
+		return true;
+	}
+
+	std::chrono::duration<double> tick = now - this->last_tick;
+	this->last_tick = now;
+	// do not catch up on the time the blocks below were too slow
+	this->credit = std::min(this->credit + tick.count() * this->profile->rate,
+	                        this->profile->rate * BENCH_MAX_BURST_MS / 1000 + 1);
+
+	bool status = true;
+	while(this->credit >= 1)
+	{
+		this->credit -= 1;
+		status &= this->sendFrame(this->sizes[this->next_size]);
+		this->next_size = (this->next_size + 1) % this->sizes.size();
+	}
+	return status;
+}
+
+
+bool Rt::DownwardChannel<BlockTrafficGenerator>::onEvent(const MessageEvent &event)
+{
+	LOG(this->log_receive, LEVEL_ERROR,
+	    "Unexpected message received: %d",
+	    event.getMessageType());
+	return false;
+}
+
+
+bool Rt::DownwardChannel<BlockTrafficGenerator>::sendFrame(std::size_t size)
+{
+	const MacAddress &dst_mac = this->dst_macs[this->next_dst];
+	this->next_dst = (this->next_dst + 1) % this->dst_macs.size();
+
+	Data frame(TUNTAP_FLAGS_LEN + size, 0);
+	unsigned char *data = &frame[0];
+
+	// TAP header: no flags, then the protocol
+	data[2] = BENCH_ETHER_TYPE >> 8;
+	data[3] = BENCH_ETHER_TYPE & 0xFF;
+	unsigned char *eth = data + TUNTAP_FLAGS_LEN;
+	for(unsigned int i = 0; i < 6; ++i)
+	{
+		eth[i] = dst_mac.at(i);
+		eth[6 + i] = this->src_mac.at(i);
+	}
+	eth[12] = BENCH_ETHER_TYPE >> 8;
+	eth[13] = BENCH_ETHER_TYPE & 0xFF;
+
+	unsigned char *payload = eth + ETHERNET_2_HEADSIZE;
+	uint64_t sequence = htobe64(this->sequence++);
+	uint64_t sent = htobe64(steadyNanoseconds());
+	memcpy(payload, BENCH_MAGIC, BENCH_MAGIC_LEN);
+	memcpy(payload + BENCH_MAGIC_LEN, &sequence, sizeof(sequence));
+	memcpy(payload + BENCH_MAGIC_LEN + sizeof(sequence), &sent, sizeof(sent));
+
+	if(!this->enqueueMessage(make_ptr<NetPacket>(frame),
+	                         to_underlying(InternalMessageType::decap_data)))
+	{
+		LOG(this->log_receive, LEVEL_ERROR,
+		    "failed to send benchmark frame to the lower block\n");
+		return false;
+	}
+	this->counters->sent_frames += 1;
+	this->counters->sent_bytes += size;
+	return true;
+}
@@ -0,0 +1,211 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file BlockTrafficGenerator.h
+ * @brief Synthetic Ethernet traffic source and sink replacing the TAP
+ *        interface to benchmark the data plane
+ * @author Viveris Technologies
+ */
+
+#ifndef BLOCK_TRAFFIC_GENERATOR_H
+#define BLOCK_TRAFFIC_GENERATOR_H
+
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <opensand_rt/Block.h>
+#include <opensand_rt/RtChannel.h>
+
+#include "OpenSandCore.h"
+#include "MacAddress.h"
+
+
+/**
+ * @brief The traffic generated by a benchmark run, given on the command line as
+ *        rate=<frames/s>,sizes=<bytes>[:<weight>][/<bytes>[:<weight>]...],
+ *        warmup=<s>,duration=<s>[,report=<file>]
+ */
+struct TrafficProfile
+{
+	/// the frames sent per second
+	double rate = 1000;
+	/// the Ethernet frame sizes (header included, CRC excluded) and their weights
+	std::vector<std::pair<std::size_t, unsigned int>> sizes{{1514, 1}};
+	/// the time given to the links to come up before measuring
+	time_ms_t warmup{2000};
+	/// the measure duration
+	time_ms_t duration{10000};
+	/// the file the results are written to, standard output if empty
+	std::string report;
+
+	/**
+	 * @brief Parse a traffic profile
+	 *
+	 * @param spec     The profile given on the command line
+	 * @param profile  OUT: the traffic profile
+	 * @param error    OUT: the reason of the failure
+	 * @return true on success, false otherwise
+	 */
+	static bool parse(const std::string &spec, TrafficProfile &profile, std::string &error);
+};
+
+
+/**
+ * @brief The counters shared by the channels of the traffic generator
+ */
+struct TrafficCounters
+{
+	/// the time the block is initialized
+	std::chrono::steady_clock::time_point start;
+	/// the frames and bytes sent during the measure
+	std::atomic<uint64_t> sent_frames{0};
+	std::atomic<uint64_t> sent_bytes{0};
+};
+
+
+struct traffic_specific
+{
+	tal_id_t tal_id;                          ///< the entity running the generator
+	std::shared_ptr<TrafficProfile> profile;  ///< the traffic to generate
+	std::shared_ptr<TrafficCounters> counters = std::make_shared<TrafficCounters>();
+};
+
+
+template<>
+class Rt::UpwardChannel<class BlockTrafficGenerator>: public Channels::Upward<UpwardChannel<BlockTrafficGenerator>>
+{
+ public:
+	UpwardChannel(const std::string &name, traffic_specific specific);
+
+	bool onInit() override;
+
+	using ChannelBase::onEvent;
+	bool onEvent(const Event &event) override;
+	bool onEvent(const TimerEvent &event) override;
+	bool onEvent(const MessageEvent &event) override;
+
+ private:
+	/**
+	 * @brief Write the results of the benchmark
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool report();
+
+	tal_id_t tal_id;
+	std::shared_ptr<TrafficProfile> profile;
+	std::shared_ptr<TrafficCounters> counters;
+
+	/// the frames and bytes received during the measure
+	uint64_t received_frames;
+	uint64_t received_bytes;
+	/// the latency of each frame received during the measure (ns)
+	std::vector<uint64_t> latencies;
+	/// the CPU time used by each block when the measure starts and ends (s)
+	std::map<std::string, double> cpu_start;
+	std::map<std::string, double> cpu_end;
+
+	event_id_t measure_start_timer;
+	event_id_t measure_end_timer;
+	event_id_t report_timer;
+};
+
+
+template<>
+class Rt::DownwardChannel<class BlockTrafficGenerator>: public Channels::Downward<DownwardChannel<BlockTrafficGenerator>>
+{
+ public:
+	DownwardChannel(const std::string &name, traffic_specific specific);
+
+	bool onInit() override;
+
+	using ChannelBase::onEvent;
+	bool onEvent(const Event &event) override;
+	bool onEvent(const TimerEvent &event) override;
+	bool onEvent(const MessageEvent &event) override;
+
+ private:
+	/**
+	 * @brief Build a frame with the TAP header expected by the
+	 *        Lan_Adaptation block and send it
+	 *
+	 * @param size  The Ethernet frame size
+	 * @return true on success, false otherwise
+	 */
+	bool sendFrame(std::size_t size);
+
+	tal_id_t tal_id;
+	std::shared_ptr<TrafficProfile> profile;
+	std::shared_ptr<TrafficCounters> counters;
+
+	/// the MAC address of the entity
+	MacAddress src_mac;
+	/// the MAC addresses the frames are sent to, in turn
+	std::vector<MacAddress> dst_macs;
+	std::size_t next_dst;
+	/// the frame sizes in the order they are sent, following their weights
+	std::vector<std::size_t> sizes;
+	std::size_t next_size;
+
+	/// the frames that may be sent but are not yet
+	double credit;
+	std::chrono::steady_clock::time_point last_tick;
+	uint64_t sequence;
+};
+
+
+/**
+ * @class BlockTrafficGenerator
+ * @brief Upper block of the Lan_Adaptation block in benchmark mode
+ *
+ * Instead of reading and writing a TAP interface, frames of the profile
+ * sizes are sent at the profile rate to the other end of the satellite
+ * links (the gateway for a terminal, the terminals of a gateway), and the
+ * frames received from them are counted, their one-way latency is given
+ * by the send time they carry as the entities run on the same host.
+ */
+class BlockTrafficGenerator: public Rt::Block<BlockTrafficGenerator, traffic_specific>
+{
+ public:
+	BlockTrafficGenerator(const std::string &name, traffic_specific specific);
+
+	bool onInit() override;
+
+ private:
+	std::shared_ptr<TrafficCounters> counters;
+};
+
+
+#endif
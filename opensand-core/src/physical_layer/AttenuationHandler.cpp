@@ -44,6 +44,7 @@
 
 #include <opensand_output/Output.h>
 
+#include <algorithm>
 #include <math.h>
 
 AttenuationHandler::AttenuationHandler(std::shared_ptr<OutputLog> log_channel):
@@ -71,7 +72,9 @@ void AttenuationHandler::generateConfiguration()
 	Plugin::generatePluginsConfiguration(error, PluginType::Error, "error_insertion_type", "Error Insertion Type");
 }
 
-bool AttenuationHandler::initialize(std::shared_ptr<OutputLog> log_init, const std::string &probe_prefix)
+bool AttenuationHandler::initialize(std::shared_ptr<OutputLog> log_init,
+                                    const std::string &probe_prefix,
+                                    tal_id_t entity_id)
 {
 	auto phy = OpenSandModelConf::Get()->getProfileData()->getComponent("physical_layer");
 	auto minimal = phy->getComponent("minimal_condition");
@@ -122,7 +125,7 @@ bool AttenuationHandler::initialize(std::shared_ptr<OutputLog> log_init, const s
 		    minimal_type.c_str());
 		return false;
 	}
-	if(!this->error_insertion_model->init())
+	if(!this->error_insertion_model->init(entity_id))
 	{
 		LOG(log_init, LEVEL_ERROR,
 		    "Unable to initialize the physical layer error insertion plugin %s",
@@ -145,41 +148,74 @@ bool AttenuationHandler::initialize(std::shared_ptr<OutputLog> log_init, const s
 }
 
 bool AttenuationHandler::process(DvbFrame &dvb_frame, double cn_total)
+{
+	this->frames.clear();
+	this->samples.clear();
+	if(!this->addFrame(dvb_frame, cn_total))
+	{
+		return false;
+	}
+	return this->processFrames();
+}
+
+bool AttenuationHandler::process(std::vector<Rt::Ptr<DvbFrame>> &dvb_frames)
+{
+	bool status = true;
+	this->frames.clear();
+	this->samples.clear();
+	for(auto &&dvb_frame: dvb_frames)
+	{
+		if(!IsAttenuatedFrame(dvb_frame->getMessageType()))
+		{
+			continue;
+		}
+		if(!this->addFrame(*dvb_frame, dvb_frame->getCn()))
+		{
+			// only drop this frame, the others are still processed
+			dvb_frame.reset();
+			status = false;
+		}
+	}
+
+	if(!this->processFrames())
+	{
+		// failures are rare, look the failed frames up in the burst
+		for(std::size_t index: this->failed)
+		{
+			auto failed_frame = std::find_if(dvb_frames.begin(), dvb_frames.end(),
+			                                 [this, index](const Rt::Ptr<DvbFrame> &frame)
+			                                 { return frame.get() == this->frames[index]; });
+			if(failed_frame != dvb_frames.end())
+			{
+				failed_frame->reset();
+			}
+		}
+		status = false;
+	}
+	return status;
+}
+
+bool AttenuationHandler::addFrame(DvbFrame &dvb_frame, double cn_total)
 {
 	fmt_id_t modcod_id = 0;
 	double min_cn;
-	Rt::Data payload;
-
-	// Consider that the packet is not dropped  (if its dropped, the probe
-	// will be updated later), so that the probe emits a 0 value if necessary.
-	this->probe_drops->put(0);
 
 	// Get the MODCOD used to send DVB frame
 	// (keep the complete header because we carry useful data)
 	switch(dvb_frame.getMessageType())
 	{
 		case EmulatedMessageType::BbFrame:
-		{
-			BBFrame &bbframe = dvb_frame_upcast<BBFrame>(dvb_frame);
-			modcod_id = bbframe.getModcodId();
-			payload = bbframe.getPayload();
-		}
-		break;
+			modcod_id = dvb_frame_upcast<BBFrame>(dvb_frame).getModcodId();
+			break;
 
 		case EmulatedMessageType::DvbBurst:
-		{
-			DvbRcsFrame &dvb_rcs_frame = dvb_frame_upcast<DvbRcsFrame>(dvb_frame);
-			modcod_id = dvb_rcs_frame.getModcodId();
-			payload = dvb_rcs_frame.getPayload();
-		}
-		break;
+			modcod_id = dvb_frame_upcast<DvbRcsFrame>(dvb_frame).getModcodId();
+			break;
 
 		default:
-		{
 			// This message, even though it carries C/N information (is attenuated)
 			// is not encoded using a MODCOD, and cannot be dropped.
 			return true;
-		}
 	}
 
 	LOG(this->log_channel, LEVEL_INFO,
@@ -205,25 +241,59 @@ bool AttenuationHandler::process(DvbFrame &dvb_frame, double cn_total)
 	LOG(this->log_channel, LEVEL_INFO,
 	    "Minimal condition value for MODCOD %u: %.2f dB", modcod_id, min_cn);
 
-	// Insert error if required
-	if(!this->error_insertion_model->isToBeModifiedPacket(cn_total, min_cn))
+	this->frames.push_back(&dvb_frame);
+	this->samples.push_back({dvb_frame.getMessageType(), modcod_id, cn_total, min_cn, false});
+	return true;
+}
+
+bool AttenuationHandler::processFrames()
+{
+	int drops = 0;
+
+	this->failed.clear();
+	if(!this->samples.empty())
 	{
-		return true;
+		// Insert error if required
+		this->error_insertion_model->isToBeModifiedPackets(this->samples);
 	}
-	LOG(this->log_channel, LEVEL_DEBUG,
-	    "Error insertion is required");
 
-	// FIXME: Check if modifying this here actually modifies content in dvb_frame
-	if(!this->error_insertion_model->modifyPacket(payload))
+	for(std::size_t i = 0; i < this->samples.size(); ++i)
 	{
-		LOG(this->log_channel, LEVEL_ERROR,
-		    "Error insertion failed");
-		return false;
+		if(!this->samples[i].corrupted)
+		{
+			continue;
+		}
+		LOG(this->log_channel, LEVEL_DEBUG,
+		    "Error insertion is required");
+
+		// the payload is only extracted for the frames to corrupt
+		DvbFrame &dvb_frame = *this->frames[i];
+		Rt::Data payload;
+		if(dvb_frame.getMessageType() == EmulatedMessageType::BbFrame)
+		{
+			payload = dvb_frame_upcast<BBFrame>(dvb_frame).getPayload();
+		}
+		else
+		{
+			payload = dvb_frame_upcast<DvbRcsFrame>(dvb_frame).getPayload();
+		}
+
+		// FIXME: Check if modifying this here actually modifies content in dvb_frame
+		if(!this->error_insertion_model->modifyPacket(payload))
+		{
+			LOG(this->log_channel, LEVEL_ERROR,
+			    "Error insertion failed");
+			this->failed.push_back(i);
+			continue;
+		}
+		dvb_frame.setCorrupted(true);
+		++drops;
+		LOG(this->log_channel, LEVEL_NOTICE,
+		    "Received frame was corrupted");
 	}
-	dvb_frame.setCorrupted(true);
-	this->probe_drops->put(1);
-	LOG(this->log_channel, LEVEL_NOTICE,
-	    "Received frame was corrupted");
 
-	return true;
+	// the probe emits a 0 value if no frame is dropped
+	this->probe_drops->put(drops);
+
+	return this->failed.empty();
 }
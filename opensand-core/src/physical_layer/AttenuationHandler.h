@@ -38,8 +38,12 @@
 
 
 #include <string>
+#include <vector>
+
+#include <opensand_rt/Ptr.h>
 
 #include "DvbFrame.h"
+#include "PhysicalLayerPlugin.h"
 
 
 template<typename> class Probe;
@@ -70,6 +74,34 @@ private:
 	std::shared_ptr<Probe<float>> probe_minimal_condition;
 	std::shared_ptr<Probe<int>> probe_drops;
 
+	/// The frames of the burst being processed, kept between
+	/// calls to avoid allocations
+	std::vector<DvbFrame *> frames;
+
+	/// The reception conditions of the frames being processed
+	std::vector<ErrorInsertionSample> samples;
+
+	/// The indexes of the frames whose error insertion failed
+	std::vector<std::size_t> failed;
+
+	/**
+	 * @brief Add a frame to the burst being processed
+	 *
+	 * @param dvb_frame  the DVB frame
+	 * @param cn_total   the specific C/N
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool addFrame(DvbFrame &dvb_frame, double cn_total);
+
+	/**
+	 * @brief Insert errors in the frames of the burst being processed,
+	 *        the frames that could not be processed are listed in failed
+	 *
+	 * @return true on success, false if a frame could not be processed
+	 */
+	bool processFrames();
+
 public:
 	/**
 	 * @brief Constructor of the attenuation handler
@@ -89,10 +121,14 @@ public:
 	 * @brief Initialize the attenuation handler
 	 *
 	 * @param log_init      the log output to use during initialization
+	 * @param probe_prefix  the prefix of the probes names
+	 * @param entity_id     the terminal or gateway receiving the frames
 	 *
 	 * @return true on success, false otherwise
 	 */
-	bool initialize(std::shared_ptr<OutputLog> log_init, const std::string &probe_prefix);
+	bool initialize(std::shared_ptr<OutputLog> log_init,
+	                const std::string &probe_prefix,
+	                tal_id_t entity_id);
 
 	/**
 	 * @brief Process the attenuation on a DVB frame with a specific C/N
@@ -103,6 +139,20 @@ public:
 	 * @return true on success, false otherwise
 	 */
 	bool process(DvbFrame &dvb_frame, double cn_total);
+
+	/**
+	 * @brief Process the attenuation on a burst of DVB frames,
+	 *        with the C/N set on each of them
+	 *
+	 * The error insertion plugin evaluates the whole burst at once.
+	 * A frame that cannot be processed is reset in the burst, the
+	 * others are kept.
+	 *
+	 * @param dvb_frames  the DVB frames
+	 *
+	 * @return true on success, false if a frame was reset
+	 */
+	bool process(std::vector<Rt::Ptr<DvbFrame>> &dvb_frames);
 };
 
 #endif
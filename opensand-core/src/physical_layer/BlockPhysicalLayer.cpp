@@ -131,7 +131,7 @@ bool Rt::UpwardChannel<BlockPhysicalLayer>::onInit()
 	this->probe_total_cn = Output::Get()->registerProbe<float>(prefix + "Phy.Total_cn", "dB", true, SAMPLE_LAST);
 
 	// Initialize the attenuation handler
-	if(!this->attenuation_hdl.initialize(this->log_init, prefix))
+	if(!this->attenuation_hdl.initialize(this->log_init, prefix, this->mac_id))
 	{
 		LOG(this->log_init, LEVEL_ERROR,
 		    "Unable to initialize Attenuation Handler");
@@ -267,10 +267,52 @@ bool Rt::UpwardChannel<BlockPhysicalLayer>::forwardPacket(Ptr<DvbFrame> dvb_fram
 }
 
 
+bool Rt::UpwardChannel<BlockPhysicalLayer>::forwardPackets(std::vector<Ptr<DvbFrame>> &dvb_frames)
+{
+	for(auto &&dvb_frame: dvb_frames)
+	{
+		if(IsCnCapableFrame(dvb_frame->getMessageType()))
+		{
+			// Set C/N to Dvb frame
+			auto cn = this->getCn(*dvb_frame);
+			dvb_frame->setCn(cn);
+
+			// Update probe
+			this->probe_total_cn->put(cn);
+		}
+	}
+
+	// Process Attenuation, the frames that fail are reset and dropped
+	bool status = true;
+	if(!this->attenuation_hdl.process(dvb_frames))
+	{
+		LOG(this->log_event, LEVEL_ERROR,
+		    "Failed to get the attenuation, dropping the failed frames");
+		status = false;
+	}
+
+	// Send frames to upper layer
+	for(auto &&dvb_frame: dvb_frames)
+	{
+		if(!dvb_frame)
+		{
+			continue;
+		}
+		if(!this->enqueueMessage(std::move(dvb_frame), to_underlying(InternalMessageType::unknown)))
+		{
+			LOG(this->log_send, LEVEL_ERROR, 
+			    "Failed to send burst of packets to upper layer");
+			status = false;
+		}
+	}
+	dvb_frames.clear();
+	return status;
+}
+
+
 double Rt::UpwardChannel<BlockPhysicalLayer>::getCn(DvbFrame &dvb_frame) const
 {
-	//return GroundPhysicalChannel::computeTotalCn(dvb_frame.getCn(), this->getCurrentCn());
-	return this->computeTotalCn(dvb_frame.getCn());
+	return this->computeTotalCn(dvb_frame);
 }
 
 
@@ -80,6 +80,16 @@ class Rt::UpwardChannel<class BlockPhysicalLayer>: public GroundPhysicalChannel,
 	 */
 	bool forwardPacket(Ptr<DvbFrame> dvb_frame) override;
 
+	/**
+	 * @brief Forward a burst of frames to the next channel,
+	 *        the attenuation is processed on the whole burst
+	 *
+	 * @param dvb_frames  the DVB frames to forward, emptied
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool forwardPackets(std::vector<Ptr<DvbFrame>> &dvb_frames) override;
+
 	/**
 	 * @brief Get the C/N fot the current DVB frame
 	 *
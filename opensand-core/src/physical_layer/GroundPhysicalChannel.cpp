@@ -53,7 +53,10 @@
 
 GroundPhysicalChannel::GroundPhysicalChannel(PhyLayerConfig config):
 	clear_sky_condition{0},
+	current_cn{0},
+	current_cn_linear{1},
 	delay_fifo{},
+	ready_frames{},
 	mac_id{config.mac_id},
 	entity_type{config.entity_type},
 	spot_id{config.spot_id},
@@ -184,6 +187,7 @@ bool GroundPhysicalChannel::initGround(bool upward_channel,
 		    attenuation_type);
 		return false;
 	}
+	this->refreshCurrentCn();
 
 	// Initialize the attenuation event
 	std::ostringstream name;
@@ -215,6 +219,7 @@ bool GroundPhysicalChannel::updateAttenuation()
 	}
 
 	double attenuation = this->attenuation_model->getAttenuation();
+	this->refreshCurrentCn();
 
 	LOG(this->log_channel, LEVEL_INFO,
 		"New attenuation: %.2f dB",
@@ -227,23 +232,24 @@ bool GroundPhysicalChannel::updateAttenuation()
 
 double GroundPhysicalChannel::getCurrentCn() const
 {
-	// C/N calculation, as the substraction of the clear sky C/N with the Attenuation
-	return this->clear_sky_condition - this->attenuation_model->getAttenuation();
+	return this->current_cn;
 }
 
-//double GroundPhysicalChannel::computeTotalCn(double up_cn, double down_cn)
-double GroundPhysicalChannel::computeTotalCn(double up_cn) const
+void GroundPhysicalChannel::refreshCurrentCn()
 {
-	double down_cn = this->getCurrentCn();
+	// C/N calculation, as the substraction of the clear sky C/N with the Attenuation
+	this->current_cn = this->clear_sky_condition - this->attenuation_model->getAttenuation();
+	this->current_cn_linear = pow(10, this->current_cn / 10);
+}
 
+double GroundPhysicalChannel::computeTotalCn(const DvbFrame &dvb_frame) const
+{
 	// Calculation of the sub total C/N ratio
-	double down_num = pow(10, down_cn / 10);
-	double up_num = pow(10, up_cn / 10);
-
-	double total_num = 1 / ((1 / down_num) + (1 / up_num)); 
-	double total_cn = 10 * log10(total_num);
+	double down_num = this->current_cn_linear;
+	double up_num = dvb_frame.getLinearCn();
 
-	return total_cn;
+	double total_num = (down_num * up_num) / (down_num + up_num);
+	return lintodb(total_num);
 }
 
 bool GroundPhysicalChannel::pushPacket(Rt::Ptr<NetContainer> pkt)
@@ -273,7 +279,24 @@ bool GroundPhysicalChannel::forwardReadyPackets()
 	for (auto &&elem: delay_fifo)
 	{
 		ASSERT(elem != nullptr, "Null element in fifo retrieved from GroundPhysicalChannel::forwardReadyPackets");
-		this->forwardPacket(elem->releaseElem<DvbFrame>());
+		this->ready_frames.push_back(elem->releaseElem<DvbFrame>());
+	}
+	if(this->ready_frames.empty())
+	{
+		return true;
 	}
+	this->forwardPackets(this->ready_frames);
+	this->ready_frames.clear();
 	return true;
 }
+
+bool GroundPhysicalChannel::forwardPackets(std::vector<Rt::Ptr<DvbFrame>> &dvb_frames)
+{
+	bool status = true;
+	for(auto &&dvb_frame: dvb_frames)
+	{
+		status &= this->forwardPacket(std::move(dvb_frame));
+	}
+	dvb_frames.clear();
+	return status;
+}
@@ -37,6 +37,8 @@
 #define GROUND_PHYSICAL_CHANNEL_H
 
 
+#include <vector>
+
 #include <opensand_rt/Types.h>
 
 #include "DelayFifo.h"
@@ -71,9 +73,18 @@ private:
 	/// Clear Sky Conditions (best C/N in clear-sky conditions)
 	double clear_sky_condition;
 
+	/// The current C/N, updated with the attenuation
+	double current_cn;
+
+	/// The current C/N in linear scale, updated with the attenuation
+	double current_cn_linear;
+
 	/// The FIFO that implements the delay
 	DelayFifo delay_fifo;
 
+	/// The frames leaving the delay FIFO, forwarded together
+	std::vector<Rt::Ptr<DvbFrame>> ready_frames;
+
 	/// Probes
 	std::shared_ptr<Probe<float>> probe_attenuation = nullptr;
 	std::shared_ptr<Probe<float>> probe_clear_sky_condition = nullptr;
@@ -126,6 +137,11 @@ protected:
 	 */
 	double getCurrentCn() const;
 
+	/**
+	 * @brief Refresh the current C/N from the attenuation model
+	 */
+	void refreshCurrentCn();
+
 	/**
 	 * @brief Push a packet in the FIFO to be delayed
 	 *
@@ -152,6 +168,16 @@ protected:
 	 */
 	virtual bool forwardPacket(Rt::Ptr<DvbFrame> dvb_frame) = 0;
 
+	/**
+	 * @brief Forward a burst of frames to the next channel,
+	 *        calls forwardPacket on each frame by default
+	 *
+	 * @param dvb_frames  the DVB frames to forward, emptied
+	 *
+	 * @return true on success, false otherwise
+	 */
+	virtual bool forwardPackets(std::vector<Rt::Ptr<DvbFrame>> &dvb_frames);
+
 public:
 	virtual ~GroundPhysicalChannel() = default;
 
@@ -166,15 +192,16 @@ public:
 
 	/**
 	 * @brief Compute the total C/N of the link according to the uplink C/N
-	 *        and the downlink C/N
+	 *        carried by the frame and the current downlink C/N
+	 *
+	 * The computation is done in linear scale from the cached downlink
+	 * C/N, without exponentiation nor logarithm.
 	 *
-	 * @param up_cn    the uplink C/N value
-	 * @param down_cn  the downlink C/N value
+	 * @param dvb_frame  the frame carrying the uplink C/N
 	 *
 	 * @return the total C/N value
 	 */
-	//static double computeTotalCn(double up_cn, double down_cn);
-	double computeTotalCn(double up_cn) const;
+	double computeTotalCn(const DvbFrame &dvb_frame) const;
 };
 
 
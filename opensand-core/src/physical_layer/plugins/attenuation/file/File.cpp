@@ -40,14 +40,12 @@
 
 #include <opensand_output/Output.h>
 
-#include <sstream>
-#include <fstream>
-
 
 File::File():
 		AttenuationModelPlugin(),
 		current_time(0),
 		attenuation(),
+		column(0),
 		loop(false)
 {
 }
@@ -55,7 +53,6 @@ File::File():
 
 File::~File()
 {
-	this->attenuation.clear();
 }
 
 
@@ -85,6 +82,13 @@ void File::generateConfiguration(const std::string &parent_path,
 	                                                  "Attenuation File Loop Mode",
 	                                                  types->getType("bool"));
 	Conf->setProfileReference(attenuation_loop, attenuation_type, plugin_name);
+	auto attenuation_column = attenuation->addParameter("file_attenuation_column",
+	                                                    "Attenuation File Column",
+	                                                    types->getType("uint"),
+	                                                    "The column of the attenuation values "
+	                                                    "when the file describes several links");
+	attenuation_column->setAdvanced(true);
+	Conf->setProfileReference(attenuation_column, attenuation_type, plugin_name);
 }
 
 
@@ -110,88 +114,31 @@ bool File::init(time_ms_t refresh_period_ms, std::string link_path)
 		return false;
 	}
 
-	return this->load(filename);
-}
-
-
-bool File::load(std::string filename)
-{
-	std::string line;
-	std::istringstream line_stream;
-	unsigned int line_number = 0;
+	// optional, the first column by default
+	unsigned int column = 0;
+	OpenSandModelConf::extractParameterData(attenuation->getParameter("file_attenuation_column"), column);
+	this->column = column;
 
-	std::ifstream file(filename.c_str());
-
-	if(!file)
+	if(!this->attenuation.load(filename, this->log_attenuation))
 	{
 		LOG(this->log_attenuation, LEVEL_ERROR,
-		    "Cannot open file %s\n", filename.c_str());
-		goto error;
+		    "Malformed attenuation configuration file '%s'\n",
+		    filename.c_str());
+		return false;
 	}
-
-	while(std::getline(file, line))
+	if(this->column >= this->attenuation.getColumnsCount())
 	{
-		unsigned int time;
-		double attenuation;
-
-		line_number++;
-
-		// skip line if empty
-		if(line == "" || line[0] == '#')
-		{
-			continue;
-		}
-
-		// Clear previous flags (if any)
-		line_stream.clear();
-		line_stream.str(line);
-
-		line_stream >> time;
-		if(line_stream.bad() || line_stream.fail())
-		{
-			LOG(this->log_attenuation, LEVEL_ERROR,
-			    "Bad syntax in file '%s', line %u: "
-			    "there should be a timestamp (integer) "
-			    "instead of '%s'\n",
-			    filename.c_str(), line_number,
-			    line.c_str());
-			goto malformed;
-		}
-
-		// get attenuation
-		line_stream >> attenuation;
-		if(line_stream.bad() || line_stream.fail())
-		{
-			LOG(this->log_attenuation, LEVEL_ERROR,
-			    "Error while parsing attenuation line %u\n",
-			    line_number);
-			goto malformed;
-		}
-
-		this->attenuation[time] = attenuation;
-
-		LOG(this->log_attenuation, LEVEL_DEBUG,
-		    "Entry: time: %u, attenuation: %.2f dB\n", time, attenuation);
+		LOG(this->log_init, LEVEL_ERROR,
+		    "FILE %s: no column %zu in attenuation file '%s'",
+		    link_path.c_str(), this->column, filename.c_str());
+		return false;
 	}
-
-	file.close();
 	return true;
-
-malformed:
-	LOG(this->log_attenuation, LEVEL_ERROR,
-	    "Malformed attenuation configuration file '%s'\n",
-	    filename.c_str());
-	file.close();
-error:
-	return false;
 }
 
 
 bool File::updateAttenuationModel()
 {
-	std::map<unsigned int, double>::const_iterator attenuation_it;
-	unsigned int old_time, new_time;
-	double old_attenuation, new_attenuation;
 	double next_attenuation;
 
 	this->current_time++;
@@ -201,69 +148,18 @@ bool File::updateAttenuationModel()
 	    "(step: %f)\n", this->current_time,
 	    std::chrono::duration_cast<std::chrono::duration<double>>(this->refresh_period).count());
 
-	// Look for the next entry whose key is equal or greater than 'current_time'
-	attenuation_it = this->attenuation.lower_bound(this->current_time);
-
-	// Attenuation found
-	if(attenuation_it != this->attenuation.end())
-	{
-		// Next entry in the configuration file
-		new_time = attenuation_it->first;
-		new_attenuation = attenuation_it->second;
-
-		LOG(this->log_attenuation, LEVEL_DEBUG,
-		    "New entry found: time: %u, value: %.2f\n",
-		    new_time, new_attenuation);
-
-		if(attenuation_it != this->attenuation.begin())
-		{
-			// Get previous entry in the configuration file
-			double coef;
-			attenuation_it--;
-
-			old_time = attenuation_it->first;
-			old_attenuation = attenuation_it->second;
-
-			LOG(this->log_attenuation, LEVEL_DEBUG,
-			    "Old time: %u, old attenuation: %.2f\n",
-			    old_time, old_attenuation);
-
-			// Linear interpolation
-			coef = (new_attenuation - old_attenuation) / (new_time - old_time);
-
-			next_attenuation = old_attenuation +
-			                   coef * (this->current_time - old_time);
-
-			LOG(this->log_attenuation, LEVEL_DEBUG,
-			    "Linear coef: %f, old step: %u\n",
-			    coef, old_time);
-		}
-		else
-		{
-			// First (and potentially only) entry, use it
-			LOG(this->log_attenuation, LEVEL_DEBUG,
-			    "It is the first entry\n");
-			next_attenuation = new_attenuation;
-		}
-	}
-	else if(!this->loop)
-	{
-		LOG(this->log_attenuation, LEVEL_DEBUG,
-		    "Reach end of simulation, keep the last value\n");
-		// we reached the end of the scenario, keep the last value
-		next_attenuation = this->attenuation.rend()->second;
-	}
-	else // loop
+	if(this->current_time > this->attenuation.getLastTime() && this->loop)
 	{
 		LOG(this->log_attenuation, LEVEL_DEBUG,
 		    "Reach end of simulation, restart with the first value\n");
 		// we reached the end of the scenario, restart at beginning
-		attenuation_it = this->attenuation.begin();
-		new_time = attenuation_it->first;
-		next_attenuation = attenuation_it->second;
 		this->current_time = 0;
 	}
 
+	// interpolated between the surrounding entries, the last value
+	// is kept at the end of the scenario
+	next_attenuation = this->attenuation.getValue(this->column, this->current_time);
+
 	LOG(this->log_attenuation, LEVEL_DEBUG,
 	    "new attenuation value: %.2f\n", next_attenuation);
 
@@ -37,8 +37,8 @@
 
 
 #include "PhysicalLayerPlugin.h"
+#include "TimeSeries.h"
 
-#include <map>
 #include <string>
 
 
@@ -53,19 +53,14 @@ private:
 	unsigned int current_time;
 
 	/// The attenuation values we will interpolate
-	std::map<unsigned int, double> attenuation;
+	TimeSeries attenuation;
+
+	/// The column of the attenuation values in the file
+	std::size_t column;
 
 	/// Reading mode
 	bool loop;
 
-	/**
-	 * @brief Load the attenuation file
-	 *
-	 * @param filename  The attenuation file name
-	 * @return true on success, false otherwise
-	 */
-	bool load(std::string filename);
-
 public:
 	/**
 	 * @brief Build a File
@@ -59,7 +59,7 @@ void Gate::generateConfiguration(const std::string &,
 }
 
 
-bool Gate::init()
+bool Gate::init(tal_id_t UNUSED(entity_id))
 {
 	return true;
 }
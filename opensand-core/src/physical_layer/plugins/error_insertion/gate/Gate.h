@@ -63,7 +63,7 @@ public:
 	                                  const std::string &param_id,
 	                                  const std::string &plugin_name);
 
-	bool init() override;
+	bool init(tal_id_t entity_id) override;
 
 	/**
 	 * @brief Corrupt a package with error bits 
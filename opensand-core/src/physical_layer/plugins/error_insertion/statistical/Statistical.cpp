@@ -0,0 +1,289 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file Statistical.cpp
+ * @brief Error insertion driven by per-MODCOD PER vs Es/N0 tables
+ * @author Viveris Technologies
+ */
+
+
+#include "Statistical.h"
+#include "OpenSandFrames.h"
+#include "OpenSandModelConf.h"
+
+#include <opensand_output/Output.h>
+#include <opensand_rt/Types.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <map>
+#include <sstream>
+
+
+/// The Es/N0 resolution of the resampled PER curves (dB)
+static constexpr double ESN0_STEP = 0.01;
+
+
+/**
+ * @brief Scale a PER to the range of the random draws
+ */
+static uint64_t scalePer(double per)
+{
+	if(per <= 0.0)
+	{
+		return 0;
+	}
+	if(per >= 1.0)
+	{
+		return std::numeric_limits<uint64_t>::max();
+	}
+	return static_cast<uint64_t>(std::ldexp(per, 64));
+}
+
+
+uint64_t Statistical::PerCurve::getThreshold(double esn0) const
+{
+	double position = (esn0 - this->min_esn0) / ESN0_STEP + 0.5;
+	if(position <= 0.0)
+	{
+		return this->thresholds.front();
+	}
+	std::size_t index = static_cast<std::size_t>(position);
+	if(index >= this->thresholds.size())
+	{
+		return this->thresholds.back();
+	}
+	return this->thresholds[index];
+}
+
+
+Statistical::Statistical():
+	ErrorInsertionPlugin(),
+	curves(),
+	rng()
+{
+}
+
+
+Statistical::~Statistical()
+{
+}
+
+
+void Statistical::generateConfiguration(const std::string &parent_path,
+                                        const std::string &param_id,
+                                        const std::string &plugin_name)
+{
+	auto Conf = OpenSandModelConf::Get();
+	auto types = Conf->getModelTypesDefinition();
+
+	auto error = Conf->getComponentByPath(parent_path);
+	if (error == nullptr)
+	{
+		return;
+	}
+	auto error_type = error->getParameter(param_id);
+	if (error_type == nullptr)
+	{
+		return;
+	}
+
+	auto per_file = error->addParameter("statistical_per_file",
+	                                    "PER Tables File Path",
+	                                    types->getType("string"),
+	                                    "Lines formatted as '<S2|RCS2> <MODCOD id> <Es/N0 (dB)> <PER>'");
+	Conf->setProfileReference(per_file, error_type, plugin_name);
+	auto seed = error->addParameter("statistical_seed",
+	                                "Random Seed",
+	                                types->getType("uint"),
+	                                "Combined with the entity id to draw the errors");
+	seed->setAdvanced(true);
+	Conf->setProfileReference(seed, error_type, plugin_name);
+}
+
+
+bool Statistical::init(tal_id_t entity_id)
+{
+	auto Conf = OpenSandModelConf::Get();
+	auto error = Conf->getProfileData()->getComponent("physical_layer")->getComponent("error_insertion");
+
+	std::string filename;
+	if(!OpenSandModelConf::extractParameterData(error->getParameter("statistical_per_file"), filename))
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+		    "Statistical error insertion: cannot get PER tables filename");
+		return false;
+	}
+
+	// optional, 0 by default
+	unsigned int seed = 0;
+	OpenSandModelConf::extractParameterData(error->getParameter("statistical_seed"), seed);
+
+	// draw different errors on each entity, terminals emulated by
+	// a single process included
+	this->rng = CounterRng{(uint64_t(seed) << 16) | entity_id};
+
+	return this->load(filename);
+}
+
+
+bool Statistical::load(const std::string &filename)
+{
+	std::map<std::size_t, std::map<double, double>> tables;
+
+	std::ifstream file{filename};
+	if(!file)
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+		    "cannot open PER tables file %s\n",
+		    filename.c_str());
+		return false;
+	}
+
+	std::string line;
+	unsigned int line_number = 0;
+	while(std::getline(file, line))
+	{
+		++line_number;
+		std::istringstream line_stream{line};
+		std::string waveform;
+		if(!(line_stream >> waveform) || waveform[0] == '#')
+		{
+			continue;
+		}
+
+		unsigned int modcod_id;
+		double esn0;
+		double per;
+		if(!(line_stream >> modcod_id >> esn0 >> per) ||
+		   modcod_id >= MODCOD_COUNT || per < 0.0 || per > 1.0 ||
+		   (waveform != "S2" && waveform != "RCS2"))
+		{
+			LOG(this->log_init, LEVEL_ERROR,
+			    "bad syntax in PER tables file %s, line %u: "
+			    "should be '<S2|RCS2> <MODCOD id> <Es/N0> <PER>'\n",
+			    filename.c_str(), line_number);
+			return false;
+		}
+
+		std::size_t index = (waveform == "S2" ? 0 : MODCOD_COUNT) + modcod_id;
+		tables[index][esn0] = per;
+	}
+
+	if(tables.empty())
+	{
+		LOG(this->log_init, LEVEL_ERROR,
+		    "no PER table in file %s\n",
+		    filename.c_str());
+		return false;
+	}
+
+	// resample each table on a regular grid, interpolating the PER
+	// on a logarithmic scale when possible as it decreases exponentially
+	for(auto &&[index, table]: tables)
+	{
+		PerCurve &curve = this->curves[index];
+		curve.min_esn0 = table.begin()->first;
+		double max_esn0 = table.rbegin()->first;
+		std::size_t count = static_cast<std::size_t>(std::lround((max_esn0 - curve.min_esn0) / ESN0_STEP)) + 1;
+		curve.thresholds.resize(count);
+
+		auto upper = table.begin();
+		for(std::size_t i = 0; i < count; ++i)
+		{
+			double esn0 = std::min(curve.min_esn0 + i * ESN0_STEP, max_esn0);
+			while(upper->first < esn0)
+			{
+				++upper;
+			}
+			double per = upper->second;
+			if(upper != table.begin() && upper->first != esn0)
+			{
+				auto lower = std::prev(upper);
+				double ratio = (esn0 - lower->first) / (upper->first - lower->first);
+				if(lower->second > 0.0 && upper->second > 0.0)
+				{
+					per = std::exp(std::log(lower->second) +
+					               ratio * (std::log(upper->second) - std::log(lower->second)));
+				}
+				else
+				{
+					per = lower->second + ratio * (upper->second - lower->second);
+				}
+			}
+			curve.thresholds[i] = scalePer(per);
+		}
+
+		LOG(this->log_init, LEVEL_INFO,
+		    "%s MODCOD %zu: PER table from %.2f dB to %.2f dB\n",
+		    index < MODCOD_COUNT ? "S2" : "RCS2", index % MODCOD_COUNT,
+		    curve.min_esn0, max_esn0);
+	}
+
+	return true;
+}
+
+
+bool Statistical::isToBeModifiedPacket(double cn_total,
+                                       double threshold_qef)
+{
+	return cn_total < threshold_qef;
+}
+
+
+void Statistical::isToBeModifiedPackets(std::vector<ErrorInsertionSample> &samples)
+{
+	for(auto &&sample: samples)
+	{
+		std::size_t index = sample.modcod_id;
+		if(sample.message_type == EmulatedMessageType::DvbBurst)
+		{
+			index += MODCOD_COUNT;
+		}
+
+		const PerCurve &curve = this->curves[index];
+		if(curve.thresholds.empty())
+		{
+			sample.corrupted = sample.cn_total < sample.threshold_qef;
+		}
+		else
+		{
+			sample.corrupted = this->rng() < curve.getThreshold(sample.cn_total);
+		}
+	}
+}
+
+
+bool Statistical::modifyPacket(const Rt::Data &)
+{
+	// not needed, we will reject frame in DVB layer as we return true
+	return true;
+}
@@ -0,0 +1,150 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file Statistical.h
+ * @brief Error insertion driven by per-MODCOD PER vs Es/N0 tables
+ * @author Viveris Technologies
+ */
+
+#ifndef STATISTICAL_ERROR_PLUGIN_H
+#define STATISTICAL_ERROR_PLUGIN_H
+
+
+#include <array>
+#include <string>
+#include <vector>
+
+#include "PhysicalLayerPlugin.h"
+#include "CounterRng.h"
+
+
+/**
+ * @class Statistical
+ * @brief Corrupt frames randomly, with the Packet Error Rate given
+ *        for their MODCOD at their Es/N0
+ *
+ * The PER tables are read from a file containing lines formatted as
+ *   <S2|RCS2> <modcod_id> <es/n0 (dB)> <PER>
+ * and resampled at load time so that a lookup is a single array access.
+ * MODCODs without table fall back to the Gate behaviour: the frame is
+ * corrupted if its C/N is below the minimal condition.
+ */
+class Statistical: public ErrorInsertionPlugin
+{
+public:
+	/**
+	 * @brief Statistical ctor
+	 */
+	Statistical();
+
+	/**
+	 * @brief Statistical dtor
+	 */
+	~Statistical();
+
+	/**
+	 * @brief Generate the configuration for the plugin
+	 */
+	static void generateConfiguration(const std::string &parent_path,
+	                                  const std::string &param_id,
+	                                  const std::string &plugin_name);
+
+	bool init(tal_id_t entity_id) override;
+
+	/**
+	 * @brief Corrupt a package with error bits 
+	 *
+	 * @param payload the payload to the frame that should be modified 
+	 * @return true if DVB header should be tagged as corrupted,
+	 *         false otherwise
+	 */
+	bool modifyPacket(const Rt::Data &payload) override;
+
+	/**
+	 * @brief Determine if a Packet shall be corrupted or not,
+	 *        without MODCOD information, the Gate behaviour is used
+	 *
+	 * @param cn_total       The total C/N of the link
+	 * @param threshold_qef  The minimal C/N of the link
+	 *
+	 * @return true if it must be corrupted, false otherwise 
+	 */
+	bool isToBeModifiedPacket(double cn_total, double threshold_qef) override;
+
+	/**
+	 * @brief Draw which packets of a burst shall be corrupted
+	 *        from the PER table of their MODCOD
+	 *
+	 * @param samples  The reception conditions of the burst frames
+	 */
+	void isToBeModifiedPackets(std::vector<ErrorInsertionSample> &samples) override;
+
+private:
+	/**
+	 * @brief A PER curve sampled on a regular Es/N0 grid
+	 */
+	struct PerCurve
+	{
+		/// The Es/N0 of the first sample (dB)
+		double min_esn0;
+		/// The PER of each sample, scaled to the range of the
+		/// random draws (a PER of 1 is UINT64_MAX)
+		std::vector<uint64_t> thresholds;
+
+		/**
+		 * @brief Get the scaled PER at the given Es/N0,
+		 *        clamped to the first and last samples
+		 */
+		uint64_t getThreshold(double esn0) const;
+	};
+
+	/// The number of curves per waveform (one per MODCOD id)
+	static constexpr std::size_t MODCOD_COUNT = 256;
+
+	/**
+	 * @brief Load the PER tables
+	 *
+	 * @param filename  The file describing the tables
+	 * @return true on success, false otherwise
+	 */
+	bool load(const std::string &filename);
+
+	/// The PER curves of the S2 MODCODs then of the RCS2 ones,
+	/// an empty curve means the MODCOD has no table
+	std::array<PerCurve, 2 * MODCOD_COUNT> curves;
+
+	/// The random draws
+	CounterRng rng;
+};
+
+
+CREATE(Statistical, PluginType::Error, "Statistical");
+
+
+#endif
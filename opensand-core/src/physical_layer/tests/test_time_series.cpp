@@ -0,0 +1,342 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ * Copyright © 2019 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+
+/**
+ * @file test_time_series.cpp
+ * @brief Load time series from text and binary files, regular, irregular
+ *        and malformed, and check the looked up values
+ * @author Viveris Technologies
+ */
+
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include <opensand_output/Output.h>
+
+#include "TimeSeries.h"
+
+
+/// the files written by the tests, removed at the end
+static std::vector<std::string> files;
+
+
+static bool near(double value, double expected)
+{
+	return std::fabs(value - expected) < 1e-9;
+}
+
+
+static std::string writeFile(const std::string &name, const std::string &content)
+{
+	std::string filename = "/tmp/test_time_series_" + std::to_string(getpid()) + "_" + name;
+	std::ofstream file(filename, std::ios::binary | std::ios::trunc);
+	file << content;
+	files.push_back(filename);
+	return filename;
+}
+
+
+static std::string writeBinary(const std::string &name,
+                               const TimeSeries::BinaryHeader &header,
+                               std::size_t payload)
+{
+	std::string content(reinterpret_cast<const char *>(&header), sizeof(header));
+	content.append(payload, '\0');
+	return writeFile(name, content);
+}
+
+
+static std::string writeRegular()
+{
+	return writeFile("regular.txt",
+	                 "# time value value\n"
+	                 "0 1 10\n"
+	                 "10 2 20\n"
+	                 "\n"
+	                 "30 4 40\n");
+}
+
+
+static std::string writeIrregular()
+{
+	return writeFile("irregular.txt",
+	                 "0 0\n"
+	                 "7 7\n"
+	                 "10000007 17\n");
+}
+
+
+static bool testText(std::shared_ptr<OutputLog> log)
+{
+	// regular entries are resampled at their stride
+	TimeSeries regular;
+	if(!regular.load(writeRegular(), log))
+	{
+		fprintf(stderr, "load regular text\n");
+		return false;
+	}
+	if(regular.getColumnsCount() != 2)
+	{
+		fprintf(stderr, "regular columns\n");
+		return false;
+	}
+	if(regular.getLastTime() != 30)
+	{
+		fprintf(stderr, "regular last time\n");
+		return false;
+	}
+	if(!near(regular.getValue(0, 0), 1))
+	{
+		fprintf(stderr, "regular first value\n");
+		return false;
+	}
+	if(!near(regular.getValue(0, 5), 1.5))
+	{
+		fprintf(stderr, "regular interpolated value\n");
+		return false;
+	}
+	if(!near(regular.getValue(1, 20), 30))
+	{
+		fprintf(stderr, "regular missing entry value\n");
+		return false;
+	}
+	if(!near(regular.getValue(1, 100), 40))
+	{
+		fprintf(stderr, "regular value after the end\n");
+		return false;
+	}
+	if(!near(regular.getMaxValue(1), 40))
+	{
+		fprintf(stderr, "regular max value\n");
+		return false;
+	}
+
+	// entries far apart are kept instead of being resampled at a 1 step
+	TimeSeries irregular;
+	if(!irregular.load(writeIrregular(), log))
+	{
+		fprintf(stderr, "load irregular text\n");
+		return false;
+	}
+	if(irregular.getLastTime() != 10000007)
+	{
+		fprintf(stderr, "irregular last time\n");
+		return false;
+	}
+	if(!near(irregular.getValue(0, 3), 3))
+	{
+		fprintf(stderr, "irregular first interval\n");
+		return false;
+	}
+	if(!near(irregular.getValue(0, 7), 7))
+	{
+		fprintf(stderr, "irregular entry value\n");
+		return false;
+	}
+	if(!near(irregular.getValue(0, 5000007), 12))
+	{
+		fprintf(stderr, "irregular second interval\n");
+		return false;
+	}
+	if(!near(irregular.getValue(0, 20000000), 17))
+	{
+		fprintf(stderr, "irregular value after the end\n");
+		return false;
+	}
+	return true;
+}
+
+
+static bool testBinary(std::shared_ptr<OutputLog> log)
+{
+	// the binary files give the same values as the text ones
+	for(const std::string &text: {writeRegular(), writeIrregular()})
+	{
+		std::string binary = text + ".bin";
+		files.push_back(binary);
+		if(!TimeSeries::convert(text, binary, log))
+		{
+			fprintf(stderr, "convert to binary\n");
+			return false;
+		}
+		TimeSeries parsed;
+		TimeSeries mapped;
+		if(!parsed.load(text, log))
+		{
+			fprintf(stderr, "load text\n");
+			return false;
+		}
+		if(!mapped.load(binary, log))
+		{
+			fprintf(stderr, "load binary\n");
+			return false;
+		}
+		if(mapped.getColumnsCount() != parsed.getColumnsCount())
+		{
+			fprintf(stderr, "binary columns\n");
+			return false;
+		}
+		if(mapped.getLastTime() != parsed.getLastTime())
+		{
+			fprintf(stderr, "binary last time\n");
+			return false;
+		}
+		for(uint64_t time = 0; time <= parsed.getLastTime(); time += 1 + time / 3)
+		{
+			for(std::size_t column = 0; column < parsed.getColumnsCount(); ++column)
+			{
+				if(!near(mapped.getValue(column, time), parsed.getValue(column, time)))
+				{
+					fprintf(stderr, "binary value\n");
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+
+static bool testMalformedText(std::shared_ptr<OutputLog> log)
+{
+	TimeSeries series;
+	if(series.load(writeFile("empty.txt", "# nothing\n"), log))
+	{
+		fprintf(stderr, "reject empty text\n");
+		return false;
+	}
+	if(series.load(writeFile("bad_time.txt", "abc 1\n"), log))
+	{
+		fprintf(stderr, "reject bad time\n");
+		return false;
+	}
+	if(series.load(writeFile("bad_columns.txt", "0 1 2\n10 1\n"), log))
+	{
+		fprintf(stderr, "reject bad columns count\n");
+		return false;
+	}
+	if(series.load("/nonexistent/time_series.txt", log))
+	{
+		fprintf(stderr, "reject missing file\n");
+		return false;
+	}
+	return true;
+}
+
+
+static bool testMalformedBinary(std::shared_ptr<OutputLog> log)
+{
+	// the header fields must not overflow the expected size
+	TimeSeries series;
+	TimeSeries::BinaryHeader header;
+	memcpy(header.magic, "OSTS", sizeof(header.magic));
+	header.version = 1;
+	header.columns = 2;
+	header.stride = 10;
+	header.first_time = 0;
+	header.rows = 4;
+	if(!series.load(writeBinary("valid.bin", header, 2 * 4 * sizeof(double)), log))
+	{
+		fprintf(stderr, "load valid binary\n");
+		return false;
+	}
+	if(series.load(writeBinary("truncated.bin", header, 2 * 4 * sizeof(double) - 1), log))
+	{
+		fprintf(stderr, "reject truncated binary\n");
+		return false;
+	}
+
+	TimeSeries::BinaryHeader overflow = header;
+	overflow.columns = UINT32_MAX;
+	overflow.rows = (UINT64_MAX / sizeof(double)) / UINT32_MAX + 1;
+	if(series.load(writeBinary("overflow.bin", overflow, 2 * 4 * sizeof(double)), log))
+	{
+		fprintf(stderr, "reject overflowing header\n");
+		return false;
+	}
+
+	TimeSeries::BinaryHeader huge_rows = header;
+	huge_rows.rows = UINT64_MAX / 2 + 1;
+	if(series.load(writeBinary("huge_rows.bin", huge_rows, 2 * 4 * sizeof(double)), log))
+	{
+		fprintf(stderr, "reject huge rows count\n");
+		return false;
+	}
+
+	TimeSeries::BinaryHeader bad_version = header;
+	bad_version.version = 2;
+	if(series.load(writeBinary("version.bin", bad_version, 2 * 4 * sizeof(double)), log))
+	{
+		fprintf(stderr, "reject unknown version\n");
+		return false;
+	}
+
+	// stored rows times must increase
+	TimeSeries::BinaryHeader sparse = header;
+	sparse.stride = 0;
+	sparse.columns = 1;
+	sparse.rows = 2;
+	std::string content(reinterpret_cast<const char *>(&sparse), sizeof(sparse));
+	uint64_t times[2] = {10, 5};
+	double values[2] = {1, 2};
+	content.append(reinterpret_cast<const char *>(times), sizeof(times));
+	content.append(reinterpret_cast<const char *>(values), sizeof(values));
+	if(series.load(writeFile("unsorted.bin", content), log))
+	{
+		fprintf(stderr, "reject unsorted rows times\n");
+		return false;
+	}
+	return true;
+}
+
+
+int main()
+{
+	std::shared_ptr<OutputLog> log = Output::Get()->registerLog(LEVEL_CRITICAL, "TimeSeries");
+
+	bool success = testText(log) && testBinary(log) &&
+	               testMalformedText(log) && testMalformedBinary(log);
+
+	for(const std::string &filename: files)
+	{
+		unlink(filename.c_str());
+	}
+	if(!success)
+	{
+		return 1;
+	}
+	printf("time series tests passed\n");
+	return 0;
+}
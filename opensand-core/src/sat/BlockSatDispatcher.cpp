@@ -48,47 +48,92 @@ constexpr uint8_t DATA_IN_GW_ID = 8;
 constexpr uint8_t CTRL_IN_GW_ID = 4;
 
 
-Rt::Ptr<NetBurst>& getNetBurstOrCreate(std::unordered_map<SpotComponentPair, Rt::Ptr<NetBurst>>& map, SpotComponentPair key)
+/**
+ * @brief Add a packet to the burst of its route, created on first use
+ */
+static void addToBurst(std::vector<Rt::Ptr<NetBurst>> &bursts, std::size_t route, Rt::Ptr<NetPacket> pkt)
 {
-	auto it = map.find(key);
-	if (it == map.end())
+	if (!bursts[route])
 	{
-		auto result = map.emplace(key, Rt::make_ptr<NetBurst>());
-		it = result.first;
+		bursts[route] = Rt::make_ptr<NetBurst>();
 	}
-
-	return it->second;
+	bursts[route]->push_back(std::move(pkt));
 }
 
 
-SpotByEntity::SpotByEntity():
-	spot_by_entity{},
-	default_spot{0}
+ForwardingTable::ForwardingTable():
+	entries{},
+	default_entry{0, Component::unknown},
+	routes{},
+	route_by_spot{}
 {
-	OpenSandModelConf::Get()->getDefaultSpotId(default_spot);
+	OpenSandModelConf::Get()->getDefaultSpotId(this->default_entry.spot_id);
+	this->entries.fill(this->default_entry);
+	for (auto &&spot_routes: this->route_by_spot)
+	{
+		spot_routes.fill(-1);
+	}
 }
 
 
-void SpotByEntity::addEntityInSpot(tal_id_t entity, spot_id_t spot)
+bool ForwardingTable::addRoute(SpotComponentPair dest, tal_id_t sat_id, RegenLevel regen_level)
 {
-	spot_by_entity[entity] = spot;
+	if (dest.spot_id >= MAX_ENTITIES ||
+	    (dest.dest != Component::gateway && dest.dest != Component::terminal))
+	{
+		return false;
+	}
+
+	DispatchRoute route{
+		.dest = dest,
+		.sat_id = sat_id,
+		.regen_level = regen_level,
+		.isl_key = {sat_id, regen_level == RegenLevel::IP},
+		.lower_key = {},
+	};
+	route.lower_key.spot_id = dest.spot_id;
+	route.lower_key.dest = dest.dest;
+	route.lower_key.is_transparent = false;
+
+	int16_t &index = this->route_by_spot[dest.spot_id][dest.dest == Component::terminal];
+	if (index < 0)
+	{
+		index = this->routes.size();
+		this->routes.push_back(route);
+	}
+	else
+	{
+		this->routes[index] = route;
+	}
+	return true;
 }
 
 
-void SpotByEntity::setDefaultSpot(spot_id_t spot)
+bool ForwardingTable::addEntityInSpot(tal_id_t entity, spot_id_t spot)
 {
-	default_spot = spot;
+	if (entity >= MAX_ENTITIES)
+	{
+		return false;
+	}
+	this->entries[entity].spot_id = spot;
+	return true;
 }
 
 
-spot_id_t SpotByEntity::getSpotForEntity(tal_id_t entity) const
+bool ForwardingTable::setEntityType(tal_id_t entity, Component component)
 {
-	auto found_spot = spot_by_entity.find(entity);
-	if (found_spot == spot_by_entity.end())
+	if (entity >= MAX_ENTITIES)
 	{
-		return default_spot;
+		return false;
 	}
-	return found_spot->second;
+	this->entries[entity].component = component;
+	return true;
+}
+
+
+const std::vector<DispatchRoute> &ForwardingTable::getRoutes() const
+{
+	return this->routes;
 }
 
 
@@ -104,25 +149,30 @@ bool BlockSatDispatcher::onInit()
 {
 	const auto conf = OpenSandModelConf::Get();
 
-	SpotByEntity spot_by_entity;
-	std::unordered_map<SpotComponentPair, tal_id_t> routes;
-	std::unordered_map<SpotComponentPair, RegenLevel> regen_levels;
+	ForwardingTable forwarding_table;
 
 	for (auto &&spot: conf->getSpotsTopology())
 	{
 		const SpotTopology &topo = spot.second;
 
-		spot_by_entity.addEntityInSpot(topo.gw_id, topo.spot_id);
+		bool added = forwarding_table.addEntityInSpot(topo.gw_id, topo.spot_id);
 		for (tal_id_t tal_id: topo.st_ids)
 		{
-			spot_by_entity.addEntityInSpot(tal_id, topo.spot_id);
+			added &= forwarding_table.addEntityInSpot(tal_id, topo.spot_id);
 		}
 
-		routes[{topo.spot_id, Component::gateway}] = topo.sat_id_gw;
-		routes[{topo.spot_id, Component::terminal}] = topo.sat_id_st;
-
-		regen_levels[{topo.spot_id, Component::terminal}] = topo.forward_regen_level;
-		regen_levels[{topo.spot_id, Component::gateway}] = topo.return_regen_level;
+		added &= forwarding_table.addRoute({topo.spot_id, Component::gateway},
+		                                   topo.sat_id_gw, topo.return_regen_level);
+		added &= forwarding_table.addRoute({topo.spot_id, Component::terminal},
+		                                   topo.sat_id_st, topo.forward_regen_level);
+		if (!added)
+		{
+			LOG(log_init, LEVEL_ERROR,
+			    "The entities IDs of the spot %d do not fit in the forwarding "
+			    "table (at most %zu)",
+			    topo.spot_id, ForwardingTable::MAX_ENTITIES);
+			return false;
+		}
 
 		// Check that ISL are enabled when they should be
 		if (topo.sat_id_gw != topo.sat_id_st &&
@@ -141,41 +191,42 @@ bool BlockSatDispatcher::onInit()
 		    spot.first, topo.spot_id);
 	}
 
-	for (auto &&[dest, sat_id] : routes)
+	// the entities type is only read once instead of once per packet
+	for (tal_id_t entity = 0; entity < ForwardingTable::MAX_ENTITIES; ++entity)
+	{
+		forwarding_table.setEntityType(entity, conf->getEntityType(entity));
+	}
+
+	for (auto &&route : forwarding_table.getRoutes())
 	{
-		auto regen_level = regen_levels.at(dest);
 		LOG(log_init, LEVEL_DEBUG,
 		    "Route on spot %d to entity type %d will go through satellite %d with regen level %d",
-			dest.spot_id, dest.dest, sat_id, regen_level);
+			route.dest.spot_id, route.dest.dest, route.sat_id, route.regen_level);
 	}
 
-	upward.initDispatcher(spot_by_entity, routes, regen_levels);
-	downward.initDispatcher(spot_by_entity, routes, regen_levels);
+	upward.initDispatcher(forwarding_table);
+	downward.initDispatcher(forwarding_table);
 	return true;
 }
 
 
+
 Rt::UpwardChannel<BlockSatDispatcher>::UpwardChannel(const std::string &name, SatDispatcherConfig config):
 	Channels::UpwardMuxDemux<UpwardChannel<BlockSatDispatcher>, IslComponentPair>{name},
-	entity_id{config.entity_id}
+	entity_id{config.entity_id},
+	forwarding_table{},
+	bursts{}
 {
 }
 
 
-void Rt::UpwardChannel<BlockSatDispatcher>::initDispatcher(const SpotByEntity& spot_by_entity,
-                                                           const std::unordered_map<SpotComponentPair, tal_id_t> &routes,
-                                                           const std::unordered_map<SpotComponentPair, RegenLevel> &regen_levels)
+void Rt::UpwardChannel<BlockSatDispatcher>::initDispatcher(const ForwardingTable &forwarding_table)
 {
-	this->spot_by_entity = spot_by_entity;
-	this->routes = routes;
-	this->regen_levels = regen_levels;
-
-	for (auto &&[dest, sat_id] : this->routes)
+	this->forwarding_table = forwarding_table;
+	this->bursts.clear();
+	for (std::size_t index = 0; index < this->forwarding_table.getRoutes().size(); ++index)
 	{
-		auto regen_level = this->regen_levels.at(dest);
-		LOG(log_init, LEVEL_DEBUG,
-		    "Route on spot %d to entity type %d will go through satellite %d with regen level %d",
-			dest.spot_id, dest.dest, sat_id, regen_level);
+		this->bursts.push_back(make_ptr<NetBurst>(nullptr));
 	}
 }
 
@@ -210,19 +261,15 @@ bool Rt::UpwardChannel<BlockSatDispatcher>::onEvent(const MessageEvent &event)
 		{
 			bool success = true;
 			auto link_up_msg = event.getMessage<T_LINK_UP>();
-			for (auto&& [key, regen_level] : regen_levels)
+			for (auto&& route : forwarding_table.getRoutes())
 			{
-				if (regen_level == RegenLevel::IP)
+				if (route.regen_level == RegenLevel::IP)
 				{
 					Ptr<T_LINK_UP> link_up_copy = make_ptr<T_LINK_UP>();
 					link_up_copy->group_id = link_up_msg->group_id;
 					link_up_copy->tal_id = link_up_msg->tal_id;
 
-					IslComponentPair link_up_key{
-						.connected_sat = routes.at(key),
-						.is_data_channel = true,
-					};
-					if (!this->enqueueMessage(link_up_key,
+					if (!this->enqueueMessage(route.isl_key,
 					                          std::move(link_up_copy),
 					                          to_underlying(InternalMessageType::link_up)))
 					{
@@ -255,15 +302,14 @@ bool Rt::UpwardChannel<BlockSatDispatcher>::handleDvbFrame(Ptr<DvbFrame> frame)
 	    spot_id, carrier_id, frame->getMessageType());
 
 	const Component dest = isGatewayCarrier(carrier_type) ? Component::terminal : Component::gateway;
-	SpotComponentPair key{spot_id, dest};
-	const auto dest_sat_id_it = routes.find(key);
-	if (dest_sat_id_it == routes.end())
+	const DispatchRoute *route = forwarding_table.getRoute(spot_id, dest);
+	if (route == nullptr)
 	{
 		auto name = getComponentName(dest);
 		LOG(log_receive, LEVEL_ERROR, "No route found for %s in spot %d", name.c_str(), spot_id);
 		return false;
 	}
-	const tal_id_t dest_sat_id = dest_sat_id_it->second;
+	const tal_id_t dest_sat_id = route->sat_id;
 
 	if (dest_sat_id == entity_id)
 	{
@@ -284,67 +330,75 @@ bool Rt::UpwardChannel<BlockSatDispatcher>::handleDvbFrame(Ptr<DvbFrame> frame)
 bool Rt::UpwardChannel<BlockSatDispatcher>::handleNetBurst(Ptr<NetBurst> in_burst)
 {
 	// Separate the packets by destination
-	std::unordered_map<SpotComponentPair, Ptr<NetBurst>> bursts{};
+	bool ok = true;
 	for (auto &&pkt: *in_burst)
 	{
 		const auto dest_id = pkt->getDstTalId();
 		const auto src_id = pkt->getSrcTalId();
-		const spot_id_t spot_id = spot_by_entity.getSpotForEntity(src_id);
+		const spot_id_t spot_id = forwarding_table.getEntry(src_id).spot_id;
 		LOG(log_receive, LEVEL_INFO, "Received a NetBurst (%d->%d, spot_id %d)", src_id, dest_id, spot_id);
 
-		Component dest = OpenSandModelConf::Get()->getEntityType(dest_id);
+		Component dest = forwarding_table.getEntry(dest_id).component;
 		if (dest == Component::unknown)
 		{
 			if (dest_id == BROADCAST_TAL_ID)
 			{
-				for (auto &&route: routes)
+				// the last route takes the packet itself, the others a copy
+				const auto &routes = forwarding_table.getRoutes();
+				for (std::size_t index = 0; index + 1 < routes.size(); ++index)
+				{
+					addToBurst(bursts, index, make_ptr<NetPacket>(*pkt));
+				}
+				if (!routes.empty())
 				{
-					Ptr<NetPacket> copy = make_ptr<NetPacket>(*pkt);
-					getNetBurstOrCreate(bursts, route.first)->push_back(std::move(copy));
+					addToBurst(bursts, routes.size() - 1, std::move(pkt));
 				}
-				pkt.reset();
 			}
 			else
 			{
 				LOG(log_receive, LEVEL_ERROR,
 				    "Invalid destination type for NetBurst (ID %d)",
 				    dest_id);
+				// the burst is rejected as a whole
+				for (auto &&burst: bursts)
+				{
+					burst.reset();
+				}
 				return false;
 			}
 		}
 		else
 		{
-			getNetBurstOrCreate(bursts, SpotComponentPair{spot_id, dest})->push_back(std::move(pkt));
+			const DispatchRoute *route = forwarding_table.getRoute(spot_id, dest);
+			if (route == nullptr)
+			{
+				auto name = getComponentName(dest);
+				LOG(log_receive, LEVEL_ERROR, "No route found for %s in spot %d", name.c_str(), spot_id);
+				ok = false;
+				continue;
+			}
+			addToBurst(bursts, forwarding_table.getRouteIndex(*route), std::move(pkt));
 		}
 	}
 
 	// Send all bursts to their respective destination
-	bool ok = true;
-	for (auto &&[dest, burst]: bursts)
+	const auto &routes = forwarding_table.getRoutes();
+	for (std::size_t index = 0; index < routes.size(); ++index)
 	{
-		const auto dest_sat_id_it = routes.find(dest);
-		if (dest_sat_id_it == routes.end())
+		if (!bursts[index])
 		{
-			auto name = getComponentName(dest.dest);
-			LOG(log_receive, LEVEL_ERROR, "No route found for %s in spot %d", name.c_str(), dest.spot_id);
-			ok = false;
 			continue;
 		}
 
-		const tal_id_t dest_sat_id = dest_sat_id_it->second;
-		auto regen_level = regen_levels.at(dest);
-		if (dest_sat_id == entity_id && regen_level != RegenLevel::IP)
+		const DispatchRoute &route = routes[index];
+		if (route.sat_id == entity_id && route.regen_level != RegenLevel::IP)
 		{
-			ok &= sendToOppositeChannel(std::move(burst), InternalMessageType::decap_data);
+			ok &= sendToOppositeChannel(std::move(bursts[index]), InternalMessageType::decap_data);
 		}
 		else
 		{
 			// send by ISL or to LanAdaptation for IP regen
-			IslComponentPair key{
-				.connected_sat = dest_sat_id,
-				.is_data_channel = regen_level == RegenLevel::IP,
-			};
-			ok &= sendToUpperBlock(key, std::move(burst), InternalMessageType::decap_data);
+			ok &= sendToUpperBlock(route.isl_key, std::move(bursts[index]), InternalMessageType::decap_data);
 		}
 	}
 	return ok;
@@ -380,25 +434,20 @@ bool Rt::UpwardChannel<BlockSatDispatcher>::sendToOppositeChannel(Ptr<void> msg,
 
 Rt::DownwardChannel<BlockSatDispatcher>::DownwardChannel(const std::string &name, SatDispatcherConfig config):
 	Channels::DownwardMuxDemux<DownwardChannel<BlockSatDispatcher>, RegenerativeSpotComponent>{name},
-	entity_id{config.entity_id}
+	entity_id{config.entity_id},
+	forwarding_table{},
+	bursts{}
 {
 }
 
 
-void Rt::DownwardChannel<BlockSatDispatcher>::initDispatcher(const SpotByEntity& spot_by_entity,
-                                                             const std::unordered_map<SpotComponentPair, tal_id_t> &routes,
-                                                             const std::unordered_map<SpotComponentPair, RegenLevel> &regen_levels)
+void Rt::DownwardChannel<BlockSatDispatcher>::initDispatcher(const ForwardingTable &forwarding_table)
 {
-	this->spot_by_entity = spot_by_entity;
-	this->routes = routes;
-	this->regen_levels = regen_levels;
-
-	for (auto &&[dest, sat_id] : this->routes)
+	this->forwarding_table = forwarding_table;
+	this->bursts.clear();
+	for (std::size_t index = 0; index < this->forwarding_table.getRoutes().size(); ++index)
 	{
-		auto regen_level = this->regen_levels.at(dest);
-		LOG(log_init, LEVEL_DEBUG,
-		    "Route on spot %d to entity type %d will go through satellite %d with regen level %d",
-			dest.spot_id, dest.dest, sat_id, regen_level);
+		this->bursts.push_back(make_ptr<NetBurst>(nullptr));
 	}
 }
 
@@ -456,15 +505,14 @@ bool Rt::DownwardChannel<BlockSatDispatcher>::handleDvbFrame(Ptr<DvbFrame> frame
 	                       ? std::make_tuple(Component::terminal, Component::gateway)
 	                       : std::make_tuple(Component::gateway, Component::terminal);
 
-	SpotComponentPair key{spot_id, dest};
-	const auto dest_sat_id_it = routes.find(key);
-	if (dest_sat_id_it == routes.end())
+	const DispatchRoute *route = forwarding_table.getRoute(spot_id, dest);
+	if (route == nullptr)
 	{
 		auto name = getComponentName(dest);
 		LOG(log_receive, LEVEL_ERROR, "No route found for %s in spot %d", name.c_str(), spot_id);
 		return false;
 	}
-	const tal_id_t dest_sat_id = dest_sat_id_it->second;
+	const tal_id_t dest_sat_id = route->sat_id;
 
 	if (dest_sat_id == entity_id)
 	{
@@ -477,8 +525,10 @@ bool Rt::DownwardChannel<BlockSatDispatcher>::handleDvbFrame(Ptr<DvbFrame> frame
 
 		// add one to the input carrier id to get the corresponding output carrier id
 		frame->setCarrierId(carrier_id + 1);
-		bool is_transparent = regen_levels.at(key) == RegenLevel::Transparent
-		                   && (is_data_carrier || regen_levels.at({spot_id, src}) == RegenLevel::Transparent);
+		const DispatchRoute *src_route = forwarding_table.getRoute(spot_id, src);
+		bool is_transparent = route->regen_level == RegenLevel::Transparent
+		                   && (is_data_carrier ||
+		                       (src_route != nullptr && src_route->regen_level == RegenLevel::Transparent));
 		return sendToLowerBlock({spot_id, dest, is_transparent}, std::move(frame), msg_type);
 	}
 	else
@@ -492,70 +542,84 @@ bool Rt::DownwardChannel<BlockSatDispatcher>::handleDvbFrame(Ptr<DvbFrame> frame
 bool Rt::DownwardChannel<BlockSatDispatcher>::handleNetBurst(Ptr<NetBurst> in_burst)
 {
 	// Separate the packets by destination
-	std::unordered_map<SpotComponentPair, Ptr<NetBurst>> bursts{};
+	bool ok = true;
 	for (auto &&pkt: *in_burst)
 	{
 		const auto dest_id = pkt->getDstTalId();
 		const auto src_id = pkt->getSrcTalId();
-		const spot_id_t spot_id = spot_by_entity.getSpotForEntity(src_id);
+		const spot_id_t spot_id = forwarding_table.getEntry(src_id).spot_id;
 		LOG(log_receive, LEVEL_INFO, "Received a NetBurst (%d->%d, spot_id %d)", src_id, dest_id, spot_id);
 
 		if (dest_id == BROADCAST_TAL_ID)
 		{
-			SpotComponentPair to_st{spot_id, Component::terminal};
-			SpotComponentPair to_gw{spot_id, Component::gateway};
-			bool forward_transparent = regen_levels.at(to_st) == RegenLevel::Transparent;
-			bool return_transparent = regen_levels.at(to_gw) == RegenLevel::Transparent;
+			const DispatchRoute *to_st = forwarding_table.getRoute(spot_id, Component::terminal);
+			const DispatchRoute *to_gw = forwarding_table.getRoute(spot_id, Component::gateway);
+			if (to_st == nullptr || to_gw == nullptr)
+			{
+				LOG(log_receive, LEVEL_ERROR, "No route found for broadcast in spot %d", spot_id);
+				ok = false;
+				continue;
+			}
+			bool forward_transparent = to_st->regen_level == RegenLevel::Transparent;
+			bool return_transparent = to_gw->regen_level == RegenLevel::Transparent;
 			if (forward_transparent)
 			{
 				if (return_transparent)
 				{
 					LOG(log_receive, LEVEL_ERROR, "Both directions are transparent in sat_dispatch, cannot handle NetBurst");
+					for (auto &&burst: bursts)
+					{
+						burst.reset();
+					}
 					return false;
 				}
 				else
 				{
-					getNetBurstOrCreate(bursts, to_gw)->push_back(std::move(pkt));
+					addToBurst(bursts, forwarding_table.getRouteIndex(*to_gw), std::move(pkt));
 				}
 			}
 			else
 			{
 				if (return_transparent)
 				{
-					getNetBurstOrCreate(bursts, to_st)->push_back(std::move(pkt));
+					addToBurst(bursts, forwarding_table.getRouteIndex(*to_st), std::move(pkt));
 				}
 				else
 				{
-					Ptr<NetPacket> copy = make_ptr<NetPacket>(*pkt);
-					getNetBurstOrCreate(bursts, to_gw)->push_back(std::move(copy));
-					getNetBurstOrCreate(bursts, to_st)->push_back(std::move(pkt));
+					addToBurst(bursts, forwarding_table.getRouteIndex(*to_gw), make_ptr<NetPacket>(*pkt));
+					addToBurst(bursts, forwarding_table.getRouteIndex(*to_st), std::move(pkt));
 				}
 			}
 		}
 		else
 		{
-			Component dest = OpenSandModelConf::Get()->getEntityType(dest_id);
-			getNetBurstOrCreate(bursts, SpotComponentPair{spot_id, dest})->push_back(std::move(pkt));
+			Component dest = forwarding_table.getEntry(dest_id).component;
+			const DispatchRoute *route = forwarding_table.getRoute(spot_id, dest);
+			if (route == nullptr)
+			{
+				auto name = getComponentName(dest);
+				LOG(log_receive, LEVEL_ERROR, "No route found for %s in spot %d", name.c_str(), spot_id);
+				ok = false;
+				continue;
+			}
+			addToBurst(bursts, forwarding_table.getRouteIndex(*route), std::move(pkt));
 		}
 	}
 
 	// Send all bursts to their respective destination
-	bool ok = true;
-	for (auto &&[dest, burst]: bursts)
+	const auto &routes = forwarding_table.getRoutes();
+	for (std::size_t index = 0; index < routes.size(); ++index)
 	{
-		const auto dest_sat_id_it = routes.find(dest);
-		if (dest_sat_id_it == routes.end())
+		if (!bursts[index])
 		{
-			auto name = getComponentName(dest.dest);
-			LOG(log_receive, LEVEL_ERROR, "No route found for %s in spot %d", name.c_str(), dest.spot_id);
-			ok = false;
 			continue;
 		}
-		const tal_id_t dest_sat_id = dest_sat_id_it->second;
-		if (dest_sat_id == entity_id || regen_levels.at(dest) == RegenLevel::IP)
+
+		const DispatchRoute &route = routes[index];
+		if (route.sat_id == entity_id || route.regen_level == RegenLevel::IP)
 		{
-			ok &= sendToLowerBlock({dest.spot_id, dest.dest, false},
-			                       std::move(burst),
+			ok &= sendToLowerBlock(route.lower_key,
+			                       std::move(bursts[index]),
 			                       InternalMessageType::decap_data);
 		}
 		else
@@ -564,6 +628,7 @@ bool Rt::DownwardChannel<BlockSatDispatcher>::handleNetBurst(Ptr<NetBurst> in_bu
 			// the message we received is only for us; no need to send back using ISL.
 			// Which is a safe assumption for a 2-satellites constellation but might need
 			// some rework to support more satellites in the future.
+			bursts[index].reset();
 		}
 	}
 	return ok;
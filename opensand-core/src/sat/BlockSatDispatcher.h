@@ -35,8 +35,9 @@
 #ifndef BLOCK_SAT_DISPATCHER_H
 #define BLOCK_SAT_DISPATCHER_H
 
-#include <unordered_set>
+#include <array>
 #include <memory>
+#include <vector>
 
 #include <opensand_rt/Block.h>
 #include <opensand_rt/RtChannelMuxDemux.h>
@@ -58,20 +59,98 @@ struct SatDispatcherConfig
 };
 
 
-class SpotByEntity
+/**
+ * @brief The way to a destination (spot and component) of the satellite
+ */
+struct DispatchRoute
 {
-public:
-	SpotByEntity();
+	SpotComponentPair dest;
+	/// the satellite the destination is connected to
+	tal_id_t sat_id;
+	RegenLevel regen_level;
+	/// the upper block output when the destination is not handled locally
+	IslComponentPair isl_key;
+	/// the lower block output when the destination is handled locally
+	RegenerativeSpotComponent lower_key;
+};
 
-	void addEntityInSpot(tal_id_t entity, spot_id_t spot);
 
-	void setDefaultSpot(spot_id_t spot);
+/**
+ * @brief The spot and component of an entity
+ */
+struct ForwardingEntry
+{
+	spot_id_t spot_id;
+	Component component;
+};
+
 
-	spot_id_t getSpotForEntity(tal_id_t entity) const;
+/**
+ * @class ForwardingTable
+ * @brief The routes of the satellite compiled at init in flat arrays,
+ *        indexed by entity and spot IDs, so that routing a packet does
+ *        not look the configuration up nor hash anything
+ */
+class ForwardingTable
+{
+public:
+	/// the entities and spots IDs handled by the table
+	static constexpr std::size_t MAX_ENTITIES = 256;
+
+	ForwardingTable();
+
+	/**
+	 * @brief Add the route to a destination
+	 *
+	 * @param dest         The spot and component of the destination
+	 * @param sat_id       The satellite the destination is connected to
+	 * @param regen_level  The regeneration level towards the destination
+	 * @return true on success, false if the spot ID is out of the table
+	 */
+	bool addRoute(SpotComponentPair dest, tal_id_t sat_id, RegenLevel regen_level);
+
+	/**
+	 * @brief Set the spot and the type of an entity
+	 *
+	 * @return true on success, false if the entity ID is out of the table
+	 */
+	bool addEntityInSpot(tal_id_t entity, spot_id_t spot);
+	bool setEntityType(tal_id_t entity, Component component);
+
+	inline const ForwardingEntry &getEntry(tal_id_t entity) const
+	{
+		return entity < MAX_ENTITIES ? this->entries[entity] : this->default_entry;
+	};
+
+	/**
+	 * @brief Get the route to a destination
+	 *
+	 * @return the route, nullptr if there is none
+	 */
+	inline const DispatchRoute *getRoute(spot_id_t spot, Component dest) const
+	{
+		if(spot >= MAX_ENTITIES || (dest != Component::gateway && dest != Component::terminal))
+		{
+			return nullptr;
+		}
+		int16_t index = this->route_by_spot[spot][dest == Component::terminal];
+		return index < 0 ? nullptr : &this->routes[index];
+	};
+
+	inline std::size_t getRouteIndex(const DispatchRoute &route) const
+	{
+		return &route - this->routes.data();
+	};
+
+	const std::vector<DispatchRoute> &getRoutes() const;
 
 private:
-	std::unordered_map<tal_id_t, spot_id_t> spot_by_entity;
-	spot_id_t default_spot;
+	std::array<ForwardingEntry, MAX_ENTITIES> entries;
+	/// the entry of the IDs out of the table
+	ForwardingEntry default_entry;
+	std::vector<DispatchRoute> routes;
+	/// the index of the route to the gateway and to the terminals of each spot, -1 if none
+	std::array<std::array<int16_t, 2>, MAX_ENTITIES> route_by_spot;
 };
 
 
@@ -85,9 +164,7 @@ class Rt::UpwardChannel<class BlockSatDispatcher>: public Channels::UpwardMuxDem
 	bool onEvent(const Event &event) override;
 	bool onEvent(const MessageEvent &event) override;
 
-	void initDispatcher(const SpotByEntity& spot_by_entity,
-	                    const std::unordered_map<SpotComponentPair, tal_id_t> &routes,
-	                    const std::unordered_map<SpotComponentPair, RegenLevel> &regen_levels);
+	void initDispatcher(const ForwardingTable &forwarding_table);
 
  private:
 	friend class BlockSatDispatcher;
@@ -99,9 +176,9 @@ class Rt::UpwardChannel<class BlockSatDispatcher>: public Channels::UpwardMuxDem
 	bool sendToOppositeChannel(Ptr<void> msg, InternalMessageType msg_type);
 
 	tal_id_t entity_id;
-	SpotByEntity spot_by_entity;
-	std::unordered_map<SpotComponentPair, tal_id_t> routes;
-	std::unordered_map<SpotComponentPair, RegenLevel> regen_levels;
+	ForwardingTable forwarding_table;
+	/// the packets of a burst sorted by route, reused from burst to burst
+	std::vector<Ptr<NetBurst>> bursts;
 };
 
 
@@ -115,9 +192,7 @@ class Rt::DownwardChannel<class BlockSatDispatcher>: public Channels::DownwardMu
 	bool onEvent(const Event &event) override;
 	bool onEvent(const MessageEvent &event) override;
 
-	void initDispatcher(const SpotByEntity& spot_by_entity,
-	                    const std::unordered_map<SpotComponentPair, tal_id_t> &routes,
-	                    const std::unordered_map<SpotComponentPair, RegenLevel> &regen_levels);
+	void initDispatcher(const ForwardingTable &forwarding_table);
 
  private:
 	friend class BlockSatDispatcher;
@@ -129,9 +204,9 @@ class Rt::DownwardChannel<class BlockSatDispatcher>: public Channels::DownwardMu
 	bool sendToOppositeChannel(Ptr<void> msg, InternalMessageType msg_type);
 
 	tal_id_t entity_id;
-	SpotByEntity spot_by_entity;
-	std::unordered_map<SpotComponentPair, tal_id_t> routes;
-	std::unordered_map<SpotComponentPair, RegenLevel> regen_levels;
+	ForwardingTable forwarding_table;
+	/// the packets of a burst sorted by route, reused from burst to burst
+	std::vector<Ptr<NetBurst>> bursts;
 };
 
 
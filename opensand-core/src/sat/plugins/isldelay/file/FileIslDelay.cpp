@@ -37,10 +37,6 @@
 
 #include <opensand_output/Output.h>
 
-#include <algorithm>
-#include <sstream>
-#include <fstream>
-
 
 std::string FileIslDelay::config_path = "";
 
@@ -50,6 +46,7 @@ FileIslDelay::FileIslDelay():
 		is_init(false),
 		current_time(0),
 		delays(),
+		column(0),
 		loop(false)
 {
 }
@@ -57,7 +54,6 @@ FileIslDelay::FileIslDelay():
 
 FileIslDelay::~FileIslDelay()
 {
-	this->delays.clear();
 }
 
 
@@ -87,6 +83,10 @@ void FileIslDelay::generateConfiguration(const std::string &parent_path,
 	Conf->setProfileReference(refresh_period, delay_type, plugin_name);
 	auto loop = delay->addParameter("loop", "Loop Mode", types->getType("bool"));
 	Conf->setProfileReference(loop, delay_type, plugin_name);
+	auto column = delay->addParameter("column", "File Column", types->getType("uint"),
+	                                  "The column of the delay values when the file describes several links");
+	column->setAdvanced(true);
+	Conf->setProfileReference(column, delay_type, plugin_name);
 }
 
 
@@ -126,156 +126,52 @@ bool FileIslDelay::init()
 		return false;
 	}
 
-	return this->load(filename);
-}
-
+	// optional, the first column by default
+	unsigned int column_index = 0;
+	OpenSandModelConf::extractParameterData(delay->getParameter("column"), column_index);
+	this->column = column_index;
 
-bool FileIslDelay::load(std::string filename)
-{
-	std::string line;
-	std::istringstream line_stream;
-	unsigned int line_number = 0;
-
-	std::ifstream file(filename.c_str());
-
-	if(!file)
+	if(!this->delays.load(filename, this->log_delay))
 	{
 		LOG(this->log_delay, LEVEL_ERROR,
-		    "Cannot open file %s\n", filename.c_str());
-		goto error;
+		    "Malformed sat delay configuration file '%s'\n",
+		    filename.c_str());
+		return false;
 	}
-
-	while(std::getline(file, line))
+	if(this->column >= this->delays.getColumnsCount())
 	{
-		unsigned int time;
-		time_ms_t::rep delay;
-		
-		line_number++;
-		
-		if(line == "" || line[0] == '#')
-		{
-			continue;
-		}
-
-		// Clear previous flags (if any)
-		line_stream.clear();
-		line_stream.str(line);
-
-		line_stream >> time;
-		if(line_stream.bad() || line_stream.fail())
-		{
-			LOG(this->log_delay, LEVEL_ERROR,
-					"Bad syntax in file '%s', line %u: "
-					"there should be a timestamp (integer) "
-					"instead of '%s'\n",
-					filename, line_number, line);
-			goto malformed;
-		}
-
-		// get delay
-		line_stream >> delay;
-		if(line_stream.bad() || line_stream.fail())
-		{
-			LOG(this->log_delay, LEVEL_ERROR,
-			    "Error while parsing delay line %u\n",
-			    line_number);
-			goto malformed;
-		}
-
-		this->delays[time] = time_ms_t(delay);
-
-		LOG(this->log_delay, LEVEL_DEBUG,
-		    "Entry: time: %u, delay: %u ms\n",
-			time, delay);
+		LOG(this->log_init, LEVEL_ERROR,
+		    "FILE delay: no column %zu in file '%s'",
+		    this->column, filename.c_str());
+		return false;
 	}
 
-	file.close();
 	// TODO: should is_init use a mutex??
 	this->is_init = true;
 	return true;
-
-malformed:
-	LOG(this->log_delay, LEVEL_ERROR,
-	    "Malformed sat delay configuration file '%s'\n",
-	    filename);
-	file.close();
-error:
-	return false;
 }
 
 bool FileIslDelay::updateIslDelay()
 {
-	unsigned int old_time, new_time;
-	time_ms_t old_delay, new_delay, next_delay;
-
 	this->current_time++;
 
 	LOG(this->log_delay, LEVEL_INFO,
 	    "Updating sat delay: current time: %u (step: %f ms)\n",
 	    this->current_time, this->refresh_period);
 
-	// Look for the next entry whose key is equal or greater than 'current_time'
-	auto delay_it = this->delays.lower_bound(this->current_time);
-
-	// Delay found
-	if(delay_it != this->delays.end())
-	{
-		// Next entry in the configuration file
-		new_time = delay_it->first;
-		new_delay = delay_it->second;
-
-		LOG(this->log_delay, LEVEL_DEBUG,
-		    "New entry found: time: %u, value: %d\n",
-		    new_time, new_delay);
-
-		if(delay_it != this->delays.begin())
-		{
-			// Get previous entry in the configuration file
-			delay_it--;
-
-			old_time = delay_it->first;
-			old_delay = delay_it->second;
-
-			LOG(this->log_delay, LEVEL_DEBUG,
-			    "Old time: %u, old delay: %u\n",
-			    old_time,
-			    old_delay.count());
-
-			// Linear interpolation
-			auto coef = (new_delay - old_delay) / double(new_time - old_time);
-
-			next_delay = old_delay + std::chrono::duration_cast<time_ms_t>(coef * (this->current_time - old_time));
-
-			LOG(this->log_delay, LEVEL_DEBUG,
-			    "Linear coef: %f, old step: %u\n",
-			    coef.count(), old_time);
-		}
-		else
-		{
-			// First (and potentially only) entry, use it
-			LOG(this->log_delay, LEVEL_DEBUG,
-			    "It is the first entry\n");
-			next_delay = new_delay;
-		}
-	}
-	else if(!this->loop)
-	{
-		LOG(this->log_delay, LEVEL_DEBUG,
-		    "Reach end of simulation, keep the last value\n");
-		// we reached the end of the scenario, keep the last value
-		next_delay = this->delays.rend()->second;
-	}
-	else // loop
+	if(this->current_time > this->delays.getLastTime() && this->loop)
 	{
 		LOG(this->log_delay, LEVEL_DEBUG,
 		    "Reach end of simulation, restart with the first value\n");
 		// we reached the end of the scenario, restart at beginning
-		delay_it = this->delays.begin();
-		new_time = delay_it->first;
-		next_delay = delay_it->second;
 		this->current_time = 0;
 	}
 
+	// interpolated between the surrounding entries, the last value
+	// is kept at the end of the scenario
+	std::chrono::duration<double, std::milli> value{this->delays.getValue(this->column, this->current_time)};
+	time_ms_t next_delay = std::chrono::duration_cast<time_ms_t>(value);
+
 	LOG(this->log_delay, LEVEL_DEBUG,
 	    "new delay value: %u\n",
 	    next_delay.count());
@@ -286,13 +182,6 @@ bool FileIslDelay::updateIslDelay()
 }
 
 
-static bool pair_compare(const std::pair<unsigned int, time_ms_t> &a,
-                         const std::pair<unsigned int, time_ms_t> &b)
-{
-	return a.second < b.second;
-}
-
-
 bool FileIslDelay::getMaxDelay(time_ms_t &delay) const
 {
 	if(!this->is_init)
@@ -300,7 +189,7 @@ bool FileIslDelay::getMaxDelay(time_ms_t &delay) const
 		return false;
 	}
 
-	auto result = std::max_element(this->delays.begin(), this->delays.end(), pair_compare);
-	delay = result->second;
+	std::chrono::duration<double, std::milli> value{this->delays.getMaxValue(this->column)};
+	delay = std::chrono::duration_cast<time_ms_t>(value);
 	return true;
 }
@@ -36,10 +36,10 @@
 
 
 #include "OpenSandCore.h"
+#include "TimeSeries.h"
 #include "IslPlugin.h"
 
 #include <string>
-#include <map>
 
 
 /**
@@ -57,19 +57,14 @@ private:
 	unsigned int current_time;
 
 	/// The satdelay values we will interpolate
-	std::map<unsigned int, time_ms_t> delays;
+	TimeSeries delays;
+
+	/// The column of the delay values in the file
+	std::size_t column;
 
 	/// Reading mode
 	bool loop;
 
-	/**
-	 * @brief Load the sat delay file
-	 *
-	 * @param filename  The sat delay file name
-	 * @return true on success, false otherwise
-	 */
-	bool load(std::string filename);
-
 public:
 	/**
 	 * @brief Build a File
@@ -0,0 +1,317 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file BlockSatCarrierTerminals.cpp
+ * @brief Satellite carrier emulation shared by the terminals of a
+ *        multi-terminal entity
+ * @author Viveris Technologies
+ */
+
+
+#include "BlockSatCarrierTerminals.h"
+
+#include <algorithm>
+#include <sstream>
+
+#include <opensand_rt/MessageEvent.h>
+#include <opensand_rt/NetSocketEvent.h>
+#include <opensand_output/Output.h>
+
+#include "Logon.h"
+#include "OpenSandFrames.h"
+#include "OpenSandCore.h"
+
+
+Rt::UpwardChannel<BlockSatCarrierTerminals>::UpwardChannel(const std::string &name,
+                                                           sc_terminals_specific specific):
+	Channels::UpwardDemux<UpwardChannel<BlockSatCarrierTerminals>, tal_id_t>{name},
+	ip_addr{specific.ip_addr},
+	terminals_by_spot{},
+	in_channel_sets{}
+{
+	auto Conf = OpenSandModelConf::Get();
+	for(tal_id_t tal_id: specific.tal_ids)
+	{
+		tal_id_t gw_id;
+		if(Conf->getGwWithTalId(tal_id, gw_id))
+		{
+			this->terminals_by_spot[gw_id].push_back(tal_id);
+		}
+	}
+}
+
+
+Rt::DownwardChannel<BlockSatCarrierTerminals>::DownwardChannel(const std::string &name,
+                                                               sc_terminals_specific specific):
+	Channels::DownwardMux<DownwardChannel<BlockSatCarrierTerminals>>{name},
+	ip_addr{specific.ip_addr},
+	tal_ids{specific.tal_ids},
+	out_channel_sets{},
+	set_by_carrier{}
+{
+}
+
+
+bool Rt::DownwardChannel<BlockSatCarrierTerminals>::onEvent(const Event& event)
+{
+	LOG(this->log_receive, LEVEL_ERROR,
+	    "unknown event received %s",
+	    event.getName().c_str());
+	return false;
+}
+
+
+bool Rt::DownwardChannel<BlockSatCarrierTerminals>::onEvent(const MessageEvent& event)
+{
+	Rt::Ptr<DvbFrame> dvb_frame = event.getMessage<DvbFrame>();
+
+	LOG(this->log_receive, LEVEL_DEBUG,
+	    "%u-bytes %s message event received\n",
+	    dvb_frame->getMessageLength(),
+	    event.getName().c_str());
+
+	auto set = this->set_by_carrier.find(dvb_frame->getCarrierId());
+	if(set == this->set_by_carrier.end() ||
+	   !this->out_channel_sets[set->second].send(dvb_frame->getCarrierId(),
+	                                             dvb_frame->getRawData(),
+	                                             dvb_frame->getTotalLength()))
+	{
+		LOG(this->log_receive, LEVEL_ERROR,
+		    "error when sending data on carrier %u\n",
+		    dvb_frame->getCarrierId());
+	}
+	return true;
+}
+
+
+bool Rt::UpwardChannel<BlockSatCarrierTerminals>::onEvent(const Event &event)
+{
+	LOG(this->log_receive, LEVEL_ERROR,
+	    "unknown event received %s\n",
+	    event.getName().c_str());
+	return false;
+}
+
+
+bool Rt::UpwardChannel<BlockSatCarrierTerminals>::onEvent(const NetSocketEvent &event)
+{
+	LOG(this->log_receive, LEVEL_DEBUG, "FD event received\n");
+
+	for(auto &&in_channel_set: this->in_channel_sets)
+	{
+		if(in_channel_set.getNbChannel() == 0 ||
+		   std::none_of(in_channel_set.begin(), in_channel_set.end(),
+		                [&event](const std::unique_ptr<UdpChannel> &channel)
+		                { return event == channel->getChannelFd(); }))
+		{
+			continue;
+		}
+
+		// for UDP we need to retrieve potentially desynchronized
+		// datagrams => loop on receive function
+		UdpChannel::ReceiveStatus ret;
+		do
+		{
+			// Data to read in Sat_Carrier socket buffer
+			spot_id_t spot_id;
+			unsigned int carrier_id;
+			Ptr<Data> buf = make_ptr<Data>(nullptr);
+			ret = in_channel_set.receive(event, carrier_id, spot_id, buf);
+			if(ret == UdpChannel::ERROR)
+			{
+				LOG(this->log_receive, LEVEL_ERROR,
+				    "failed to receive data on any "
+				    "input channel (code = %d)\n",
+				    ret);
+				return false;
+			}
+			else if(buf)
+			{
+				LOG(this->log_receive, LEVEL_DEBUG,
+				    "%zu bytes of data received on carrier ID %u\n",
+				    buf->length(), carrier_id);
+
+				if(buf->length() > 0)
+				{
+					this->onReceivePktFromCarrier(carrier_id, spot_id, std::move(buf));
+				}
+			}
+		} while(ret == UdpChannel::STACKED);
+		return true;
+	}
+
+	LOG(this->log_receive, LEVEL_ERROR,
+	    "no input channel for fd %d\n", event.getFd());
+	return false;
+}
+
+
+bool Rt::UpwardChannel<BlockSatCarrierTerminals>::onInit()
+{
+	// initialize the channels of each spot from the configuration file,
+	// on behalf of the first terminal of the spot
+	this->in_channel_sets.reserve(this->terminals_by_spot.size());
+	for(auto &&[spot_id, tal_ids]: this->terminals_by_spot)
+	{
+		this->in_channel_sets.emplace_back(tal_ids.front());
+		sat_carrier_channel_set &in_channel_set = this->in_channel_sets.back();
+		if(!in_channel_set.readInConfig(this->ip_addr, Component::unknown, spot_id))
+		{
+			LOG(this->log_init, LEVEL_ERROR,
+			    "Wrong channel set configuration for spot %u\n",
+			    spot_id);
+			return false;
+		}
+
+		// ask the runtime to manage channel file descriptors
+		// (only for channels that accept input)
+		for(auto &&channel : in_channel_set)
+		{
+			if(channel->isInputOk() && channel->getChannelFd() != -1)
+			{
+				std::ostringstream name;
+
+				LOG(this->log_init, LEVEL_NOTICE,
+				    "Listen on fd %d for channel %d\n",
+				    channel->getChannelFd(),
+				    channel->getChannelID());
+				name << "Channel_" << channel->getChannelID();
+				this->addNetSocketEvent(name.str(),
+				                        channel->getChannelFd(),
+				                        MSG_BBFRAME_SIZE_MAX + 1); // consider byte used for sequencing
+			}
+		}
+	}
+	return true;
+}
+
+
+bool Rt::DownwardChannel<BlockSatCarrierTerminals>::onInit()
+{
+	auto Conf = OpenSandModelConf::Get();
+
+	// initialize the channels of each spot from the configuration file,
+	// on behalf of the first terminal of the spot
+	std::map<tal_id_t, tal_id_t> first_tal_by_gw;
+	for(tal_id_t tal_id: this->tal_ids)
+	{
+		tal_id_t gw_id;
+		if(!Conf->getGwWithTalId(tal_id, gw_id))
+		{
+			LOG(this->log_init, LEVEL_ERROR,
+			    "couldn't find gateway for tal %d\n",
+			    tal_id);
+			return false;
+		}
+		first_tal_by_gw.emplace(gw_id, tal_id);
+	}
+
+	this->out_channel_sets.reserve(first_tal_by_gw.size());
+	for(auto &&[gw_id, tal_id]: first_tal_by_gw)
+	{
+		this->out_channel_sets.emplace_back(tal_id);
+		sat_carrier_channel_set &out_channel_set = this->out_channel_sets.back();
+		if(!out_channel_set.readOutConfig(this->ip_addr, Component::unknown, gw_id))
+		{
+			LOG(this->log_init, LEVEL_ERROR,
+			    "Wrong channel set configuration for spot %u\n",
+			    gw_id);
+			return false;
+		}
+
+		// carrier IDs are unique among spots
+		for(auto &&channel : out_channel_set)
+		{
+			this->set_by_carrier[channel->getChannelID()] = this->out_channel_sets.size() - 1;
+		}
+	}
+	return true;
+}
+
+
+void Rt::UpwardChannel<BlockSatCarrierTerminals>::onReceivePktFromCarrier(uint8_t carrier_id,
+                                                                          spot_id_t spot_id,
+                                                                          Ptr<Data> data)
+{
+	auto terminals = this->terminals_by_spot.find(spot_id);
+	if(terminals == this->terminals_by_spot.end())
+	{
+		LOG(this->log_receive, LEVEL_ERROR,
+		    "frame received from carrier %u for unknown spot %u\n",
+		    carrier_id, spot_id);
+		return;
+	}
+
+	Ptr<DvbFrame> dvb_frame = make_ptr<DvbFrame>(*data);
+	dvb_frame->setCarrierId(carrier_id);
+	dvb_frame->setSpot(spot_id);
+
+	if(dvb_frame->getMessageType() == EmulatedMessageType::SessionLogonResp)
+	{
+		// only the terminal that logged on is interested
+		tal_id_t tal_id = dvb_frame_upcast<LogonResponse>(*dvb_frame).getMac();
+		const std::vector<tal_id_t> &tal_ids = terminals->second;
+		if(std::find(tal_ids.begin(), tal_ids.end(), tal_id) != tal_ids.end())
+		{
+			this->sendToTerminal(tal_id, std::move(dvb_frame));
+		}
+		return;
+	}
+
+	// the other forward frames are broadcast on the spot: each terminal
+	// gets its own copy as its stack may modify it
+	const std::vector<tal_id_t> &tal_ids = terminals->second;
+	for(std::size_t i = 0; i + 1 < tal_ids.size(); ++i)
+	{
+		Ptr<DvbFrame> copy = make_ptr<DvbFrame>(*data);
+		copy->setCarrierId(carrier_id);
+		copy->setSpot(spot_id);
+		this->sendToTerminal(tal_ids[i], std::move(copy));
+	}
+	this->sendToTerminal(tal_ids.back(), std::move(dvb_frame));
+}
+
+
+void Rt::UpwardChannel<BlockSatCarrierTerminals>::sendToTerminal(tal_id_t tal_id,
+                                                                 Ptr<DvbFrame> dvb_frame)
+{
+	uint8_t carrier_id = dvb_frame->getCarrierId();
+	if (!this->enqueueMessage(tal_id, std::move(dvb_frame), to_underlying(InternalMessageType::unknown)))
+	{
+		LOG(this->log_receive, LEVEL_ERROR,
+		    "failed to send frame from carrier %u to terminal %u\n",
+		    carrier_id, tal_id);
+	}
+	else
+	{
+		LOG(this->log_receive, LEVEL_DEBUG,
+		    "Message from carrier %u sent to terminal %u\n",
+		    carrier_id, tal_id);
+	}
+}
@@ -0,0 +1,138 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file BlockSatCarrierTerminals.h
+ * @brief Satellite carrier emulation shared by the terminals of a
+ *        multi-terminal entity
+ * @author Viveris Technologies
+ */
+
+#ifndef BlockSatCarrierTerminals_H
+#define BlockSatCarrierTerminals_H
+
+
+#include <map>
+#include <vector>
+
+#include <opensand_rt/Block.h>
+#include <opensand_rt/RtChannelMux.h>
+#include <opensand_rt/RtChannelDemux.h>
+
+#include "sat_carrier_channel_set.h"
+#include "DvbFrame.h"
+
+
+struct sc_terminals_specific
+{
+	std::string ip_addr;            ///< the IP address for emulation
+	std::vector<tal_id_t> tal_ids;  ///< the terminals sharing the carriers
+};
+
+
+template<>
+class Rt::UpwardChannel<class BlockSatCarrierTerminals>: public Channels::UpwardDemux<UpwardChannel<BlockSatCarrierTerminals>, tal_id_t>
+{
+ public:
+	UpwardChannel(const std::string &name, sc_terminals_specific specific);
+
+	bool onInit() override;
+
+	using ChannelBase::onEvent;
+	bool onEvent(const Event &event) override;
+	bool onEvent(const NetSocketEvent &event) override;
+
+ private:
+	/**
+	 * @brief Handle a packet received from carrier: logon responses
+	 *        are sent to their terminal, other frames to all the
+	 *        terminals of the spot
+	 *
+	 * @param carrier_id  The carrier of the packet
+	 * @param spot_id     The spot of the packet
+	 * @param data        The data read on socket
+	 */
+	void onReceivePktFromCarrier(uint8_t carrier_id,
+	                             spot_id_t spot_id,
+	                             Ptr<Data> data);
+
+	/**
+	 * @brief Send a frame to the upper block of a terminal
+	 *
+	 * @param tal_id     The terminal
+	 * @param dvb_frame  The frame
+	 */
+	void sendToTerminal(tal_id_t tal_id, Ptr<DvbFrame> dvb_frame);
+
+	/// the IP address for emulation newtork
+	std::string ip_addr;
+	/// the terminals by spot, the first one gives the spot channels
+	std::map<spot_id_t, std::vector<tal_id_t>> terminals_by_spot;
+	/// List of input channels, one set per spot
+	std::vector<sat_carrier_channel_set> in_channel_sets;
+};
+
+
+template<>
+class Rt::DownwardChannel<class BlockSatCarrierTerminals>: public Channels::DownwardMux<DownwardChannel<BlockSatCarrierTerminals>>
+{
+ public:
+	DownwardChannel(const std::string &name, sc_terminals_specific specific);
+
+	bool onInit() override;
+
+	using ChannelBase::onEvent;
+	bool onEvent(const Event &event) override;
+	bool onEvent(const MessageEvent &event) override;
+
+ private:
+	/// the IP address for emulation newtork
+	std::string ip_addr;
+	/// the terminals sharing the carriers
+	std::vector<tal_id_t> tal_ids;
+	/// List of output channels, one set per spot
+	std::vector<sat_carrier_channel_set> out_channel_sets;
+	/// the output channels set of each carrier
+	std::map<uint8_t, std::size_t> set_by_carrier;
+};
+
+
+/**
+ * @class BlockSatCarrierTerminals
+ * @brief Satellite carrier emulation for several terminals: the
+ *        carriers of each spot are opened once and shared by the
+ *        terminals connected to it
+ */
+class BlockSatCarrierTerminals: public Rt::Block<BlockSatCarrierTerminals, sc_terminals_specific>
+{
+ public:
+	using Rt::Block<BlockSatCarrierTerminals, sc_terminals_specific>::Block;
+};
+
+
+#endif
@@ -38,19 +38,23 @@
 
 
 #include <iostream>
+#include <sstream>
 #include <vector>
 #include <map>
 #include <unistd.h>
 
 #include "Entity.h"
+#include "BlockTrafficGenerator.h"
 #include "EntityGw.h"
 #include "EntityGwNetAcc.h"
 #include "EntityGwPhy.h"
 #include "EntitySat.h"
 #include "EntitySat.h"
 #include "EntitySt.h"
+#include "EntityStMulti.h"
 #include "NetBurst.h"
 #include "OpenSandModelConf.h"
+#include "Plugin.h"
 
 #include <opensand_output/Output.h>
 #include <opensand_output/OutputEvent.h>
@@ -65,7 +69,8 @@
 
 void usage(std::ostream &stream, const std::string &progname)
 {
-	stream << progname << " [-h] [-v] [-V] -i infrastructure_path -t topology_path [-p profile_path]" << std::endl;
+	stream << progname << " [-h] [-v] [-V] [-n] -i infrastructure_path -t topology_path [-p profile_path]"
+	                      " [-m stack_kb] [-a thread_settings]... [-b traffic]" << std::endl;
 	stream << "\t-h                         print this message and exit" << std::endl;
 	stream << "\t-V                         print version and exit" << std::endl;
 	stream << "\t-c							check: perform some basic checks on the configuration files and" << std::endl;
@@ -75,6 +80,111 @@ void usage(std::ostream &stream, const std::string &progname)
 	stream << "\t-i <infrastructure_path>   path to the XML file describing the network infrastructure of the platform" << std::endl;
 	stream << "\t-t <topology_path>         path to the XML file describing the satcom topology of the platform" << std::endl;
 	stream << "\t-p <profile_path>          path to the XML file selecting options for this specific entity" << std::endl;
+	stream << "\t-n                         do not use the binary snapshots of the XML files (<file>.snapshot)," << std::endl;
+	stream << "\t                           by default they are read when up to date and written otherwise" << std::endl;
+	stream << "\t-m <stack_kb>              lock the process memory and prefault stack_kb kB of stack per thread" << std::endl;
+	stream << "\t-a <thread_settings>       place and schedule a channel thread, overriding the infrastructure file:" << std::endl;
+	stream << "\t                           <block>[.up|.down]=<cpus>[:<other|fifo|rr>[:<priority>]][@<executor>]" << std::endl;
+	stream << "\t                           e.g. Dvb.down=2:fifo:50 (without channel, both channels are set)" << std::endl;
+	stream << "\t                           block names may contain dots, e.g. Sat_Carrier.GW1.up=3" << std::endl;
+	stream << "\t                           @<executor> runs the channel on a shared executor thread, placed with" << std::endl;
+	stream << "\t                           <executor>.exec=<cpus>[:<other|fifo|rr>[:<priority>]]" << std::endl;
+	stream << "\t-b <traffic>               benchmark the data plane: replace the TAP interface with generated frames" << std::endl;
+	stream << "\t                           sent to the gateway (terminal) or the terminals (gateway), report the rates," << std::endl;
+	stream << "\t                           latencies and CPU time per block then exit:" << std::endl;
+	stream << "\t                           rate=<frames/s>,sizes=<bytes>[:<weight>][/...],warmup=<s>,duration=<s>,report=<file>" << std::endl;
+	stream << "\t                           e.g. rate=10000,sizes=64:7/576:4/1514:1,duration=10" << std::endl;
+}
+
+
+/**
+ * @brief Parse a channel thread settings given on the command line
+ *
+ * @param option    The option value
+ *                  <block>[.up|.down|.exec]=<cpus>[:<policy>[:<priority>]][@<executor>]
+ *                  where the block name may itself contain dots (Sat_Carrier.GW1)
+ * @param channels  OUT: the channels threads to set
+ * @return true on success, false otherwise
+ */
+static bool parseThreadOption(const std::string &option,
+                              std::vector<OpenSandModelConf::channel_thread> &channels)
+{
+	std::size_t equal = option.find('=');
+	if(equal == std::string::npos)
+	{
+		return false;
+	}
+
+	std::string block = option.substr(0, equal);
+	std::vector<std::string> channel_types{"Upward", "Downward"};
+	std::size_t dot = block.rfind('.');
+	if(dot != std::string::npos)
+	{
+		// any other suffix is part of the block name (e.g. Sat_Carrier.GW1)
+		std::string direction = block.substr(dot + 1);
+		if(direction == "up")
+		{
+			channel_types = {"Upward"};
+			block.resize(dot);
+		}
+		else if(direction == "down")
+		{
+			channel_types = {"Downward"};
+			block.resize(dot);
+		}
+		else if(direction == "exec")
+		{
+			channel_types = {"Executor"};
+			block.resize(dot);
+		}
+	}
+	if(block.empty())
+	{
+		return false;
+	}
+
+	Rt::ThreadSettings settings;
+	std::string value = option.substr(equal + 1);
+	std::size_t at = value.find('@');
+	if(at != std::string::npos)
+	{
+		settings.executor = value.substr(at + 1);
+		if(settings.executor.empty() || channel_types.front() == "Executor")
+		{
+			return false;
+		}
+		value.resize(at);
+	}
+	std::istringstream fields{value};
+	std::string field;
+	if(!std::getline(fields, field, ':') ||
+	   (!field.empty() && !Rt::parseCpuList(field, settings.cpus)))
+	{
+		return false;
+	}
+	if(std::getline(fields, field, ':') &&
+	   !Rt::parseSchedulingPolicy(field, settings.policy))
+	{
+		return false;
+	}
+	if(std::getline(fields, field, ':'))
+	{
+		std::istringstream priority{field};
+		if(!(priority >> settings.priority) || !priority.eof())
+		{
+			return false;
+		}
+	}
+	if(std::getline(fields, field, ':'))
+	{
+		return false;
+	}
+
+	for(auto &&channel_type: channel_types)
+	{
+		channels.push_back({block, channel_type, settings});
+	}
+	return true;
 }
 
 
@@ -112,14 +222,53 @@ std::shared_ptr<Entity> Entity::parseArguments(int argc, char **argv, int &retur
 	std::string infrastructure_path;
 	std::string topology_path;
 	std::string profile_path;
+	bool lock_memory = false;
+	unsigned int stack_prefault_kb = 0;
+	std::vector<OpenSandModelConf::channel_thread> channel_threads;
+	std::shared_ptr<TrafficProfile> traffic;
 	
 	auto output = Output::Get();
 
 	return_code = 0;
-	while((opt = getopt(argc, argv, "-hVvci:t:p:g:")) != EOF)
+	while((opt = getopt(argc, argv, "-hVvcni:t:p:g:m:a:b:")) != EOF)
 	{
 		switch(opt)
 		{
+		case 'm':
+			{
+				std::istringstream stack_kb{optarg};
+				if(!(stack_kb >> stack_prefault_kb) || !stack_kb.eof())
+				{
+					usage(std::cerr, progname);
+					std::cerr << "\n" << progname << ": error: invalid stack size '" << optarg << "'." << std::endl;
+					return_code = 4;
+					return nullptr;
+				}
+				lock_memory = true;
+			}
+			break;
+		case 'a':
+			if(!parseThreadOption(optarg, channel_threads))
+			{
+				usage(std::cerr, progname);
+				std::cerr << "\n" << progname << ": error: invalid thread settings '" << optarg << "'." << std::endl;
+				return_code = 5;
+				return nullptr;
+			}
+			break;
+		case 'b':
+			{
+				traffic = std::make_shared<TrafficProfile>();
+				std::string error;
+				if(!TrafficProfile::parse(optarg, *traffic, error))
+				{
+					usage(std::cerr, progname);
+					std::cerr << "\n" << progname << ": error: invalid traffic '" << optarg << "': " << error << "." << std::endl;
+					return_code = 6;
+					return nullptr;
+				}
+			}
+			break;
 		case 'i':
 			infrastructure_path = optarg;
 			break;
@@ -132,6 +281,9 @@ std::shared_ptr<Entity> Entity::parseArguments(int argc, char **argv, int &retur
 		case 'c':
 			check_mode = true;
 			break;
+		case 'n':
+			OpenSandModelConf::Get()->setSnapshotsEnabled(false);
+			break;
 		case 'v':
 			// Configure terminal output before constructing Conf to see Conf logs
 			output->configureTerminalOutput();
@@ -140,6 +292,8 @@ std::shared_ptr<Entity> Entity::parseArguments(int argc, char **argv, int &retur
 			{
 				// TODO: Error handling
 				std::string folder = optarg;
+				// every plugin contributes to the generated XSD
+				Plugin::loadAllPlugins();
 				auto Conf = OpenSandModelConf::Get();
 				Conf->createModels();
 				Conf->writeTopologyModel(folder + "/topology.xsd");
@@ -157,7 +311,8 @@ std::shared_ptr<Entity> Entity::parseArguments(int argc, char **argv, int &retur
 																  "Gateway Net Access",
 																  "Gateway Phy",
 																  "Satellite",
-																  "Terminal"});
+																  "Terminal",
+																  "Terminals"});
 				types->addEnumType("upload", "Upload Method", {"File System", "SCP", "SFTP"});
 				types->addEnumType("run", "Run Method", {"LAUNCH", "STATUS", "PING", "STOP"});
 
@@ -247,6 +402,19 @@ std::shared_ptr<Entity> Entity::parseArguments(int argc, char **argv, int &retur
 		return nullptr;
 	}
 
+	// only open the plugins the configuration refers to
+	std::vector<std::string> configuration_files{infrastructure_path, topology_path};
+	if(!profile_path.empty())
+	{
+		configuration_files.push_back(profile_path);
+	}
+	if(!Plugin::loadReferencedPlugins(configuration_files))
+	{
+		std::cerr << progname << ": error: unable to load plugins" << std::endl;
+		return_code = 100;
+		return nullptr;
+	}
+
 	Conf->createModels();
 	if(!Conf->readInfrastructure(infrastructure_path))
 	{
@@ -266,6 +434,35 @@ std::shared_ptr<Entity> Entity::parseArguments(int argc, char **argv, int &retur
 	}
 	output->setLevels(levels);
 
+	// the command line settings take precedence over the infrastructure ones
+	bool infrastructure_lock_memory;
+	unsigned int infrastructure_stack_prefault_kb;
+	std::vector<OpenSandModelConf::channel_thread> infrastructure_threads;
+	if(!Conf->getThreadsSettings(infrastructure_lock_memory,
+	                             infrastructure_stack_prefault_kb,
+	                             infrastructure_threads))
+	{
+		std::cerr << progname << ": error: unable to load the threads settings" << std::endl;
+		return_code = 16;
+		return nullptr;
+	}
+	if(!lock_memory && infrastructure_lock_memory)
+	{
+		lock_memory = true;
+		stack_prefault_kb = infrastructure_stack_prefault_kb;
+	}
+	if(lock_memory)
+	{
+		Rt::Rt::setMemoryLock(stack_prefault_kb * 1024);
+	}
+	channel_threads.insert(channel_threads.begin(),
+	                       infrastructure_threads.begin(),
+	                       infrastructure_threads.end());
+	for(auto &&thread: channel_threads)
+	{
+		Rt::Rt::setThreadSettings(thread.block, thread.channel_type, thread.settings);
+	}
+
 	std::string type;
 	tal_id_t entity_id;
 	if(!Conf->getComponentType(type, entity_id))
@@ -304,6 +501,10 @@ std::shared_ptr<Entity> Entity::parseArguments(int argc, char **argv, int &retur
 	{
 		entity = std::make_shared<EntitySt>(entity_id, check_mode);
 	}
+	else if(type == "st_multi")
+	{
+		entity = std::make_shared<EntityStMulti>(entity_id, check_mode);
+	}
 	else
 	{
 		std::cerr << progname << ": error: infrastructure file defines an entity that is not handled by this program." << std::endl;
@@ -311,6 +512,18 @@ std::shared_ptr<Entity> Entity::parseArguments(int argc, char **argv, int &retur
 		return nullptr;
 	}
 
+	if(traffic)
+	{
+		if(type != "st" && type != "gw" && type != "gw_net_acc")
+		{
+			std::cerr << progname << ": error: the data plane benchmark needs a terminal or a gateway "
+			             "with a single TAP interface." << std::endl;
+			return_code = 17;
+			return nullptr;
+		}
+		entity->traffic = traffic;
+	}
+
 	bool enabled = false;
 	output->setEntityName(entity->getName());
 
@@ -43,6 +43,7 @@
 
 
 class OutputEvent;
+struct TrafficProfile;
 
 
 /**
@@ -130,6 +131,9 @@ protected:
 	const tal_id_t instance_id;
 	const bool check_mode;
 
+	/// the synthetic traffic replacing the TAP interface in benchmark mode
+	std::shared_ptr<TrafficProfile> traffic;
+
 	std::shared_ptr<OutputEvent> status;
 };
 
@@ -64,6 +64,7 @@
 
 #include "BlockInterconnect.h"
 #include "BlockLanAdaptation.h"
+#include "BlockTrafficGenerator.h"
 #include "BlockDvbNcc.h"
 #include "SpotUpward.h"
 #include "SpotDownward.h"
@@ -100,6 +101,8 @@ bool EntityGwNetAcc::createSpecificBlocks()
 
 		la_specific spec_la;
 		spec_la.tap_iface = this->tap_iface;
+		// the benchmark traffic generator takes the place of the TAP interface
+		spec_la.tap_dispatched = this->traffic != nullptr;
 		spec_la.packet_switch = std::make_shared<GatewayPacketSwitch>(this->instance_id);
 		spec_la.packet_switch = isRegen ? std::make_shared<RegenGatewayPacketSwitch>(this->instance_id) : std::make_shared<GatewayPacketSwitch>(this->instance_id);
 
@@ -119,6 +122,15 @@ bool EntityGwNetAcc::createSpecificBlocks()
 
 		Rt::Rt::connectBlocks(block_lan_adaptation, block_dvb);
 		Rt::Rt::connectBlocks(block_dvb, block_interconnect);
+
+		if(this->traffic)
+		{
+			traffic_specific traffic_spec;
+			traffic_spec.tal_id = this->instance_id;
+			traffic_spec.profile = this->traffic;
+			auto& block_traffic = Rt::Rt::createBlock<BlockTrafficGenerator>("Traffic", traffic_spec);
+			Rt::Rt::connectBlocks(block_traffic, block_lan_adaptation);
+		}
 	}
 	catch (const std::bad_alloc &e)
 	{
@@ -64,6 +64,7 @@
 #include "OpenSandModelConf.h"
 
 #include "BlockLanAdaptation.h"
+#include "BlockTrafficGenerator.h"
 #include "BlockDvbTal.h"
 #include "BlockSatCarrier.h"
 #include "BlockPhysicalLayer.h"
@@ -90,6 +91,8 @@ bool EntitySt::createSpecificBlocks()
 	 	Conf->getGwWithTalId(this->instance_id, gw_id);
 		la_specific laspecific;
 		laspecific.tap_iface = this->tap_iface;
+		// the benchmark traffic generator takes the place of the TAP interface
+		laspecific.tap_dispatched = this->traffic != nullptr;
 		laspecific.packet_switch = std::make_shared<TerminalPacketSwitch>(this->instance_id, gw_id);
 
 		dvb_specific dvb_spec;
@@ -118,6 +121,15 @@ bool EntitySt::createSpecificBlocks()
 		Rt::Rt::connectBlocks(block_lan_adaptation, block_dvb);
 		Rt::Rt::connectBlocks(block_dvb, block_phy_layer);
 		Rt::Rt::connectBlocks(block_phy_layer, block_sat_carrier);
+
+		if(this->traffic)
+		{
+			traffic_specific traffic_spec;
+			traffic_spec.tal_id = this->instance_id;
+			traffic_spec.profile = this->traffic;
+			auto& block_traffic = Rt::Rt::createBlock<BlockTrafficGenerator>("Traffic", traffic_spec);
+			Rt::Rt::connectBlocks(block_traffic, block_lan_adaptation);
+		}
 	}
 	catch (const std::bad_alloc &e)
 	{
@@ -0,0 +1,219 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file EntityStMulti.cpp
+ * @brief Entity process emulating several satellite terminals
+ * @author Viveris Technologies
+ *
+ * Each terminal gets its own Lan Adaptation, Dvb Tal and Physical Layer
+ * blocks, their channels run on a pool of shared executors; the
+ * satellite carriers of a spot are opened once for all its terminals:
+ *
+ * <pre>
+ *
+ *           eth nic 1 (one TAP per terminal, or shared)
+ *                         |
+ *                  [Tap Dispatcher]
+ *                 /       |        \
+ *       Lan Adaptation   ...   Lan Adaptation
+ *             |                      |
+ *          Dvb Tal       ...      Dvb Tal
+ *             |                      |
+ *       Physical Layer   ...   Physical Layer
+ *                 \       |        /
+ *                  Sat Carrier Terminals
+ *                         |
+ *                     eth nic 2
+ *
+ * </pre>
+ *
+ */
+
+
+#include <opensand_rt/Rt.h>
+#include <opensand_output/Output.h>
+
+#include "EntityStMulti.h"
+
+#include "BlockLanAdaptation.h"
+#include "BlockTapDispatcher.h"
+#include "BlockDvbTal.h"
+#include "BlockSatCarrierTerminals.h"
+#include "BlockPhysicalLayer.h"
+#include "DvbS2Std.h"
+#include "PacketSwitch.h"
+
+
+EntityStMulti::EntityStMulti(tal_id_t instance_id, bool check_mode):
+	Entity("terminals" + std::to_string(instance_id), instance_id, check_mode)
+{
+}
+
+EntityStMulti::~EntityStMulti()
+{
+}
+
+bool EntityStMulti::createSpecificBlocks()
+{
+	try
+	{
+		auto Conf = OpenSandModelConf::Get();
+		auto Out = Output::Get();
+
+		BlockTapDispatcher *block_tap_dispatcher = nullptr;
+		if(this->terminals.tap_sharing != TapSharing::PerTerminal)
+		{
+			tap_dispatcher_specific tap_spec;
+			tap_spec.tap_iface = this->tap_iface;
+			tap_spec.tap_sharing = this->terminals.tap_sharing;
+			tap_spec.vlan_base = this->terminals.vlan_base;
+			tap_spec.tal_ids = this->terminals.tal_ids;
+			block_tap_dispatcher = &Rt::Rt::createBlock<BlockTapDispatcher>("Tap_Dispatcher", tap_spec);
+		}
+
+		sc_terminals_specific scspecific;
+		scspecific.ip_addr = this->ip_address;
+		scspecific.tal_ids = this->terminals.tal_ids;
+		auto& block_sat_carrier = Rt::Rt::createBlock<BlockSatCarrierTerminals>("Sat_Carrier", scspecific);
+
+		for(std::size_t index = 0; index < this->terminals.tal_ids.size(); ++index)
+		{
+			tal_id_t tal_id = this->terminals.tal_ids[index];
+			tal_id_t gw_id;
+			if(!Conf->getGwWithTalId(tal_id, gw_id))
+			{
+				DFLTLOG(LEVEL_CRITICAL, "%s: terminal %u is not connected to any gateway",
+				        this->getName().c_str(), tal_id);
+				return false;
+			}
+
+			la_specific laspecific;
+			laspecific.packet_switch = std::make_shared<TerminalPacketSwitch>(tal_id, gw_id);
+			if(block_tap_dispatcher == nullptr)
+			{
+				laspecific.tap_iface = this->tap_iface + std::to_string(tal_id);
+			}
+			else
+			{
+				laspecific.tap_iface = this->tap_iface;
+				laspecific.tap_dispatched = true;
+			}
+
+			dvb_specific dvb_spec;
+			dvb_spec.disable_control_plane = false;
+			dvb_spec.disable_acm_loop = false;
+			dvb_spec.mac_id = tal_id;
+			dvb_spec.spot_id = gw_id;
+			dvb_spec.is_ground_entity = true;
+
+			PhyLayerConfig phy_config;
+			phy_config.mac_id = tal_id;
+			phy_config.spot_id = gw_id;
+			phy_config.entity_type = Component::terminal;
+
+			// the blocks of each terminal register their probes
+			// under the terminal name to keep them apart
+			std::string suffix = ".ST" + std::to_string(tal_id);
+			Out->setProbeScope("st" + std::to_string(tal_id));
+			auto& block_lan_adaptation = Rt::Rt::createBlock<BlockLanAdaptation>("Lan_Adaptation" + suffix, laspecific);
+			auto& block_dvb = Rt::Rt::createBlock<BlockDvbTal>("Dvb" + suffix, dvb_spec);
+			auto& block_phy_layer = Rt::Rt::createBlock<BlockPhysicalLayer>("Physical_Layer" + suffix, phy_config);
+			Out->setProbeScope("");
+
+			if(block_tap_dispatcher != nullptr)
+			{
+				Rt::Rt::connectBlocks(*block_tap_dispatcher, block_lan_adaptation, tal_id);
+			}
+			Rt::Rt::connectBlocks(block_lan_adaptation, block_dvb);
+			Rt::Rt::connectBlocks(block_dvb, block_phy_layer);
+			Rt::Rt::connectBlocks(block_phy_layer, block_sat_carrier, tal_id);
+
+			if(this->terminals.executors > 0)
+			{
+				std::string executor = "Terminals." + std::to_string(index % this->terminals.executors);
+				this->setExecutor("Lan_Adaptation" + suffix, executor);
+				this->setExecutor("Dvb" + suffix, executor);
+				this->setExecutor("Physical_Layer" + suffix, executor);
+			}
+		}
+	}
+	catch (const std::bad_alloc &e)
+	{
+		DFLTLOG(LEVEL_CRITICAL, "%s: error during block creation: could not allocate memory: %s",
+		        this->getName().c_str(), e.what());
+		return false;
+	}
+	return true;
+}
+
+void EntityStMulti::setExecutor(const std::string &block_name, const std::string &executor) const
+{
+	for(auto &&channel_type: {"Upward", "Downward"})
+	{
+		Rt::ThreadSettings settings = Rt::Rt::getThreadSettings(block_name, channel_type);
+		if(settings.executor.empty())
+		{
+			settings.executor = executor;
+			Rt::Rt::setThreadSettings(block_name, channel_type, settings);
+		}
+	}
+}
+
+bool EntityStMulti::loadConfiguration(const std::string &profile_path)
+{
+	this->defineProfileMetaModel();
+	auto Conf = OpenSandModelConf::Get();
+	if(!Conf->readProfile(profile_path))
+	{
+		return false;
+	}
+	return Conf->getGroundInfrastructure(this->ip_address, this->tap_iface) &&
+	       Conf->getTerminalsInfrastructure(this->terminals);
+}
+
+bool EntityStMulti::createSpecificConfiguration(const std::string &filepath) const
+{
+	auto Conf = OpenSandModelConf::Get();
+	Conf->createModels();
+	this->defineProfileMetaModel();
+	return Conf->writeProfileModel(filepath);
+}
+
+void EntityStMulti::defineProfileMetaModel() const
+{
+	auto Conf = OpenSandModelConf::Get();
+	auto types = Conf->getModelTypesDefinition();
+	auto ctrl_plane = Conf->getOrCreateComponent("control_plane", "Control plane", "Control plane configuration");
+	auto disable_ctrl_plane = ctrl_plane->addParameter("disable_control_plane", "Disable control plane", types->getType("bool"));
+
+	BlockLanAdaptation::generateConfiguration();
+	BlockDvb::generateConfiguration();
+	BlockDvbTal::generateConfiguration(disable_ctrl_plane);
+	BlockPhysicalLayer::generateConfiguration();
+}
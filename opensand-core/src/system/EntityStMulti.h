@@ -0,0 +1,110 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file EntityStMulti.h
+ * @brief Entity process emulating several satellite terminals
+ * @author Viveris Technologies
+ */
+
+#ifndef ENTITY_SATELLITE_TERMINALS_H
+#define ENTITY_SATELLITE_TERMINALS_H
+
+
+#include "Entity.h"
+#include "OpenSandModelConf.h"
+
+#include <string>
+
+
+/**
+ * @class EntityStMulti
+ * @brief Entity process emulating several satellite terminals, each
+ *        with its own stack of blocks, sharing the satellite carriers,
+ *        optionally the TAP interface, and a pool of executors
+ */
+class EntityStMulti: public Entity
+{
+public:
+	/**
+	 * Build an entity process emulating several satellite terminals
+	 *
+	 * @param instance_id  The ID of the first terminal
+	 * @param check_mode   Whether the entity only checks its configuration
+	 */
+	EntityStMulti(tal_id_t instance_id, bool check_mode);
+
+	/**
+	 * Destroy an entity process emulating several satellite terminals
+	 */
+	virtual ~EntityStMulti();
+
+protected:
+	/**
+	 * Load configuration files
+	 *
+	 * @param profile_path   The path to the entity configuration file
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool loadConfiguration(const std::string &profile_path);
+
+	/**
+	 * Create blocks of the specific entity process
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool createSpecificBlocks();
+
+	/**
+	 * Create configuration for the blocks of the specific entity process
+	 *
+	 * @param filepath   The path of the file to write the configuration into
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool createSpecificConfiguration(const std::string &filepath) const;
+
+private:
+	void defineProfileMetaModel() const;
+
+	/**
+	 * Run the channels of a terminal block on a shared executor,
+	 * unless the user placed them elsewhere
+	 *
+	 * @param block_name  The name of the block
+	 * @param executor    The name of the executor
+	 */
+	void setExecutor(const std::string &block_name, const std::string &executor) const;
+
+	std::string ip_address;
+	std::string tap_iface;
+	OpenSandModelConf::terminals_infrastructure terminals;
+};
+
+#endif
@@ -0,0 +1,63 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2020 TAS
+ * Copyright © 2020 CNES
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or FITNESS
+ * FOR A PARTICULAR PURPOSE. See the GNU General Public License for more
+ * details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file opensand_timeseries.cpp
+ * @brief Convert a text time series file (attenuation or delay) into
+ *        the binary format mapped by the file driven plugins
+ * @author Viveris Technologies
+ */
+
+
+#include <iostream>
+#include <opensand_output/Output.h>
+
+#include "TimeSeries.h"
+
+
+int main(int argc, char **argv)
+{
+	if(argc != 3)
+	{
+		std::cerr << "Usage: " << argv[0] << " <text_file> <binary_file>" << std::endl
+		          << std::endl
+		          << "Convert a text time series, with one \"<time> <value> [<value> ...]\"" << std::endl
+		          << "line per entry, into the binary format used by the File," << std::endl
+		          << "FileDelay and FileIslDelay plugins." << std::endl;
+		return 1;
+	}
+
+	auto log = Output::Get()->registerLog(LEVEL_WARNING, "TimeSeries");
+	Output::Get()->finalizeConfiguration();
+	if(!TimeSeries::convert(argv[1], argv[2], log))
+	{
+		std::cerr << argv[0] << ": error: unable to convert " << argv[1] << std::endl;
+		return 2;
+	}
+	return 0;
+}
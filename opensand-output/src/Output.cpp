@@ -555,6 +555,15 @@ std::shared_ptr<Output::OutputSection> Output::getOrCreateSection(const std::vec
 }
 
 
+std::string Output::scopedName(const std::string& identifier) const
+{
+	if (probeScope.empty()) {
+		return identifier;
+	}
+	return probeScope + "." + identifier;
+}
+
+
 void Output::registerProbe(const std::string& name, std::shared_ptr<BaseProbe> probe)
 {
 	if (privateLog != nullptr) {
@@ -576,7 +585,7 @@ void Output::registerProbe(const std::string& name, std::shared_ptr<BaseProbe> p
 template<>
 std::shared_ptr<Probe<int32_t>> Output::registerProbe(const std::string& identifier, const std::string& unit, bool enabled, sample_type_t type)
 {
-	std::string name = normalizeName(identifier);
+	std::string name = normalizeName(scopedName(identifier));
 
 	std::shared_ptr<Probe<int32_t>> probe{new Probe<int32_t>(name, unit, enabled, type)};
 	try {
@@ -592,7 +601,7 @@ std::shared_ptr<Probe<int32_t>> Output::registerProbe(const std::string& identif
 template<>
 std::shared_ptr<Probe<float>> Output::registerProbe(const std::string& identifier, const std::string& unit, bool enabled, sample_type_t type)
 {
-	std::string name = normalizeName(identifier);
+	std::string name = normalizeName(scopedName(identifier));
 
 	std::shared_ptr<Probe<float>> probe{new Probe<float>(name, unit, enabled, type)};
 	try {
@@ -608,7 +617,7 @@ std::shared_ptr<Probe<float>> Output::registerProbe(const std::string& identifie
 template<>
 std::shared_ptr<Probe<double>> Output::registerProbe(const std::string& identifier, const std::string& unit, bool enabled, sample_type_t type)
 {
-	std::string name = normalizeName(identifier);
+	std::string name = normalizeName(scopedName(identifier));
 
 	std::shared_ptr<Probe<double>> probe{new Probe<double>(name, unit, enabled, type)};
 	try {
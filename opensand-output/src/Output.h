@@ -120,6 +120,18 @@ class Output
 	*/
 	std::string getEntityName() const;
 
+	/**
+	* @brief Set a section prepended to the name of the probes registered
+	*        afterwards, to keep apart the probes of the entities emulated
+	*        by a single process; empty to register the probes as named
+	*/
+	inline void setProbeScope(const std::string& scope) { probeScope = scope; }
+
+	/**
+	* @brief Get the section prepended to the name of the registered probes
+	*/
+	inline const std::string &getProbeScope() const { return probeScope; }
+
 	/**
 	 * @brief Register a probe in the output library
 	 *
@@ -251,8 +263,10 @@ class Output
  private:
 	Output();
 	void registerProbe(const std::string& name, std::shared_ptr<BaseProbe> probe);
+	std::string scopedName(const std::string& identifier) const;
 
 	std::string entityName;
+	std::string probeScope;
 
 	class OutputSection;
 	std::shared_ptr<OutputSection> getOrCreateSection(const std::vector<std::string>& names);
@@ -361,17 +361,40 @@ bool Gse::encapNextPacket(Rt::Ptr<NetPacket> packet,
 							  Rt::Ptr<NetPacket> &encap_packet,
 							  Rt::Ptr<NetPacket> &remaining_data)
 {
-	bool contestExists = false;
+	// TODO buffer_encap should not exceed 4Ko + 2 o (check)
+	uint8_t buffer_encap[remaining_length];
+	std::size_t written = 0;
+	qos_t qos = packet->getQos();
+	tal_id_t src_tal_id = packet->getSrcTalId();
+	tal_id_t dst_tal_id = packet->getDstTalId();
+
+	if (!this->encapInto(std::move(packet), buffer_encap, remaining_length,
+						 new_burst, written, remaining_data))
+	{
+		return false;
+	}
+
+	encap_packet = Rt::make_ptr<NetPacket>(buffer_encap, written,
+										   this->getName(), this->getEtherType(),
+										   qos, src_tal_id, dst_tal_id, 0);
+	return true;
+}
 
-	size_t size_data_encap = remaining_length;
+bool Gse::encapInto(Rt::Ptr<NetPacket> packet,
+					uint8_t *dst,
+					std::size_t dst_length,
+					bool,
+					std::size_t &written,
+					Rt::Ptr<NetPacket> &remaining_data)
+{
+	bool contestExists = false;
 
-	// TODO buffer_encap should not exceed 4Ko + 2 o (check)
-	uint8_t buffer_encap[size_data_encap];
+	written = 0;
 	uint8_t frag_id = Gse::getFragId(*packet);
 	RustSlice payload = (RustSlice){.size = packet->getTotalLength(),
 									.bytes = packet->getRawData()};
-	RustMutSlice gse_pck = {.size = size_data_encap,
-							.bytes = buffer_encap};
+	RustMutSlice gse_pck = {.size = dst_length,
+							.bytes = dst};
 	GseIdentifier identifier{packet->getSrcTalId(),
 							 packet->getDstTalId(),
 							 packet->getQos()};
@@ -495,10 +518,7 @@ bool Gse::encapNextPacket(Rt::Ptr<NetPacket> packet,
 			remaining_data = nullptr;
 		}
 
-		encap_packet = Rt::make_ptr<NetPacket>(gse_pck.bytes, status_encap.value.completed_pkt,
-											   this->getName(), this->getEtherType(),
-											   packet->getQos(), packet->getSrcTalId(), packet->getDstTalId(), 0);
-
+		written = status_encap.value.completed_pkt;
 		return true;
 	}
 
@@ -510,9 +530,7 @@ bool Gse::encapNextPacket(Rt::Ptr<NetPacket> packet,
 			status_encap.value.fragmented_pkt.len_pkt, packet->getTotalLength(), status_encap.value.completed_pkt,
 			packet->getSrcTalId(), packet->getDstTalId(), packet->getQos(), packet->getType(), frag_id);
 
-		encap_packet = Rt::make_ptr<NetPacket>(gse_pck.bytes, status_encap.value.completed_pkt,
-											   this->getName(), this->getEtherType(),
-											   packet->getQos(), packet->getSrcTalId(), packet->getDstTalId(), 0);
+		written = status_encap.value.completed_pkt;
 
 		// save the context
 		this->contexts.emplace(identifier, status_encap.value.fragmented_pkt.context);
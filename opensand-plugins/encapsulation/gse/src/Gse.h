@@ -139,6 +139,17 @@ public:
 						 Rt::Ptr<NetPacket> &encap_packet,
 						 Rt::Ptr<NetPacket> &remaining_data) override;
 
+	/**
+	 * @brief Encapsulate the packet, the GSE header and payload being
+	 *        written by the encapsulator directly in the destination buffer
+	 */
+	bool encapInto(Rt::Ptr<NetPacket> packet,
+				   uint8_t *dst,
+				   std::size_t dst_length,
+				   bool new_burst,
+				   std::size_t &written,
+				   Rt::Ptr<NetPacket> &remaining_data) override;
+
 	bool setHeaderExtensions(Rt::Ptr<NetPacket> packet,
 							 Rt::Ptr<NetPacket> &new_packet,
 							 tal_id_t tal_id_src,
@@ -60,6 +60,7 @@ std::shared_ptr<Fifo> BlockBase::createFifo()
 
 BlockBase::BlockBase(const std::string &name):
 	name{name},
+	output_scope{Output::Get()->getProbeScope()},
 	initialized{false}
 {
 	// Output logs
@@ -90,45 +91,66 @@ void BlockBase::setInitialized()
 }
 
 
-bool BlockBase::start()
+bool BlockBase::start(const ThreadSettings &up_settings, const ThreadSettings &down_settings)
 {
 	//create upward thread
-	LOG(this->log_rt, LEVEL_INFO,
-	    "Block %s: start upward channel\n", this->name.c_str());
-	try
+	if(!up_settings.executor.empty())
 	{
-		this->up_thread = this->initUpwardThread();
+		LOG(this->log_rt, LEVEL_INFO,
+		    "Block %s: upward channel run by executor %s\n",
+		    this->name.c_str(), up_settings.executor.c_str());
 	}
-	catch (const std::system_error& e)
+	else
 	{
-		Rt::Rt::reportError(this->name, std::this_thread::get_id(), true,
-		                    "cannot start upward thread [%u: %s]", e.code(), e.what());
-		return false;
+		LOG(this->log_rt, LEVEL_INFO,
+		    "Block %s: start upward channel\n", this->name.c_str());
+		try
+		{
+			this->up_thread = this->initUpwardThread(up_settings);
+		}
+		catch (const std::system_error& e)
+		{
+			Rt::Rt::reportError(this->name, std::this_thread::get_id(), true,
+			                    "cannot start upward thread [%u: %s]", e.code(), e.what());
+			return false;
+		}
+		LOG(this->log_rt, LEVEL_INFO,
+		    "Block %s: upward channel thread id %lu\n",
+		    this->name.c_str(), this->up_thread.get_id());
 	}
-	LOG(this->log_rt, LEVEL_INFO,
-	    "Block %s: upward channel thread id %lu\n",
-	    this->name.c_str(), this->up_thread.get_id());
 
 	//create downward thread
-	LOG(this->log_rt, LEVEL_INFO,
-	    "Block %s: start downward channel\n", this->name.c_str());
-	try
+	if(!down_settings.executor.empty())
 	{
-		this->down_thread = this->initDownwardThread();
+		LOG(this->log_rt, LEVEL_INFO,
+		    "Block %s: downward channel run by executor %s\n",
+		    this->name.c_str(), down_settings.executor.c_str());
 	}
-	catch (const std::system_error& e)
+	else
 	{
-		Rt::Rt::reportError(this->name, std::this_thread::get_id(), true,
-		                    "cannot downward start thread [%u: %s]", e.code(), e.what());
-		// TODO: avoid cancel here and find a way to let
-		// the other thread terminate gracefully
-		pthread_cancel(this->up_thread.native_handle());
-		this->up_thread.join();
-		return false;
+		LOG(this->log_rt, LEVEL_INFO,
+		    "Block %s: start downward channel\n", this->name.c_str());
+		try
+		{
+			this->down_thread = this->initDownwardThread(down_settings);
+		}
+		catch (const std::system_error& e)
+		{
+			Rt::Rt::reportError(this->name, std::this_thread::get_id(), true,
+			                    "cannot downward start thread [%u: %s]", e.code(), e.what());
+			if(this->up_thread.joinable())
+			{
+				// TODO: avoid cancel here and find a way to let
+				// the other thread terminate gracefully
+				pthread_cancel(this->up_thread.native_handle());
+				this->up_thread.join();
+			}
+			return false;
+		}
+		LOG(this->log_rt, LEVEL_INFO,
+		    "Block %s: downward channel thread id: %lu\n",
+		    this->name.c_str(), this->down_thread.get_id());
 	}
-	LOG(this->log_rt, LEVEL_INFO,
-	    "Block %s: downward channel thread id: %lu\n",
-	    this->name.c_str(), this->down_thread.get_id());
 
 	return true;
 }
@@ -144,7 +166,11 @@ bool BlockBase::stop()
 	    "Block %s: join channels\n", this->name.c_str());
 	try
 	{
-		this->up_thread.join();
+		// the channels run by an executor have no thread
+		if(this->up_thread.joinable())
+		{
+			this->up_thread.join();
+		}
 	}
 	catch (const std::system_error& e)
 	{
@@ -155,7 +181,10 @@ bool BlockBase::stop()
 
 	try
 	{
-		this->down_thread.join();
+		if(this->down_thread.joinable())
+		{
+			this->down_thread.join();
+		}
 	}
 	catch (const std::system_error& e)
 	{
@@ -44,6 +44,7 @@
 
 #include "RtEvent.h"
 #include "TemplateHelper.h"
+#include "ThreadSettings.h"
 
 
 class OutputLog;
@@ -55,6 +56,7 @@ namespace Rt
 
 
 class Fifo;
+class ChannelBase;
 class Channel;
 class ChannelMux;
 template<typename Key> class ChannelDemux;
@@ -125,20 +127,37 @@ class BlockBase
 
 	/**
 	 * @brief Initialize upward thread
+	 *
+	 * @param settings  The placement and scheduling of the thread
 	 */
-	virtual std::thread initUpwardThread() = 0;
+	virtual std::thread initUpwardThread(const ThreadSettings &settings) = 0;
 
 	/**
 	 * @brief Initialize downward thread
+	 *
+	 * @param settings  The placement and scheduling of the thread
 	 */
-	virtual std::thread initDownwardThread() = 0;
+	virtual std::thread initDownwardThread(const ThreadSettings &settings) = 0;
 
 	/**
-	 * @brief start the channel threads
+	 * @brief Get the upward channel, to run it on a shared executor
+	 */
+	virtual ChannelBase &getUpwardChannel() = 0;
+
+	/**
+	 * @brief Get the downward channel, to run it on a shared executor
+	 */
+	virtual ChannelBase &getDownwardChannel() = 0;
+
+	/**
+	 * @brief start the channel threads, except for the channels
+	 *        run by a shared executor
 	 *
+	 * @param up_settings    The placement and scheduling of the upward thread
+	 * @param down_settings  The placement and scheduling of the downward thread
 	 * @return true on success, false otherwise
 	 */
-	bool start();
+	bool start(const ThreadSettings &up_settings, const ThreadSettings &down_settings);
 
 	/*
 	 * @brief Stop the channel threads and call block destructor
@@ -168,6 +187,10 @@ class BlockBase
 	/// The name of the block
 	const std::string name;
 
+	/// The probe scope of the output library when the block was created,
+	/// restored while the block initializes
+	const std::string output_scope;
+
  private:
 	/// The upward channel thread
 	std::thread up_thread;
@@ -309,8 +332,18 @@ class Block: public BlockBase
 		downward.setOppositeFifo(down_fifo, up_fifo);
 	};
 
-	std::thread initUpwardThread() override { return std::thread{&ChannelUpward::executeThread, &this->upward}; };
-	std::thread initDownwardThread() override { return std::thread{&ChannelDownward::executeThread, &this->downward}; };
+	std::thread initUpwardThread(const ThreadSettings &settings) override
+	{
+		this->upward.setThreadSettings(settings);
+		return std::thread{&ChannelUpward::executeThread, &this->upward};
+	};
+	std::thread initDownwardThread(const ThreadSettings &settings) override
+	{
+		this->downward.setThreadSettings(settings);
+		return std::thread{&ChannelDownward::executeThread, &this->downward};
+	};
+	ChannelBase &getUpwardChannel() override { return this->upward; };
+	ChannelBase &getDownwardChannel() override { return this->downward; };
 
  public:
 	using ChannelUpward = UpwardChannel<Bl>;
@@ -34,9 +34,11 @@
  */
 
 #include <unistd.h>
+#include <sys/mman.h>
 #include <sys/signalfd.h>
 #include <signal.h>
 #include <syslog.h>
+#include <cerrno>
 #include <cstring>
 
 #include <cxxabi.h>
@@ -48,6 +50,7 @@
 #include "Rt.h"
 #include "RtChannelBase.h"
 #include "RtFifo.h"
+#include "Executor.h"
 
 
 namespace Rt
@@ -163,7 +166,11 @@ static void crash_handler(int sig)
 BlockManager::BlockManager():
 	stopped(false),
 	status(true),
-	stop_fd(-1)
+	stop_fd(-1),
+	thread_settings(),
+	lock_memory(false),
+	stack_prefault(0),
+	executors()
 {
 }
 
@@ -192,6 +199,10 @@ void BlockManager::stop()
 			block->stop();
 		}
 	}
+	for(auto &&[name, executor]: this->executors)
+	{
+		executor->join();
+	}
 }
 
 
@@ -241,6 +252,7 @@ bool BlockManager::init()
 			continue;
 		}
 
+		Output::Get()->setProbeScope(block->output_scope);
 		if(!block->init(this->stop_fd))
 		{
 			// only return false, the block init function should call
@@ -263,6 +275,7 @@ bool BlockManager::init()
 			    "Block %s already initialized...",
 			    block->getName().c_str());
 		}
+		Output::Get()->setProbeScope(block->output_scope);
 		if(!block->initSpecific())
 		{
 			// only return false, the block initSpecific function should call
@@ -273,6 +286,7 @@ bool BlockManager::init()
 		    "Block %s initialized its specifics.",
 		    block->getName().c_str());
 	}
+	Output::Get()->setProbeScope("");
 
 	return true;
 }
@@ -294,9 +308,40 @@ void BlockManager::reportError(const std::string& msg, bool critical)
 }
 
 
+void BlockManager::setThreadSettings(const std::string &block_name,
+                                     const std::string &channel_type,
+                                     const ThreadSettings &settings)
+{
+	this->thread_settings[block_name + "." + channel_type] = settings;
+}
+
+
+void BlockManager::setMemoryLock(std::size_t stack_prefault)
+{
+	this->lock_memory = true;
+	this->stack_prefault = stack_prefault;
+}
+
+
 bool BlockManager::start()
 {
-	//start all threads
+	if(this->lock_memory)
+	{
+		// lock before starting the threads so that their stacks are locked too
+		if(mlockall(MCL_CURRENT | MCL_FUTURE) != 0)
+		{
+			Rt::reportError("manager", std::this_thread::get_id(),
+			                true, "cannot lock memory [%u: %s]",
+			                errno, strerror(errno));
+			return false;
+		}
+		LOG(this->log_rt, LEVEL_NOTICE,
+		    "Process memory locked, %zu bytes of stack prefaulted per channel\n",
+		    this->stack_prefault);
+	}
+
+	// attach the channels to their shared executors before starting
+	// any thread so that no message is pushed in the meantime
 	for(auto &&block: block_list)
 	{
 		if(!block->isInitialized())
@@ -305,17 +350,76 @@ bool BlockManager::start()
 			                true, "block not initialized");
 			return false;
 		}
-		if(!block->start())
+
+		ThreadSettings up_settings = this->getThreadSettings(block->getName(), "Upward");
+		if(!up_settings.executor.empty())
+		{
+			this->getExecutor(up_settings.executor).addChannel(block->getUpwardChannel());
+		}
+		ThreadSettings down_settings = this->getThreadSettings(block->getName(), "Downward");
+		if(!down_settings.executor.empty())
+		{
+			this->getExecutor(down_settings.executor).addChannel(block->getDownwardChannel());
+		}
+	}
+	for(auto &&[name, executor]: this->executors)
+	{
+		if(!executor->init(this->stop_fd))
+		{
+			return false;
+		}
+	}
+
+	//start all threads
+	for(auto &&block: block_list)
+	{
+		if(!block->start(this->getThreadSettings(block->getName(), "Upward"),
+		                 this->getThreadSettings(block->getName(), "Downward")))
 		{
 			Rt::reportError("manager", std::this_thread::get_id(),
 			                true, "block does not start");
 			return false;
 		}
 	}
+	for(auto &&[name, executor]: this->executors)
+	{
+		if(!executor->start(this->getThreadSettings(name, "Executor")))
+		{
+			return false;
+		}
+	}
 	return true;
 }
 
 
+ThreadSettings BlockManager::getThreadSettings(const std::string &name,
+                                               const std::string &type) const
+{
+	ThreadSettings settings;
+	auto it = this->thread_settings.find(name + "." + type);
+	if(it != this->thread_settings.end())
+	{
+		settings = it->second;
+	}
+	if(this->lock_memory)
+	{
+		settings.stack_prefault = this->stack_prefault;
+	}
+	return settings;
+}
+
+
+Executor &BlockManager::getExecutor(const std::string &name)
+{
+	auto &executor = this->executors[name];
+	if(executor == nullptr)
+	{
+		executor.reset(new Executor{name, this->log_rt});
+	}
+	return *executor;
+}
+
+
 void BlockManager::wait()
 {
 	fd_set fds;
@@ -37,6 +37,7 @@
 #ifndef BLOCK_MANAGER_H
 #define BLOCK_MANAGER_H
 
+#include <map>
 #include <vector>
 
 #include "Block.h"
@@ -50,6 +51,9 @@ namespace Rt
 {
 
 
+class Executor;
+
+
 /**
  * @class BlockManager
  * @brief Interface for operations on runtime library. Singleton.
@@ -161,6 +165,36 @@ class BlockManager
 	                   typename LowerBl::ChannelUpward::DemuxKey up_key,
 	                   typename UpperBl::ChannelDownward::DemuxKey down_key);
 
+	/**
+	 * @brief Set the placement and scheduling of a channel thread,
+	 *        or of a shared executor thread
+	 *
+	 * @param block_name    The block name, or the executor name
+	 * @param channel_type  The channel type ("Upward" or "Downward"),
+	 *                      or "Executor"
+	 * @param settings      The thread settings
+	 */
+	void setThreadSettings(const std::string &block_name,
+	                       const std::string &channel_type,
+	                       const ThreadSettings &settings);
+
+	/**
+	 * @brief Get the settings of a channel or executor thread
+	 *
+	 * @param name  The block name, or the executor name
+	 * @param type  The channel type, or "Executor"
+	 * @return the thread settings
+	 */
+	ThreadSettings getThreadSettings(const std::string &name, const std::string &type) const;
+
+	/**
+	 * @brief Lock the process memory when the blocks start
+	 *
+	 * @param stack_prefault  The size of stack each channel thread
+	 *                        touches when it starts (bytes)
+	 */
+	void setMemoryLock(std::size_t stack_prefault);
+
 	/**
 	 * @brief stops the application
 	 *        Force kill if a thread don't stop
@@ -217,6 +251,26 @@ class BlockManager
 	bool status;
 
 	int stop_fd;
+
+	/// the channels threads settings, by block name and channel type
+	std::map<std::string, ThreadSettings> thread_settings;
+
+	/// whether the process memory is locked when the blocks start
+	bool lock_memory;
+
+	/// the size of stack each channel thread touches when it starts
+	std::size_t stack_prefault;
+
+	/// the shared executors, by name
+	std::map<std::string, std::unique_ptr<Executor>> executors;
+
+	/**
+	 * @brief Get a shared executor, created on first use
+	 *
+	 * @param name  The executor name
+	 * @return the executor
+	 */
+	Executor &getExecutor(const std::string &name);
 };
 
 
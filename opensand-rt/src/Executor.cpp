@@ -0,0 +1,272 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file Executor.cpp
+ * @author Viveris Technologies
+ * @brief  A thread running the event loop of several channels
+ */
+
+#include <unistd.h>
+#include <sys/epoll.h>
+#include <cerrno>
+#include <cstring>
+
+#include <opensand_output/Output.h>
+
+#include "Executor.h"
+#include "Rt.h"
+#include "RtChannelBase.h"
+
+
+namespace Rt
+{
+
+
+/// The maximum number of file descriptors reported by each epoll_wait
+constexpr const int MAX_READY_EVENTS = 64;
+
+
+thread_local Executor *Executor::running = nullptr;
+
+
+Executor::Executor(const std::string &name, std::shared_ptr<OutputLog> log_rt):
+	name{name},
+	channels{},
+	settings{},
+	thread{},
+	epoll_fd{-1},
+	stop_fd{-1},
+	owners{},
+	local_events{},
+	log_rt{log_rt}
+{
+}
+
+
+Executor::~Executor()
+{
+	if(this->epoll_fd >= 0)
+	{
+		close(this->epoll_fd);
+	}
+}
+
+
+Executor *Executor::current()
+{
+	return running;
+}
+
+
+const std::string &Executor::getName() const
+{
+	return this->name;
+}
+
+
+void Executor::addChannel(ChannelBase &channel)
+{
+	this->channels.push_back(&channel);
+}
+
+
+bool Executor::init(int stop_fd)
+{
+	this->epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+	if(this->epoll_fd < 0)
+	{
+		Rt::reportError(this->name, std::this_thread::get_id(), true,
+		                "cannot create epoll set [%d: %s]", errno, strerror(errno));
+		return false;
+	}
+
+	this->stop_fd = stop_fd;
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.fd = this->stop_fd;
+	if(epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, this->stop_fd, &event) != 0)
+	{
+		Rt::reportError(this->name, std::this_thread::get_id(), true,
+		                "cannot monitor stop signal [%d: %s]", errno, strerror(errno));
+		return false;
+	}
+
+	for(auto &&channel: this->channels)
+	{
+		if(!channel->attachExecutor(*this))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool Executor::start(const ThreadSettings &settings)
+{
+	this->settings = settings;
+	LOG(this->log_rt, LEVEL_INFO,
+	    "executor %s: start with %zu channels\n",
+	    this->name.c_str(), this->channels.size());
+	try
+	{
+		this->thread = std::thread{&Executor::run, this};
+	}
+	catch (const std::system_error& e)
+	{
+		Rt::reportError(this->name, std::this_thread::get_id(), true,
+		                "cannot start executor thread [%u: %s]", e.code(), e.what());
+		return false;
+	}
+	return true;
+}
+
+
+bool Executor::join()
+{
+	if(!this->thread.joinable())
+	{
+		return true;
+	}
+	try
+	{
+		this->thread.join();
+	}
+	catch (const std::system_error& e)
+	{
+		Rt::reportError(this->name, std::this_thread::get_id(), false,
+		                "cannot join executor thread [%u: %s]", e.code(), e.what());
+		return false;
+	}
+	return true;
+}
+
+
+bool Executor::watch(int32_t fd, ChannelBase *channel)
+{
+	epoll_event event{};
+	event.events = EPOLLIN;
+	event.data.fd = fd;
+	if(epoll_ctl(this->epoll_fd, EPOLL_CTL_ADD, fd, &event) != 0)
+	{
+		Rt::reportError(this->name, std::this_thread::get_id(), true,
+		                "cannot monitor fd %d [%d: %s]", fd, errno, strerror(errno));
+		return false;
+	}
+	this->owners[fd] = channel;
+	return true;
+}
+
+
+void Executor::unwatch(int32_t fd)
+{
+	epoll_ctl(this->epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
+	this->owners.erase(fd);
+}
+
+
+void Executor::pushLocal(ChannelBase *channel, MessageEvent *event)
+{
+	this->local_events.emplace_back(channel, event);
+}
+
+
+void Executor::run()
+{
+	running = this;
+
+	std::string error;
+	if(!applyToCurrentThread(this->name, this->settings, error))
+	{
+		Rt::reportError(this->name, std::this_thread::get_id(), true,
+		                "%s", error.c_str());
+		return;
+	}
+
+	epoll_event ready[MAX_READY_EVENTS];
+	while(true)
+	{
+		// get the new events for the next loop
+		for(auto &&channel: this->channels)
+		{
+			channel->updateEvents();
+		}
+
+		int number_fd = epoll_wait(this->epoll_fd, ready, MAX_READY_EVENTS, -1);
+		if(number_fd < 0)
+		{
+			if(errno == EINTR)
+			{
+				continue;
+			}
+			Rt::reportError(this->name, std::this_thread::get_id(), true,
+			                "epoll_wait failed: [%d: %s]", errno, strerror(errno));
+			return;
+		}
+
+		for(int index = 0; index < number_fd; ++index)
+		{
+			int32_t fd = ready[index].data.fd;
+			if(fd == this->stop_fd)
+			{
+				// we have to stop
+				LOG(this->log_rt, LEVEL_INFO,
+				    "executor %s: stop signal received\n", this->name.c_str());
+				return;
+			}
+
+			auto owner = this->owners.find(fd);
+			if(owner == this->owners.end())
+			{
+				// removed by a previous event of this loop
+				continue;
+			}
+			if(!owner->second->handleEventFd(fd))
+			{
+				return;
+			}
+		}
+
+		for(auto &&channel: this->channels)
+		{
+			channel->processEvents();
+		}
+
+		// the handed over messages may trigger new ones, process them all
+		// before waiting again
+		while(!this->local_events.empty())
+		{
+			auto [channel, event] = this->local_events.front();
+			this->local_events.pop_front();
+			channel->processLocalMessage(*event);
+		}
+	}
+}
+
+
+};
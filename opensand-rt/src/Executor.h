@@ -0,0 +1,198 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file Executor.h
+ * @author Viveris Technologies
+ * @brief  A thread running the event loop of several channels
+ */
+
+
+#ifndef RT_EXECUTOR_H
+#define RT_EXECUTOR_H
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "ThreadSettings.h"
+
+
+class OutputLog;
+
+
+namespace Rt
+{
+
+
+class ChannelBase;
+class MessageEvent;
+
+
+/**
+ * @class Executor
+ * @brief Runs the events of several channels on a single thread
+ *
+ * The file descriptors of the events of all the channels are monitored
+ * with a single epoll set. A message pushed by one of the channels to
+ * another channel of the same executor does not go through the fifo pipe
+ * and semaphore: it is queued on the executor and handed over to the
+ * receiving channel once the current events are processed.
+ */
+class Executor
+{
+	friend class BlockManager;
+	friend class ChannelBase;
+	friend class Fifo;
+
+ public:
+	~Executor();
+
+	/**
+	 * @brief Get the executor running on the calling thread
+	 *
+	 * @return the executor, nullptr if the thread is not an executor
+	 */
+	static Executor *current();
+
+	/**
+	 * @brief Get the executor name
+	 *
+	 * @return the executor name
+	 */
+	const std::string &getName() const;
+
+ protected:
+	/**
+	 * @brief Executor constructor
+	 *
+	 * @param name    The executor name
+	 * @param log_rt  The log of the manager, as the logs cannot be
+	 *                registered once the blocks are initialized
+	 */
+	Executor(const std::string &name, std::shared_ptr<OutputLog> log_rt);
+
+	/**
+	 * @brief Add a channel to run, before init
+	 *
+	 * @param channel  The channel
+	 */
+	void addChannel(ChannelBase &channel);
+
+	/**
+	 * @brief Create the epoll set and attach the channels
+	 *
+	 * @param stop_fd  file descriptor to the stop signals listener
+	 * @return true on success, false otherwise
+	 */
+	bool init(int stop_fd);
+
+	/**
+	 * @brief Start the executor thread
+	 *
+	 * @param settings  The placement and scheduling of the thread
+	 * @return true on success, false otherwise
+	 */
+	bool start(const ThreadSettings &settings);
+
+	/**
+	 * @brief Wait for the executor thread to stop
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool join();
+
+	/**
+	 * @brief Monitor a file descriptor of a channel
+	 *
+	 * @param fd       The file descriptor
+	 * @param channel  The channel handling it
+	 * @return true on success, false otherwise
+	 */
+	bool watch(int32_t fd, ChannelBase *channel);
+
+	/**
+	 * @brief Stop monitoring a file descriptor
+	 *
+	 * @param fd  The file descriptor
+	 */
+	void unwatch(int32_t fd);
+
+	/**
+	 * @brief Queue a message event handed over between two channels
+	 *        of this executor, only called from the executor thread
+	 *
+	 * @param channel  The receiving channel
+	 * @param event    The message event of the receiving channel
+	 */
+	void pushLocal(ChannelBase *channel, MessageEvent *event);
+
+ private:
+	/**
+	 * @brief the loop
+	 */
+	void run();
+
+	/// The executor name
+	std::string name;
+
+	/// The channels run by this executor
+	std::vector<ChannelBase *> channels;
+
+	/// The placement and scheduling of the thread
+	ThreadSettings settings;
+
+	/// The executor thread
+	std::thread thread;
+
+	/// The epoll set of all the channels file descriptors
+	int epoll_fd;
+
+	/// fd of the stop signal event
+	int stop_fd;
+
+	/// The channel handling each monitored file descriptor
+	std::unordered_map<int32_t, ChannelBase *> owners;
+
+	/// The messages handed over between the channels of this executor
+	std::deque<std::pair<ChannelBase *, MessageEvent *>> local_events;
+
+	/// Output Log
+	std::shared_ptr<OutputLog> log_rt;
+
+	/// The executor running on the current thread
+	static thread_local Executor *running;
+};
+
+
+};  // namespace Rt
+
+
+#endif
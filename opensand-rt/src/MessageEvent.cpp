@@ -79,6 +79,18 @@ bool MessageEvent::handle()
 }
 
 
+bool MessageEvent::handleLocal()
+{
+	return this->fifo->popLocal(this->message);
+}
+
+
+void MessageEvent::attachExecutor(Executor &executor, ChannelBase &channel)
+{
+	this->fifo->setConsumer(&executor, &channel, this);
+}
+
+
 bool MessageEvent::advertiseEvent(ChannelBase& channel)
 {
 	return channel.onEvent(*this);
@@ -47,6 +47,7 @@ namespace Rt
 
 
 class Fifo;
+class Executor;
 
 
 /**
@@ -81,6 +82,22 @@ class MessageEvent: public Event
 
 	bool handle() override;
 
+	/**
+	 * @brief Get the message handed over by a channel of the same executor
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool handleLocal();
+
+	/**
+	 * @brief Hand over the messages pushed from the executor thread
+	 *        directly to the channel
+	 *
+	 * @param executor  The executor running the channel
+	 * @param channel   The channel receiving the messages
+	 */
+	void attachExecutor(Executor &executor, ChannelBase &channel);
+
  protected:
 	/// the message
 	mutable Message message;
@@ -69,6 +69,27 @@ bool Rt::run(bool init)
 }
 
 
+void Rt::setThreadSettings(const std::string &block_name,
+                           const std::string &channel_type,
+                           const ThreadSettings &settings)
+{
+	manager.setThreadSettings(block_name, channel_type, settings);
+}
+
+
+ThreadSettings Rt::getThreadSettings(const std::string &block_name,
+                                    const std::string &channel_type)
+{
+	return manager.getThreadSettings(block_name, channel_type);
+}
+
+
+void Rt::setMemoryLock(std::size_t stack_prefault)
+{
+	manager.setMemoryLock(stack_prefault);
+}
+
+
 void Rt::stop()
 {
 	manager.stop();
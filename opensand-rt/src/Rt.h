@@ -130,6 +130,45 @@ class Rt
 	                          typename LowerBl::ChannelUpward::DemuxKey up_key,
 	                          typename UpperBl::ChannelDownward::DemuxKey down_key);
 
+	/**
+	 * @brief Set the placement and scheduling of a channel thread,
+	 *        or of a shared executor thread, must be called before
+	 *        the blocks start
+	 *
+	 * The channels with an executor name in their settings share the
+	 * event loop of this executor instead of running their own thread.
+	 *
+	 * @param block_name    The block name, or the executor name
+	 * @param channel_type  The channel type ("Upward" or "Downward"),
+	 *                      or "Executor"
+	 * @param settings      The thread settings
+	 */
+	static void setThreadSettings(const std::string &block_name,
+	                              const std::string &channel_type,
+	                              const ThreadSettings &settings);
+
+	/**
+	 * @brief Get the placement and scheduling of a channel thread,
+	 *        or of a shared executor thread, as set so far
+	 *
+	 * @param block_name    The block name, or the executor name
+	 * @param channel_type  The channel type ("Upward" or "Downward"),
+	 *                      or "Executor"
+	 * @return the thread settings
+	 */
+	static ThreadSettings getThreadSettings(const std::string &block_name,
+	                                        const std::string &channel_type);
+
+	/**
+	 * @brief Lock the process memory when the blocks start and prefault
+	 *        the stack of the channels threads, must be called before
+	 *        the blocks start
+	 *
+	 * @param stack_prefault  The size of stack each channel thread
+	 *                        touches when it starts (bytes)
+	 */
+	static void setMemoryLock(std::size_t stack_prefault);
+
 	/**
 	 * @brief Initialize the blocks
 	 *
@@ -35,6 +35,7 @@
 
 #include <unistd.h>
 #include <signal.h>
+#include <algorithm>
 #include <cstring>
 #include <set>
 
@@ -51,6 +52,7 @@
 #include "TcpListenEvent.h"
 #include "TimerEvent.h"
 #include "RtCommunicate.h"
+#include "Executor.h"
 
 #ifdef TIME_REPORTS
 	#include <numeric>
@@ -75,7 +77,10 @@ ChannelBase::ChannelBase(const std::string &name, const std::string &type):
 	out_opp_fifo{nullptr},
 	stop_fd{-1},
 	w_sel_break{-1},
-	r_sel_break{-1}
+	r_sel_break{-1},
+	thread_settings{},
+	executor{nullptr},
+	ready_events{[](const Event *e1, const Event *e2) { return (*e1) < (*e2); }}
 {
 	FD_ZERO(&(this->input_fd_set));
 }
@@ -370,6 +375,10 @@ void ChannelBase::updateEvents(void)
 		// add fd to set
 		auto fd = new_event->getFd();
 		FD_SET(fd, &(this->input_fd_set));
+		if(this->executor != nullptr)
+		{
+			this->executor->watch(fd, this);
+		}
 		// add fd to map
 		this->events[fd] = std::move(new_event);
 	}
@@ -386,6 +395,10 @@ void ChannelBase::updateEvents(void)
 			    it->second->getName().c_str());
 			// remove fd from set
 			FD_CLR(it->first, &(this->input_fd_set));
+			if(this->executor != nullptr)
+			{
+				this->executor->unwatch(it->first);
+			}
 			// remove fd from map
 			this->events.erase(it);
 		}
@@ -486,29 +499,51 @@ void ChannelBase::removeEvent(event_id_t id)
 }
 
 
+void ChannelBase::setThreadSettings(const ThreadSettings &settings)
+{
+	this->thread_settings = settings;
+}
+
+
+bool ChannelBase::applyThreadSettings()
+{
+	std::string thread_name = this->channel_name + (this->channel_type == "Upward" ? ".up" : ".down");
+	std::string error;
+	if(!applyToCurrentThread(thread_name, this->thread_settings, error))
+	{
+		this->reportError(true, "%s\n", error.c_str());
+		return false;
+	}
+
+	LOG(this->log_rt, LEVEL_INFO,
+	    "thread %s started\n", thread_name.c_str());
+	return true;
+}
+
+
 void ChannelBase::executeThread(void)
 {
 	int32_t number_fd;
 	int32_t handled;
 	fd_set readfds;
 
+	if(!this->applyThreadSettings())
+	{
+		return;
+	}
+
 	/*
 	pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, nullptr);
 	pthread_setcanceltype(PTHREAD_CANCEL_ASYNCHRONOUS, nullptr);
 	timeval timeout{0, 500};
 	*/
 
-	// sort the list according to priority
-	static const auto eventSorter = [](const Event* e1, const Event* e2) { return (*e1) < (*e2); };
-	std::set<Event *, decltype(eventSorter)> priority_sorted_events(eventSorter);
-
 	while(true)
 	{
 		handled = 0;
 		
 		// get the new events for the next loop
 		this->updateEvents();
-		priority_sorted_events.clear();
 		readfds = this->input_fd_set;
 
 		// wait for any event
@@ -556,41 +591,137 @@ void ChannelBase::executeThread(void)
 			handled++;
 
 			// fd is set
-			if(!event->handle())
+			if(!this->handleEvent(*event))
 			{
-				if(event->isCritical())
-				{
-					this->reportError(true, "unable to handle critical event\n");
-					return;
-				}
-				this->reportError(false, "unable to handle event\n");
-				// ignore this event
-				continue;
+				return;
 			}
-			priority_sorted_events.insert(event.get());
 		}
 
 		// call processEvent on each event
-		for(auto &&event: priority_sorted_events)
+		this->processEvents();
+	}
+}
+
+bool ChannelBase::attachExecutor(Executor &executor)
+{
+	this->executor = &executor;
+
+	// the select break pipe is still used when events are added from
+	// another thread
+	if(!executor.watch(this->r_sel_break, this))
+	{
+		return false;
+	}
+
+	// the messages pushed from the executor thread are handed over directly
+	for(auto &&[fd, event]: this->events)
+	{
+		MessageEvent *message_event = dynamic_cast<MessageEvent *>(event.get());
+		if(message_event != nullptr)
 		{
-			const std::string event_name = event->getName();
-			event->setTriggerTime();
-			LOG(this->log_rt, LEVEL_DEBUG, "event received (%s)",
+			message_event->attachExecutor(executor, *this);
+		}
+	}
+	for(auto &&event: this->new_events)
+	{
+		MessageEvent *message_event = dynamic_cast<MessageEvent *>(event.get());
+		if(message_event != nullptr)
+		{
+			message_event->attachExecutor(executor, *this);
+		}
+	}
+	return true;
+}
+
+
+bool ChannelBase::handleEvent(Event &event)
+{
+	if(!event.handle())
+	{
+		if(event.isCritical())
+		{
+			this->reportError(true, "unable to handle critical event\n");
+			return false;
+		}
+		this->reportError(false, "unable to handle event\n");
+		// ignore this event
+		return true;
+	}
+	this->ready_events.insert(&event);
+	return true;
+}
+
+
+bool ChannelBase::handleEventFd(int32_t fd)
+{
+	if(fd == this->r_sel_break)
+	{
+		if(!check_read(this->r_sel_break))
+		{
+			LOG(this->log_rt, LEVEL_ERROR,
+			    "failed to read in pipe");
+		}
+		return true;
+	}
+
+	auto it = this->events.find(fd);
+	if(it == this->events.end())
+	{
+		return true;
+	}
+	return this->handleEvent(*(it->second));
+}
+
+
+void ChannelBase::processEvents()
+{
+	for(auto &&event: this->ready_events)
+	{
+		const std::string event_name = event->getName();
+		event->setTriggerTime();
+		LOG(this->log_rt, LEVEL_DEBUG, "event received (%s)",
+		    event_name.c_str());
+		if(!event->advertiseEvent(*this))
+		{
+			LOG(this->log_rt, LEVEL_ERROR,
+			    "failed to process event %s\n",
 			    event_name.c_str());
-			if(!event->advertiseEvent(*this))
-			{
-				LOG(this->log_rt, LEVEL_ERROR,
-				    "failed to process event %s\n",
-				    event_name.c_str());
-			}
+		}
 #ifdef TIME_REPORTS
-			time_val_t time = event->getTimeFromTrigger();
-			this->durations[event_name].push_back(time);
+		time_val_t time = event->getTimeFromTrigger();
+		this->durations[event_name].push_back(time);
 #endif
-		}
 	}
+	this->ready_events.clear();
 }
 
+
+void ChannelBase::processLocalMessage(MessageEvent &event)
+{
+	if(!event.handleLocal())
+	{
+		this->reportError(false, "unable to handle message\n");
+		return;
+	}
+
+	Event &base_event = event;
+	const std::string event_name = base_event.getName();
+	base_event.setTriggerTime();
+	LOG(this->log_rt, LEVEL_DEBUG, "message handed over (%s)",
+	    event_name.c_str());
+	if(!base_event.advertiseEvent(*this))
+	{
+		LOG(this->log_rt, LEVEL_ERROR,
+		    "failed to process event %s\n",
+		    event_name.c_str());
+	}
+#ifdef TIME_REPORTS
+	time_val_t time = base_event.getTimeFromTrigger();
+	this->durations[event_name].push_back(time);
+#endif
+}
+
+
 void ChannelBase::reportError(bool critical, const char *msg_format, ...)
 {
 	char msg[512];
@@ -39,11 +39,13 @@
 
 #include <string>
 #include <map>
+#include <set>
 #include <vector>
 #include <memory>
 
 #include "Types.h"
 #include "TemplateHelper.h"
+#include "ThreadSettings.h"
 
 
 class OutputLog;
@@ -55,6 +57,7 @@ namespace Rt
 
 class Fifo;
 class Event;
+class Executor;
 class MessageEvent;
 class TimerEvent;
 class SignalEvent;
@@ -82,6 +85,7 @@ class ChannelBase
 	template<IsBlock Bl, class Specific>
 #endif
 	friend class Block;
+	friend class Executor;
 
  protected:
 	/// Output Log
@@ -274,6 +278,14 @@ class ChannelBase
 	 * @param initialized  Th block initialization status
 	 */
 	void setIsBlockInitialized(bool initialized);
+
+	/**
+	 * @brief Set the placement and scheduling applied by the channel
+	 *        thread when it starts
+	 *
+	 * @param settings  The thread settings
+	 */
+	void setThreadSettings(const ThreadSettings &settings);
 	
 	/**
 	 * @brief Set the fifos for opposite channel (in the same block)
@@ -346,12 +358,67 @@ class ChannelBase
 	/// fd used in select to break when an event is created
 	int32_t r_sel_break;
 
+	/// the placement and scheduling of the channel thread
+	ThreadSettings thread_settings;
+
+	/// the shared executor running the channel, nullptr if it has its own thread
+	Executor *executor;
+
+	/// the events handled in the current loop, sorted by priority
+	std::set<Event *, bool (*)(const Event *, const Event *)> ready_events;
+
 	/**
 	 * @brief the loop
 	 *
 	 */
 	void executeThread();
 
+	/**
+	 * @brief Attach the channel to a shared executor, before it starts
+	 *
+	 * @param executor  The executor
+	 * @return true on success, false otherwise
+	 */
+	bool attachExecutor(Executor &executor);
+
+	/**
+	 * @brief Handle an event that was raised, its processing is
+	 *        delayed to processEvents
+	 *
+	 * @param event  The event
+	 * @return false if the channel should stop, true otherwise
+	 */
+	bool handleEvent(Event &event);
+
+	/**
+	 * @brief Handle the event on a file descriptor raised in a
+	 *        shared executor
+	 *
+	 * @param fd  The file descriptor
+	 * @return false if the channel should stop, true otherwise
+	 */
+	bool handleEventFd(int32_t fd);
+
+	/**
+	 * @brief Process the handled events by priority
+	 */
+	void processEvents();
+
+	/**
+	 * @brief Process a message handed over by a channel of the same executor
+	 *
+	 * @param event  The message event
+	 */
+	void processLocalMessage(MessageEvent &event);
+
+	/**
+	 * @brief Name, place and schedule the calling thread
+	 *        according to the channel thread settings
+	 *
+	 * @return true on success, false otherwise
+	 */
+	bool applyThreadSettings();
+
 	/**
 	 * @brief Add an event in event map
 	 *
@@ -98,7 +98,13 @@ bool Event::operator <(const Event& event) const
 {
 	long int delta = 100000000L * (this->priority - event.priority);
 	delta += std::chrono::duration_cast<std::chrono::microseconds>(this->trigger_time - event.trigger_time).count();
-	return delta < 0;		
+	if(delta == 0)
+	{
+		// distinct events must not be equivalent, or only one of
+		// them would be kept in the set of ready events
+		return this->fd < event.fd;
+	}
+	return delta < 0;
 }
 
 
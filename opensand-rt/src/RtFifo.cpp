@@ -38,6 +38,7 @@
 #include "RtFifo.h"
 #include "Rt.h"
 #include "RtCommunicate.h"
+#include "Executor.h"
 
 
 namespace Rt
@@ -49,6 +50,10 @@ constexpr const std::size_t DEFAULT_FIFO_SIZE = 3;
 
 Fifo::Fifo():
 	fifo{},
+	local_fifo{},
+	executor{nullptr},
+	consumer{nullptr},
+	consumer_event{nullptr},
 	max_size{DEFAULT_FIFO_SIZE},
 	fifo_mutex{},
 	fifo_size_sem{DEFAULT_FIFO_SIZE}
@@ -78,8 +83,25 @@ bool Fifo::init()
 }
 
 
+void Fifo::setConsumer(Executor *executor, ChannelBase *consumer, MessageEvent *event)
+{
+	this->executor = executor;
+	this->consumer = consumer;
+	this->consumer_event = event;
+}
+
+
 bool Fifo::push(Message message)
 {
+	if(this->executor != nullptr && Executor::current() == this->executor)
+	{
+		// the consumer runs on this thread: waiting for room in the fifo
+		// would never end, hand the message over to the executor instead
+		this->local_fifo.push(std::move(message));
+		this->executor->pushLocal(this->consumer, this->consumer_event);
+		return true;
+	}
+
 	// we need a semaphore here to block while fifo is full
 	fifo_size_sem.wait();
 	Lock acquire{fifo_mutex};
@@ -114,6 +136,20 @@ bool Fifo::push(Message message)
 }
 
 
+bool Fifo::popLocal(Message &elem)
+{
+	if(this->local_fifo.empty())
+	{
+		Rt::reportError("fifo", std::this_thread::get_id(), false,
+		                "Local fifo is already empty, this should not happend\n");
+		return false;
+	}
+	elem = std::move(this->local_fifo.front());
+	this->local_fifo.pop();
+	return true;
+}
+
+
 bool Fifo::pop(Message &elem)
 {
 	{
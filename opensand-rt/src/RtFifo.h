@@ -46,6 +46,11 @@ namespace Rt
 {
 
 
+class ChannelBase;
+class Executor;
+class MessageEvent;
+
+
 /**
  * @class Fifo
  * @brief A fifo between two blocks
@@ -102,10 +107,40 @@ class Fifo
 	 */
 	int32_t getSigFd(void) const {return this->r_sig_pipe;};
 
+	/**
+	 * @brief Set the channel reading the fifo when it runs on a shared
+	 *        executor, the messages pushed from the executor thread are
+	 *        then handed over without the pipe and the size limit
+	 *
+	 * @param executor  The executor running the channel
+	 * @param consumer  The channel reading the fifo
+	 * @param event     The message event of the channel for this fifo
+	 */
+	void setConsumer(Executor *executor, ChannelBase *consumer, MessageEvent *event);
+
+	/**
+	 * @brief Access the first element handed over on the executor thread
+	 *        and remove it
+	 *
+	 * @param message  the first element handed over
+	 * @return true on success, false otherwise
+	 */
+	bool popLocal(Message &message);
+
  private:
 	/// the queue
 	std::queue<Message> fifo;
 
+	/// the messages handed over on the executor thread, only accessed by it
+	std::queue<Message> local_fifo;
+
+	/// the executor running the consumer channel, if any
+	Executor *executor;
+	/// the channel reading the fifo on the executor
+	ChannelBase *consumer;
+	/// the message event of the consumer channel
+	MessageEvent *consumer_event;
+
 	/// The fifo size
 	std::size_t max_size;
 	
@@ -0,0 +1,234 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file ThreadSettings.cpp
+ * @author Viveris Technologies
+ * @brief  Placement and scheduling of the channels threads
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#include <alloca.h>
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+#include <sstream>
+
+#include "ThreadSettings.h"
+
+
+namespace Rt
+{
+
+
+static bool parseCpu(const std::string &value, unsigned int &cpu)
+{
+	if(value.empty() ||
+	   !std::all_of(value.begin(), value.end(),
+	                [](unsigned char c) { return std::isdigit(c); }))
+	{
+		return false;
+	}
+	std::istringstream stream{value};
+	stream >> cpu;
+	return !stream.fail();
+}
+
+
+bool parseCpuList(const std::string &list, std::vector<unsigned int> &cpus)
+{
+	std::istringstream stream{list};
+	std::string range;
+
+	cpus.clear();
+	while(std::getline(stream, range, ','))
+	{
+		unsigned int first;
+		unsigned int last;
+		std::size_t dash = range.find('-');
+		if(dash == std::string::npos)
+		{
+			if(!parseCpu(range, first))
+			{
+				return false;
+			}
+			last = first;
+		}
+		else if(!parseCpu(range.substr(0, dash), first) ||
+		        !parseCpu(range.substr(dash + 1), last) ||
+		        last < first)
+		{
+			return false;
+		}
+		if(last >= CPU_SETSIZE)
+		{
+			return false;
+		}
+
+		for(unsigned int cpu = first; cpu <= last; ++cpu)
+		{
+			cpus.push_back(cpu);
+		}
+	}
+	return !cpus.empty();
+}
+
+
+bool parseSchedulingPolicy(const std::string &name, SchedulingPolicy &policy)
+{
+	std::string lower_name = name;
+	std::transform(lower_name.begin(), lower_name.end(), lower_name.begin(),
+	               [](unsigned char c) { return std::tolower(c); });
+
+	if(lower_name == "other")
+	{
+		policy = SchedulingPolicy::other;
+	}
+	else if(lower_name == "fifo")
+	{
+		policy = SchedulingPolicy::fifo;
+	}
+	else if(lower_name == "rr")
+	{
+		policy = SchedulingPolicy::rr;
+	}
+	else
+	{
+		return false;
+	}
+	return true;
+}
+
+
+std::string shortThreadName(const std::string &name)
+{
+	// 16 bytes, terminating null byte included
+	const std::size_t max_length = 15;
+	if(name.size() <= max_length)
+	{
+		return name;
+	}
+
+	std::size_t dot = name.find('.');
+	if(dot == std::string::npos)
+	{
+		return name.substr(0, max_length);
+	}
+	std::string suffix = name.substr(dot);
+	if(suffix.size() >= max_length)
+	{
+		// keep the end of the suffix, where the channel is
+		return suffix.substr(suffix.size() - max_length);
+	}
+	return name.substr(0, max_length - suffix.size()) + suffix;
+}
+
+
+// keep the touched stack out of the caller frame so that it is released on return
+static void __attribute__((noinline)) prefaultStack(std::size_t size)
+{
+	volatile unsigned char *stack = static_cast<volatile unsigned char *>(alloca(size));
+	const std::size_t page_size = sysconf(_SC_PAGESIZE);
+	for(std::size_t offset = 0; offset < size; offset += page_size)
+	{
+		stack[offset] = 0;
+	}
+}
+
+
+bool applyToCurrentThread(const std::string &thread_name,
+                          const ThreadSettings &settings,
+                          std::string &error)
+{
+	pthread_t self = pthread_self();
+	std::ostringstream message;
+
+	// thread names only help debugging so a failure is not an error
+	pthread_setname_np(self, shortThreadName(thread_name).c_str());
+
+	if(!settings.cpus.empty())
+	{
+		cpu_set_t cpu_set;
+		CPU_ZERO(&cpu_set);
+		for(auto &&cpu: settings.cpus)
+		{
+			if(cpu >= CPU_SETSIZE)
+			{
+				message << "CPU " << cpu << " is out of range";
+				error = message.str();
+				return false;
+			}
+			CPU_SET(cpu, &cpu_set);
+		}
+		int ret = pthread_setaffinity_np(self, sizeof(cpu_set), &cpu_set);
+		if(ret != 0)
+		{
+			message << "cannot set thread affinity [" << ret << ": " << strerror(ret) << "]";
+			error = message.str();
+			return false;
+		}
+	}
+
+	if(settings.policy != SchedulingPolicy::other)
+	{
+		int policy = (settings.policy == SchedulingPolicy::fifo) ? SCHED_FIFO : SCHED_RR;
+		sched_param param{};
+		param.sched_priority = settings.priority;
+		int ret = pthread_setschedparam(self, policy, &param);
+		if(ret != 0)
+		{
+			message << "cannot set thread scheduling policy with priority "
+			        << settings.priority << " [" << ret << ": " << strerror(ret) << "]";
+			error = message.str();
+			return false;
+		}
+	}
+
+	if(settings.stack_prefault > 0)
+	{
+		// keep some stack for the thread itself
+		std::size_t prefault_size = settings.stack_prefault;
+		pthread_attr_t attr;
+		std::size_t stack_size;
+		if(pthread_getattr_np(self, &attr) == 0)
+		{
+			if(pthread_attr_getstacksize(&attr, &stack_size) == 0)
+			{
+				prefault_size = std::min(prefault_size, stack_size / 2);
+			}
+			pthread_attr_destroy(&attr);
+		}
+		prefaultStack(prefault_size);
+	}
+
+	return true;
+}
+
+
+};
@@ -0,0 +1,128 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file ThreadSettings.h
+ * @author Viveris Technologies
+ * @brief  Placement and scheduling of the channels threads
+ */
+
+
+#ifndef RT_THREAD_SETTINGS_H
+#define RT_THREAD_SETTINGS_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+
+namespace Rt
+{
+
+
+/// The scheduling policy of a channel thread
+enum class SchedulingPolicy
+{
+	other,
+	fifo,
+	rr,
+};
+
+
+/**
+ * @struct ThreadSettings
+ * @brief The placement and scheduling applied by a channel thread or a
+ *        shared executor on itself when it starts, the default values keep
+ *        the process settings
+ */
+struct ThreadSettings
+{
+	/// The CPUs the thread may run on, empty to keep the process affinity
+	std::vector<unsigned int> cpus;
+	/// The scheduling policy of the thread
+	SchedulingPolicy policy = SchedulingPolicy::other;
+	/// The real-time priority, only used with the fifo and rr policies
+	int priority = 0;
+	/// The size of the stack touched when the thread starts (bytes),
+	/// set by the manager when the memory is locked
+	std::size_t stack_prefault = 0;
+	/// The name of the shared executor running the channel,
+	/// empty to run the channel on its own thread
+	std::string executor;
+};
+
+
+/**
+ * @brief Parse a CPU list such as "0-3,6"
+ *
+ * The CPUs must be lower than CPU_SETSIZE.
+ *
+ * @param list  The CPU list
+ * @param cpus  OUT: the CPUs in the list
+ * @return true on success, false otherwise
+ */
+bool parseCpuList(const std::string &list, std::vector<unsigned int> &cpus);
+
+/**
+ * @brief Parse a scheduling policy name ("other", "fifo" or "rr")
+ *
+ * @param name    The policy name, case insensitive
+ * @param policy  OUT: the scheduling policy
+ * @return true on success, false otherwise
+ */
+bool parseSchedulingPolicy(const std::string &name, SchedulingPolicy &policy);
+
+/**
+ * @brief Shorten a thread name to the 15 characters allowed by the system
+ *
+ * The dotted suffixes (terminal, channel) distinguish the threads of the
+ * same block so they are kept, the block name is truncated instead:
+ * Asymetric_Handler.down gives Asymetric_.down.
+ *
+ * @param name  The full thread name
+ * @return the name to give to the thread
+ */
+std::string shortThreadName(const std::string &name);
+
+/**
+ * @brief Name, place and schedule the calling thread, then prefault
+ *        its stack (capped to half the stack size)
+ *
+ * @param thread_name  The thread name, shortened with shortThreadName
+ * @param settings     The thread settings
+ * @param error        OUT: the reason of the failure
+ * @return true on success, false otherwise
+ */
+bool applyToCurrentThread(const std::string &thread_name,
+                          const ThreadSettings &settings,
+                          std::string &error);
+
+
+};  // namespace Rt
+
+
+#endif
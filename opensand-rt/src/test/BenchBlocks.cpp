@@ -0,0 +1,598 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file BenchBlocks.cpp
+ * @author Viveris Technologies
+ * @brief Benchmark of the message passing and timers between blocks,
+ *        measures the throughput, the latency of the messages on each
+ *        hop, the jitter of a periodic timer and the CPU time spent per
+ *        message, and writes the results as a JSON object
+ */
+
+
+#include "BenchBlocks.h"
+
+#include "Rt.h"
+#include "MessageEvent.h"
+#include "TimerEvent.h"
+
+#include <opensand_output/Output.h>
+
+#include <algorithm>
+#include <csignal>
+#include <fstream>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+
+using bench_clock = std::chrono::steady_clock;
+
+
+/**
+ * @brief The benchmark parameters and measures, shared by the blocks
+ */
+static struct
+{
+	/// The number of relay blocks on each branch
+	uint32_t relays = 4;
+	/// The number of branches between the source and the sink
+	uint32_t fanout = 1;
+	/// Whether the relays use MuxDemux channels instead of simple channels
+	bool mux_relays = false;
+	/// The number of messages received by the sink before stopping
+	std::size_t messages = 100000;
+	/// The number of messages in flight, 0 for two messages per hop,
+	/// bounded so that the messages cannot fill all the FIFOs of the
+	/// loop and block every channel
+	std::size_t window = 0;
+	/// The period of the timer whose jitter is measured (ms)
+	double timer_period = 1;
+	/// The file the results are written to, standard output if empty
+	std::string output;
+
+	/// The number of messages sent by the source
+	std::size_t sent = 0;
+	/// The time and resource usage when the first message is sent
+	bench_clock::time_point start;
+	struct rusage usage_start;
+	/// The latency of each message from the source to the sink (ns)
+	std::vector<uint64_t> latencies;
+	/// The latency of each hop of the messages from the source to the sink (ns)
+	std::vector<uint64_t> hop_latencies;
+	/// The deviation of each timer expiry from the timer period (ns)
+	std::vector<uint64_t> jitters;
+	std::mutex jitters_lock;
+} bench;
+
+
+/**
+ * @brief Print usage of the benchmark application
+ */
+static void usage(void)
+{
+	std::cerr << "Bench blocks: benchmark the opensand rt library" << std::endl
+	          << "usage: bench_blocks [-l relays] [-f fanout] [-m] [-n messages] [-w window]"
+	          << " [-t timer_period] [-e] [-o output_file]" << std::endl
+	          << "  -l  number of relay blocks on each branch (default 4)" << std::endl
+	          << "  -f  number of branches between the source and the sink (default 1)" << std::endl
+	          << "  -m  use MuxDemux channels in the relay blocks" << std::endl
+	          << "  -n  number of messages to measure (default 100000)" << std::endl
+	          << "  -w  number of messages in flight, at most two per hop (default)" << std::endl
+	          << "  -t  period of the timer whose jitter is measured, in ms (default 1)" << std::endl
+	          << "  -e  run all the channels on a shared executor" << std::endl
+	          << "  -o  write the results to output_file instead of the standard output" << std::endl;
+}
+
+
+static double cpuTime(const struct rusage &usage)
+{
+	return usage.ru_utime.tv_sec + usage.ru_utime.tv_usec / 1e6 +
+	       usage.ru_stime.tv_sec + usage.ru_stime.tv_usec / 1e6;
+}
+
+
+/**
+ * @brief Get a percentile of sorted samples
+ *
+ * @param samples   The sorted samples
+ * @param quantile  The quantile, between 0 and 1
+ * @return the percentile in µs
+ */
+static double percentile(const std::vector<uint64_t> &samples, double quantile)
+{
+	if(samples.empty())
+	{
+		return 0;
+	}
+	std::size_t index = std::min(samples.size() - 1,
+	                             static_cast<std::size_t>(quantile * samples.size()));
+	return samples[index] / 1e3;
+}
+
+
+static std::string distribution(const std::vector<uint64_t> &samples, double divider)
+{
+	std::ostringstream json;
+	json << "{\"p50\": " << percentile(samples, 0.5) / divider
+	     << ", \"p99\": " << percentile(samples, 0.99) / divider
+	     << ", \"p999\": " << percentile(samples, 0.999) / divider
+	     << ", \"max\": " << (samples.empty() ? 0 : samples.back() / 1e3 / divider)
+	     << "}";
+	return json.str();
+}
+
+
+/**
+ * @brief Compute the results once all the messages are received
+ *        and write them
+ *
+ * @return true on success, false otherwise
+ */
+static bool report()
+{
+	auto end = bench_clock::now();
+	struct rusage usage_end;
+	getrusage(RUSAGE_SELF, &usage_end);
+
+	double elapsed = std::chrono::duration<double>(end - bench.start).count();
+	double cpu = cpuTime(usage_end) - cpuTime(bench.usage_start);
+
+	std::vector<uint64_t> jitters;
+	{
+		std::lock_guard<std::mutex> lock{bench.jitters_lock};
+		jitters = bench.jitters;
+	}
+	std::sort(bench.latencies.begin(), bench.latencies.end());
+	std::sort(bench.hop_latencies.begin(), bench.hop_latencies.end());
+	std::sort(jitters.begin(), jitters.end());
+
+	std::ostringstream json;
+	json << "{\"relays\": " << bench.relays
+	     << ", \"fanout\": " << bench.fanout
+	     << ", \"channels\": \"" << (bench.mux_relays ? "muxdemux" : "simple") << "\""
+	     << ", \"window\": " << bench.window
+	     << ", \"messages\": " << bench.latencies.size()
+	     << ", \"duration_s\": " << elapsed
+	     << ", \"messages_per_s\": " << (elapsed > 0 ? bench.latencies.size() / elapsed : 0)
+	     << ", \"latency_us\": " << distribution(bench.latencies, 1)
+	     << ", \"hop_latency_us\": " << distribution(bench.hop_latencies, 1)
+	     << ", \"timer_period_ms\": " << bench.timer_period
+	     << ", \"timer_jitter_us\": " << distribution(jitters, 1)
+	     << ", \"cpu_us_per_message\": " << cpu * 1e6 / std::max<std::size_t>(bench.latencies.size(), 1)
+	     << "}" << std::endl;
+
+	if(bench.output.empty())
+	{
+		std::cout << json.str();
+		return true;
+	}
+	std::ofstream output{bench.output};
+	output << json.str();
+	return output.good();
+}
+
+
+/**
+ * @brief Record the latency of the hop a message just made
+ *
+ * @param message  The message received from the previous block
+ */
+static void stamp(BenchMessage &message)
+{
+	auto now = bench_clock::now();
+	auto latency = now - message.forwarded;
+	message.hops.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+	message.forwarded = now;
+}
+
+
+///////////////////////// BenchSource /////////////////////////
+
+Rt::UpwardChannel<BenchSource>::UpwardChannel(const std::string& name):
+	Channels::UpwardMux<UpwardChannel<BenchSource>>{name}
+{
+}
+
+
+bool Rt::UpwardChannel<BenchSource>::onEvent(const MessageEvent& event)
+{
+	// give the message back to the downward channel to send it again
+	return this->shareMessage(event.getMessage<BenchMessage>(), 0);
+}
+
+
+Rt::DownwardChannel<BenchSource>::DownwardChannel(const std::string& name):
+	Channels::DownwardDemux<DownwardChannel<BenchSource>, uint32_t>{name}
+{
+}
+
+
+bool Rt::DownwardChannel<BenchSource>::onInit()
+{
+	// let all the channels start before sending the first messages
+	this->addTimerEvent("start", 100, false);
+	return true;
+}
+
+
+bool Rt::DownwardChannel<BenchSource>::onEvent(const TimerEvent&)
+{
+	bench.start = bench_clock::now();
+	getrusage(RUSAGE_SELF, &bench.usage_start);
+
+	std::size_t window = std::min(bench.window, bench.messages);
+	for(std::size_t index = 0; index < window; ++index)
+	{
+		auto message = make_ptr<BenchMessage>();
+		message->branch = index % bench.fanout;
+		message->hops.reserve(bench.relays + 1);
+		if(!this->send(std::move(message)))
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+
+bool Rt::DownwardChannel<BenchSource>::onEvent(const MessageEvent& event)
+{
+	auto message = event.getMessage<BenchMessage>();
+	if(bench.sent >= bench.messages)
+	{
+		return true;
+	}
+	return this->send(std::move(message));
+}
+
+
+bool Rt::DownwardChannel<BenchSource>::send(Ptr<BenchMessage> message)
+{
+	uint32_t branch = message->branch;
+	++bench.sent;
+	message->sent = bench_clock::now();
+	message->forwarded = message->sent;
+	message->hops.clear();
+	if(!this->enqueueMessage(branch, std::move(message), 0))
+	{
+		Rt::reportError(this->getName(), std::this_thread::get_id(), true,
+		                "cannot send message on branch %u", branch);
+		return false;
+	}
+	return true;
+}
+
+
+///////////////////////// BenchRelay /////////////////////////
+
+Rt::UpwardChannel<BenchRelay>::UpwardChannel(const std::string& name):
+	Channels::Upward<UpwardChannel<BenchRelay>>{name}
+{
+}
+
+
+bool Rt::UpwardChannel<BenchRelay>::onEvent(const MessageEvent& event)
+{
+	return this->enqueueMessage(event.getMessage<BenchMessage>(), 0);
+}
+
+
+Rt::DownwardChannel<BenchRelay>::DownwardChannel(const std::string& name):
+	Channels::Downward<DownwardChannel<BenchRelay>>{name}
+{
+}
+
+
+bool Rt::DownwardChannel<BenchRelay>::onEvent(const MessageEvent& event)
+{
+	auto message = event.getMessage<BenchMessage>();
+	stamp(*message);
+	return this->enqueueMessage(std::move(message), 0);
+}
+
+
+///////////////////////// BenchMuxRelay /////////////////////////
+
+Rt::UpwardChannel<BenchMuxRelay>::UpwardChannel(const std::string& name, uint32_t branch):
+	Channels::UpwardMuxDemux<UpwardChannel<BenchMuxRelay>, uint32_t>{name},
+	branch{branch}
+{
+}
+
+
+bool Rt::UpwardChannel<BenchMuxRelay>::onEvent(const MessageEvent& event)
+{
+	return this->enqueueMessage(this->branch, event.getMessage<BenchMessage>(), 0);
+}
+
+
+Rt::DownwardChannel<BenchMuxRelay>::DownwardChannel(const std::string& name, uint32_t branch):
+	Channels::DownwardMuxDemux<DownwardChannel<BenchMuxRelay>, uint32_t>{name},
+	branch{branch}
+{
+}
+
+
+bool Rt::DownwardChannel<BenchMuxRelay>::onEvent(const MessageEvent& event)
+{
+	auto message = event.getMessage<BenchMessage>();
+	stamp(*message);
+	return this->enqueueMessage(this->branch, std::move(message), 0);
+}
+
+
+///////////////////////// BenchSink /////////////////////////
+
+Rt::UpwardChannel<BenchSink>::UpwardChannel(const std::string& name):
+	Channels::UpwardDemux<UpwardChannel<BenchSink>, uint32_t>{name},
+	last_expiry{}
+{
+}
+
+
+bool Rt::UpwardChannel<BenchSink>::onInit()
+{
+	this->addTimerEvent("jitter", bench.timer_period);
+	return true;
+}
+
+
+bool Rt::UpwardChannel<BenchSink>::onEvent(const TimerEvent&)
+{
+	auto now = bench_clock::now();
+	if(this->last_expiry != bench_clock::time_point{})
+	{
+		auto period = std::chrono::duration<double, std::nano>(bench.timer_period * 1e6);
+		auto deviation = std::chrono::duration<double, std::nano>(now - this->last_expiry) - period;
+		std::lock_guard<std::mutex> lock{bench.jitters_lock};
+		bench.jitters.push_back(std::abs(deviation.count()));
+	}
+	this->last_expiry = now;
+	return true;
+}
+
+
+bool Rt::UpwardChannel<BenchSink>::onEvent(const MessageEvent& event)
+{
+	auto message = event.getMessage<BenchMessage>();
+	uint32_t branch = message->branch;
+	return this->enqueueMessage(branch, std::move(message), 0);
+}
+
+
+Rt::DownwardChannel<BenchSink>::DownwardChannel(const std::string& name):
+	Channels::DownwardMux<DownwardChannel<BenchSink>>{name}
+{
+}
+
+
+bool Rt::DownwardChannel<BenchSink>::onEvent(const MessageEvent& event)
+{
+	auto message = event.getMessage<BenchMessage>();
+	if(bench.latencies.size() >= bench.messages)
+	{
+		// the messages still in flight once the results are written
+		return true;
+	}
+	stamp(*message);
+	auto latency = message->forwarded - message->sent;
+	bench.latencies.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(latency).count());
+	bench.hop_latencies.insert(bench.hop_latencies.end(), message->hops.begin(), message->hops.end());
+
+	if(bench.latencies.size() < bench.messages)
+	{
+		// send the message back to the source through the upward channel
+		return this->shareMessage(std::move(message), 0);
+	}
+
+	if(!report())
+	{
+		Rt::reportError(this->getName(), std::this_thread::get_id(), true,
+		                "cannot write the results in %s", bench.output.c_str());
+		return false;
+	}
+	kill(getpid(), SIGTERM);
+	return true;
+}
+
+
+/**
+ * @brief Create the relay blocks of each branch and connect them
+ *
+ * @param source  The source block
+ * @param sink    The sink block
+ * @param names   OUT: the names of the created blocks
+ */
+static void buildSimpleRelays(BenchSource &source, BenchSink &sink,
+                              std::vector<std::string> &names)
+{
+	for(uint32_t branch = 0; branch < bench.fanout; ++branch)
+	{
+		std::vector<BenchRelay *> relays;
+		for(uint32_t index = 0; index < bench.relays; ++index)
+		{
+			std::ostringstream name;
+			name << "relay_" << branch << "_" << index;
+			names.push_back(name.str());
+			relays.push_back(&Rt::Rt::createBlock<BenchRelay>(name.str()));
+		}
+
+		Rt::Rt::connectBlocks(source, *relays.front(), branch);
+		for(uint32_t index = 1; index < bench.relays; ++index)
+		{
+			Rt::Rt::connectBlocks(*relays[index - 1], *relays[index]);
+		}
+		Rt::Rt::connectBlocks(*relays.back(), sink, branch);
+	}
+}
+
+
+/**
+ * @brief Create the MuxDemux relay blocks of each branch and connect them
+ *
+ * @param source  The source block
+ * @param sink    The sink block
+ * @param names   OUT: the names of the created blocks
+ */
+static void buildMuxRelays(BenchSource &source, BenchSink &sink,
+                           std::vector<std::string> &names)
+{
+	for(uint32_t branch = 0; branch < bench.fanout; ++branch)
+	{
+		std::vector<BenchMuxRelay *> relays;
+		for(uint32_t index = 0; index < bench.relays; ++index)
+		{
+			std::ostringstream name;
+			name << "relay_" << branch << "_" << index;
+			names.push_back(name.str());
+			relays.push_back(&Rt::Rt::createBlock<BenchMuxRelay>(name.str(), branch));
+		}
+
+		Rt::Rt::connectBlocks(source, *relays.front(), branch, branch);
+		for(uint32_t index = 1; index < bench.relays; ++index)
+		{
+			Rt::Rt::connectBlocks(*relays[index - 1], *relays[index], branch, branch);
+		}
+		Rt::Rt::connectBlocks(*relays.back(), sink, branch, branch);
+	}
+}
+
+
+int main(int argc, char **argv)
+{
+	bool shared_executor = false;
+	int args_used;
+
+	/* parse program arguments, print the help message in case of failure */
+	for(argc--, argv++; argc > 0; argc -= args_used, argv += args_used)
+	{
+		args_used = 1;
+		std::string argument(*argv);
+
+		if(argument == "-m")
+		{
+			bench.mux_relays = true;
+		}
+		else if(argument == "-e")
+		{
+			shared_executor = true;
+		}
+		else if(argc > 1 && argument == "-l")
+		{
+			bench.relays = std::stoul(argv[1]);
+			args_used++;
+		}
+		else if(argc > 1 && argument == "-f")
+		{
+			bench.fanout = std::stoul(argv[1]);
+			args_used++;
+		}
+		else if(argc > 1 && argument == "-n")
+		{
+			bench.messages = std::stoul(argv[1]);
+			args_used++;
+		}
+		else if(argc > 1 && argument == "-w")
+		{
+			bench.window = std::stoul(argv[1]);
+			args_used++;
+		}
+		else if(argc > 1 && argument == "-t")
+		{
+			bench.timer_period = std::stod(argv[1]);
+			args_used++;
+		}
+		else if(argc > 1 && argument == "-o")
+		{
+			bench.output = argv[1];
+			args_used++;
+		}
+		else
+		{
+			usage();
+			return 1;
+		}
+	}
+
+	if(bench.relays == 0 || bench.fanout == 0 || bench.messages == 0 ||
+	   bench.timer_period <= 0)
+	{
+		std::cerr << "the relays, fanout, messages and timer period must be positive" << std::endl;
+		return 1;
+	}
+	std::size_t max_window = 2 * (bench.relays + 1);
+	if(bench.window == 0)
+	{
+		bench.window = max_window;
+	}
+	if(bench.window > max_window)
+	{
+		std::cerr << "the window must not exceed " << max_window
+		          << " messages with " << bench.relays << " relays" << std::endl;
+		return 1;
+	}
+	bench.latencies.reserve(bench.messages);
+	bench.hop_latencies.reserve(bench.messages * (bench.relays + 1));
+
+	std::vector<std::string> names{"source", "sink"};
+	auto& source = Rt::Rt::createBlock<BenchSource>("source");
+	auto& sink = Rt::Rt::createBlock<BenchSink>("sink");
+	if(bench.mux_relays)
+	{
+		buildMuxRelays(source, sink, names);
+	}
+	else
+	{
+		buildSimpleRelays(source, sink, names);
+	}
+
+	if(shared_executor)
+	{
+		Rt::ThreadSettings settings;
+		settings.executor = "shared";
+		for(auto &&name : names)
+		{
+			Rt::Rt::setThreadSettings(name, "Upward", settings);
+			Rt::Rt::setThreadSettings(name, "Downward", settings);
+		}
+	}
+
+	Output::Get()->finalizeConfiguration();
+	if(!Rt::Rt::run(true))
+	{
+		std::cerr << "Unable to run" << std::endl;
+		return 1;
+	}
+
+	return 0;
+}
@@ -0,0 +1,228 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ * @file BenchBlocks.h
+ * @author Viveris Technologies
+ * @brief Benchmark of the message passing and timers between blocks
+ *
+ *  A source block sends messages on F branches of L relay blocks down to a
+ *  sink block, which measures their latency and sends them back to the
+ *  source, keeping a fixed number of messages in flight. Each relay
+ *  stamps the messages on their way down to measure each hop.
+ *
+ *           +-----------------------+
+ *           |        source         |
+ *           +-----------------------+
+ *             |   ^     ...   |   ^
+ *           +-----------+   +-----------+
+ *           |  relay 0  |...|  relay 0  |
+ *           +-----------+   +-----------+
+ *              ...              ...
+ *           +-----------+   +-----------+
+ *           | relay L-1 |...| relay L-1 |
+ *           +-----------+   +-----------+
+ *             |   ^     ...   |   ^
+ *           +-----------------------+
+ *           |    sink  (+ timer)    |
+ *           +-----------------------+
+ */
+
+
+#ifndef BENCH_BLOCKS_H
+#define BENCH_BLOCKS_H
+
+
+#include "Block.h"
+#include "RtChannel.h"
+#include "RtChannelMux.h"
+#include "RtChannelDemux.h"
+#include "RtChannelMuxDemux.h"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+
+/**
+ * @brief The message exchanged between the benchmark blocks
+ */
+struct BenchMessage
+{
+	/// The branch the message travels on
+	uint32_t branch;
+	/// The time the message was sent by the source
+	std::chrono::steady_clock::time_point sent;
+	/// The time the message was sent by the previous block
+	std::chrono::steady_clock::time_point forwarded;
+	/// The latency of each hop from the source to the sink (ns)
+	std::vector<uint64_t> hops;
+};
+
+
+template<>
+class Rt::UpwardChannel<class BenchSource>: public Rt::Channels::UpwardMux<Rt::UpwardChannel<BenchSource>>
+{
+ public:
+	UpwardChannel(const std::string& name);
+
+	using Rt::ChannelBase::onEvent;
+	bool onEvent(const Rt::MessageEvent& event) override;
+};
+
+
+template<>
+class Rt::DownwardChannel<class BenchSource>: public Rt::Channels::DownwardDemux<Rt::DownwardChannel<BenchSource>, uint32_t>
+{
+ public:
+	DownwardChannel(const std::string& name);
+
+	bool onInit() override;
+
+	using Rt::ChannelBase::onEvent;
+	bool onEvent(const Rt::TimerEvent& event) override;
+	bool onEvent(const Rt::MessageEvent& event) override;
+
+ protected:
+	/**
+	 * @brief Stamp and send a message on its branch
+	 *
+	 * @param message  The message to send
+	 * @return true on success, false otherwise
+	 */
+	bool send(Rt::Ptr<BenchMessage> message);
+};
+
+
+class BenchSource: public Rt::Block<BenchSource>
+{
+ public:
+	using Rt::Block<BenchSource>::Block;
+};
+
+
+template<>
+class Rt::UpwardChannel<class BenchRelay>: public Rt::Channels::Upward<Rt::UpwardChannel<BenchRelay>>
+{
+ public:
+	UpwardChannel(const std::string& name);
+
+	using Rt::ChannelBase::onEvent;
+	bool onEvent(const Rt::MessageEvent& event) override;
+};
+
+
+template<>
+class Rt::DownwardChannel<class BenchRelay>: public Rt::Channels::Downward<Rt::DownwardChannel<BenchRelay>>
+{
+ public:
+	DownwardChannel(const std::string& name);
+
+	using Rt::ChannelBase::onEvent;
+	bool onEvent(const Rt::MessageEvent& event) override;
+};
+
+
+class BenchRelay: public Rt::Block<BenchRelay>
+{
+ public:
+	using Rt::Block<BenchRelay>::Block;
+};
+
+
+template<>
+class Rt::UpwardChannel<class BenchMuxRelay>: public Rt::Channels::UpwardMuxDemux<Rt::UpwardChannel<BenchMuxRelay>, uint32_t>
+{
+ public:
+	UpwardChannel(const std::string& name, uint32_t branch);
+
+	using Rt::ChannelBase::onEvent;
+	bool onEvent(const Rt::MessageEvent& event) override;
+
+ protected:
+	uint32_t branch;
+};
+
+
+template<>
+class Rt::DownwardChannel<class BenchMuxRelay>: public Rt::Channels::DownwardMuxDemux<Rt::DownwardChannel<BenchMuxRelay>, uint32_t>
+{
+ public:
+	DownwardChannel(const std::string& name, uint32_t branch);
+
+	using Rt::ChannelBase::onEvent;
+	bool onEvent(const Rt::MessageEvent& event) override;
+
+ protected:
+	uint32_t branch;
+};
+
+
+class BenchMuxRelay: public Rt::Block<BenchMuxRelay, uint32_t>
+{
+ public:
+	using Rt::Block<BenchMuxRelay, uint32_t>::Block;
+};
+
+
+template<>
+class Rt::UpwardChannel<class BenchSink>: public Rt::Channels::UpwardDemux<Rt::UpwardChannel<BenchSink>, uint32_t>
+{
+ public:
+	UpwardChannel(const std::string& name);
+
+	bool onInit() override;
+
+	using Rt::ChannelBase::onEvent;
+	bool onEvent(const Rt::TimerEvent& event) override;
+	bool onEvent(const Rt::MessageEvent& event) override;
+
+ protected:
+	/// The last time the jitter timer expired
+	std::chrono::steady_clock::time_point last_expiry;
+};
+
+
+template<>
+class Rt::DownwardChannel<class BenchSink>: public Rt::Channels::DownwardMux<Rt::DownwardChannel<BenchSink>>
+{
+ public:
+	DownwardChannel(const std::string& name);
+
+	using Rt::ChannelBase::onEvent;
+	bool onEvent(const Rt::MessageEvent& event) override;
+};
+
+
+class BenchSink: public Rt::Block<BenchSink>
+{
+ public:
+	using Rt::Block<BenchSink>::Block;
+};
+
+
+#endif
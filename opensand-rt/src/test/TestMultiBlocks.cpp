@@ -97,7 +97,8 @@
 static void usage(void)
 {
 	std::cerr << "Test multi blocks: test the opensand rt library" << std::endl
-	          << "usage: test_multi_blocks -i input_file" << std::endl;
+	          << "usage: test_multi_blocks -i input_file [-e]" << std::endl
+	          << "  -e  run the middle and bottom channels on a shared executor" << std::endl;
 }
 
 
@@ -472,10 +473,11 @@ HeapLeakChecker heap_checker("test_multi_blocks");
 #endif
 	std::string error;
 	std::string input_file;
+	bool shared_executor = false;
 	int args_used;
 
 	/* parse program arguments, print the help message in case of failure */
-	if(argc <= 1 || argc > 3)
+	if(argc <= 1 || argc > 4)
 	{
 		usage();
 		return 1;
@@ -498,6 +500,10 @@ HeapLeakChecker heap_checker("test_multi_blocks");
 			input_file = argv[1];
 			args_used++;
 		}
+		else if(argument == "-e")
+		{
+			shared_executor = true;
+		}
 		else
 		{
 			usage();
@@ -513,6 +519,17 @@ HeapLeakChecker heap_checker("test_multi_blocks");
 	Rt::Rt::connectBlocks(top, middle);
 	Rt::Rt::connectBlocks(middle, bottom);
 
+	if(shared_executor)
+	{
+		// top keeps its own threads to mix local and cross-thread messages
+		Rt::ThreadSettings settings;
+		settings.executor = "shared";
+		Rt::Rt::setThreadSettings("middle", "Upward", settings);
+		Rt::Rt::setThreadSettings("middle", "Downward", settings);
+		Rt::Rt::setThreadSettings("bottom", "Upward", settings);
+		Rt::Rt::setThreadSettings("bottom", "Downward", settings);
+	}
+
 	std::cout << "Start loop, please wait..." << std::endl;
 	Output::Get()->finalizeConfiguration();
 	if(!Rt::Rt::run(true))
@@ -0,0 +1,84 @@
+/*
+ *
+ * OpenSAND is an emulation testbed aiming to represent in a cost effective way a
+ * satellite telecommunication system for research and engineering activities.
+ *
+ *
+ * Copyright © 2019 TAS
+ *
+ *
+ * This file is part of the OpenSAND testbed.
+ *
+ *
+ * OpenSAND is free software : you can redistribute it and/or modify it under
+ * the terms of the GNU Lesser General Public License as published by the Free
+ * Software Foundation, either version 3 of the License, or (at your option)
+ * any later version.
+ *
+ * This program is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY, without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE. See the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this program. If not, see http://www.gnu.org/licenses/.
+ *
+ */
+
+/**
+ *
+ * @file TestThreadSettings.cpp
+ * @author Viveris Technologies
+ * @brief Check the parsing of the CPU lists given for the block threads
+ */
+
+
+#include "ThreadSettings.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sched.h>
+
+
+int main()
+{
+	std::vector<unsigned int> cpus;
+
+	if(!Rt::parseCpuList("0-3,6", cpus) ||
+	   cpus != std::vector<unsigned int>{0, 1, 2, 3, 6})
+	{
+		fprintf(stderr, "wrong CPUs for a valid list\n");
+		return EXIT_FAILURE;
+	}
+
+	std::string last_cpu = std::to_string(CPU_SETSIZE - 1);
+	if(!Rt::parseCpuList(last_cpu, cpus) || cpus.size() != 1)
+	{
+		fprintf(stderr, "last CPU rejected\n");
+		return EXIT_FAILURE;
+	}
+
+	// out of range CPUs are rejected before the range is expanded
+	std::string out_of_range = std::to_string(CPU_SETSIZE);
+	for(const std::string &list: {std::string{"0-4294967295"},
+	                               std::string{"4294967295"},
+	                               "0-" + out_of_range,
+	                               out_of_range + "-" + out_of_range,
+	                               std::string{"0-99999999999"},
+	                               std::string{"3-1"},
+	                               std::string{""},
+	                               std::string{"1,,2"},
+	                               std::string{"-1"},
+	                               std::string{"a-b"}})
+	{
+		if(Rt::parseCpuList(list, cpus))
+		{
+			fprintf(stderr, "CPU list \"%s\" accepted\n", list.c_str());
+			return EXIT_FAILURE;
+		}
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -15,11 +15,13 @@ if [ "x$MAKELEVEL" != "x" ] ; then
 	TEST="./test_block"
 	TEST_MULTI="./test_multi_blocks -i ${BASEDIR}/TestMultiBlocks.h"
 	TEST_MUX="./test_mux_blocks"
+	BENCH="./bench_blocks"
 else
 	BASEDIR=$( dirname "${SCRIPT}" )
 	TEST="${BASEDIR}/test_block"
 	TEST_MULTI="${BASEDIR}/test_multi_blocks -i ${BASEDIR}/TestMultiBlocks.h"
 	TEST_MUX="${BASEDIR}/test_mux_blocks"
+	BENCH="${BASEDIR}/bench_blocks"
 fi
 
 if [ -e "/usr/bin/google-pprof" ]; then
@@ -36,5 +38,14 @@ fi
 echo "Check multi blocks"
 env HEAPCHECK=strict > /dev/null ${TEST_MULTI} 2>&1 1>/dev/null || env HEAPCHECK=strict ${TEST_MULTI} || exit $?
 
+echo "Check multi blocks on a shared executor"
+env HEAPCHECK=strict > /dev/null ${TEST_MULTI} -e 2>&1 1>/dev/null || env HEAPCHECK=strict ${TEST_MULTI} -e || exit $?
+
 echo "Check mux blocks"
 env HEAPCHECK=strict > /dev/null "${TEST_MUX}" 2>&1 1>/dev/null || env HEAPCHECK=strict "${TEST_MUX}" || exit $?
+
+# short runs only check the benchmark works, not the performances
+echo "Check blocks benchmark"
+"${BENCH}" -n 2000 -l 2 -f 2 || exit $?
+"${BENCH}" -n 2000 -l 2 -f 2 -m || exit $?
+"${BENCH}" -n 2000 -l 2 -e || exit $?